@@ -59,6 +59,13 @@ class configuration:
   # Default floating point for the main openmoc module is single precision
   fp = 'single'
 
+  # Additional floating point precisions (single, double or mixed) to build
+  # side by side with the main openmoc module as the openmoc.single,
+  # openmoc.double and openmoc.mixed packages. The precision used by
+  # "import openmoc" may be selected at runtime with the OPENMOC_PRECISION
+  # environment variable.
+  precisions = list()
+
   # Compile using ccache (for developers needing fast recompilation)
   with_ccache = False
 
@@ -71,8 +78,12 @@ class configuration:
   # Build the openmoc.cuda module
   with_cuda = False
 
+  # Build with MPI to solve the domains of a decomposed Geometry in
+  # separate processes with the MPICommunicator
+  with_mpi = False
+
   # The vector length used for the VectorizedSolver class. This will used
-  # as a hint for the Intel compiler to issue SIMD (ie, SSE, AVX, etc) vector
+  # as a hint for the compiler to issue SIMD (ie, SSE, AVX, etc) vector
   # instructions. This is accomplished by adding "dummy" energy groups such
   # that the number of energy groups is be fit too a multiple of this
   # vector_length, and restructuring the innermost loops in the solver to
@@ -90,6 +101,11 @@ class configuration:
   # List of the possible packages to install based on runtime options
   packages = ['openmoc', 'openmoc.cuda']
 
+  # The floating point precisions supported by OpenMOC. Mixed precision
+  # stores Track angular fluxes and segments in single precision while
+  # accumulating FSR scalar fluxes, k_eff and residuals in double precision.
+  fp_types = ['single', 'double', 'mixed']
+
 
   #############################################################################
   #                                 Source Code
@@ -109,6 +125,10 @@ class configuration:
                     'src/ExpEvaluator.cpp',
                     'src/Solver.cpp',
                     'src/CPUSolver.cpp',
+                    'src/BatchSolver.cpp',
+                    'src/CPULSSolver.cpp',
+                    'src/KrylovSolver.cpp',
+                    'src/VectorizedSolver.cpp',
                     'src/Surface.cpp',
                     'src/Timer.cpp',
                     'src/Track.cpp',
@@ -117,6 +137,7 @@ class configuration:
                     'src/Vector.cpp',
                     'src/Matrix.cpp',
                     'src/Cmfd.cpp',
+                    'src/Communicator.cpp',
                     'src/linalg.cpp']
 
   sources['clang'] = ['openmoc/openmoc_wrap.cpp',
@@ -130,12 +151,17 @@ class configuration:
                       'src/ExpEvaluator.cpp',
                       'src/Solver.cpp',
                       'src/CPUSolver.cpp',
+                      'src/BatchSolver.cpp',
+                      'src/CPULSSolver.cpp',
+                      'src/KrylovSolver.cpp',
+                      'src/VectorizedSolver.cpp',
                       'src/Surface.cpp',
                       'src/Timer.cpp',
                       'src/Track.cpp',
                       'src/TrackGenerator.cpp',
                       'src/Universe.cpp',
                       'src/Cmfd.cpp',
+                      'src/Communicator.cpp',
                       'src/Vector.cpp',
                       'src/Matrix.cpp',
                       'src/linalg.cpp']
@@ -152,6 +178,9 @@ class configuration:
                      'src/ExpEvaluator.cpp',
                      'src/Solver.cpp',
                      'src/CPUSolver.cpp',
+                     'src/BatchSolver.cpp',
+                     'src/CPULSSolver.cpp',
+                     'src/KrylovSolver.cpp',
                      'src/VectorizedSolver.cpp',
                      'src/Surface.cpp',
                      'src/Timer.cpp',
@@ -159,6 +188,7 @@ class configuration:
                      'src/TrackGenerator.cpp',
                      'src/Universe.cpp',
                      'src/Cmfd.cpp',
+                     'src/Communicator.cpp',
                      'src/Vector.cpp',
                      'src/Matrix.cpp',
                      'src/linalg.cpp']
@@ -175,12 +205,16 @@ class configuration:
                       'src/ExpEvaluator.cpp',
                       'src/Solver.cpp',
                       'src/CPUSolver.cpp',
+                      'src/BatchSolver.cpp',
+                      'src/CPULSSolver.cpp',
+                      'src/KrylovSolver.cpp',
                       'src/Surface.cpp',
                       'src/Timer.cpp',
                       'src/Track.cpp',
                       'src/TrackGenerator.cpp',
                       'src/Universe.cpp',
                       'src/Cmfd.cpp',
+                      'src/Communicator.cpp',
                       'src/Vector.cpp',
                       'src/Matrix.cpp',
                       'src/linalg.cpp']
@@ -307,6 +341,18 @@ class configuration:
   if sys.version_info[0] == 3:
     swig_flags.append('-py3')
 
+  # A dictionary of the SWIG flags for each floating point precision
+  swig_fp_flags = dict()
+
+  swig_fp_flags['single'] = ['-DSINGLE', '-DFP_PRECISION=float']
+  swig_fp_flags['double'] = ['-DDOUBLE', '-DFP_PRECISION=double']
+  swig_fp_flags['mixed'] = ['-DMIXED', '-DSINGLE', '-DFP_PRECISION=float',
+                            '-DACC_PRECISION=double']
+
+  # A dictionary of the complete SWIG flags for each additional precision
+  # built side by side with the main openmoc module
+  precision_swig_flags = dict()
+
 
   #############################################################################
   #                                  Macros
@@ -384,6 +430,47 @@ class configuration:
                               ('NVCC', None),
                               ('CCACHE_CC', 'nvcc')]
 
+  macros['gcc']['mixed'] = [('FP_PRECISION', 'float'),
+                            ('ACC_PRECISION', 'double'),
+                            ('SINGLE', None),
+                            ('MIXED', None),
+                            ('GCC', None),
+                            ('VEC_LENGTH', vector_length),
+                            ('VEC_ALIGNMENT', vector_alignment)]
+
+  macros['clang']['mixed'] = [('FP_PRECISION', 'float'),
+                              ('ACC_PRECISION', 'double'),
+                              ('SINGLE', None),
+                              ('MIXED', None),
+                              ('CLANG', None),
+                              ('VEC_LENGTH', vector_length),
+                              ('VEC_ALIGNMENT', vector_alignment)]
+
+  macros['icpc']['mixed'] = [('FP_PRECISION', 'float'),
+                             ('ACC_PRECISION', 'double'),
+                             ('SINGLE', None),
+                             ('MIXED', None),
+                             ('ICPC', None),
+                             ('MKL_ILP64', None),
+                             ('VEC_LENGTH', vector_length),
+                             ('VEC_ALIGNMENT', vector_alignment)]
+
+  macros['bgxlc']['mixed'] = [('FP_PRECISION', 'float'),
+                              ('ACC_PRECISION', 'double'),
+                              ('SINGLE', None),
+                              ('MIXED', None),
+                              ('BGXLC', None),
+                              ('VEC_LENGTH', vector_length),
+                              ('VEC_ALIGNMENT', vector_alignment),
+                              ('CCACHE_CC', 'bgxlc++_r')]
+
+  macros['nvcc']['mixed'] = [('FP_PRECISION', 'float'),
+                             ('ACC_PRECISION', 'double'),
+                             ('SINGLE', None),
+                             ('MIXED', None),
+                             ('NVCC', None),
+                             ('CCACHE_CC', 'nvcc')]
+
   # define OPENMP and SWIG (for log output)
   for compiler in macros:
     for precision in macros[compiler]:
@@ -411,6 +498,14 @@ class configuration:
         self.compiler_flags[k].append('-pg')
         self.compiler_flags[k].append('-g')
 
+    # If the user wishes to build with MPI, define the MPIx macro for the
+    # compiler and SWIG to include the MPICommunicator
+    if self.with_mpi:
+      for cc in ['gcc', 'clang', 'icpc', 'bgxlc']:
+        for fp in self.macros[cc]:
+          self.macros[cc][fp].append(('MPIx', None))
+      self.swig_flags.append('-DMPIx')
+
     # Obtain the NumPy include directory
     try:
       numpy_include = numpy.get_include()
@@ -423,12 +518,30 @@ class configuration:
       self.include_directories[cc].append(numpy_include)
 
 
+    # The openmoc extensions for each additional precision built side by
+    # side with the main module in the openmoc.single, openmoc.double and
+    # openmoc.mixed packages. The SWIG wrappers are generated in the package
+    # directories, so "openmoc" is added to the include directories to
+    # resolve the relative "../src" headers included by the wrappers.
+    for fp in self.precisions:
+      self.precision_swig_flags[fp] = \
+        self.swig_flags + self.swig_fp_flags[fp] + ['-D' + self.cc.upper()]
+
+      self.extensions.append(
+        Extension(name = 'openmoc.{0}._openmoc'.format(fp),
+                  sources = ['openmoc/{0}/openmoc_wrap.cpp'.format(fp)] + \
+                            copy.deepcopy(self.sources[self.cc][1:]),
+                  library_dirs = self.library_directories[self.cc],
+                  libraries = self.shared_libraries[self.cc],
+                  extra_link_args = self.linker_flags[self.cc],
+                  include_dirs = self.include_directories[self.cc] + \
+                                 ['openmoc'],
+                  define_macros = self.macros[self.cc][fp],
+                  swig_opts = self.precision_swig_flags[fp]))
+      self.packages.append('openmoc.{0}'.format(fp))
+
     # The main openmoc extension (defaults are gcc and single precision)
-    self.swig_flags += ['-D' + self.fp.upper()]
-    if self.fp == 'double':
-      self.swig_flags += ['-DFP_PRECISION=double']
-    else:
-      self.swig_flags += ['-DFP_PRECISION=float']
+    self.swig_flags += self.swig_fp_flags[self.fp]
 
     self.extensions.append(
       Extension(name = '_openmoc',
@@ -1,11 +1,32 @@
 import sys, os
+import importlib
 import random
 import datetime
 import signal
 
+# The floating point precision (single, double or mixed) of the C++ extension
+# module may be selected at runtime if it was built side by side with the main
+# module (python setup.py install --with-precisions=single,double,mixed)
+precision = os.environ.get('OPENMOC_PRECISION', None)
+if precision not in [None, 'single', 'double', 'mixed']:
+    raise ImportError('Unable to import OpenMOC with precision "{0}" since '
+                      'only single, double and mixed precisions are '
+                      'supported'.format(precision))
+
+def _import_precision(precision):
+    """Import all public names from an OpenMOC extension module built side
+    by side with the main module for a floating point precision."""
+    module = importlib.import_module('openmoc.{0}.openmoc'.format(precision))
+    for name in dir(module):
+        if not name.startswith('__'):
+            globals()[name] = getattr(module, name)
+
 # For Python 2.X.X
 if (sys.version_info[0] == 2):
-    from openmoc import *
+    if precision is None:
+        from openmoc import *
+    else:
+        _import_precision(precision)
     import log
     import options
     import materialize
@@ -14,7 +35,10 @@ if (sys.version_info[0] == 2):
     import krylov
 # For Python 3.X.X
 else:
-    from openmoc.openmoc import *
+    if precision is None:
+        from openmoc.openmoc import *
+    else:
+        _import_precision(precision)
     import openmoc.log
     import openmoc.options
     import openmoc.materialize
@@ -42,6 +42,12 @@
   }
 }
 
+/* Iteration callbacks may only be given to the CPU solvers from Python */
+%ignore Solver::setIterationCallback(iterationCallback callback,
+                                     void* callback_data);
+%ignore Solver::getIterationCallback();
+%ignore Solver::getIterationCallbackData();
+
 #ifdef NO_NUMPY
 #else
 %include "../numpy_typemaps.i"
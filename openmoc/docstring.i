@@ -1190,7 +1190,7 @@ Parameters
 ";
 
 %feature("docstring") Cmfd::updateBoundaryFlux "
-updateBoundaryFlux(Track **tracks, FP_PRECISION *boundary_flux, int num_tracks)  
+updateBoundaryFlux(FP_PRECISION *boundary_flux, int num_tracks)  
 
 Update the MOC boundary fluxes.  
 
@@ -1200,14 +1200,10 @@ outgoing flux from the track enters.
 
 Parameters
 ----------
-* tracks :  
-    2D array of Tracks  
 * boundary_flux :  
     Array of boundary fluxes  
-
-Returns
--------
-The number of Tracks  
+* num_tracks :  
+    The number of Tracks  
 ";
 
 %feature("docstring") Cmfd::setBoundary "
@@ -0,0 +1,8 @@
+import sys
+
+# For Python 2.X.X
+if (sys.version_info[0] == 2):
+    from openmoc import *
+# For Python 3.X.X
+else:
+    from openmoc.double.openmoc import *
@@ -22,6 +22,11 @@ class IRAMSolver(object):
     n highest order eigenvalues/vectors for a k-eigenvalue criticality problem.
     This functionality is based on original work by Colin Josey (cjosey@mit.edu).
 
+    With a CPUSolver and the 'gmres' inner method, the Arnoldi and GMRES
+    iterations are performed by the C++ KrylovSolver, which applies the
+    transport sweeps directly to its Krylov vectors. The other inner methods
+    and solvers use the scipy.sparse.linalg package.
+
     NOTE: This functionality only works for vacuum boundary conditions.
 
     """
@@ -59,6 +64,7 @@ class IRAMSolver(object):
         self._op_size = num_FSRs * num_groups
 
         # Initialize solution-dependent class attributes to None
+        self._krylov_solver = None
         self._num_modes = None
         self._interval = None
         self._outer_tol = None
@@ -74,7 +80,11 @@ class IRAMSolver(object):
     def computeEigenmodes(self, solver_mode=openmoc.FORWARD, num_modes=5,
                           inner_method='gmres', outer_tol=1e-5,
                           inner_tol=1e-6, interval=10):
-        """Compute all eigenmodes in the problem using the scipy.linalg package.
+        """Compute all eigenmodes in the problem.
+
+        The eigenmodes are computed by the C++ KrylovSolver for a CPUSolver
+        with the 'gmres' inner method and by the scipy.linalg package
+        otherwise.
 
         Parameters
         ----------
@@ -101,6 +111,15 @@ class IRAMSolver(object):
             py_printf('ERROR', 'All boundary conditions must be ' + \
                       'VACUUM for the IRAMSolver')
 
+        if inner_method not in ['gmres', 'lgmres', 'bicgstab', 'cgs']:
+            py_printf('ERROR', 'Unable to use %s to solve Ax=b', inner_method)
+
+        if inner_method == 'gmres' and \
+           isinstance(self._moc_solver, openmoc.CPUSolver):
+            self._computeKrylovEigenmodes(solver_mode, num_modes, outer_tol,
+                                          inner_tol, interval)
+            return
+
         import scipy.sparse.linalg as linalg
 
         # Set solution-dependent class attributes based on parameters
@@ -156,6 +175,64 @@ class IRAMSolver(object):
         # Restore the material data
         self._moc_solver.resetMaterials(solver_mode)
 
+    def _computeKrylovEigenmodes(self, solver_mode, num_modes, outer_tol,
+                                 inner_tol, interval):
+        """Private routine to compute the eigenmodes with the KrylovSolver.
+
+        Parameters
+        ----------
+        solver_mode : {openmoc.FORWARD, openmoc.ADJOINT}
+            The type of eigenmodes to compute
+        num_modes : Integral
+            The number of eigenmodes to compute
+        outer_tol : Real
+            The tolerance on the outer eigenvalue solve
+        inner_tol : Real
+            The tolerance on the inner Ax=b solve
+        interval : Integral
+            The transport sweep interval for logging messages
+
+        """
+
+        if self._krylov_solver is None:
+            self._krylov_solver = openmoc.KrylovSolver(self._moc_solver)
+
+        # Set solution-dependent class attributes based on parameters
+        self._num_modes = num_modes
+        self._inner_method = 'gmres'
+        self._outer_tol = outer_tol
+        self._inner_tol = inner_tol
+        self._interval = interval
+
+        # Solve the eigenvalue problem
+        self._krylov_solver.setLogInterval(interval)
+        timer = openmoc.Timer()
+        timer.startTimer()
+        self._krylov_solver.computeEigenmodes(solver_mode, num_modes,
+                                              outer_tol, inner_tol)
+        timer.stopTimer()
+
+        # Print a timer report
+        tot_time = timer.getTime()
+        time_per_mode = tot_time / self._num_modes
+        tot_time = '{0:.4e} sec'.format(tot_time)
+        time_per_mode = '{0:.4e} sec'.format(time_per_mode)
+        py_printf('RESULT', 'Total time to solution'.ljust(53, '.') + tot_time)
+        py_printf('RESULT', 'Solution time per mode'.ljust(53, '.') + time_per_mode)
+
+        # Store the eigenvalues and eigenvectors
+        self._eigenvalues = np.zeros(num_modes, dtype=np.complex128)
+        self._eigenvectors = np.zeros((self._op_size, num_modes),
+                                      dtype=np.complex128)
+
+        for mode in range(num_modes):
+            self._eigenvalues[mode] = \
+                complex(self._krylov_solver.getEigenvalue(mode),
+                        self._krylov_solver.getEigenvalueImag(mode))
+            self._eigenvectors[:, mode] = \
+                self._krylov_solver.getEigenvector(mode, self._op_size) + \
+                1j * self._krylov_solver.getEigenvectorImag(mode, self._op_size)
+
     def _A(self, flux):
         """Private routine for inner Ax=b solves with the scattering source.
 
@@ -75,3 +75,53 @@
 
 /* The typemap used to match the method signature for Solver::setFluxes */
 %apply (FP_PRECISION* INPLACE_ARRAY1, int DIM1) {(FP_PRECISION* in_fluxes, int num_fluxes)}
+
+/* The typemap used to match the method signature for Solver::getFSRSources */
+%apply (FP_PRECISION* ARGOUT_ARRAY1, int DIM1) {(FP_PRECISION* out_sources, int num_sources)}
+
+/* The typemap used to match the method signature for Solver::getFSRVolumes */
+%apply (FP_PRECISION* ARGOUT_ARRAY1, int DIM1) {(FP_PRECISION* out_volumes, int num_volumes)}
+
+/* The typemaps used to match the method signatures for the Solver's
+ * getFluxesView, getReducedSourcesView and getFSRVolumesView methods. These
+ * return read-only NumPy arrays which share memory with the Solver rather
+ * than copies. Each array holds a reference to the Solver as its base object
+ * such that the Solver's arrays are not freed while the array exists. */
+%define %solver_view_typemaps(DATA_TYPE, DATA_TYPECODE)
+
+%typemap(in,numinputs=0)
+  (DATA_TYPE** view_values, int* num_values)
+  (DATA_TYPE* data_temp = NULL, int dim_temp = 0)
+{
+  $1 = &data_temp;
+  $2 = &dim_temp;
+}
+
+%typemap(argout,
+         fragment="NumPy_Backward_Compatibility")
+  (DATA_TYPE** view_values, int* num_values)
+{
+  npy_intp dims[1] = { *$2 };
+  PyObject* obj = PyArray_SimpleNewFromData(1, dims, DATA_TYPECODE,
+                                            (void*)(*$1));
+  PyArrayObject* array = (PyArrayObject*) obj;
+
+  if (!array) SWIG_fail;
+
+  Py_INCREF(obj0);
+
+%#if NPY_API_VERSION < 0x00000007
+  PyArray_FLAGS(array) &= ~NPY_WRITEABLE;
+  PyArray_BASE(array) = obj0;
+%#else
+  PyArray_CLEARFLAGS(array, NPY_ARRAY_WRITEABLE);
+  PyArray_SetBaseObject(array, obj0);
+%#endif
+
+  $result = SWIG_Python_AppendOutput($result, obj);
+}
+
+%enddef
+
+%solver_view_typemaps(float, NPY_FLOAT)
+%solver_view_typemaps(double, NPY_DOUBLE)
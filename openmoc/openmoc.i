@@ -21,8 +21,12 @@
   #include "../src/Material.h"
   #include "../src/Point.h"
   #include "../src/PolarQuad.h"
+  #include "../src/Communicator.h"
   #include "../src/Solver.h"
   #include "../src/CPUSolver.h"
+  #include "../src/KrylovSolver.h"
+  #include "../src/BatchSolver.h"
+  #include "../src/CPULSSolver.h"
   #include "../src/boundary_type.h"
   #include "../src/Surface.h"
   #include "../src/Timer.h"
@@ -34,7 +38,7 @@
   #include "../src/Matrix.h"
   #include "../src/linalg.h"
 
-  #ifdef ICPC
+  #ifndef BGXLC
   #include "../src/VectorizedSolver.h"
   #endif
 
@@ -88,6 +92,9 @@
   }
 }
 
+/* Routines which release the GIL during long running methods */
+%include threads.i
+
 /* Routines to allow parent classes to be cast to subclasses from Python */
 %include casting.i
 
@@ -106,8 +113,12 @@
 %include ../src/Material.h
 %include ../src/Point.h
 %include ../src/PolarQuad.h
+%include ../src/Communicator.h
 %include ../src/Solver.h
 %include ../src/CPUSolver.h
+%include ../src/KrylovSolver.h
+%include ../src/BatchSolver.h
+%include ../src/CPULSSolver.h
 %include ../src/boundary_type.h
 %include ../src/Surface.h
 %include ../src/Timer.h
@@ -119,7 +130,7 @@
 %include ../src/Matrix.h
 %include ../src/linalg.h
 
-#ifdef ICPC
+#ifndef BGXLC
 %include ../src/VectorizedSolver.h
 #endif
 
@@ -758,15 +758,14 @@ def plot_energy_fluxes(solver, fsrs, group_bounds=None, norm=True,
     # Initialize an empty list of Matplotlib figures if requestd by the user
     figures = []
 
+    # Extract the FSR fluxes from the Solver
+    fsr_fluxes = get_scalar_fluxes(solver)
+
     # Iterate over all flat source regions
     for fsr in fsrs:
 
-        # Allocate memory for an array of this FSR's fluxes
-        fluxes = np.zeros(num_groups, dtype=np.float)
-
-        # Extract the flux in each energy group
-        for group in range(num_groups):
-            fluxes[group] = solver.getFlux(fsr, group+1)
+        # Copy this FSR's flux in each energy group
+        fluxes = np.array(fsr_fluxes[fsr, :], dtype=np.float)
 
         # Normalize fluxes to the total integrated flux
         if norm:
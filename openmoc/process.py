@@ -37,6 +37,10 @@ def get_scalar_fluxes(solver, fsrs='all', groups='all'):
     energy groups, then the fluxes are returned in the order in which the FSRs
     and groups are enumerated in the associated paramters.
 
+    If 'all' FSRs and groups are requested from a CPU solver, the array is a
+    read-only view of the solver's scalar flux array rather than a copy. The
+    fluxes of a BatchSolver are those of its active state.
+
     Parameters
     ----------
     solver : openmoc.Solver
@@ -57,35 +61,34 @@ def get_scalar_fluxes(solver, fsrs='all', groups='all'):
 
     cv.check_type('solver', solver, openmoc.Solver)
 
-    if isinstance('fsrs', basestring):
+    if isinstance(fsrs, basestring):
         cv.check_value('fsrs', fsrs, 'all')
     else:
-        cv.check_type('fsrs', Iterable, Integral)
+        cv.check_type('fsrs', fsrs, Iterable, Integral)
 
-    if isinstance('groups', basestring):
-        cv.check_value('groups', fsrs, 'all')
+    if isinstance(groups, basestring):
+        cv.check_value('groups', groups, 'all')
     else:
-        cv.check_type('groups', Iterable, Integral)
+        cv.check_type('groups', groups, Iterable, Integral)
 
-    # Build a list of FSRs to iterate over
-    if fsrs == 'all':
-        num_fsrs = solver.getGeometry().getNumFSRs()
-        fsrs = np.arange(num_fsrs)
-    else:
-        num_fsrs = len(fsrs)
+    num_fsrs = solver.getGeometry().getNumFSRs()
+    num_groups = solver.getGeometry().getNumEnergyGroups()
 
-    # Build a list of enery groups to iterate over
-    if groups == 'all':
-        num_groups = solver.getGeometry().getNumEnergyGroups()
-        groups = np.arange(num_groups) + 1
+    # Extract all FSR scalar fluxes in bulk, without a copy if on the CPU
+    # (the view of a BatchSolver holds the fluxes of all of its states)
+    if 'GPUSolver' in type(solver).__name__ or \
+       isinstance(solver, openmoc.BatchSolver):
+        fluxes = solver.getFluxes(num_fsrs * num_groups)
     else:
-        num_groups = len(groups)
+        fluxes = solver.getFluxesView()
+
+    fluxes = fluxes.reshape((num_fsrs, num_groups))
 
-    # Extract the FSR scalar fluxes
-    fluxes = np.zeros((num_fsrs, num_groups))
-    for fsr in fsrs:
-        for group in groups:
-            fluxes[fsr, group-1] = solver.getFlux(int(fsr), int(group))
+    # Select the requested FSRs and energy groups
+    if not isinstance(fsrs, basestring):
+        fluxes = fluxes[np.asarray(fsrs, dtype=np.int), :]
+    if not isinstance(groups, basestring):
+        fluxes = fluxes[:, np.asarray(groups, dtype=np.int) - 1]
 
     return fluxes
 
@@ -298,9 +301,10 @@ def store_simulation_state(solver, fluxes=False, sources=False,
         precision = 'single'
 
     # Determine whether we are using the exponential
-    # linear interpolation for exponential evaluations
+    # interpolation table for exponential evaluations
     if solver.isUsingExponentialInterpolation():
-        method = 'linear interpolation'
+        order = solver.getExpInterpolationOrder()
+        method = ['linear', 'quadratic', 'cubic'][order-1] + ' interpolation'
     else:
         method = 'exp intrinsic'
 
@@ -339,24 +343,16 @@ def store_simulation_state(solver, fluxes=False, sources=False,
     # If the user requested to store the FSR fluxes
     if fluxes:
 
-        # Allocate array
-        scalar_fluxes = np.zeros((num_FSRs, num_groups))
-
         # Get the scalar flux for each FSR and energy group
-        for i in range(num_FSRs):
-            for j in range(num_groups):
-                scalar_fluxes[i,j] = solver.getFlux(i,j+1)
+        scalar_fluxes = np.array(get_scalar_fluxes(solver), dtype=np.float)
 
     # If the user requested to store the FSR sources
     if sources:
 
-        # Allocate array
-        sources_array = np.zeros((num_FSRs, num_groups))
-
-        # Get the scalar flux for each FSR and energy group
-        for i in range(num_FSRs):
-            for j in range(num_groups):
-                sources_array[i,j] = solver.getFSRSource(i,j+1)
+        # Get the source for each FSR and energy group
+        sources_array = solver.getFSRSources(num_FSRs * num_groups)
+        sources_array = sources_array.reshape((num_FSRs, num_groups))
+        sources_array = sources_array.astype(np.float)
 
     # If using HDF5
     if use_hdf5:
@@ -945,8 +941,9 @@ class Mesh(object):
             cv.check_type('domains_to_coeffs',
                           domains_to_coeffs, (dict, np.ndarray))
 
-        # Extract the FSR fluxes from the Solver
+        # Extract the FSR fluxes and volumes from the Solver
         fluxes = get_scalar_fluxes(solver)
+        volumes = solver.getFSRVolumes(num_fsrs)
 
         # Initialize a 2D or 3D NumPy array in which to tally
         tally_shape = tuple(self.dimension) + (num_groups,)
@@ -956,7 +953,7 @@ class Mesh(object):
         for fsr in range(num_fsrs):
             point = geometry.getFSRPoint(fsr)
             mesh_indices = self.get_mesh_cell_indices(point)
-            volume = solver.getFSRVolume(fsr)
+            volume = volumes[fsr]
             fsr_tally = np.zeros(num_groups, dtype=np.float)
 
             # Determine domain ID (material, cell or FSR) for this FSR
@@ -0,0 +1,104 @@
+/** Rules for releasing the Python GIL during long running C++ routines */
+
+%module threads
+
+%{
+  /* Calls a Python callable with the progress of a Solver iteration. The
+   * GIL is reacquired since the Solver runs with the GIL released. */
+  static void python_iteration_callback(int iteration, double k_eff,
+                                        double residual, double time,
+                                        void* data) {
+
+    PyGILState_STATE gil_state = PyGILState_Ensure();
+    PyObject* result = PyObject_CallFunction((PyObject*)data, (char*)"iddd",
+                                             iteration, k_eff, residual, time);
+    bool failed = (result == NULL);
+    Py_XDECREF(result);
+    PyGILState_Release(gil_state);
+
+    /* Abort the solve and leave the Python exception to be raised */
+    if (failed)
+      throw std::runtime_error("The iteration callback raised an exception");
+  }
+
+  /* Releases the reference held on a Solver's Python iteration callback */
+  static void release_iteration_callback(Solver* solver) {
+    if (solver->getIterationCallback() == python_iteration_callback)
+      Py_XDECREF((PyObject*)solver->getIterationCallbackData());
+  }
+%}
+
+/* Threads must be initialized for the GIL to be released (Python < 3.7) */
+%init %{
+#if PY_VERSION_HEX < 0x03070000
+  PyEval_InitThreads();
+#endif
+%}
+
+/* Convert a Python callable (or None) into a Solver iteration callback. The
+ * Solver keeps a reference to the callable for as long as it may call it. */
+%typemap(in) (iterationCallback callback, void* callback_data) {
+  if ($input == Py_None) {
+    $1 = NULL;
+    $2 = NULL;
+  }
+  else if (!PyCallable_Check($input)) {
+    PyErr_SetString(PyExc_TypeError, "The iteration callback must be callable");
+    SWIG_fail;
+  }
+  else {
+    Py_INCREF($input);
+    $1 = python_iteration_callback;
+    $2 = (void*)$input;
+  }
+}
+
+/* The callback and its data are only of use to the wrapper */
+%ignore Solver::getIterationCallback();
+%ignore Solver::getIterationCallbackData();
+
+/* Release the reference to the previous callable once it is replaced */
+%feature("action") Solver::setIterationCallback {
+  release_iteration_callback(arg1);
+  arg1->setIterationCallback(arg2, arg3);
+}
+
+/* Release the reference to the callable when a Solver is destroyed */
+%define %release_callback(CLASS)
+%feature("action") CLASS::~CLASS {
+  release_iteration_callback(arg1);
+  delete arg1;
+}
+%enddef
+
+%release_callback(Solver);
+%release_callback(CPUSolver);
+%release_callback(CPULSSolver);
+%release_callback(BatchSolver);
+%release_callback(VectorizedSolver);
+
+/* Release the GIL while the wrapped method runs such that other Python
+ * threads may run concurrently. Exceptions are raised once the GIL has been
+ * reacquired, and a Python exception raised by a callback takes precedence. */
+%define %release_gil(METHOD)
+%exception METHOD {
+  PyThreadState* _save = PyEval_SaveThread();
+  try {
+    $function
+  } catch (const std::exception &e) {
+    PyEval_RestoreThread(_save);
+    if (PyErr_Occurred())
+      SWIG_fail;
+    SWIG_exception(SWIG_RuntimeError, e.what());
+  }
+  PyEval_RestoreThread(_save);
+}
+%enddef
+
+%release_gil(Solver::computeFlux);
+%release_gil(Solver::computeSource);
+%release_gil(Solver::computeEigenvalue);
+%release_gil(TrackGenerator::generateTracks);
+%release_gil(TrackGenerator::splitSegments);
+%release_gil(KrylovSolver::computeSource);
+%release_gil(KrylovSolver::computeEigenmodes);
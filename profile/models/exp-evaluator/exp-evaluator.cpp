@@ -0,0 +1,88 @@
+#include "../../../src/ExpEvaluator.h"
+#include "../../../src/log.h"
+#include <omp.h>
+#include <stdlib.h>
+
+/**
+ * @brief Compares the accuracy and throughput of the exponential evaluation
+ *        methods of the ExpEvaluator.
+ * @details The optional arguments are the number of polar angles (6) and the
+ *          exponential precision (1E-5).
+ */
+int main(int argc, char** argv) {
+
+  /* Define benchmark parameters */
+  int num_polar = (argc > 1) ? atoi(argv[1]) : 6;
+  double precision = (argc > 2) ? atof(argv[2]) : 1E-5;
+  double max_tau = 10.;
+  int num_taus = 1 << 20;
+  int num_sweeps = 20;
+
+  set_log_level("NORMAL");
+  log_printf(TITLE, "Benchmarking the exponential evaluator...");
+  log_printf(NORMAL, "Polar angles = %d, precision = %1.1E", num_polar,
+             precision);
+
+  GLPolarQuad polar_quad;
+  polar_quad.setNumPolarAngles(num_polar);
+  polar_quad.initialize();
+
+  /* Sample the optical lengths of the segments */
+  FP_PRECISION* taus = new FP_PRECISION[num_taus];
+  srand(1);
+  for (int i=0; i < num_taus; i++)
+    taus[i] = max_tau * rand() / RAND_MAX;
+
+  const char* methods[4] = {"intrinsic", "linear", "quadratic", "cubic"};
+
+  for (int m=0; m < 4; m++) {
+
+    ExpEvaluator evaluator;
+    evaluator.setPolarQuadrature(&polar_quad);
+    evaluator.setMaxOpticalLength(max_tau);
+    evaluator.setExpPrecision(precision);
+
+    if (m == 0)
+      evaluator.useIntrinsic();
+    else
+      evaluator.setInterpolationOrder(m);
+
+    evaluator.initialize();
+
+    /* Find the largest error over a fine grid of optical lengths */
+    double max_error = 0.;
+    for (int i=0; i <= 1000000; i++) {
+      double tau = max_tau * i / 1000000.;
+      for (int p=0; p < num_polar; p++) {
+        double exact = 1. - exp(-tau / polar_quad.getSinTheta(p));
+        double error = fabs(evaluator.computeExponential(tau, p) - exact);
+        max_error = std::max(max_error, error);
+      }
+    }
+
+    /* Time the evaluation of all polar angles for each optical length */
+    double sum = 0.;
+    double start = omp_get_wtime();
+    for (int s=0; s < num_sweeps; s++) {
+      for (int i=0; i < num_taus; i++) {
+        for (int p=0; p < num_polar; p++)
+          sum += evaluator.computeExponential(taus[i], p);
+      }
+    }
+    double time = omp_get_wtime() - start;
+    double num_exponentials = double(num_sweeps) * num_taus * num_polar;
+
+    int table_size = 0;
+    if (m > 0)
+      table_size = evaluator.getTableSize() * sizeof(FP_PRECISION);
+
+    log_printf(RESULT, "%-9s %7.1f kB  error = %1.1E  %5.2f ns/exp",
+               methods[m], table_size / 1024., max_error,
+               time / num_exponentials * 1E9);
+    log_printf(DEBUG, "Checksum = %f", sum);
+  }
+
+  delete [] taus;
+
+  return 0;
+}
@@ -59,12 +59,16 @@ class custom_install(install):
   # The user options for a customized OpenMOC build
   user_options = [
     ('cc=', None, "Compiler (gcc, icpc, or bgxlc) for main openmoc module"),
-    ('fp=', None, "Floating point precision (single or double) for " + \
+    ('fp=', None, "Floating point precision (single, double or mixed) " + \
+                  "for main openmoc module"),
+    ('with-precisions=', None, "Comma-separated floating point precisions " + \
+                  "(single, double, mixed) to build side by side with the " + \
                   "main openmoc module"),
     ('with-cuda', None, "Build openmoc.cuda module for NVIDIA GPUs"),
     ('debug-mode', None, "Build with debugging symbols"),
     ('profile-mode', None, "Build with profiling symbols"),
     ('with-ccache', None, "Build with ccache for rapid recompilation"),
+    ('with-mpi', None, "Build with MPI for domain decomposition"),
   ]
 
   # Include all of the default options provided by distutils for the
@@ -74,7 +78,8 @@ class custom_install(install):
   # Set some compile options to be boolean switches
   boolean_options = ['debug-mode',
                      'profile-mode',
-                     'with-ccache']
+                     'with-ccache',
+                     'with-mpi']
 
   # Include all of the boolean options provided by distutils for the
   # install command parent class
@@ -98,12 +103,14 @@ class custom_install(install):
     # Default compiler and precision level for the main openmoc module
     self.cc = 'gcc'
     self.fp = 'single'
+    self.with_precisions = None
 
     # Set defaults for each of the newly defined compile time options
     self.with_cuda = False
     self.debug_mode = False
     self.profile_mode = False
     self.with_ccache = False
+    self.with_mpi = False
 
 
   def finalize_options(self):
@@ -126,6 +133,7 @@ class custom_install(install):
     config.debug_mode = self.debug_mode
     config.profile_mode = self.profile_mode
     config.with_ccache = self.with_ccache
+    config.with_mpi = self.with_mpi
 
     # Check that the user specified a supported C++ compiler
     if self.cc not in ['gcc', 'clang', 'icpc', 'bgxlc']:
@@ -136,13 +144,24 @@ class custom_install(install):
       config.cc = self.cc
 
     # Check that the user specified a supported floating point precision
-    if self.fp not in ['single', 'double']:
+    if self.fp not in config.fp_types:
       raise DistutilsOptionError \
           ('Must supply the -cc flag with one of the supported ' +
-           'floating point precision levels: single, double')
+           'floating point precision levels: single, double, mixed')
     else:
       config.fp = self.fp
 
+    # Check the additional precisions to build side by side
+    if self.with_precisions is not None:
+      for fp in self.with_precisions.split(','):
+        if fp not in config.fp_types:
+          raise DistutilsOptionError \
+              ('Must supply the --with-precisions flag with a comma-' +
+               'separated list of the supported floating point precision ' +
+               'levels: single, double, mixed')
+        elif fp not in config.precisions:
+          config.precisions.append(fp)
+
     # Build the C/C++/CUDA extension modules for this distribution
     config.setup_extension_modules()
 
@@ -229,6 +248,14 @@ def customize_compiler(self):
     else:
       raise EnvironmentError('Unable to compile ' + str(src))
 
+    # If the user wishes to build with MPI, compile C++ with the MPI wrapper
+    if config.with_mpi and '-DNVCC' not in pp_opts and \
+       os.path.splitext(src)[1] == '.cpp':
+      if config.with_ccache:
+        self.set_executable('compiler_so', 'ccache mpicxx')
+      else:
+        self.set_executable('compiler_so', 'mpicxx')
+
     # Now call distutils-defined _compile method
     super_compile(obj, src, ext, cc_args, postargs, pp_opts)
 
@@ -274,6 +301,11 @@ def customize_linker(self):
       self.set_executable('linker_so', 'bgxlc++_r')
       self.set_executable('linker_exe', 'bgxlc++_r')
 
+    # If the user wishes to build with MPI, link with the MPI wrapper
+    if config.with_mpi:
+      self.set_executable('linker_so', 'mpicxx')
+      self.set_executable('linker_exe', 'mpicxx')
+
     # If the filename for the extension contains cuda, use nvcc to link
     if 'cuda' in output_filename:
       self.set_executable('linker_so', 'nvcc')
@@ -341,6 +373,13 @@ class custom_build_ext(build_ext):
     os.system('swig {0} -o '.format(str.join(' ', swig_flags)) + \
               'openmoc/openmoc_wrap.cpp openmoc/openmoc.i')
 
+    # Generate the wrappers for each precision built side by side
+    for fp in config.precisions:
+      swig_flags = config.precision_swig_flags[fp]
+      os.system('swig {0} -outdir openmoc/{1} -o '.format(
+                str.join(' ', swig_flags), fp) + \
+                'openmoc/{0}/openmoc_wrap.cpp openmoc/openmoc.i'.format(fp))
+
     if config.with_cuda:
       swig_flags = config.swig_flags + ['-DNVCC']
       os.system('swig {0} -o '.format(str.join(' ', swig_flags)) + \
@@ -0,0 +1,1154 @@
+#include "BatchSolver.h"
+
+
+/**
+ * @brief Constructor initializes a BatchSolver with a single material state.
+ * @param track_generator an optional pointer to the TrackGenerator
+ */
+BatchSolver::BatchSolver(TrackGenerator* track_generator)
+  : CPUSolver(track_generator) {
+
+  _num_states = 1;
+  _active_state = 0;
+  _batch_groups = 0;
+  _replacements.resize(_num_states);
+
+  _state_materials = NULL;
+  _state_sigma_t = NULL;
+  _state_k_eff = NULL;
+}
+
+
+/**
+ * @brief Destructor deletes the arrays of Materials, cross-sections and
+ *        eigenvalues for each state.
+ */
+BatchSolver::~BatchSolver() {
+
+  if (_state_materials != NULL)
+    delete [] _state_materials;
+
+  if (_state_sigma_t != NULL)
+    delete [] _state_sigma_t;
+
+  if (_state_k_eff != NULL)
+    delete [] _state_k_eff;
+}
+
+
+/**
+ * @brief Returns the number of material states.
+ * @return the number of states
+ */
+int BatchSolver::getNumStates() {
+  return _num_states;
+}
+
+
+/**
+ * @brief Returns the state whose results are returned by the Solver
+ *        accessors.
+ * @return the active state
+ */
+int BatchSolver::getActiveState() {
+  return _active_state;
+}
+
+
+/**
+ * @brief Returns the eigenvalue of a state.
+ * @param state the state of interest
+ * @return the state's eigenvalue
+ */
+ACC_PRECISION BatchSolver::getStateKeff(int state) {
+
+  if (state < 0 || state >= _num_states)
+    log_printf(ERROR, "Unable to return the eigenvalue of state %d since "
+               "there are %d states", state, _num_states);
+
+  else if (_state_k_eff == NULL)
+    log_printf(ERROR, "Unable to return the eigenvalue of state %d since "
+               "it has not yet been computed", state);
+
+  return _state_k_eff[state];
+}
+
+
+/**
+ * @brief Returns the source in an FSR and energy group for the active state.
+ * @param fsr_id the ID for the FSR of interest
+ * @param group the energy group of interest
+ * @return the total source (fission, scattering, fixed) of the active state
+ */
+FP_PRECISION BatchSolver::getFSRSource(int fsr_id, int group) {
+
+  if (fsr_id < 0 || fsr_id >= _num_FSRs)
+    log_printf(ERROR, "Unable to return a source for FSR ID = %d "
+               "since there are %d FSRs", fsr_id, _num_FSRs);
+
+  else if (group <= 0 || group > _num_groups)
+    log_printf(ERROR, "Unable to return a source in group %d "
+               "since there are %d groups", group, _num_groups);
+
+  else if (_scalar_flux == NULL)
+    log_printf(ERROR, "Unable to return a source "
+               "since it has not yet been computed");
+
+  int s = _active_state;
+  int G = group - 1;
+  Material* material = _state_materials(fsr_id,s);
+  FP_PRECISION* sigma_s = material->getSigmaS();
+  FP_PRECISION* fiss_mat = material->getFissionMatrix();
+
+  FP_PRECISION fission_source = 0.0;
+  FP_PRECISION scatter_source = 0.0;
+
+  for (int g=0; g < _num_groups; g++) {
+    scatter_source += sigma_s[G*_num_groups+g] * _state_flux(fsr_id,s,g);
+    fission_source += fiss_mat[G*_num_groups+g] * _state_flux(fsr_id,s,g);
+  }
+
+  return (fission_source / _state_k_eff[s] + scatter_source +
+          _fixed_sources(fsr_id,G)) * ONE_OVER_FOUR_PI;
+}
+
+
+/**
+ * @brief Returns the scalar flux in an FSR and energy group for the active
+ *        state.
+ * @param fsr_id the ID for the FSR of interest
+ * @param group the energy group of interest
+ * @return the FSR scalar flux of the active state
+ */
+FP_PRECISION BatchSolver::getFlux(int fsr_id, int group) {
+
+  if (fsr_id < 0 || fsr_id >= _num_FSRs)
+    log_printf(ERROR, "Unable to return a scalar flux for FSR ID = %d "
+               "since there are %d FSRs", fsr_id, _num_FSRs);
+
+  else if (group <= 0 || group > _num_groups)
+    log_printf(ERROR, "Unable to return a scalar flux in group %d "
+               "since there are %d groups", group, _num_groups);
+
+  else if (_scalar_flux == NULL)
+    log_printf(ERROR, "Unable to return a scalar flux "
+               "since it has not yet been computed");
+
+  return _state_flux(fsr_id,_active_state,group-1);
+}
+
+
+/**
+ * @brief Fills an array with the scalar fluxes of the active state.
+ * @details This may be called from Python as follows:
+ *
+ * @code
+ *          solver.setActiveState(3)
+ *          fluxes = solver.getFluxes(num_FSRs * num_groups)
+ * @endcode
+ *
+ * @param out_fluxes an array of FSR scalar fluxes in each energy group
+ * @param num_fluxes the total number of FSR flux values
+ */
+void BatchSolver::getFluxes(FP_PRECISION* out_fluxes, int num_fluxes) {
+
+  if (num_fluxes != _num_groups * _num_FSRs)
+    log_printf(ERROR, "Unable to get FSR scalar fluxes since there are "
+               "%d groups and %d FSRs which does not match the requested "
+               "%d flux values", _num_groups, _num_FSRs, num_fluxes);
+
+  else if (_scalar_flux == NULL)
+    log_printf(ERROR, "Unable to get FSR scalar fluxes since they "
+               "have not yet been allocated");
+
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int e=0; e < _num_groups; e++)
+      out_fluxes[r*_num_groups+e] = _state_flux(r,_active_state,e);
+  }
+}
+
+
+/**
+ * @brief Fills an array with the total source in each FSR and energy group
+ *        for the active state.
+ * @param out_sources an array of FSR sources in each energy group
+ * @param num_sources the total number of FSR source values
+ */
+void BatchSolver::getFSRSources(FP_PRECISION* out_sources, int num_sources) {
+
+  if (num_sources != _num_groups * _num_FSRs)
+    log_printf(ERROR, "Unable to get FSR sources since there are "
+               "%d groups and %d FSRs which does not match the requested "
+               "%d source values", _num_groups, _num_FSRs, num_sources);
+
+  else if (_scalar_flux == NULL)
+    log_printf(ERROR, "Unable to return the FSR sources "
+               "since they have not yet been computed");
+
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int G=0; G < _num_groups; G++)
+      out_sources[r*_num_groups+G] = getFSRSource(r, G+1);
+  }
+}
+
+
+/**
+ * @brief Returns a pointer to the scalar flux array of all states.
+ * @details The scalar fluxes are ordered by FSR, state and energy group:
+ *
+ * @code
+ *          fluxes = solver.getFluxesView()
+ *          fluxes = fluxes.reshape((num_FSRs, num_states, num_groups))
+ * @endcode
+ *
+ * @param view_values a pointer to the FSR scalar flux array
+ * @param num_values the number of FSR scalar flux values
+ */
+void BatchSolver::getFluxesView(ACC_PRECISION** view_values,
+                                int* num_values) {
+
+  Solver::getFluxesView(view_values, num_values);
+  *num_values *= _num_states;
+}
+
+
+/**
+ * @brief Returns a pointer to the reduced source array of all states.
+ * @details The reduced sources are ordered by FSR, state and energy group.
+ * @param view_values a pointer to the FSR reduced source array
+ * @param num_values the number of FSR reduced source values
+ */
+void BatchSolver::getReducedSourcesView(FP_PRECISION** view_values,
+                                        int* num_values) {
+
+  Solver::getReducedSourcesView(view_values, num_values);
+  *num_values *= _num_states;
+}
+
+
+/**
+ * @brief Sets the number of material states to solve together.
+ * @details This clears any replacement Materials assigned to the states.
+ * @param num_states the number of states (>0)
+ */
+void BatchSolver::setNumStates(int num_states) {
+
+  if (num_states <= 0)
+    log_printf(ERROR, "Unable to set the number of states to %d since it "
+               "is less than or equal to 0", num_states);
+
+  _num_states = num_states;
+  _active_state = 0;
+  _replacements.clear();
+  _replacements.resize(_num_states);
+
+  /* The eigenvalues are reallocated with the flux arrays */
+  if (_state_k_eff != NULL)
+    delete [] _state_k_eff;
+  _state_k_eff = NULL;
+
+  _dirty_components |= FSR_COMPONENT | FLUX_COMPONENT | SOURCE_COMPONENT;
+}
+
+
+/**
+ * @brief Sets the state whose results are returned by the Solver accessors.
+ * @details This allows the routines in the openmoc.process module to be
+ *          used for each state, for instance:
+ *
+ * @code
+ *          for state in range(solver.getNumStates()):
+ *            solver.setActiveState(state)
+ *            fission_rates = openmoc.process.compute_fission_rates(solver)
+ * @endcode
+ *
+ * @param state the active state
+ */
+void BatchSolver::setActiveState(int state) {
+
+  if (state < 0 || state >= _num_states)
+    log_printf(ERROR, "Unable to set the active state to %d since there "
+               "are %d states", state, _num_states);
+
+  _active_state = state;
+
+  if (_state_k_eff != NULL)
+    _k_eff = _state_k_eff[_active_state];
+}
+
+
+/**
+ * @brief Replaces a Material of the Geometry with another Material in
+ *        one state.
+ * @details The replacement Material is used in every FSR filled by the
+ *          Material in the state, while the other states are unchanged.
+ *          A branch calculation may for instance be set up as follows:
+ *
+ * @code
+ *          solver.setNumStates(len(temperatures))
+ *          for state, temperature in enumerate(temperatures):
+ *            solver.setStateMaterial(state, fuel, fuels[temperature])
+ *          solver.computeEigenvalue()
+ * @endcode
+ *
+ * @param state the state of interest
+ * @param material the Material of the Geometry to replace
+ * @param replacement the Material to use in its place
+ */
+void BatchSolver::setStateMaterial(int state, Material* material,
+                                   Material* replacement) {
+
+  if (state < 0 || state >= _num_states)
+    log_printf(ERROR, "Unable to set a Material for state %d since there "
+               "are %d states", state, _num_states);
+
+  else if (material == NULL || replacement == NULL)
+    log_printf(ERROR, "Unable to set a NULL Material for state %d", state);
+
+  _replacements[state][material->getId()] = replacement;
+
+  /* The segments may need to be split for the replacement's optical lengths */
+  _dirty_components |= EXP_COMPONENT;
+}
+
+
+/**
+ * @brief Sets the eigenvalue of all states.
+ * @param k_eff the eigenvalue
+ */
+void BatchSolver::setKeff(ACC_PRECISION k_eff) {
+
+  _k_eff = k_eff;
+
+  if (_state_k_eff != NULL) {
+    for (int s=0; s < _num_states; s++)
+      _state_k_eff[s] = k_eff;
+  }
+}
+
+
+/**
+ * @brief The BatchSolver does not support user-defined flux arrays since
+ *        the fluxes of all states are stored together.
+ */
+void BatchSolver::setFluxes(FP_PRECISION*, int) {
+  log_printf(ERROR, "Unable to set the fluxes of a BatchSolver");
+}
+
+
+/**
+ * @brief Returns the replacement Materials of all states which are not
+ *        in the Geometry.
+ * @return the set of replacement Materials
+ */
+std::set<Material*> BatchSolver::getReplacementMaterials() {
+
+  std::map<int, Material*> materials = _geometry->getAllMaterials();
+  std::map<int, Material*>::iterator m_iter;
+  std::set<Material*> replacements;
+
+  for (int s=0; s < _num_states; s++) {
+    for (m_iter = _replacements[s].begin();
+         m_iter != _replacements[s].end(); ++m_iter) {
+
+      Material* replacement = m_iter->second;
+      if (materials.find(replacement->getId()) == materials.end() ||
+          materials[replacement->getId()] != replacement)
+        replacements.insert(replacement);
+    }
+  }
+
+  return replacements;
+}
+
+
+/**
+ * @brief Flags the exponential evaluator to be rebuilt if the total
+ *        cross-sections of the Geometry's or the replacement Materials may
+ *        have grown since it was built.
+ */
+void BatchSolver::checkCrossSections() {
+
+  Solver::checkCrossSections();
+
+  std::set<Material*> replacements = getReplacementMaterials();
+  std::set<Material*>::iterator m_iter;
+
+  for (m_iter = replacements.begin(); m_iter != replacements.end(); ++m_iter)
+    checkMaxSigmaT(*m_iter);
+}
+
+
+/**
+ * @brief Builds the fission matrices of the Geometry's and the replacement
+ *        Materials, and transposes them for adjoint calculations.
+ * @details The Materials and total cross-sections of each FSR in each state
+ *          are also updated here, since the Materials are initialized for
+ *          every calculation. The total cross-sections of all states are
+ *          stored contiguously for each FSR such that they are loaded
+ *          together in the transport sweep. Anderson acceleration, which
+ *          is not supported by the BatchSolver, is rejected here since this
+ *          is called for every calculation. So are replacements of a
+ *          Material which is void in some energy group by one which is not
+ *          with the exponential interpolation table, since the segments
+ *          are split by the Geometry's cross-sections and the optical
+ *          lengths of those segments could not be bounded.
+ * @param mode the solution type (FORWARD or ADJOINT)
+ */
+void BatchSolver::initializeMaterials(solverMode mode) {
+
+  if (_anderson_depth > 0)
+    log_printf(ERROR, "The BatchSolver is unable to use Anderson "
+               "acceleration");
+
+  Solver::initializeMaterials(mode);
+
+  std::map<int, Material*> materials = _geometry->getAllMaterials();
+
+  for (int s=0; s < _num_states; s++) {
+
+    std::map<int, Material*>::iterator m_iter;
+    for (m_iter = _replacements[s].begin();
+         m_iter != _replacements[s].end(); ++m_iter) {
+      if (m_iter->second->getNumEnergyGroups() != _num_groups)
+        log_printf(ERROR, "Unable to replace Material ID = %d in state %d "
+                   "with Material ID = %d which has %d rather than %d "
+                   "energy groups", m_iter->first, s, m_iter->second->getId(),
+                   m_iter->second->getNumEnergyGroups(), _num_groups);
+
+      /* Segments in void are not split for the interpolation table, so
+       * void Materials must remain void */
+      if (!_exp_evaluator->isUsingInterpolation() ||
+          materials.find(m_iter->first) == materials.end())
+        continue;
+
+      FP_PRECISION* sigma_t = materials[m_iter->first]->getSigmaT();
+      FP_PRECISION* state_sigma_t = m_iter->second->getSigmaT();
+
+      for (int e=0; e < _num_groups; e++) {
+        if (sigma_t[e] == 0. && state_sigma_t[e] > 0.)
+          log_printf(ERROR, "Unable to replace Material ID = %d in state %d "
+                     "with Material ID = %d since it is void in group %d, "
+                     "unless exponential intrinsics are used",
+                     m_iter->first, s, m_iter->second->getId(), e);
+      }
+    }
+  }
+
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int s=0; s < _num_states; s++) {
+
+      Material* material = _FSR_materials[r];
+      std::map<int, Material*>::iterator m_iter =
+        _replacements[s].find(material->getId());
+
+      if (m_iter != _replacements[s].end())
+        material = m_iter->second;
+
+      _state_materials(r,s) = material;
+      FP_PRECISION* sigma_t = material->getSigmaT();
+
+      for (int e=0; e < _num_groups; e++)
+        _state_sigma_t(r,s,e) = sigma_t[e];
+    }
+  }
+
+  std::set<Material*> replacements = getReplacementMaterials();
+  std::set<Material*>::iterator m_iter;
+
+  for (m_iter = replacements.begin(); m_iter != replacements.end(); ++m_iter) {
+    (*m_iter)->buildFissionMatrix();
+
+    if (mode == ADJOINT)
+      (*m_iter)->transposeProductionMatrices();
+  }
+}
+
+
+/**
+ * @brief Restores the production matrices of the Geometry's and the
+ *        replacement Materials following an adjoint calculation.
+ * @param mode the solution type (FORWARD or ADJOINT)
+ */
+void BatchSolver::resetMaterials(solverMode mode) {
+
+  Solver::resetMaterials(mode);
+
+  if (mode == FORWARD)
+    return;
+
+  std::set<Material*> replacements = getReplacementMaterials();
+  std::set<Material*>::iterator m_iter;
+
+  for (m_iter = replacements.begin(); m_iter != replacements.end(); ++m_iter)
+    (*m_iter)->transposeProductionMatrices();
+}
+
+
+/**
+ * @brief Initializes the FSR volumes and allocates the Materials and total
+ *        cross-sections of each FSR in each state.
+ */
+void BatchSolver::initializeFSRs() {
+
+  CPUSolver::initializeFSRs();
+
+  _batch_groups = _num_states * _num_groups;
+
+  if (_state_materials != NULL)
+    delete [] _state_materials;
+
+  if (_state_sigma_t != NULL)
+    delete [] _state_sigma_t;
+
+  _state_materials = new Material*[_num_FSRs * _num_states];
+  _state_sigma_t = new FP_PRECISION[_num_FSRs * _batch_groups];
+}
+
+
+/**
+ * @brief Initializes the exponential evaluator for the optical lengths of
+ *        all states.
+ * @details The Track segments are split according to the cross-sections of
+ *          the Geometry's Materials. When a replacement Material has a larger
+ *          total cross-section, the segments are split further by the largest
+ *          ratio of a state's to the Geometry's total cross-section such that
+ *          the optical lengths of all states are within the interpolation
+ *          table. Void FSRs of the Geometry are not considered since
+ *          they must remain void in all states (see
+ *          BatchSolver::initializeMaterials(...)).
+ */
+void BatchSolver::initializeExpEvaluator() {
+
+  _exp_evaluator->setPolarQuadrature(_polar_quad);
+
+  if (!_exp_evaluator->isUsingInterpolation())
+    return;
+
+  /* Find the largest ratio of a state's to the segments' cross-sections */
+  FP_PRECISION ratio = 1.;
+
+  for (int r=0; r < _num_FSRs; r++) {
+    FP_PRECISION* sigma_t = _FSR_materials[r]->getSigmaT();
+
+    for (int s=0; s < _num_states; s++) {
+      for (int e=0; e < _num_groups; e++) {
+        if (sigma_t[e] > 0.)
+          ratio = std::max(ratio, _state_sigma_t(r,s,e) / sigma_t[e]);
+      }
+    }
+  }
+
+  /* Find minimum of optional user-specified and actual max taus */
+  FP_PRECISION max_tau_a = _track_generator->getMaxOpticalLength() * ratio;
+  FP_PRECISION max_tau_b = _exp_evaluator->getMaxOpticalLength();
+  FP_PRECISION max_tau = std::min(max_tau_a, max_tau_b) + TAU_NUDGE;
+
+  /* Split Track segments so that no state has a greater optical length */
+  _track_generator->splitSegments(max_tau / ratio);
+
+  /* Initialize exponential interpolation table */
+  _exp_evaluator->setMaxOpticalLength(max_tau);
+  _exp_evaluator->initialize();
+}
+
+
+/**
+ * @brief Allocates memory for the Track boundary angular fluxes, FSR scalar
+ *        fluxes and eigenvalues of all states.
+ * @details Each state's eigenvalue is initialized to the Solver's
+ *          eigenvalue. The BatchSolver stores the boundary angular fluxes
+ *          in full precision.
+ */
+void BatchSolver::initializeFluxArrays() {
+
+  if (_boundary_flux_storage != BOUNDARY_FLUX_FULL)
+    log_printf(ERROR, "The BatchSolver is unable to use compressed "
+               "boundary angular fluxes");
+
+  if (_boundary_flux != NULL)
+    delete [] _boundary_flux;
+
+  if (_scalar_flux != NULL)
+    delete [] _scalar_flux;
+
+  if (_old_scalar_flux != NULL)
+    delete [] _old_scalar_flux;
+
+  if (_state_k_eff != NULL)
+    delete [] _state_k_eff;
+
+  /* Allocate memory for the Track boundary and FSR scalar flux arrays */
+  try{
+    long size = 2 * long(_tot_num_tracks) * _num_polar * _batch_groups;
+    _boundary_flux = new FP_PRECISION[size];
+
+    size = long(_num_FSRs) * _batch_groups;
+    _scalar_flux = new ACC_PRECISION[size];
+    _old_scalar_flux = new ACC_PRECISION[size];
+
+    _state_k_eff = new ACC_PRECISION[_num_states];
+  }
+  catch(std::exception &e) {
+    log_printf(ERROR, "Could not allocate memory for the fluxes");
+  }
+
+  for (int s=0; s < _num_states; s++)
+    _state_k_eff[s] = _k_eff;
+}
+
+
+/**
+ * @brief Allocates memory for the reduced sources of all states and the
+ *        fixed sources shared by the states.
+ */
+void BatchSolver::initializeSourceArrays() {
+
+  CPUSolver::initializeSourceArrays();
+
+  delete [] _reduced_sources;
+
+  try{
+    _reduced_sources = new FP_PRECISION[_num_FSRs * _batch_groups];
+  }
+  catch(std::exception &e) {
+    log_printf(ERROR, "Could not allocate memory for FSR sources");
+  }
+}
+
+
+/**
+ * @brief Retrieves the Cmfd from the Geometry.
+ * @details CMFD acceleration is not supported by the BatchSolver since the
+ *          states would each require their own diffusion problem.
+ */
+void BatchSolver::initializeCmfd() {
+
+  Solver::initializeCmfd();
+
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
+    log_printf(ERROR, "The BatchSolver is unable to use CMFD acceleration");
+}
+
+
+/**
+ * @brief Zero each Track's boundary fluxes for each state.
+ */
+void BatchSolver::zeroTrackFluxes() {
+
+  long size = 2 * long(_tot_num_tracks) * _num_polar * _batch_groups;
+
+#pragma omp parallel for schedule(static)
+  for (long i=0; i < size; i++)
+    _boundary_flux[i] = 0.0;
+}
+
+
+/**
+ * @brief Set the scalar flux for each FSR, state and energy group to some
+ *        value.
+ * @param value the value to assign to each FSR scalar flux
+ */
+void BatchSolver::flattenFSRFluxes(FP_PRECISION value) {
+
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int i=0; i < _batch_groups; i++)
+      _scalar_flux[r*_batch_groups + i] = value;
+  }
+}
+
+
+/**
+ * @brief Stores the FSR scalar fluxes of each state in the old scalar flux
+ *        array.
+ */
+void BatchSolver::storeFSRFluxes() {
+
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int i=0; i < _batch_groups; i++)
+      _old_scalar_flux[r*_batch_groups + i] = _scalar_flux[r*_batch_groups + i];
+  }
+}
+
+
+/**
+ * @brief Computes the total fission source (times \f$ \nu \f$) of each
+ *        state.
+ * @param fission_sources an array to store the fission source of each state
+ */
+void BatchSolver::computeTotalFissionSources(ACC_PRECISION* fission_sources) {
+
+  ACC_PRECISION* FSR_rates = new ACC_PRECISION[_num_states * _num_FSRs];
+
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+
+    FP_PRECISION volume = _FSR_volumes[r];
+
+    for (int s=0; s < _num_states; s++) {
+      FP_PRECISION* nu_sigma_f = _state_materials(r,s)->getNuSigmaF();
+      ACC_PRECISION rate = 0.;
+
+      for (int e=0; e < _num_groups; e++)
+        rate += nu_sigma_f[e] * _state_flux(r,s,e);
+
+      FSR_rates[s*_num_FSRs + r] = rate * volume;
+    }
+  }
+
+  for (int s=0; s < _num_states; s++)
+    fission_sources[s] = pairwise_sum<ACC_PRECISION>(&FSR_rates[s*_num_FSRs],
+                                                     _num_FSRs);
+
+  delete [] FSR_rates;
+}
+
+
+/**
+ * @brief Normalizes the FSR scalar fluxes and Track boundary angular fluxes
+ *        of each state to the state's total fission source.
+ */
+void BatchSolver::normalizeFluxes() {
+
+  ACC_PRECISION* norm_factors = new ACC_PRECISION[_num_states];
+  computeTotalFissionSources(norm_factors);
+
+  for (int s=0; s < _num_states; s++) {
+    log_printf(DEBUG, "State %d Tot. Fiss. Src. = %f", s, norm_factors[s]);
+    norm_factors[s] = 1.0 / norm_factors[s];
+  }
+
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int s=0; s < _num_states; s++) {
+      for (int e=0; e < _num_groups; e++) {
+        _state_flux(r,s,e) *= norm_factors[s];
+        _state_old_flux(r,s,e) *= norm_factors[s];
+      }
+    }
+  }
+
+  /* Normalize angular boundary fluxes for each Track direction */
+  long num_directions = 2 * long(_tot_num_tracks) * _num_polar;
+
+#pragma omp parallel for schedule(guided)
+  for (long i=0; i < num_directions; i++) {
+    FP_PRECISION* track_flux = &_boundary_flux[i * _batch_groups];
+
+    for (int s=0; s < _num_states; s++) {
+      for (int e=0; e < _num_groups; e++)
+        track_flux[s*_num_groups + e] *= norm_factors[s];
+    }
+  }
+
+  delete [] norm_factors;
+}
+
+
+/**
+ * @brief Computes the total source (fission, scattering, fixed) in each FSR
+ *        for each state.
+ * @details The fission source of each state is divided by the state's
+ *          eigenvalue, while the fixed sources are shared by all states.
+ */
+void BatchSolver::computeFSRSources() {
+
+#pragma omp parallel
+  {
+    Material* material;
+    FP_PRECISION* sigma_s;
+    FP_PRECISION* fiss_mat;
+    FP_PRECISION* scatter_sources = new FP_PRECISION[_num_groups];
+    FP_PRECISION* fission_sources = new FP_PRECISION[_num_groups];
+    FP_PRECISION scatter_source, fission_source;
+
+#pragma omp for schedule(guided)
+    for (int r=0; r < _num_FSRs; r++) {
+      for (int s=0; s < _num_states; s++) {
+
+        material = _state_materials(r,s);
+        sigma_s = material->getSigmaS();
+        fiss_mat = material->getFissionMatrix();
+
+        for (int G=0; G < _num_groups; G++) {
+          for (int g=0; g < _num_groups; g++) {
+            scatter_sources[g] = sigma_s[G*_num_groups+g] * _state_flux(r,s,g);
+            fission_sources[g] = fiss_mat[G*_num_groups+g] * _state_flux(r,s,g);
+          }
+
+          scatter_source = pairwise_sum<FP_PRECISION>(scatter_sources,
+                                                      _num_groups);
+          fission_source = pairwise_sum<FP_PRECISION>(fission_sources,
+                                                      _num_groups);
+          fission_source /= _state_k_eff[s];
+
+          /* Compute total (scatter+fission+fixed) reduced source */
+          _state_sources(r,s,G) = _fixed_sources(r,G);
+          _state_sources(r,s,G) += scatter_source + fission_source;
+          _state_sources(r,s,G) *= ONE_OVER_FOUR_PI / _state_sigma_t(r,s,G);
+        }
+      }
+    }
+
+    delete [] scatter_sources;
+    delete [] fission_sources;
+  }
+}
+
+
+/**
+ * @brief The BatchSolver does not support the separate fission source
+ *        used by Krylov subspace methods.
+ */
+void BatchSolver::computeFSRFissionSources() {
+  log_printf(ERROR, "The BatchSolver is unable to compute fission sources "
+             "for Krylov subspace methods");
+}
+
+
+/**
+ * @brief The BatchSolver does not support the separate scattering source
+ *        used by Krylov subspace methods.
+ */
+void BatchSolver::computeFSRScatterSources() {
+  log_printf(ERROR, "The BatchSolver is unable to compute scattering "
+             "sources for Krylov subspace methods");
+}
+
+
+/**
+ * @brief Performs one transport sweep of all states.
+ * @details Each Track and its segments are traversed once, and the angular
+ *          fluxes of all states are attenuated along each segment and
+ *          transferred to the outgoing Track together. The states of each
+ *          segment's FSR are stored contiguously such that the states
+ *          share the memory traffic of the sweep.
+ */
+void BatchSolver::transportSweep() {
+
+  log_printf(DEBUG, "Batched transport sweep of %d states with %d OpenMP "
+             "threads", _num_states, _num_threads);
+
+  if (_num_group_blocks > 1)
+    log_printf(ERROR, "Unable to sweep %d energy group blocks since the "
+               "BatchSolver does not support energy group decomposition",
+               _num_group_blocks);
+
+  if (_communicator != NULL)
+    log_printf(ERROR, "Unable to sweep a domain of a decomposed Geometry "
+               "since the BatchSolver does not support domain decomposition");
+
+  int min_track = 0;
+  int max_track = 0;
+  int direction_size = _num_polar * _batch_groups;
+
+  /* Initialize flux in each FSR to zero */
+  flattenFSRFluxes(0.0);
+
+  if (_cumulative_segments == NULL)
+    initializeTrackSchedule();
+
+  /* Loop over the parallel track groups */
+  for (int i=0; i < _num_parallel_track_groups; i++) {
+
+    min_track = max_track;
+    max_track += _track_generator->getNumTracksByParallelGroup(i);
+
+#pragma omp parallel
+    {
+
+      int first_track, last_track;
+      int azim_index, num_segments;
+      Track* curr_track;
+      Track* segmented_track;
+      segment* segments;
+      FP_PRECISION* track_flux;
+
+      /* Scratch Track for the segments if they are traced on-the-fly */
+      Track scratch;
+
+      /* Use local array accumulator to prevent false sharing */
+      FP_PRECISION* thread_fsr_flux = new FP_PRECISION[_batch_groups];
+
+      getThreadTracks(min_track, max_track, &first_track, &last_track);
+
+      for (int track_id=first_track; track_id < last_track; track_id++) {
+
+        curr_track = _tracks[track_id];
+        segmented_track = _track_generator->getSegmentedTrack(curr_track,
+                                                              &scratch);
+        azim_index = curr_track->getAzimAngleIndex();
+        num_segments = segmented_track->getNumSegments();
+        segments = segmented_track->getSegments();
+        track_flux = &_boundary_flux[2 * long(track_id) * direction_size];
+
+        /* Loop over each Track segment in forward direction */
+        for (int s=0; s < num_segments; s++)
+          tallyStateFluxes(&segments[s], azim_index, track_flux,
+                           thread_fsr_flux);
+
+        transferStateFluxes(track_id, true, track_flux);
+
+        /* Loop over each Track segment in reverse direction */
+        track_flux += direction_size;
+
+        for (int s=num_segments-1; s > -1; s--)
+          tallyStateFluxes(&segments[s], azim_index, track_flux,
+                           thread_fsr_flux);
+
+        transferStateFluxes(track_id, false, track_flux);
+      }
+
+      delete [] thread_fsr_flux;
+    }
+  }
+}
+
+
+/**
+ * @brief Computes the contribution to the FSR scalar flux of each state
+ *        from a Track segment.
+ * @param curr_segment a pointer to the Track segment of interest
+ * @param azim_index the azimuthal angle index for this segment
+ * @param track_flux a pointer to the Track's angular fluxes of all states
+ * @param fsr_flux a pointer to the temporary FSR flux buffer
+ */
+void BatchSolver::tallyStateFluxes(segment* curr_segment, int azim_index,
+                                   FP_PRECISION* track_flux,
+                                   FP_PRECISION* fsr_flux) {
+
+  int fsr_id = curr_segment->_region_id;
+  FP_PRECISION length = curr_segment->_length;
+  FP_PRECISION* sigma_t = &_state_sigma_t[fsr_id * _batch_groups];
+  FP_PRECISION* sources = &_reduced_sources[fsr_id * _batch_groups];
+  FP_PRECISION delta_psi, exponential;
+
+  /* Compute change in angular flux along segment for each state and group */
+  for (int i=0; i < _batch_groups; i++) {
+    fsr_flux[i] = 0.;
+
+    for (int p=0; p < _num_polar; p++) {
+      exponential = _exp_evaluator->computeExponential(sigma_t[i] * length, p);
+      delta_psi = (batch_track_flux(p,i) - sources[i]) * exponential;
+      fsr_flux[i] += delta_psi * _polar_weights(azim_index,p);
+      batch_track_flux(p,i) -= delta_psi;
+    }
+  }
+
+  /* Atomically increment the FSR scalar flux from the temporary array */
+  ACC_PRECISION* scalar_flux = &_scalar_flux[fsr_id * _batch_groups];
+
+  omp_set_lock(&_FSR_locks[fsr_id]);
+  {
+    for (int i=0; i < _batch_groups; i++)
+      scalar_flux[i] += fsr_flux[i];
+  }
+  omp_unset_lock(&_FSR_locks[fsr_id]);
+}
+
+
+/**
+ * @brief Transfers the outgoing angular fluxes of all states to the
+ *        outgoing Track given its boundary condition.
+ * @param track_id the ID number for the Track of interest
+ * @param direction the Track direction (forward - true, reverse - false)
+ * @param track_flux a pointer to the Track's outgoing angular fluxes
+ */
+void BatchSolver::transferStateFluxes(int track_id, bool direction,
+                                      FP_PRECISION* track_flux) {
+
+  int direction_out;
+  bool transfer_flux;
+  int track_out_id;
+
+  if (direction) {
+    direction_out = _tracks[track_id]->isNextOut();
+    transfer_flux = _tracks[track_id]->getTransferFluxOut();
+    track_out_id = _tracks[track_id]->getTrackOut()->getUid();
+  }
+  else {
+    direction_out = _tracks[track_id]->isNextIn();
+    transfer_flux = _tracks[track_id]->getTransferFluxIn();
+    track_out_id = _tracks[track_id]->getTrackIn()->getUid();
+  }
+
+  int direction_size = _num_polar * _batch_groups;
+  FP_PRECISION* track_out_flux =
+    &_boundary_flux[(2 * long(track_out_id) + direction_out) * direction_size];
+
+  for (int i=0; i < direction_size; i++)
+    track_out_flux[i] = track_flux[i] * transfer_flux;
+}
+
+
+/**
+ * @brief Add the source term contribution in the transport equation to
+ *        the FSR scalar flux of each state.
+ */
+void BatchSolver::addSourceToScalarFlux() {
+
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    FP_PRECISION volume = _FSR_volumes[r];
+
+    for (int s=0; s < _num_states; s++) {
+      for (int e=0; e < _num_groups; e++) {
+        _state_flux(r,s,e) *= 0.5;
+        _state_flux(r,s,e) /= (_state_sigma_t(r,s,e) * volume);
+        _state_flux(r,s,e) += (FOUR_PI * _state_sources(r,s,e));
+      }
+    }
+  }
+}
+
+
+/**
+ * @brief Compute the eigenvalue of each state from successive fission
+ *        sources.
+ */
+void BatchSolver::computeKeff() {
+
+  ACC_PRECISION* fission_sources = new ACC_PRECISION[_num_states];
+  computeTotalFissionSources(fission_sources);
+
+  for (int s=0; s < _num_states; s++)
+    _state_k_eff[s] *= fission_sources[s];
+
+  _k_eff = _state_k_eff[_active_state];
+
+  delete [] fission_sources;
+}
+
+
+/**
+ * @brief Computes the residual between source/flux iterations.
+ * @details The residual of each state is computed as for the CPUSolver and
+ *          the largest residual is returned, such that the source iteration
+ *          continues until every state has converged.
+ * @param res_type the type of residuals to compute
+ *        (SCALAR_FLUX, FISSION_SOURCE, TOTAL_SOURCE)
+ * @return the largest residual of the states
+ */
+double BatchSolver::computeResidual(residualType res_type) {
+
+  double* residuals = new double[_num_states * _num_FSRs];
+  int* norms = new int[_num_states];
+  memset(residuals, 0, _num_states * _num_FSRs * sizeof(double));
+
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int s=0; s < _num_states; s++) {
+
+      Material* material = _state_materials(r,s);
+      double* residual = &residuals[s*_num_FSRs + r];
+
+      if (res_type == SCALAR_FLUX) {
+        for (int e=0; e < _num_groups; e++) {
+          if (_state_old_flux(r,s,e) > 0.)
+            *residual += pow((_state_flux(r,s,e) - _state_old_flux(r,s,e)) /
+                             _state_old_flux(r,s,e), 2);
+        }
+        continue;
+      }
+
+      double new_source = 0.;
+      double old_source = 0.;
+
+      if (material->isFissionable()) {
+        FP_PRECISION* nu_sigma_f = material->getNuSigmaF();
+
+        for (int e=0; e < _num_groups; e++) {
+          new_source += _state_flux(r,s,e) * nu_sigma_f[e];
+          old_source += _state_old_flux(r,s,e) * nu_sigma_f[e];
+        }
+      }
+      else if (res_type == FISSION_SOURCE)
+        continue;
+
+      /* Add the total scattering source */
+      if (res_type == TOTAL_SOURCE) {
+        FP_PRECISION* sigma_s = material->getSigmaS();
+        new_source /= _state_k_eff[s];
+        old_source /= _state_k_eff[s];
+
+        for (int G=0; G < _num_groups; G++) {
+          for (int g=0; g < _num_groups; g++) {
+            new_source += sigma_s[G*_num_groups+g] * _state_flux(r,s,g);
+            old_source += sigma_s[G*_num_groups+g] * _state_old_flux(r,s,g);
+          }
+        }
+      }
+
+      if (old_source > 0.)
+        *residual = pow((new_source - old_source) / old_source, 2);
+    }
+  }
+
+  /* Count the FSRs which normalize the residual of each state */
+  for (int s=0; s < _num_states; s++) {
+    norms[s] = _num_FSRs;
+
+    if (res_type == FISSION_SOURCE) {
+      norms[s] = 0;
+      for (int r=0; r < _num_FSRs; r++) {
+        if (_state_materials(r,s)->isFissionable())
+          norms[s]++;
+      }
+
+      if (norms[s] == 0)
+        log_printf(ERROR, "The BatchSolver is unable to compute a "
+                   "FISSION_SOURCE residual without fissionable FSRs in "
+                   "state %d", s);
+    }
+  }
+
+  double max_residual = 0.;
+  for (int s=0; s < _num_states; s++) {
+    double residual = pairwise_sum<double>(&residuals[s*_num_FSRs],
+                                           _num_FSRs);
+    max_residual = std::max(max_residual, sqrt(residual / norms[s]));
+  }
+
+  delete [] residuals;
+  delete [] norms;
+
+  return max_residual;
+}
+
+
+/**
+ * @brief Computes the volume-integrated, energy-integrated nu-fission rate in
+ *        each FSR for the active state.
+ * @param fission_rates an array to store the nu-fission rates (implicitly
+ *                      passed in as a NumPy array from Python)
+ * @param num_FSRs the number of FSRs passed in from Python
+ */
+void BatchSolver::computeFSRFissionRates(double* fission_rates,
+                                         int num_FSRs) {
+
+  if (num_FSRs != _num_FSRs)
+    log_printf(ERROR, "Unable to compute FSR fission rates for %d FSRs "
+               "since there are %d FSRs", num_FSRs, _num_FSRs);
+
+  if (_scalar_flux == NULL)
+    log_printf(ERROR, "Unable to compute FSR fission rates since the "
+               "source distribution has not been calculated");
+
+  log_printf(INFO, "Computing FSR fission rates for state %d...",
+             _active_state);
+
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    FP_PRECISION* sigma_f = _state_materials(r,_active_state)->getSigmaF();
+    FP_PRECISION volume = _FSR_volumes[r];
+
+    fission_rates[r] = 0.0;
+    for (int e=0; e < _num_groups; e++)
+      fission_rates[r] += sigma_f[e] * _state_flux(r,_active_state,e) * volume;
+  }
+}
@@ -0,0 +1,135 @@
+/**
+ * @file BatchSolver.h
+ * @brief The BatchSolver class.
+ * @date October 19, 2026
+ */
+
+
+#ifndef BATCHSOLVER_H_
+#define BATCHSOLVER_H_
+
+#ifdef __cplusplus
+#include "CPUSolver.h"
+#include <vector>
+#include <set>
+#endif
+
+
+/** Indexing macro for the Material of each FSR and state */
+#define _state_materials(r,s) (_state_materials[(r)*_num_states + (s)])
+
+/** Indexing macro for the total cross-section in each FSR, state and energy
+ *  group */
+#define _state_sigma_t(r,s,e) (_state_sigma_t[((r)*_num_states + (s)) \
+                                              *_num_groups + (e)])
+
+/** Indexing macro for the scalar flux in each FSR, state and energy group */
+#define _state_flux(r,s,e) (_scalar_flux[((r)*_num_states + (s)) \
+                                         *_num_groups + (e)])
+
+/** Indexing macro for the old scalar flux in each FSR, state and energy
+ *  group */
+#define _state_old_flux(r,s,e) (_old_scalar_flux[((r)*_num_states + (s)) \
+                                                 *_num_groups + (e)])
+
+/** Indexing macro for the reduced source in each FSR, state and energy
+ *  group */
+#define _state_sources(r,s,e) (_reduced_sources[((r)*_num_states + (s)) \
+                                                *_num_groups + (e)])
+
+/** Indexing macro for the angular fluxes for each polar angle, state and
+ *  energy group for either direction of a given Track */
+#define batch_track_flux(p,i) (track_flux[(p)*_batch_groups + (i)])
+
+
+/**
+ * @class BatchSolver BatchSolver.h "src/BatchSolver.h"
+ * @brief A CPUSolver which solves several material states of the same
+ *        Geometry together.
+ * @details Each state replaces some of the Geometry's Materials by
+ *          perturbed Materials, such as for branch calculations. The fluxes
+ *          and sources of all states are stored contiguously for each FSR,
+ *          such that a single transport sweep traverses each Track segment
+ *          and boundary condition once for all states. Each state has its
+ *          own eigenvalue and converges independently. The Solver accessors
+ *          (eg, getFlux(...), getKeff()) refer to the active state.
+ */
+class BatchSolver : public CPUSolver {
+
+protected:
+
+  /** The number of material states */
+  int _num_states;
+
+  /** The state whose fluxes are returned by the Solver accessors */
+  int _active_state;
+
+  /** The number of energy groups in all states (# states x # groups) */
+  int _batch_groups;
+
+  /** The replacement Material for each Material ID in each state */
+  std::vector< std::map<int, Material*> > _replacements;
+
+  /** The Material of each FSR in each state */
+  Material** _state_materials;
+
+  /** The total cross-section of each FSR, state and energy group */
+  FP_PRECISION* _state_sigma_t;
+
+  /** The eigenvalue of each state */
+  ACC_PRECISION* _state_k_eff;
+
+  std::set<Material*> getReplacementMaterials();
+  void setKeff(ACC_PRECISION k_eff);
+  void checkCrossSections();
+  void computeTotalFissionSources(ACC_PRECISION* fission_sources);
+  void tallyStateFluxes(segment* curr_segment, int azim_index,
+                        FP_PRECISION* track_flux, FP_PRECISION* fsr_flux);
+  void transferStateFluxes(int track_id, bool direction,
+                           FP_PRECISION* track_flux);
+
+public:
+  BatchSolver(TrackGenerator* track_generator=NULL);
+  virtual ~BatchSolver();
+
+  int getNumStates();
+  int getActiveState();
+  ACC_PRECISION getStateKeff(int state);
+  virtual FP_PRECISION getFSRSource(int fsr_id, int group);
+  virtual FP_PRECISION getFlux(int fsr_id, int group);
+  virtual void getFluxes(FP_PRECISION* out_fluxes, int num_fluxes);
+  virtual void getFSRSources(FP_PRECISION* out_sources, int num_sources);
+  virtual void getFluxesView(ACC_PRECISION** view_values, int* num_values);
+  virtual void getReducedSourcesView(FP_PRECISION** view_values,
+                                     int* num_values);
+
+  void setNumStates(int num_states);
+  void setActiveState(int state);
+  void setStateMaterial(int state, Material* material, Material* replacement);
+  virtual void setFluxes(FP_PRECISION* in_fluxes, int num_fluxes);
+
+  void initializeMaterials(solverMode mode=FORWARD);
+  void resetMaterials(solverMode mode=FORWARD);
+  void initializeFSRs();
+  void initializeExpEvaluator();
+  void initializeFluxArrays();
+  void initializeSourceArrays();
+  void initializeCmfd();
+
+  void zeroTrackFluxes();
+  void flattenFSRFluxes(FP_PRECISION value);
+  void storeFSRFluxes();
+  void normalizeFluxes();
+  void computeFSRSources();
+  void computeFSRFissionSources();
+  void computeFSRScatterSources();
+  void transportSweep();
+  void addSourceToScalarFlux();
+  void computeKeff();
+  double computeResidual(residualType res_type);
+
+  void computeFSRFissionRates(double* fission_rates, int num_FSRs);
+};
+
+
+#endif /* BATCHSOLVER_H_ */
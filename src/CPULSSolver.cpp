@@ -0,0 +1,626 @@
+#include "CPULSSolver.h"
+
+
+/**
+ * @brief Constructor initializes the linear source arrays to NULL.
+ * @details The ExpEvaluator is set to also evaluate the exponential terms
+ *          of the linear source transport equation.
+ * @param track_generator an optional pointer to the TrackGenerator
+ */
+CPULSSolver::CPULSSolver(TrackGenerator* track_generator)
+  : CPUSolver(track_generator) {
+
+  _FSR_centroids = NULL;
+  _FSR_moments = NULL;
+  _FSR_inverse_moments = NULL;
+  _scalar_flux_xy = NULL;
+  _reduced_sources_xy = NULL;
+
+  _exp_evaluator->useLinearSource(true);
+}
+
+
+/**
+ * @brief Destructor deletes the linear source arrays.
+ */
+CPULSSolver::~CPULSSolver() {
+
+  if (_FSR_centroids != NULL) {
+    delete [] _FSR_centroids;
+    delete [] _FSR_moments;
+    delete [] _FSR_inverse_moments;
+  }
+
+  if (_scalar_flux_xy != NULL)
+    delete [] _scalar_flux_xy;
+
+  if (_reduced_sources_xy != NULL)
+    delete [] _reduced_sources_xy;
+}
+
+
+/**
+ * @brief Returns the scalar flux at a point in an FSR.
+ * @details The scalar flux is reconstructed from the FSR's average scalar
+ *          flux and its gradient, computed from the flux moments. Points in
+ *          a part of the Geometry reduced by symmetry are mapped to their
+ *          mirror images. This method may be called from Python as follows:
+ *
+ * @code
+ *          fsr_id = geometry.findFSRId(openmoc.LocalCoords(x, y))
+ *          flux = solver.getFluxByCoords(fsr_id, group, x, y)
+ * @endcode
+ *
+ * @param fsr_id the ID of the FSR containing the point
+ * @param group the energy group of interest
+ * @param x the x-coordinate of the point
+ * @param y the y-coordinate of the point
+ * @return the scalar flux at the point
+ */
+FP_PRECISION CPULSSolver::getFluxByCoords(int fsr_id, int group,
+                                          double x, double y) {
+
+  FP_PRECISION flux = getFlux(fsr_id, group);
+
+  /* Move a point in a part of the Geometry reduced by symmetry to its
+   * mirror image in the FSR */
+  LocalCoords coords(x, y, 0.);
+  _geometry->applySymmetry(&coords);
+
+  double dx = coords.getX() - _FSR_centroids[2*fsr_id];
+  double dy = coords.getY() - _FSR_centroids[2*fsr_id+1];
+  FP_PRECISION* inverse = &_FSR_inverse_moments[3*fsr_id];
+  ACC_PRECISION* moments = &_scalar_flux_xy(fsr_id,group-1,0);
+
+  /* Add the flux gradient along the displacement from the centroid */
+  flux += (inverse[0] * moments[0] + inverse[1] * moments[1]) * dx;
+  flux += (inverse[1] * moments[0] + inverse[2] * moments[1]) * dy;
+
+  return flux;
+}
+
+
+/**
+ * @brief Initializes the FSR volumes, Materials and spatial moments.
+ * @details The second spatial moments of each FSR about its centroid are
+ *          integrated exactly along each Track segment and weighted by the
+ *          segment's azimuthal weight, consistent with the FSR volumes and
+ *          centroids. They are inverted to compute the source gradient
+ *          from the source moments. FSRs whose moment matrix is singular
+ *          or ill-conditioned (eg, those crossed by Tracks of a single
+ *          azimuthal angle) keep a flat source, since the Tracks do not
+ *          resolve their gradients.
+ */
+void CPULSSolver::initializeFSRs() {
+
+  CPUSolver::initializeFSRs();
+
+  if (_FSR_centroids != NULL) {
+    delete [] _FSR_centroids;
+    delete [] _FSR_moments;
+    delete [] _FSR_inverse_moments;
+  }
+
+  _FSR_centroids = new double[2*_num_FSRs];
+  _FSR_moments = new FP_PRECISION[3*_num_FSRs];
+  _FSR_inverse_moments = new FP_PRECISION[3*_num_FSRs];
+
+  /* Copy the centroids from the Geometry */
+  for (int r=0; r < _num_FSRs; r++) {
+    Point* centroid = _geometry->getFSRCentroid(r);
+    _FSR_centroids[2*r] = centroid->getX();
+    _FSR_centroids[2*r+1] = centroid->getY();
+  }
+
+  double* moments = new double[3*_num_FSRs];
+  memset(moments, 0, 3*_num_FSRs*sizeof(double));
+
+  FP_PRECISION* azim_weights = _track_generator->getAzimWeights();
+
+  /* Integrate the second moments along each Track segment */
+#pragma omp parallel
+  {
+    Track scratch;
+
+#pragma omp for schedule(guided)
+    for (int t=0; t < _tot_num_tracks; t++) {
+
+      Track* curr_track = _tracks[t];
+      Track* segmented_track =
+          _track_generator->getSegmentedTrack(curr_track, &scratch);
+      segment* segments = segmented_track->getSegments();
+      double weight = azim_weights[curr_track->getAzimAngleIndex()];
+      double cos_phi = cos(curr_track->getPhi());
+      double sin_phi = sin(curr_track->getPhi());
+      double x = curr_track->getStart()->getX();
+      double y = curr_track->getStart()->getY();
+
+      for (int s=0; s < segmented_track->getNumSegments(); s++) {
+        int fsr_id = segments[s]._region_id;
+        double length = segments[s]._length;
+
+        /* The segment mid-point relative to the FSR centroid */
+        double mid_x = x + 0.5 * length * cos_phi - _FSR_centroids[2*fsr_id];
+        double mid_y = y + 0.5 * length * sin_phi -
+                       _FSR_centroids[2*fsr_id+1];
+        double length_sq = length * length / 12.;
+
+        omp_set_lock(&_FSR_locks[fsr_id]);
+        moments[3*fsr_id] += weight * length *
+                             (mid_x * mid_x + cos_phi * cos_phi * length_sq);
+        moments[3*fsr_id+1] += weight * length *
+                               (mid_x * mid_y + cos_phi * sin_phi * length_sq);
+        moments[3*fsr_id+2] += weight * length *
+                               (mid_y * mid_y + sin_phi * sin_phi * length_sq);
+        omp_unset_lock(&_FSR_locks[fsr_id]);
+
+        x += length * cos_phi;
+        y += length * sin_phi;
+      }
+    }
+  }
+
+  /* Normalize the moments to the FSR volumes and invert them */
+  int num_flat = 0;
+  for (int r=0; r < _num_FSRs; r++) {
+    double xx = moments[3*r] / _FSR_volumes[r];
+    double xy = moments[3*r+1] / _FSR_volumes[r];
+    double yy = moments[3*r+2] / _FSR_volumes[r];
+    double det = xx * yy - xy * xy;
+
+    _FSR_moments[3*r] = xx;
+    _FSR_moments[3*r+1] = xy;
+    _FSR_moments[3*r+2] = yy;
+
+    if (det > 1E-3 * (xx + yy) * (xx + yy)) {
+      _FSR_inverse_moments[3*r] = yy / det;
+      _FSR_inverse_moments[3*r+1] = -xy / det;
+      _FSR_inverse_moments[3*r+2] = xx / det;
+    }
+    else {
+      memset(&_FSR_inverse_moments[3*r], 0, 3*sizeof(FP_PRECISION));
+      num_flat++;
+    }
+  }
+
+  if (num_flat > 0)
+    log_printf(WARNING, "Using a flat source in %d FSRs which are not "
+               "resolved by the Tracks", num_flat);
+
+  delete [] moments;
+}
+
+
+/**
+ * @brief Allocates memory for the Track boundary angular fluxes and the
+ *        FSR scalar fluxes and flux moments.
+ */
+void CPULSSolver::initializeFluxArrays() {
+
+  CPUSolver::initializeFluxArrays();
+
+  if (_scalar_flux_xy != NULL)
+    delete [] _scalar_flux_xy;
+
+  try{
+    _scalar_flux_xy = new ACC_PRECISION[2*_num_FSRs*_num_groups];
+  }
+  catch(std::exception &e) {
+    log_printf(ERROR, "Could not allocate memory for the flux moments");
+  }
+
+  memset(_scalar_flux_xy, 0, 2*_num_FSRs*_num_groups*sizeof(ACC_PRECISION));
+}
+
+
+/**
+ * @brief Allocates memory for the FSR sources and source gradients.
+ */
+void CPULSSolver::initializeSourceArrays() {
+
+  CPUSolver::initializeSourceArrays();
+
+  if (_reduced_sources_xy != NULL)
+    delete [] _reduced_sources_xy;
+
+  try{
+    _reduced_sources_xy = new FP_PRECISION[2*_num_FSRs*_num_groups];
+  }
+  catch(std::exception &e) {
+    log_printf(ERROR, "Could not allocate memory for the source gradients");
+  }
+
+  memset(_reduced_sources_xy, 0,
+         2*_num_FSRs*_num_groups*sizeof(FP_PRECISION));
+}
+
+
+/**
+ * @brief Initializes the Cmfd object to also update the flux moments
+ *        with the ratios of the new to old CMFD fluxes.
+ */
+void CPULSSolver::initializeCmfd() {
+
+  CPUSolver::initializeCmfd();
+
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
+    _cmfd->setFSRFluxMoments(_scalar_flux_xy);
+}
+
+
+/**
+ * @brief Set the scalar flux for each FSR and energy group to some value
+ *        and the flux moments to zero.
+ * @param value the value to assign to each FSR scalar flux
+ */
+void CPULSSolver::flattenFSRFluxes(FP_PRECISION value) {
+
+  CPUSolver::flattenFSRFluxes(value);
+
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int e=0; e < _num_groups; e++) {
+      _scalar_flux_xy(r,e,0) = 0.;
+      _scalar_flux_xy(r,e,1) = 0.;
+    }
+  }
+}
+
+
+/**
+ * @brief Normalizes the FSR scalar fluxes, flux moments and Track boundary
+ *        angular fluxes to the total fission source (times \f$ \nu \f$).
+ */
+void CPULSSolver::normalizeFluxes() {
+
+  int size = _num_FSRs * _num_groups;
+  ACC_PRECISION old_sum = pairwise_sum<ACC_PRECISION>(_scalar_flux, size);
+
+  CPUSolver::normalizeFluxes();
+
+  /* Scale the moments by the same factor as the scalar fluxes */
+  ACC_PRECISION norm_factor =
+       pairwise_sum<ACC_PRECISION>(_scalar_flux, size) / old_sum;
+
+#pragma omp parallel for schedule(guided)
+  for (int i=0; i < 2 * size; i++)
+    _scalar_flux_xy[i] *= norm_factor;
+}
+
+
+/**
+ * @brief Computes the total source and its gradient in each FSR.
+ */
+void CPULSSolver::computeFSRSources() {
+  CPUSolver::computeFSRSources();
+  computeFSRLinearSources(true, true);
+}
+
+
+/**
+ * @brief Computes the fission source and its gradient in each FSR.
+ * @details This method is a helper routine for the openmoc.krylov submodule.
+ */
+void CPULSSolver::computeFSRFissionSources() {
+  CPUSolver::computeFSRFissionSources();
+  computeFSRLinearSources(false, true);
+}
+
+
+/**
+ * @brief Computes the scatter source and its gradient in each FSR.
+ * @details This method is a helper routine for the openmoc.krylov submodule.
+ */
+void CPULSSolver::computeFSRScatterSources() {
+  CPUSolver::computeFSRScatterSources();
+  computeFSRLinearSources(true, false);
+}
+
+
+/**
+ * @brief Computes the gradients of the reduced source in each FSR.
+ * @details The source moments are computed from the flux moments with the
+ *          scattering and/or fission matrices and converted to gradients
+ *          with the inverse of the FSR's spatial moment matrix. The fixed
+ *          sources are flat.
+ * @param scatter whether to include the scattering source
+ * @param fission whether to include the fission source
+ */
+void CPULSSolver::computeFSRLinearSources(bool scatter, bool fission) {
+
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+
+    Material* material = _FSR_materials[r];
+    FP_PRECISION* sigma_t = material->getSigmaT();
+    FP_PRECISION* sigma_s = material->getSigmaS();
+    FP_PRECISION* fiss_mat = material->getFissionMatrix();
+    FP_PRECISION* inverse = &_FSR_inverse_moments[3*r];
+
+    /* Skip FSRs with a flat source */
+    if (inverse[0] == 0. && inverse[2] == 0.)
+      continue;
+
+    for (int g=0; g < _num_groups; g++) {
+
+      double source_x = 0.;
+      double source_y = 0.;
+
+      for (int g_prime=0; g_prime < _num_groups; g_prime++) {
+        double matrix = 0.;
+        if (scatter)
+          matrix += sigma_s[g*_num_groups + g_prime];
+        if (fission)
+          matrix += fiss_mat[g*_num_groups + g_prime] / _k_eff;
+
+        source_x += matrix * _scalar_flux_xy(r,g_prime,0);
+        source_y += matrix * _scalar_flux_xy(r,g_prime,1);
+      }
+
+      source_x *= ONE_OVER_FOUR_PI / sigma_t[g];
+      source_y *= ONE_OVER_FOUR_PI / sigma_t[g];
+
+      _reduced_sources_xy(r,g,0) = inverse[0] * source_x +
+                                   inverse[1] * source_y;
+      _reduced_sources_xy(r,g,1) = inverse[1] * source_x +
+                                   inverse[2] * source_y;
+    }
+  }
+}
+
+
+/**
+ * @brief This method performs one transport sweep of all azimuthal angles,
+ *        Tracks, Track segments, polar angles and energy groups.
+ * @details The sweep follows CPUSolver::transportSweep() while tracking the
+ *          position along each Track, from its start point in the forward
+ *          direction and from its end point in the reverse direction.
+ */
+void CPULSSolver::transportSweep() {
+
+  log_printf(DEBUG, "Transport sweep with %d OpenMP threads", _num_threads);
+
+  if (_num_group_blocks > 1)
+    log_printf(ERROR, "Unable to sweep %d energy group blocks since the "
+               "CPULSSolver does not support energy group decomposition",
+               _num_group_blocks);
+
+  if (_communicator != NULL)
+    log_printf(ERROR, "Unable to sweep a domain of a decomposed Geometry "
+               "since the CPULSSolver does not support domain decomposition");
+
+  int min_track = 0;
+  int max_track = 0;
+
+  /* Initialize the flux and flux moments in each FSR to zero */
+  flattenFSRFluxes(0.0);
+
+  if (_cumulative_segments == NULL)
+    initializeTrackSchedule();
+
+  bool tally_currents = _cmfd != NULL && _cmfd->isFluxUpdateOn();
+
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
+    _cmfd->zeroCurrents();
+
+  /* Loop over the parallel track groups */
+  for (int i=0; i < _num_parallel_track_groups; i++) {
+
+    /* Compute the minimum and maximum Track IDs corresponding to
+     * this parallel track group */
+    min_track = max_track;
+    max_track += _track_generator->getNumTracksByParallelGroup(i);
+
+#pragma omp parallel
+    {
+
+      int first_track, last_track;
+      int azim_index, num_segments, num_crossings;
+      Track* curr_track;
+      Track* segmented_track;
+      segment* curr_segment;
+      segment* segments;
+      cmfd_crossing* crossings;
+      FP_PRECISION* track_flux;
+      double position[2];
+      double direction[2];
+
+      /* Scratch Track for the segments if they are traced on-the-fly */
+      Track scratch;
+
+      /* Use local array accumulator for the flux and flux moments */
+      FP_PRECISION thread_fsr_flux[3 * _num_groups];
+
+      /* Local buffer for the decompressed Track angular fluxes */
+      FP_PRECISION thread_track_flux[2 * _polar_times_groups];
+
+      /* Loop over this thread's Tracks within this parallel group */
+      getThreadTracks(min_track, max_track, &first_track, &last_track);
+
+      for (int track_id=first_track; track_id < last_track; track_id++) {
+
+        /* Initialize local pointers to important data structures */
+        curr_track = _tracks[track_id];
+        segmented_track = _track_generator->getSegmentedTrack(curr_track,
+                                                              &scratch);
+        azim_index = curr_track->getAzimAngleIndex();
+        num_segments = segmented_track->getNumSegments();
+        segments = segmented_track->getSegments();
+        crossings = segmented_track->getCmfdCrossings();
+        num_crossings = tally_currents ?
+            segmented_track->getNumCmfdCrossings() : 0;
+
+        /* Use the boundary fluxes in place or decompress them */
+        if (_boundary_flux != NULL)
+          track_flux = &_boundary_flux(track_id,0,0,0);
+        else {
+          track_flux = thread_track_flux;
+          loadBoundaryFlux(track_id, 0, track_flux);
+        }
+
+        /* Loop over each Track segment in forward direction */
+        position[0] = curr_track->getStart()->getX();
+        position[1] = curr_track->getStart()->getY();
+        direction[0] = cos(curr_track->getPhi());
+        direction[1] = sin(curr_track->getPhi());
+
+        for (int s=0, c=0; s < num_segments; s++) {
+          curr_segment = &segments[s];
+          tallyLSScalarFlux(curr_segment, azim_index, track_flux,
+                            thread_fsr_flux, position, direction);
+
+          if (c < num_crossings && crossings[c]._segment == s) {
+            tallyCurrent(crossings[c]._surface_fwd, azim_index, track_flux);
+            c++;
+          }
+        }
+
+        /* Transfer boundary angular flux to outgoing Track */
+        transferBoundaryFlux(track_id, true, track_flux);
+
+        /* Loop over each Track segment in reverse direction */
+        track_flux += _polar_times_groups;
+
+        if (_boundary_flux == NULL)
+          loadBoundaryFlux(track_id, 1, track_flux);
+
+        position[0] = curr_track->getEnd()->getX();
+        position[1] = curr_track->getEnd()->getY();
+        direction[0] = -direction[0];
+        direction[1] = -direction[1];
+
+        for (int s=num_segments-1, c=num_crossings-1; s > -1; s--) {
+          curr_segment = &segments[s];
+          tallyLSScalarFlux(curr_segment, azim_index, track_flux,
+                            thread_fsr_flux, position, direction);
+
+          if (c >= 0 && crossings[c]._segment == s) {
+            tallyCurrent(crossings[c]._surface_bwd, azim_index, track_flux);
+            c--;
+          }
+        }
+
+        /* Transfer boundary angular flux to outgoing Track */
+        transferBoundaryFlux(track_id, false, track_flux);
+      }
+    }
+  }
+
+  /* Reduce the thread private CMFD surface currents */
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
+    _cmfd->reduceCurrents();
+}
+
+
+/**
+ * @brief Computes the contribution to the FSR scalar flux and flux moments
+ *        from a Track segment with a linear source.
+ * @details For a segment with length l and the reduced source
+ *          \f$ \bar{q} \f$ at its mid-point and G its change along the
+ *          segment, the change in angular flux is
+ *          \f$ \Delta\psi = (\psi_{in} - \bar{q}) F_1 + G F_2 \f$. The flux
+ *          moments are tallied without the contribution of the source
+ *          itself, which is added analytically by addSourceToScalarFlux().
+ *          The position is advanced to the end of the segment.
+ * @param curr_segment a pointer to the Track segment of interest
+ * @param azim_index the azimuthal angle index for this segment
+ * @param track_flux a pointer to the Track's angular flux
+ * @param fsr_flux a pointer to the temporary FSR flux and moments buffer
+ * @param position the x and y coordinates of the start of the segment
+ * @param direction the x and y components of the direction of travel
+ */
+void CPULSSolver::tallyLSScalarFlux(segment* curr_segment, int azim_index,
+                                    FP_PRECISION* track_flux,
+                                    FP_PRECISION* fsr_flux,
+                                    double* position, double* direction) {
+
+  int fsr_id = curr_segment->_region_id;
+  FP_PRECISION length = curr_segment->_length;
+  FP_PRECISION* sigma_t = _FSR_materials[fsr_id]->getSigmaT();
+  FP_PRECISION* fsr_flux_xy = &fsr_flux[_num_groups];
+  FP_PRECISION F1, F2, H;
+
+  /* The segment mid-point relative to the FSR centroid */
+  FP_PRECISION mid_x = position[0] + 0.5 * length * direction[0] -
+                       _FSR_centroids[2*fsr_id];
+  FP_PRECISION mid_y = position[1] + 0.5 * length * direction[1] -
+                       _FSR_centroids[2*fsr_id+1];
+
+  /* Set the FSR scalar flux buffer to zero */
+  memset(fsr_flux, 0.0, 3 * _num_groups * sizeof(FP_PRECISION));
+
+  for (int e=0; e < _num_groups; e++) {
+
+    FP_PRECISION* gradient = &_reduced_sources_xy(fsr_id,e,0);
+    FP_PRECISION source = _reduced_sources(fsr_id,e) +
+                          gradient[0] * mid_x + gradient[1] * mid_y;
+    FP_PRECISION source_change = length * (gradient[0] * direction[0] +
+                                           gradient[1] * direction[1]);
+    FP_PRECISION delta_psi_sum = 0.;
+    FP_PRECISION moment_sum = 0.;
+
+    for (int p=0; p < _num_polar; p++) {
+      _exp_evaluator->computeLinearSourceExponentials(sigma_t[e] * length, p,
+                                                      &F1, &F2, &H);
+      FP_PRECISION weight = _polar_weights(azim_index,p);
+      FP_PRECISION psi = track_flux(p,e) - source;
+      FP_PRECISION delta_psi = psi * F1 + source_change * F2;
+
+      delta_psi_sum += delta_psi * weight;
+      moment_sum += (psi * F2 + source_change * (H + 0.5 * F2)) * weight;
+      track_flux(p,e) -= delta_psi;
+    }
+
+    fsr_flux[e] = delta_psi_sum;
+    fsr_flux_xy[2*e] = delta_psi_sum * mid_x +
+                       moment_sum * length * direction[0];
+    fsr_flux_xy[2*e+1] = delta_psi_sum * mid_y +
+                         moment_sum * length * direction[1];
+  }
+
+  /* Atomically increment the FSR scalar flux from the temporary array */
+  omp_set_lock(&_FSR_locks[fsr_id]);
+  {
+    for (int e=0; e < _num_groups; e++) {
+      _scalar_flux(fsr_id,e) += fsr_flux[e];
+      _scalar_flux_xy(fsr_id,e,0) += fsr_flux_xy[2*e];
+      _scalar_flux_xy(fsr_id,e,1) += fsr_flux_xy[2*e+1];
+    }
+  }
+  omp_unset_lock(&_FSR_locks[fsr_id]);
+
+  /* Advance to the end of the segment */
+  position[0] += length * direction[0];
+  position[1] += length * direction[1];
+}
+
+
+/**
+ * @brief Add the source term contribution in the transport equation to
+ *        the FSR scalar flux and flux moments.
+ * @details The source contributes \f$ 4 \pi M \nabla q \f$ to the flux
+ *          moments, where M is the FSR's spatial moment matrix.
+ */
+void CPULSSolver::addSourceToScalarFlux() {
+
+  CPUSolver::addSourceToScalarFlux();
+
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+
+    FP_PRECISION volume = _FSR_volumes[r];
+    FP_PRECISION* sigma_t = _FSR_materials[r]->getSigmaT();
+    FP_PRECISION* moments = &_FSR_moments[3*r];
+
+    for (int e=0; e < _num_groups; e++) {
+      FP_PRECISION* gradient = &_reduced_sources_xy(r,e,0);
+
+      _scalar_flux_xy(r,e,0) *= 0.5 / (sigma_t[e] * volume);
+      _scalar_flux_xy(r,e,0) += FOUR_PI * (moments[0] * gradient[0] +
+                                           moments[1] * gradient[1]);
+      _scalar_flux_xy(r,e,1) *= 0.5 / (sigma_t[e] * volume);
+      _scalar_flux_xy(r,e,1) += FOUR_PI * (moments[1] * gradient[0] +
+                                           moments[2] * gradient[1]);
+    }
+  }
+}
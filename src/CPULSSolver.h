@@ -0,0 +1,88 @@
+/**
+ * @file CPULSSolver.h
+ * @brief The CPULSSolver class.
+ * @date October 19, 2026
+ */
+
+
+#ifndef CPULSSOLVER_H_
+#define CPULSSOLVER_H_
+
+#ifdef __cplusplus
+#include "CPUSolver.h"
+#endif
+
+
+/** Indexing macro for the x and y scalar flux moments in each FSR and
+ *  energy group */
+#define _scalar_flux_xy(r,e,i) (_scalar_flux_xy[((r)*_num_groups + (e))*2 \
+                                                + (i)])
+
+/** Indexing macro for the x and y gradients of the reduced source in each
+ *  FSR and energy group */
+#define _reduced_sources_xy(r,e,i) (_reduced_sources_xy[((r)*_num_groups \
+                                                         + (e))*2 + (i)])
+
+
+/**
+ * @class CPULSSolver CPULSSolver.h "src/CPULSSolver.h"
+ * @brief A CPUSolver which approximates the source in each FSR as linear
+ *        in x and y.
+ * @details The linear source is computed from the first spatial moments of
+ *          the scalar flux in each FSR relative to the FSR's numerical
+ *          centroid, as described in R. Ferrer et. al. "Linear Source
+ *          Approximation in CASMO 5", PHYSOR 2012. The transport sweep
+ *          integrates the angular flux along each segment with the source
+ *          gradient and tallies the flux moments in addition to the scalar
+ *          flux. A linear source reaches the accuracy of a flat source with
+ *          far fewer FSRs (ie, rings and sectors in each Cell).
+ */
+class CPULSSolver : public CPUSolver {
+
+protected:
+
+  /** The x and y coordinates of the numerical centroid of each FSR */
+  double* _FSR_centroids;
+
+  /** The second spatial moments (xx, xy, yy) of each FSR about its
+   *  centroid, divided by the FSR volume */
+  FP_PRECISION* _FSR_moments;
+
+  /** The inverse of the matrix of the second spatial moments of each FSR,
+   *  or zeros if the matrix is singular */
+  FP_PRECISION* _FSR_inverse_moments;
+
+  /** The x and y scalar flux moments for each FSR and energy group */
+  ACC_PRECISION* _scalar_flux_xy;
+
+  /** The x and y gradients of the reduced source for each FSR and energy
+   *  group */
+  FP_PRECISION* _reduced_sources_xy;
+
+  void computeFSRLinearSources(bool scatter, bool fission);
+  void tallyLSScalarFlux(segment* curr_segment, int azim_index,
+                         FP_PRECISION* track_flux, FP_PRECISION* fsr_flux,
+                         double* position, double* direction);
+
+public:
+  CPULSSolver(TrackGenerator* track_generator=NULL);
+  virtual ~CPULSSolver();
+
+  FP_PRECISION getFluxByCoords(int fsr_id, int group, double x, double y);
+
+  void initializeFSRs();
+  void initializeFluxArrays();
+  void initializeSourceArrays();
+  void initializeCmfd();
+
+  void flattenFSRFluxes(FP_PRECISION value);
+  void normalizeFluxes();
+  void computeFSRSources();
+  void computeFSRFissionSources();
+  void computeFSRScatterSources();
+  void transportSweep();
+  void addSourceToScalarFlux();
+};
+
+
+#endif /* CPULSSOLVER_H_ */
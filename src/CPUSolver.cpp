@@ -13,7 +13,34 @@ CPUSolver::CPUSolver(TrackGenerator* track_generator)
   : Solver(track_generator) {
 
   setNumThreads(1);
+  _num_group_blocks = 1;
   _FSR_locks = NULL;
+
+  _boundary_flux_storage = BOUNDARY_FLUX_FULL;
+  _compressed_flux = NULL;
+  _compressed_flux_scales = NULL;
+  _cumulative_segments = NULL;
+
+  _anderson_fluxes = NULL;
+  _anderson_residuals = NULL;
+  _anderson_last_flux = NULL;
+  _anderson_last_residual = NULL;
+  _anderson_boundary_fluxes = NULL;
+  _anderson_boundary_residuals = NULL;
+  _anderson_last_boundary_flux = NULL;
+  _anderson_last_boundary_residual = NULL;
+  _anderson_mixed_boundary_flux = NULL;
+  _anderson_k_effs = NULL;
+  _anderson_k_residuals = NULL;
+  _anderson_num_stored = 0;
+  _anderson_index = 0;
+
+  _communicator = NULL;
+  _num_neighbors = 0;
+  _interface_index = NULL;
+  _interface_fluxes_in = NULL;
+  _send_flux = NULL;
+  _recv_flux = NULL;
 }
 
 
@@ -22,7 +49,38 @@ CPUSolver::CPUSolver(TrackGenerator* track_generator)
  *        FSR scalar flux updates, and calls Solver parent class destructor
  *        to deletes arrays for fluxes and sources.
  */
-CPUSolver::~CPUSolver() {}
+CPUSolver::~CPUSolver() {
+
+  if (_compressed_flux != NULL)
+    delete [] _compressed_flux;
+
+  if (_compressed_flux_scales != NULL)
+    delete [] _compressed_flux_scales;
+
+  if (_cumulative_segments != NULL)
+    delete [] _cumulative_segments;
+
+  if (_anderson_fluxes != NULL) {
+    delete [] _anderson_fluxes;
+    delete [] _anderson_residuals;
+    delete [] _anderson_last_flux;
+    delete [] _anderson_last_residual;
+    delete [] _anderson_boundary_fluxes;
+    delete [] _anderson_boundary_residuals;
+    delete [] _anderson_last_boundary_flux;
+    delete [] _anderson_last_boundary_residual;
+    delete [] _anderson_mixed_boundary_flux;
+    delete [] _anderson_k_effs;
+    delete [] _anderson_k_residuals;
+  }
+
+  if (_interface_index != NULL) {
+    delete [] _interface_index;
+    delete [] _interface_fluxes_in;
+    delete [] _send_flux;
+    delete [] _recv_flux;
+  }
+}
 
 
 /**
@@ -62,7 +120,7 @@ void CPUSolver::getFluxes(FP_PRECISION* out_fluxes, int num_fluxes) {
                "have not yet been allocated");
 
   /* If the user called setFluxes(...) they already have the flux */
-  if (_user_fluxes && _scalar_flux == out_fluxes)
+  if (_user_fluxes && (void*)_scalar_flux == (void*)out_fluxes)
     return;
 
   /* Otherwise, copy the fluxes into the input array */
@@ -76,6 +134,33 @@ void CPUSolver::getFluxes(FP_PRECISION* out_fluxes, int num_fluxes) {
 }
 
 
+/**
+ * @brief Returns the number of blocks of energy groups swept concurrently.
+ * @return the number of energy group blocks
+ */
+int CPUSolver::getNumGroupBlocks() {
+  return _num_group_blocks;
+}
+
+
+/**
+ * @brief Returns the format used to store the Track boundary angular fluxes.
+ * @return the boundary angular flux storage format
+ */
+boundaryFluxStorage CPUSolver::getBoundaryFluxStorage() {
+  return _boundary_flux_storage;
+}
+
+
+/**
+ * @brief Returns the Communicator with the Solvers of the other domains.
+ * @return a pointer to the Communicator (NULL if none was set)
+ */
+Communicator* CPUSolver::getCommunicator() {
+  return _communicator;
+}
+
+
 /**
  * @brief Sets the number of shared memory OpenMP threads to use (>0).
  * @param num_threads the number of threads
@@ -92,6 +177,94 @@ void CPUSolver::setNumThreads(int num_threads) {
 }
 
 
+/**
+ * @brief Sets the number of blocks of energy groups swept concurrently (>0).
+ * @details By default the threads divide the Tracks of each parallel group
+ *          among themselves and sweep every energy group of their Tracks,
+ *          such that the FSR scalar flux updates must be atomic. With more
+ *          than one block, the energy groups are divided into contiguous
+ *          blocks and the threads are assigned to the blocks in a round
+ *          robin fashion. The threads of each block divide the Tracks among
+ *          themselves and sweep only the block's energy groups. Since the
+ *          energy groups are independent within a transport sweep, the FSR
+ *          scalar flux updates are only atomic if several threads share a
+ *          block, and setting the number of blocks to the number of threads
+ *          removes the locks entirely. This is most useful for problems with
+ *          many energy groups, or when there are too few Tracks per parallel
+ *          group to balance the threads. The number of blocks is limited to
+ *          the number of threads and energy groups during the sweep. This
+ *          requires the BOUNDARY_FLUX_FULL storage, and may be called from
+ *          Python as follows:
+ *
+ * @code
+ *          solver.setNumThreads(8)
+ *          solver.setNumGroupBlocks(4)
+ * @endcode
+ *
+ * @param num_blocks the number of energy group blocks
+ */
+void CPUSolver::setNumGroupBlocks(int num_blocks) {
+
+  if (num_blocks <= 0)
+    log_printf(ERROR, "Unable to set the number of energy group blocks to "
+               "%d since it is less than or equal to 0", num_blocks);
+
+  _num_group_blocks = num_blocks;
+}
+
+
+/**
+ * @brief Sets the format used to store the Track boundary angular fluxes.
+ * @details The boundary angular fluxes require 2 x # Tracks x # polar angles
+ *          x # energy groups values. The compressed formats store each value
+ *          in 16 bits, with a scale for each Track direction, which roughly
+ *          halves the memory and bandwidth needed for the boundary fluxes
+ *          of single precision solvers. The angular fluxes are decompressed
+ *          at the start of each Track in the transport sweep and compressed
+ *          when they are transferred to the outgoing Track, such that the
+ *          sweep itself is unchanged. The half precision format bounds the
+ *          relative error of each angular flux by \f$ 2^{-11} \f$, while
+ *          the 16-bit integer format bounds the error by \f$ 2^{-16} \f$
+ *          of the largest angular flux for the Track direction. This may be
+ *          called from Python as follows:
+ *
+ * @code
+ *          solver.setBoundaryFluxStorage(openmoc.BOUNDARY_FLUX_HALF)
+ * @endcode
+ *
+ * @param storage the boundary angular flux storage format
+ */
+void CPUSolver::setBoundaryFluxStorage(boundaryFluxStorage storage) {
+  _boundary_flux_storage = storage;
+  _dirty_components |= FLUX_COMPONENT;
+}
+
+
+/**
+ * @brief Sets the Communicator with the Solvers of the other domains of a
+ *        decomposed Geometry.
+ * @details The Geometry of each domain is restricted with
+ *          Geometry::setDomain(...), and its Solver must use the
+ *          Communicator whose rank is the index of the domain. After each
+ *          transport sweep, the angular fluxes of the Tracks leaving the
+ *          domain through its interfaces are exchanged with the neighboring
+ *          domains and become the incoming fluxes of the next sweep. The
+ *          fission sources and residuals are summed over all domains such
+ *          that all Solvers converge to the same eigenvalue. This may be
+ *          called from Python with MPI as follows:
+ *
+ * @code
+ *          communicator = openmoc.MPICommunicator()
+ *          solver.setCommunicator(communicator)
+ * @endcode
+ *
+ * @param communicator a pointer to the Communicator
+ */
+void CPUSolver::setCommunicator(Communicator* communicator) {
+  _communicator = communicator;
+}
+
+
 /**
  * @brief Set the flux array for use in transport sweep source calculations.
  * @detail This is a helper method for the checkpoint restart capabilities,
@@ -105,7 +278,9 @@ void CPUSolver::setNumThreads(int num_threads) {
  *
  *          NOTE: This routine stores a pointer to the fluxes for the Solver
  *          to use during transport sweeps and other calculations. Hence, the
- *          flux array pointer is shared between NumPy and the Solver.
+ *          flux array pointer is shared between NumPy and the Solver. Mixed
+ *          precision solvers accumulate the scalar flux in double precision
+ *          and instead copy the fluxes into their own array.
  *
  * @param in_fluxes an array with the fluxes to use
  * @param num_fluxes the number of flux values (# groups x # FSRs)
@@ -119,9 +294,16 @@ void CPUSolver::setFluxes(FP_PRECISION* in_fluxes, int num_fluxes) {
   if (_scalar_flux == NULL)
     initializeFluxArrays();
 
+#ifdef MIXED
+  /* Copy the fluxes into the double precision scalar flux array */
+#pragma omp parallel for schedule(guided)
+  for (int i=0; i < num_fluxes; i++)
+    _scalar_flux[i] = in_fluxes[i];
+#else
   /* Set the scalar flux array pointer to the array passed in from NumPy */
   _scalar_flux = in_fluxes;
   _user_fluxes = true;
+#endif
 }
 
 
@@ -136,6 +318,270 @@ void CPUSolver::initializeFSRs() {
 }
 
 
+/**
+ * @brief Initializes the Solver's components for a calculation and the
+ *        partition of the Tracks among threads in the transport sweep.
+ * @param mode the solution type (FORWARD or ADJOINT)
+ * @return whether the flux arrays of the previous calculation were kept
+ */
+bool CPUSolver::initializeSolver(solverMode mode) {
+
+  /* Size the Geometry's maps for the threads tracing Tracks on-the-fly */
+  _geometry->setNumThreads(omp_get_max_threads());
+
+  bool kept_fluxes = Solver::initializeSolver(mode);
+  initializeTrackSchedule();
+  initializeInterfaces();
+  return kept_fluxes;
+}
+
+
+/**
+ * @brief Initializes the exchange of angular fluxes with the neighboring
+ *        domains of a decomposed Geometry.
+ * @details The angular fluxes of the Tracks leaving this domain through
+ *          each interface are sent to the neighboring domain in the order
+ *          given by the TrackGenerator, which is the same in every domain
+ *          since their Track laydowns are identical. The angular fluxes
+ *          received from the neighboring domain across an interface are
+ *          those leaving that domain through the opposite interface, and
+ *          are transferred to the Tracks entering this domain in the same
+ *          order.
+ */
+void CPUSolver::initializeInterfaces() {
+
+  if (_interface_index != NULL) {
+    delete [] _interface_index;
+    delete [] _interface_fluxes_in;
+    delete [] _send_flux;
+    delete [] _recv_flux;
+  }
+
+  _num_neighbors = 0;
+  _interface_index = NULL;
+  _interface_fluxes_in = NULL;
+  _send_flux = NULL;
+  _recv_flux = NULL;
+
+  int num_domains_x = _geometry->getNumDomainsX();
+  int num_domains_y = _geometry->getNumDomainsY();
+  int domain_x = _geometry->getDomainIndexX();
+  int domain_y = _geometry->getDomainIndexY();
+
+  if (num_domains_x * num_domains_y == 1)
+    return;
+
+  if (_communicator == NULL)
+    log_printf(ERROR, "Unable to solve domain (%d, %d) of the Geometry "
+               "without a Communicator", domain_x, domain_y);
+
+  if (_communicator->getNumRanks() != num_domains_x * num_domains_y ||
+      _communicator->getRank() != domain_y * num_domains_x + domain_x)
+    log_printf(ERROR, "Unable to solve domain (%d, %d) of %d x %d domains "
+               "with rank %d of %d ranks", domain_x, domain_y, num_domains_x,
+               num_domains_y, _communicator->getRank(),
+               _communicator->getNumRanks());
+
+  Cmfd* cmfd = _geometry->getCmfd();
+  if (cmfd != NULL && cmfd->isFluxUpdateOn())
+    log_printf(ERROR, "Unable to use CMFD acceleration for a domain of "
+               "a decomposed Geometry");
+
+  /* The surfaces opposite to SURFACE_X_MIN, SURFACE_Y_MIN, SURFACE_X_MAX
+   * and SURFACE_Y_MAX, and the domains across them */
+  int opposite[NUM_FACES] = {SURFACE_X_MAX, SURFACE_Y_MAX, SURFACE_X_MIN,
+                             SURFACE_Y_MIN};
+  int shift_x[NUM_FACES] = {-1, 0, 1, 0};
+  int shift_y[NUM_FACES] = {0, -1, 0, 1};
+
+  std::vector<int> fluxes_in;
+  _interface_index = new int[2 * _tot_num_tracks];
+  std::fill(_interface_index, _interface_index + 2 * _tot_num_tracks, -1);
+  _send_offsets[0] = 0;
+  _recv_offsets[0] = 0;
+
+  for (int s=0; s < NUM_FACES; s++) {
+
+    int neighbor_x = domain_x + shift_x[s];
+    int neighbor_y = domain_y + shift_y[s];
+    if (neighbor_x < 0 || neighbor_x >= num_domains_x ||
+        neighbor_y < 0 || neighbor_y >= num_domains_y)
+      continue;
+
+    int n = _num_neighbors++;
+    _neighbor_ranks[n] = neighbor_y * num_domains_x + neighbor_x;
+
+    /* The Track directions leaving through this interface */
+    int num_out = _track_generator->getBoundaryFluxes(s, NULL, NULL);
+    std::vector<int> out(num_out), in(num_out);
+    _track_generator->getBoundaryFluxes(s, &out[0], &in[0]);
+
+    for (int i=0; i < num_out; i++)
+      _interface_index[out[i]] = _send_offsets[n] / _polar_times_groups + i;
+    _send_offsets[n+1] = _send_offsets[n] + num_out * _polar_times_groups;
+
+    /* The Track directions entering through this interface */
+    int num_in = _track_generator->getBoundaryFluxes(opposite[s], NULL, NULL);
+    out.resize(num_in);
+    in.resize(num_in);
+    _track_generator->getBoundaryFluxes(opposite[s], &out[0], &in[0]);
+
+    fluxes_in.insert(fluxes_in.end(), in.begin(), in.end());
+    _recv_offsets[n+1] = _recv_offsets[n] + num_in * _polar_times_groups;
+  }
+
+  _interface_fluxes_in = new int[fluxes_in.size()];
+  std::copy(fluxes_in.begin(), fluxes_in.end(), _interface_fluxes_in);
+  _send_flux = new FP_PRECISION[_send_offsets[_num_neighbors]];
+  _recv_flux = new FP_PRECISION[_recv_offsets[_num_neighbors]];
+
+  log_printf(INFO, "Exchanging %d outgoing and %d incoming angular fluxes "
+             "with %d neighboring domains", _send_offsets[_num_neighbors] /
+             _polar_times_groups, _recv_offsets[_num_neighbors] /
+             _polar_times_groups, _num_neighbors);
+}
+
+
+/**
+ * @brief Returns the location in the send buffer of the outgoing angular
+ *        flux of a Track direction leaving through a domain interface.
+ * @param track_id the ID number for the Track of interest
+ * @param direction the Track direction (forward - true, reverse - false)
+ * @return a pointer to the outgoing angular flux in the send buffer, or NULL
+ *         if the Track direction does not leave through an interface
+ */
+FP_PRECISION* CPUSolver::getInterfaceFlux(int track_id, bool direction) {
+
+  if (_interface_index == NULL)
+    return NULL;
+
+  int index = _interface_index[2 * track_id + !direction];
+  if (index < 0)
+    return NULL;
+
+  return &_send_flux[index * _polar_times_groups];
+}
+
+
+/**
+ * @brief Exchanges the angular fluxes leaving through the domain interfaces
+ *        with the neighboring domains after a transport sweep.
+ * @details The received angular fluxes are the incoming boundary fluxes of
+ *          the Tracks entering this domain in the next transport sweep.
+ */
+void CPUSolver::exchangeInterfaceFluxes() {
+
+  if (_interface_index == NULL)
+    return;
+
+  _communicator->exchange(_num_neighbors, _neighbor_ranks, _send_flux,
+                          _send_offsets, _recv_flux, _recv_offsets);
+
+  int num_fluxes = _recv_offsets[_num_neighbors] / _polar_times_groups;
+
+#pragma omp parallel for schedule(guided)
+  for (int i=0; i < num_fluxes; i++) {
+    int track_id = _interface_fluxes_in[i] / 2;
+    int direction = _interface_fluxes_in[i] % 2;
+    FP_PRECISION* track_flux = &_recv_flux[i * _polar_times_groups];
+
+    if (_boundary_flux == NULL)
+      storeBoundaryFlux(track_id, direction, track_flux, 1.);
+    else
+      std::copy(track_flux, track_flux + _polar_times_groups,
+                &_boundary_flux(track_id,direction,0,0));
+  }
+}
+
+
+/**
+ * @brief Sums a value over all domains of a decomposed Geometry.
+ * @param value the value in this domain
+ * @return the sum of the values in all domains
+ */
+double CPUSolver::sumOverDomains(double value) {
+
+  if (_communicator != NULL)
+    _communicator->reduceSum(&value, 1);
+
+  return value;
+}
+
+
+/**
+ * @brief Computes the cumulative number of segments of the Tracks used to
+ *        partition them among threads in the transport sweep.
+ * @details This is called after the segments are split for the maximum
+ *          optical length such that the number of segments of each Track is
+ *          that of the transport sweep.
+ */
+void CPUSolver::initializeTrackSchedule() {
+
+  if (_cumulative_segments != NULL)
+    delete [] _cumulative_segments;
+
+  _cumulative_segments = new long[_tot_num_tracks+1];
+  _cumulative_segments[0] = 0;
+
+  for (int t=0; t < _tot_num_tracks; t++)
+    _cumulative_segments[t+1] = _cumulative_segments[t] +
+        _track_generator->getNumSegments(_tracks[t]);
+}
+
+
+/**
+ * @brief Finds the range of Tracks to be swept by the calling thread.
+ * @details The Tracks of a parallel group are partitioned into contiguous
+ *          ranges with equal numbers of segments for each thread in the
+ *          OpenMP team. Since the Tracks for each azimuthal angle are
+ *          ordered by their perpendicular offset, each thread sweeps a band
+ *          of adjacent parallel Tracks which cross many of the same FSRs,
+ *          and the same Tracks in every transport sweep such that their
+ *          segments and boundary fluxes remain in its cache. This must be
+ *          called from within an OpenMP parallel region.
+ * @param min_track the ID of the first Track in the parallel group
+ * @param max_track one past the ID of the last Track in the parallel group
+ * @param first_track a pointer to the ID of the thread's first Track
+ * @param last_track a pointer to one past the ID of the thread's last Track
+ */
+void CPUSolver::getThreadTracks(int min_track, int max_track,
+                                int* first_track, int* last_track) {
+  getThreadTracks(min_track, max_track, omp_get_thread_num(),
+                  omp_get_num_threads(), first_track, last_track);
+}
+
+
+/**
+ * @brief Finds the range of Tracks to be swept by one of a team of threads.
+ * @details The Tracks of a parallel group are partitioned into contiguous
+ *          ranges with equal numbers of segments for each member of the
+ *          team, as for the whole OpenMP team in the method above.
+ * @param min_track the ID of the first Track in the parallel group
+ * @param max_track one past the ID of the last Track in the parallel group
+ * @param rank the rank of the thread within its team
+ * @param team_size the number of threads in the team
+ * @param first_track a pointer to the ID of the thread's first Track
+ * @param last_track a pointer to one past the ID of the thread's last Track
+ */
+void CPUSolver::getThreadTracks(int min_track, int max_track, int rank,
+                                int team_size, int* first_track,
+                                int* last_track) {
+
+  long min_segments = _cumulative_segments[min_track];
+  long num_segments = _cumulative_segments[max_track] - min_segments;
+  long start = min_segments + num_segments * rank / team_size;
+  long end = min_segments + num_segments * (rank + 1) / team_size;
+
+  /* Assign each Track to the thread whose range contains its first segment */
+  long* tracks_begin = &_cumulative_segments[min_track];
+  long* tracks_end = &_cumulative_segments[max_track];
+  *first_track = std::lower_bound(tracks_begin, tracks_end, start)
+                 - _cumulative_segments;
+  *last_track = std::lower_bound(tracks_begin, tracks_end, end)
+                - _cumulative_segments;
+}
+
+
 /**
  * @brief Allocates memory for Track boundary angular and FSR scalar fluxes.
  * @details Deletes memory for old flux arrays if they were allocated
@@ -147,6 +593,16 @@ void CPUSolver::initializeFluxArrays() {
   if (_boundary_flux != NULL)
     delete [] _boundary_flux;
 
+  if (_compressed_flux != NULL)
+    delete [] _compressed_flux;
+
+  if (_compressed_flux_scales != NULL)
+    delete [] _compressed_flux_scales;
+
+  _boundary_flux = NULL;
+  _compressed_flux = NULL;
+  _compressed_flux_scales = NULL;
+
   if (_scalar_flux != NULL)
     delete [] _scalar_flux;
 
@@ -156,12 +612,18 @@ void CPUSolver::initializeFluxArrays() {
   /* Allocate memory for the Track boundary flux arrays */
   try{
     int size = 2 * _tot_num_tracks * _polar_times_groups;
-    _boundary_flux = new FP_PRECISION[size];
+
+    if (_boundary_flux_storage == BOUNDARY_FLUX_FULL)
+      _boundary_flux = new FP_PRECISION[size];
+    else {
+      _compressed_flux = new uint16_t[size];
+      _compressed_flux_scales = new FP_PRECISION[2 * _tot_num_tracks];
+    }
 
     /* Allocate an array for the FSR scalar flux */
     size = _num_FSRs * _num_groups;
-    _scalar_flux = new FP_PRECISION[size];
-    _old_scalar_flux = new FP_PRECISION[size];
+    _scalar_flux = new ACC_PRECISION[size];
+    _old_scalar_flux = new ACC_PRECISION[size];
   }
   catch(std::exception &e) {
     log_printf(ERROR, "Could not allocate memory for the fluxes");
@@ -240,6 +702,15 @@ void CPUSolver::initializeFixedSources() {
  */
 void CPUSolver::zeroTrackFluxes() {
 
+  /* Zero the compressed angular fluxes and their scales */
+  if (_boundary_flux == NULL) {
+    memset(_compressed_flux, 0, 2 * _tot_num_tracks * _polar_times_groups *
+           sizeof(uint16_t));
+    memset(_compressed_flux_scales, 0, 2 * _tot_num_tracks *
+           sizeof(FP_PRECISION));
+    return;
+  }
+
 #pragma omp parallel for schedule(guided)
   for (int t=0; t < _tot_num_tracks; t++) {
     for (int d=0; d < 2; d++) {
@@ -288,11 +759,11 @@ void CPUSolver::normalizeFluxes() {
 
   FP_PRECISION* nu_sigma_f;
   FP_PRECISION volume;
-  FP_PRECISION tot_fission_source;
-  FP_PRECISION norm_factor;
+  ACC_PRECISION tot_fission_source;
+  ACC_PRECISION norm_factor;
 
   int size = _num_FSRs * _num_groups;
-  FP_PRECISION* fission_sources = new FP_PRECISION[_num_FSRs * _num_groups];
+  ACC_PRECISION* fission_sources = new ACC_PRECISION[_num_FSRs * _num_groups];
 
   /* Compute total fission source for each FSR, energy group */
 #pragma omp parallel for private(volume, nu_sigma_f) schedule(guided)
@@ -306,8 +777,9 @@ void CPUSolver::normalizeFluxes() {
       fission_sources(r,e) = nu_sigma_f[e] * _scalar_flux(r,e) * volume;
   }
 
-  /* Compute the total fission source */
-  tot_fission_source = pairwise_sum<FP_PRECISION>(fission_sources,size);
+  /* Compute the total fission source over all domains */
+  tot_fission_source = pairwise_sum<ACC_PRECISION>(fission_sources,size);
+  tot_fission_source = sumOverDomains(tot_fission_source);
 
   /* Deallocate memory for fission source array */
   delete [] fission_sources;
@@ -326,6 +798,13 @@ void CPUSolver::normalizeFluxes() {
     }
   }
 
+  /* Normalize the scales of the compressed angular boundary fluxes */
+  if (_boundary_flux == NULL) {
+    for (int i=0; i < 2 * _tot_num_tracks; i++)
+      _compressed_flux_scales[i] *= norm_factor;
+    return;
+  }
+
   /* Normalize angular boundary fluxes for each Track */
 #pragma omp parallel for schedule(guided)
   for (int t=0; t < _tot_num_tracks; t++) {
@@ -493,7 +972,7 @@ double CPUSolver::computeResidual(residualType res_type) {
 
   if (res_type == SCALAR_FLUX) {
 
-    norm = _num_FSRs;
+    norm = sumOverDomains(_num_FSRs);
 
 #pragma omp parallel for schedule(guided)
     for (int r=0; r < _num_FSRs; r++) {
@@ -507,12 +986,12 @@ double CPUSolver::computeResidual(residualType res_type) {
 
   else if (res_type == FISSION_SOURCE) {
 
-    if (_num_fissionable_FSRs == 0)
+    norm = sumOverDomains(_num_fissionable_FSRs);
+
+    if (norm == 0)
       log_printf(ERROR, "The Solver is unable to compute a "
                  "FISSION_SOURCE residual without fissionable FSRs");
 
-    norm = _num_fissionable_FSRs;
-
 #pragma omp parallel
     {
 
@@ -544,7 +1023,7 @@ double CPUSolver::computeResidual(residualType res_type) {
 
   else if (res_type == TOTAL_SOURCE) {
 
-    norm = _num_FSRs;
+    norm = sumOverDomains(_num_FSRs);
 
 #pragma omp parallel
     {
@@ -591,8 +1070,9 @@ double CPUSolver::computeResidual(residualType res_type) {
     }
   }
 
-  /* Sum up the residuals from each FSR and normalize */
+  /* Sum up the residuals from each FSR and domain and normalize */
   residual = pairwise_sum<double>(residuals, _num_FSRs);
+  residual = sumOverDomains(residual);
   residual = sqrt(residual / norm);
 
   /* Deallocate memory for residuals array */
@@ -607,9 +1087,9 @@ double CPUSolver::computeResidual(residualType res_type) {
  */
 void CPUSolver::computeKeff() {
 
-  FP_PRECISION fission;
-  FP_PRECISION* FSR_rates = new FP_PRECISION[_num_FSRs];
-  FP_PRECISION* group_rates = new FP_PRECISION[_num_threads * _num_groups];
+  ACC_PRECISION fission;
+  ACC_PRECISION* FSR_rates = new ACC_PRECISION[_num_FSRs];
+  ACC_PRECISION* group_rates = new ACC_PRECISION[_num_threads * _num_groups];
 
   /* Compute the old nu-fission rates in each FSR */
 #pragma omp parallel
@@ -630,13 +1110,14 @@ void CPUSolver::computeKeff() {
       for (int e=0; e < _num_groups; e++)
         group_rates[tid+e] = sigma[e] * _scalar_flux(r,e);
 
-      FSR_rates[r]=pairwise_sum<FP_PRECISION>(&group_rates[tid], _num_groups);
+      FSR_rates[r]=pairwise_sum<ACC_PRECISION>(&group_rates[tid], _num_groups);
       FSR_rates[r] *= volume;
     }
   }
 
-  /* Reduce new fission rates across FSRs */
-  fission = pairwise_sum<FP_PRECISION>(FSR_rates, _num_FSRs);
+  /* Reduce new fission rates across FSRs and domains */
+  fission = pairwise_sum<ACC_PRECISION>(FSR_rates, _num_FSRs);
+  fission = sumOverDomains(fission);
 
   _k_eff *= fission;
 
@@ -665,6 +1146,12 @@ void CPUSolver::transportSweep() {
   if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
     _cmfd->zeroCurrents();
 
+  if (_cumulative_segments == NULL)
+    initializeTrackSchedule();
+
+  /* Tally the CMFD surface currents at the CMFD crossings of each Track */
+  bool tally_currents = _cmfd != NULL && _cmfd->isFluxUpdateOn();
+
   /* Loop over the parallel track groups */
   for (int i=0; i < _num_parallel_track_groups; i++) {
 
@@ -673,61 +1160,267 @@ void CPUSolver::transportSweep() {
     min_track = max_track;
     max_track += _track_generator->getNumTracksByParallelGroup(i);
 
+    /* Divide the threads among blocks of energy groups */
+    if (_num_group_blocks > 1) {
+      sweepGroupBlocks(min_track, max_track, tally_currents);
+      continue;
+    }
+
 #pragma omp parallel
     {
 
       int tid = omp_get_thread_num();
-      int azim_index, num_segments;
+      int first_track, last_track;
+      int azim_index, num_segments, num_crossings;
       Track* curr_track;
+      Track* segmented_track;
       segment* curr_segment;
       segment* segments;
+      cmfd_crossing* crossings;
       FP_PRECISION* track_flux;
 
+      /* Scratch Track for the segments if they are traced on-the-fly */
+      Track scratch;
+
       /* Use local array accumulator to prevent false sharing */
       FP_PRECISION thread_fsr_flux[_num_groups];
 
-      /* Loop over each thread within this azimuthal angle halfspace */
-#pragma omp for schedule(guided)
-      for (int track_id=min_track; track_id < max_track; track_id++) {
+      /* Local buffer for the decompressed Track angular fluxes */
+      FP_PRECISION thread_track_flux[2 * _polar_times_groups];
+
+      /* Loop over this thread's Tracks within this parallel group */
+      getThreadTracks(min_track, max_track, &first_track, &last_track);
+
+      for (int track_id=first_track; track_id < last_track; track_id++) {
 
         /* Initialize local pointers to important data structures */
         curr_track = _tracks[track_id];
+        segmented_track = _track_generator->getSegmentedTrack(curr_track,
+                                                              &scratch);
         azim_index = curr_track->getAzimAngleIndex();
-        num_segments = curr_track->getNumSegments();
-        segments = curr_track->getSegments();
-        track_flux = &_boundary_flux(track_id,0,0,0);
+        num_segments = segmented_track->getNumSegments();
+        segments = segmented_track->getSegments();
+        crossings = segmented_track->getCmfdCrossings();
+        num_crossings = tally_currents ?
+            segmented_track->getNumCmfdCrossings() : 0;
+
+        /* Use the boundary fluxes in place or decompress them */
+        if (_boundary_flux != NULL)
+          track_flux = &_boundary_flux(track_id,0,0,0);
+        else {
+          track_flux = thread_track_flux;
+          loadBoundaryFlux(track_id, 0, track_flux);
+        }
 
         /* Loop over each Track segment in forward direction */
-        for (int s=0; s < num_segments; s++) {
+        for (int s=0, c=0; s < num_segments; s++) {
           curr_segment = &segments[s];
           tallyScalarFlux(curr_segment, azim_index, track_flux,
                           thread_fsr_flux);
-          tallyCurrent(curr_segment, azim_index, track_flux, true);
+
+          /* Tally the current if the segment ends on a CMFD surface */
+          if (c < num_crossings && crossings[c]._segment == s) {
+            tallyCurrent(crossings[c]._surface_fwd, azim_index, track_flux);
+            c++;
+          }
         }
 
         /* Transfer boundary angular flux to outgoing Track */
-        transferBoundaryFlux(track_id, azim_index, true, track_flux);
+        transferBoundaryFlux(track_id, true, track_flux);
 
         /* Loop over each Track segment in reverse direction */
         track_flux += _polar_times_groups;
 
-        for (int s=num_segments-1; s > -1; s--) {
+        if (_boundary_flux == NULL)
+          loadBoundaryFlux(track_id, 1, track_flux);
+
+        for (int s=num_segments-1, c=num_crossings-1; s > -1; s--) {
           curr_segment = &segments[s];
           tallyScalarFlux(curr_segment, azim_index, track_flux,
                           thread_fsr_flux);
-          tallyCurrent(curr_segment, azim_index, track_flux, false);
+
+          /* Tally the current if the segment starts on a CMFD surface */
+          if (c >= 0 && crossings[c]._segment == s) {
+            tallyCurrent(crossings[c]._surface_bwd, azim_index, track_flux);
+            c--;
+          }
         }
 
         /* Transfer boundary angular flux to outgoing Track */
-        transferBoundaryFlux(track_id, azim_index, false, track_flux);
+        transferBoundaryFlux(track_id, false, track_flux);
       }
     }
   }
 
+  /* Reduce the thread private CMFD surface currents */
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
+    _cmfd->reduceCurrents();
+
+  /* Exchange the angular fluxes at the interfaces with the other domains */
+  exchangeInterfaceFluxes();
+
   return;
 }
 
 
+/**
+ * @brief Sweeps the Tracks of a parallel group with the OpenMP threads
+ *        divided among blocks of energy groups.
+ * @details Each thread is assigned to a block of energy groups and a range
+ *          of Tracks balanced among the threads of its block. The threads of
+ *          different blocks start at different Tracks of their ranges such
+ *          that they update different FSRs at the same time.
+ * @param min_track the ID of the first Track in the parallel group
+ * @param max_track one past the ID of the last Track in the parallel group
+ * @param tally_currents whether to tally the CMFD surface currents
+ */
+void CPUSolver::sweepGroupBlocks(int min_track, int max_track,
+                                 bool tally_currents) {
+
+  if (_boundary_flux == NULL)
+    log_printf(ERROR, "Unable to sweep %d energy group blocks with "
+               "compressed boundary angular fluxes", _num_group_blocks);
+
+#pragma omp parallel
+  {
+
+    int tid = omp_get_thread_num();
+    int num_threads = omp_get_num_threads();
+    int num_blocks = std::min(std::min(_num_group_blocks, _num_groups),
+                              num_threads);
+
+    /* Assign the threads to the energy group blocks in round robin order */
+    int block = tid % num_blocks;
+    int rank = tid / num_blocks;
+    int team_size = (num_threads - block + num_blocks - 1) / num_blocks;
+    int first_group = _num_groups * block / num_blocks;
+    int last_group = _num_groups * (block + 1) / num_blocks;
+
+    /* The FSR fluxes are only shared with the threads of the same block */
+    bool atomic = team_size > 1;
+
+    int first_track, last_track;
+    int azim_index, num_segments, num_crossings;
+    Track* curr_track;
+    Track* segmented_track;
+    segment* segments;
+    cmfd_crossing* crossings;
+    FP_PRECISION* track_flux;
+    FP_PRECISION* polar_weights;
+
+    /* Scratch Track for the segments if they are traced on-the-fly */
+    Track scratch;
+
+    /* Use local array accumulator to prevent false sharing */
+    FP_PRECISION thread_fsr_flux[_num_groups];
+
+    getThreadTracks(min_track, max_track, rank, team_size, &first_track,
+                    &last_track);
+    int num_tracks = last_track - first_track;
+    int offset = num_tracks * block / num_blocks;
+
+    /* Loop over this thread's Tracks within this parallel group */
+    for (int i=0; i < num_tracks; i++) {
+
+      int track_id = first_track + (i + offset) % num_tracks;
+
+      /* Initialize local pointers to important data structures */
+      curr_track = _tracks[track_id];
+      segmented_track = _track_generator->getSegmentedTrack(curr_track,
+                                                            &scratch);
+      azim_index = curr_track->getAzimAngleIndex();
+      num_segments = segmented_track->getNumSegments();
+      segments = segmented_track->getSegments();
+      crossings = segmented_track->getCmfdCrossings();
+      num_crossings = tally_currents ?
+          segmented_track->getNumCmfdCrossings() : 0;
+      track_flux = &_boundary_flux(track_id,0,0,0);
+      polar_weights = &_polar_weights(azim_index,0);
+
+      /* Loop over each Track segment in forward direction */
+      for (int s=0, c=0; s < num_segments; s++) {
+        tallyGroupBlockFlux(&segments[s], azim_index, track_flux,
+                            thread_fsr_flux, first_group, last_group, atomic);
+
+        /* Tally the current if the segment ends on a CMFD surface */
+        if (c < num_crossings && crossings[c]._segment == s) {
+          _cmfd->tallyCurrent(crossings[c]._surface_fwd, track_flux,
+                              polar_weights, first_group, last_group);
+          c++;
+        }
+      }
+
+      /* Transfer boundary angular flux to outgoing Track */
+      transferGroupBlockFlux(track_id, true, track_flux, first_group,
+                             last_group);
+
+      /* Loop over each Track segment in reverse direction */
+      track_flux += _polar_times_groups;
+
+      for (int s=num_segments-1, c=num_crossings-1; s > -1; s--) {
+        tallyGroupBlockFlux(&segments[s], azim_index, track_flux,
+                            thread_fsr_flux, first_group, last_group, atomic);
+
+        /* Tally the current if the segment starts on a CMFD surface */
+        if (c >= 0 && crossings[c]._segment == s) {
+          _cmfd->tallyCurrent(crossings[c]._surface_bwd, track_flux,
+                              polar_weights, first_group, last_group);
+          c--;
+        }
+      }
+
+      /* Transfer boundary angular flux to outgoing Track */
+      transferGroupBlockFlux(track_id, false, track_flux, first_group,
+                             last_group);
+    }
+  }
+}
+
+
+/**
+ * @brief Computes the contribution to the FSR scalar flux from a Track
+ *        segment for a block of energy groups.
+ * @param curr_segment a pointer to the Track segment of interest
+ * @param azim_index the azimuthal angle index for this segment
+ * @param track_flux a pointer to the Track's angular flux
+ * @param fsr_flux a pointer to the temporary FSR flux buffer
+ * @param first_group the first energy group of the block
+ * @param last_group one past the last energy group of the block
+ * @param atomic whether other threads may update the same FSR fluxes
+ */
+void CPUSolver::tallyGroupBlockFlux(segment* curr_segment, int azim_index,
+                                    FP_PRECISION* track_flux,
+                                    FP_PRECISION* fsr_flux, int first_group,
+                                    int last_group, bool atomic) {
+
+  int fsr_id = curr_segment->_region_id;
+  FP_PRECISION length = curr_segment->_length;
+  FP_PRECISION* sigma_t = _FSR_materials[fsr_id]->getSigmaT();
+  FP_PRECISION delta_psi, exponential;
+
+  /* Compute change in angular flux along segment in this FSR */
+  for (int e=first_group; e < last_group; e++) {
+    fsr_flux[e] = 0.;
+    for (int p=0; p < _num_polar; p++) {
+      exponential = _exp_evaluator->computeExponential(sigma_t[e] * length, p);
+      delta_psi = (track_flux(p,e)-_reduced_sources(fsr_id,e)) * exponential;
+      fsr_flux[e] += delta_psi * _polar_weights(azim_index,p);
+      track_flux(p,e) -= delta_psi;
+    }
+  }
+
+  /* Increment the FSR scalar flux from the temporary array */
+  if (atomic)
+    omp_set_lock(&_FSR_locks[fsr_id]);
+
+  for (int e=first_group; e < last_group; e++)
+    _scalar_flux(fsr_id,e) += fsr_flux[e];
+
+  if (atomic)
+    omp_unset_lock(&_FSR_locks[fsr_id]);
+}
+
+
 /**
  * @brief Computes the contribution to the FSR scalar flux from a Track segment.
  * @details This method integrates the angular flux for a Track segment across
@@ -745,7 +1438,7 @@ void CPUSolver::tallyScalarFlux(segment* curr_segment, int azim_index,
 
   int fsr_id = curr_segment->_region_id;
   FP_PRECISION length = curr_segment->_length;
-  FP_PRECISION* sigma_t = curr_segment->_material->getSigmaT();
+  FP_PRECISION* sigma_t = _FSR_materials[fsr_id]->getSigmaT();
   FP_PRECISION delta_psi, exponential;
 
   /* Set the FSR scalar flux buffer to zero */
@@ -772,20 +1465,15 @@ void CPUSolver::tallyScalarFlux(segment* curr_segment, int azim_index,
 
 
 /**
- * @brief Tallies the current contribution from this segment across the
- *        the appropriate CMFD mesh cell surface.
- * @param curr_segment a pointer to the Track segment of interest
- * @param azim_index the azimuthal index for this segmenbt
+ * @brief Tallies the current contribution from a segment across a CMFD mesh
+ *        cell surface.
+ * @param surface the CMFD mesh surface crossed by the segment (or -1)
+ * @param azim_index the azimuthal index for this segment
  * @param track_flux a pointer to the Track's angular flux
- * @param fwd boolean indicating direction of integration along segment
  */
-void CPUSolver::tallyCurrent(segment* curr_segment, int azim_index,
-                             FP_PRECISION* track_flux, bool fwd) {
-
-  /* Tally surface currents if CMFD is in use */
-  if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
-    _cmfd->tallyCurrent(curr_segment, track_flux,
-                        &_polar_weights(azim_index,0), fwd);
+void CPUSolver::tallyCurrent(int surface, int azim_index,
+                             FP_PRECISION* track_flux) {
+  _cmfd->tallyCurrent(surface, track_flux, &_polar_weights(azim_index,0));
 }
 
 
@@ -796,33 +1484,46 @@ void CPUSolver::tallyCurrent(segment* curr_segment, int azim_index,
  *          or periodic Track. For vacuum boundary conditions, the outgoing flux
  *          is tallied as leakage.
  * @param track_id the ID number for the Track of interest
- * @param azim_index a pointer to the azimuthal angle index for this segment
  * @param direction the Track direction (forward - true, reverse - false)
  * @param track_flux a pointer to the Track's outgoing angular flux
  */
 void CPUSolver::transferBoundaryFlux(int track_id,
-                                     int azim_index,
                                      bool direction,
                                      FP_PRECISION* track_flux) {
+  int direction_out;
   int start;
   bool transfer_flux;
   int track_out_id;
 
   /* For the "forward" direction */
   if (direction) {
-    start = _tracks[track_id]->isNextOut() * _polar_times_groups;
+    direction_out = _tracks[track_id]->isNextOut();
     transfer_flux = _tracks[track_id]->getTransferFluxOut();
     track_out_id = _tracks[track_id]->getTrackOut()->getUid();
   }
 
   /* For the "reverse" direction */
   else {
-    start = _tracks[track_id]->isNextIn() * _polar_times_groups;
+    direction_out = _tracks[track_id]->isNextIn();
     transfer_flux = _tracks[track_id]->getTransferFluxIn();
     track_out_id = _tracks[track_id]->getTrackIn()->getUid();
   }
 
-  FP_PRECISION* track_out_flux = &_boundary_flux(track_out_id,0,0,start);
+  /* Send the outgoing flux to the neighboring domain across an interface */
+  FP_PRECISION* track_out_flux = getInterfaceFlux(track_id, direction);
+
+  if (track_out_flux == NULL) {
+
+    /* Compress the outgoing angular fluxes */
+    if (_boundary_flux == NULL) {
+      storeBoundaryFlux(track_out_id, direction_out, track_flux,
+                        transfer_flux);
+      return;
+    }
+
+    start = direction_out * _polar_times_groups;
+    track_out_flux = &_boundary_flux(track_out_id,0,0,start);
+  }
 
   /* Loop over polar angles and energy groups */
   for (int e=0; e < _num_groups; e++) {
@@ -832,6 +1533,448 @@ void CPUSolver::transferBoundaryFlux(int track_id,
 }
 
 
+/**
+ * @brief Updates the boundary flux for a Track given boundary conditions
+ *        for a block of energy groups.
+ * @param track_id the ID number for the Track of interest
+ * @param direction the Track direction (forward - true, reverse - false)
+ * @param track_flux a pointer to the Track's outgoing angular flux
+ * @param first_group the first energy group of the block
+ * @param last_group one past the last energy group of the block
+ */
+void CPUSolver::transferGroupBlockFlux(int track_id, bool direction,
+                                       FP_PRECISION* track_flux,
+                                       int first_group, int last_group) {
+  int direction_out;
+  bool transfer_flux;
+  int track_out_id;
+
+  /* For the "forward" direction */
+  if (direction) {
+    direction_out = _tracks[track_id]->isNextOut();
+    transfer_flux = _tracks[track_id]->getTransferFluxOut();
+    track_out_id = _tracks[track_id]->getTrackOut()->getUid();
+  }
+
+  /* For the "reverse" direction */
+  else {
+    direction_out = _tracks[track_id]->isNextIn();
+    transfer_flux = _tracks[track_id]->getTransferFluxIn();
+    track_out_id = _tracks[track_id]->getTrackIn()->getUid();
+  }
+
+  /* Send the outgoing flux to the neighboring domain across an interface */
+  FP_PRECISION* track_out_flux = getInterfaceFlux(track_id, direction);
+
+  if (track_out_flux == NULL) {
+    int start = direction_out * _polar_times_groups;
+    track_out_flux = &_boundary_flux(track_out_id,0,0,start);
+  }
+
+  /* Loop over polar angles and the block's energy groups */
+  for (int e=first_group; e < last_group; e++) {
+    for (int p=0; p < _num_polar; p++)
+      track_out_flux(p,e) = track_flux(p,e) * transfer_flux;
+  }
+}
+
+
+/**
+ * @brief Decompresses the boundary angular fluxes for a Track direction.
+ * @param track_id the ID number for the Track of interest
+ * @param direction the Track direction (forward - 0, reverse - 1)
+ * @param track_flux a pointer to the buffer for the Track's angular flux
+ */
+void CPUSolver::loadBoundaryFlux(int track_id, int direction,
+                                 FP_PRECISION* track_flux) {
+
+  int index = 2 * track_id + direction;
+  uint16_t* compressed_flux = &_compressed_flux[index * _polar_times_groups];
+  FP_PRECISION scale = _compressed_flux_scales[index];
+
+  if (_boundary_flux_storage == BOUNDARY_FLUX_HALF) {
+    for (int i=0; i < _polar_times_groups; i++)
+      track_flux[i] = half_to_float(compressed_flux[i]) * scale;
+  }
+  else {
+    scale /= 32767;
+    for (int i=0; i < _polar_times_groups; i++)
+      track_flux[i] = (int16_t)compressed_flux[i] * scale;
+  }
+}
+
+
+/**
+ * @brief Compresses the boundary angular fluxes for a Track direction.
+ * @details The angular fluxes are scaled by the largest angular flux
+ *          magnitude for the Track direction before they are converted to
+ *          half precision or 16-bit integers.
+ * @param track_id the ID number for the Track of interest
+ * @param direction the Track direction (forward - 0, reverse - 1)
+ * @param track_flux a pointer to the Track's angular flux
+ * @param weight a factor multiplying the Track's angular flux
+ */
+void CPUSolver::storeBoundaryFlux(int track_id, int direction,
+                                  FP_PRECISION* track_flux,
+                                  FP_PRECISION weight) {
+
+  int index = 2 * track_id + direction;
+  uint16_t* compressed_flux = &_compressed_flux[index * _polar_times_groups];
+  FP_PRECISION max_flux = 0.;
+
+  for (int i=0; i < _polar_times_groups; i++)
+    max_flux = std::max(max_flux, FP_PRECISION(fabs(track_flux[i])));
+
+  max_flux *= weight;
+  _compressed_flux_scales[index] = max_flux;
+
+  /* Store zeros if the angular fluxes vanish (ie, vacuum boundaries) */
+  if (max_flux == 0.) {
+    memset(compressed_flux, 0, _polar_times_groups * sizeof(uint16_t));
+    return;
+  }
+
+  FP_PRECISION inverse_scale = weight / max_flux;
+
+  if (_boundary_flux_storage == BOUNDARY_FLUX_HALF) {
+    for (int i=0; i < _polar_times_groups; i++)
+      compressed_flux[i] = float_to_half(track_flux[i] * inverse_scale);
+  }
+  else {
+    inverse_scale *= 32767;
+    for (int i=0; i < _polar_times_groups; i++)
+      compressed_flux[i] =
+        (uint16_t)(int16_t)floor(track_flux[i] * inverse_scale + 0.5);
+  }
+}
+
+
+/**
+ * @brief Updates the Track boundary angular fluxes with the ratios of the
+ *        new to old CMFD fluxes following a CMFD solve.
+ * @details Compressed boundary angular fluxes are decompressed for each
+ *          Track, updated by the Cmfd and compressed again.
+ */
+void CPUSolver::updateCmfdBoundaryFlux() {
+
+  if (_boundary_flux != NULL) {
+    Solver::updateCmfdBoundaryFlux();
+    return;
+  }
+
+#pragma omp parallel
+  {
+    FP_PRECISION track_flux[2 * _polar_times_groups];
+
+#pragma omp for schedule(guided)
+    for (int t=0; t < _tot_num_tracks; t++) {
+      loadBoundaryFlux(t, 0, track_flux);
+      loadBoundaryFlux(t, 1, &track_flux[_polar_times_groups]);
+      _cmfd->updateBoundaryFlux(t, track_flux,
+                                &track_flux[_polar_times_groups]);
+      storeBoundaryFlux(t, 0, track_flux, 1.);
+      storeBoundaryFlux(t, 1, &track_flux[_polar_times_groups], 1.);
+    }
+  }
+}
+
+
+/**
+ * @brief Applies Anderson acceleration to the fluxes following a transport
+ *        sweep.
+ * @details The state of the source iteration, \f$ x_k \f$, holds the scalar
+ *          flux, the Track boundary angular fluxes and the eigenvalue used
+ *          by a transport sweep. The state following the transport sweep,
+ *          \f$ g_k = G(x_k) \f$, is replaced by the extrapolation
+ *          \f$ x_{k+1} = g_k - \Delta G \gamma \f$, where the columns of
+ *          \f$ \Delta G \f$ and \f$ \Delta F \f$ are the differences
+ *          between successive swept states and their residuals
+ *          \f$ f_k = g_k - x_k \f$ for up to the Anderson depth previous
+ *          iterations, and \f$ \gamma \f$ minimizes
+ *          \f$ || f_k - \Delta F \gamma ||_2 \f$. The eigenvalue residuals
+ *          are weighted by the norm of the scalar flux. Each component of
+ *          the state must enter the residual, since otherwise the
+ *          extrapolation may stagnate at a state which is not a solution,
+ *          such as one in which the extrapolated boundary fluxes act as
+ *          albedos other than unity for reflective boundaries.
+ *
+ *          The boundary fluxes input to a transport sweep are the
+ *          extrapolated boundary fluxes from the previous iteration, scaled
+ *          by the normalization of the scalar flux in eigenvalue
+ *          calculations. The acceleration is safeguarded by restarting from
+ *          the unaccelerated state whenever the relative residual of the
+ *          scalar flux grows, and by keeping the unaccelerated fluxes wherever
+ *          the extrapolated fluxes are negative.
+ * @param old_k_eff the eigenvalue used in the source of the transport sweep
+ */
+void CPUSolver::mixFluxes(ACC_PRECISION old_k_eff) {
+
+  if (_communicator != NULL)
+    log_printf(ERROR, "Unable to use Anderson acceleration for a domain of "
+               "a decomposed Geometry");
+
+  if (_boundary_flux == NULL)
+    log_printf(ERROR, "Unable to use Anderson acceleration with compressed "
+               "boundary angular fluxes");
+
+  int size = _num_FSRs * _num_groups;
+  long boundary_size = 2 * long(_tot_num_tracks) * _polar_times_groups;
+  int depth = _anderson_depth;
+
+  /* Allocate the history at the start of each calculation */
+  if (_num_iterations == 0) {
+
+    if (_anderson_fluxes != NULL) {
+      delete [] _anderson_fluxes;
+      delete [] _anderson_residuals;
+      delete [] _anderson_last_flux;
+      delete [] _anderson_last_residual;
+      delete [] _anderson_boundary_fluxes;
+      delete [] _anderson_boundary_residuals;
+      delete [] _anderson_last_boundary_flux;
+      delete [] _anderson_last_boundary_residual;
+      delete [] _anderson_mixed_boundary_flux;
+      delete [] _anderson_k_effs;
+      delete [] _anderson_k_residuals;
+    }
+
+    _anderson_fluxes = new ACC_PRECISION[depth * size];
+    _anderson_residuals = new ACC_PRECISION[depth * size];
+    _anderson_last_flux = new ACC_PRECISION[size];
+    _anderson_last_residual = new ACC_PRECISION[size];
+    _anderson_boundary_fluxes = new FP_PRECISION[depth * boundary_size];
+    _anderson_boundary_residuals = new FP_PRECISION[depth * boundary_size];
+    _anderson_last_boundary_flux = new FP_PRECISION[boundary_size];
+    _anderson_last_boundary_residual = new FP_PRECISION[boundary_size];
+    _anderson_mixed_boundary_flux = new FP_PRECISION[boundary_size];
+    _anderson_k_effs = new double[depth];
+    _anderson_k_residuals = new double[depth];
+    _anderson_num_stored = 0;
+    _anderson_index = 0;
+  }
+
+  /* Compute the relative residual and the scale of the input flux */
+  double residual_norm = 0.;
+  double flux_norm = 0.;
+  double flux_sum = 0.;
+
+#pragma omp parallel for reduction(+:residual_norm,flux_norm,flux_sum)
+  for (int i=0; i < size; i++) {
+    double residual = _scalar_flux[i] - _old_scalar_flux[i];
+    residual_norm += residual * residual;
+    flux_norm += double(_old_scalar_flux[i]) * _old_scalar_flux[i];
+    flux_sum += _old_scalar_flux[i];
+  }
+
+  residual_norm = sqrt(residual_norm / flux_norm);
+  double k_residual = _k_eff - old_k_eff;
+
+  /* Compute the boundary flux residuals from the last extrapolation, which
+   * has since been normalized along with the scalar flux */
+  FP_PRECISION* boundary_residual = _anderson_mixed_boundary_flux;
+
+  if (_num_iterations > 0) {
+    FP_PRECISION scale = flux_sum / _anderson_last_sum;
+
+#pragma omp parallel for
+    for (long i=0; i < boundary_size; i++)
+      boundary_residual[i] = _boundary_flux[i] -
+        scale * _anderson_mixed_boundary_flux[i];
+  }
+
+  /* Store the differences from the last iteration unless restarting */
+  if (_num_iterations > 1 && residual_norm < _anderson_last_norm) {
+
+    ACC_PRECISION* delta_flux = &_anderson_fluxes[_anderson_index * size];
+    ACC_PRECISION* delta_residual =
+      &_anderson_residuals[_anderson_index * size];
+    FP_PRECISION* delta_boundary =
+      &_anderson_boundary_fluxes[_anderson_index * boundary_size];
+    FP_PRECISION* delta_boundary_residual =
+      &_anderson_boundary_residuals[_anderson_index * boundary_size];
+
+#pragma omp parallel for
+    for (int i=0; i < size; i++) {
+      ACC_PRECISION residual = _scalar_flux[i] - _old_scalar_flux[i];
+      delta_flux[i] = _scalar_flux[i] - _anderson_last_flux[i];
+      delta_residual[i] = residual - _anderson_last_residual[i];
+    }
+
+#pragma omp parallel for
+    for (long i=0; i < boundary_size; i++) {
+      delta_boundary[i] = _boundary_flux[i] - _anderson_last_boundary_flux[i];
+      delta_boundary_residual[i] = boundary_residual[i] -
+        _anderson_last_boundary_residual[i];
+    }
+
+    _anderson_k_effs[_anderson_index] = _k_eff - _anderson_last_k_eff;
+    _anderson_k_residuals[_anderson_index] = k_residual -
+      _anderson_last_k_residual;
+
+    _anderson_index = (_anderson_index + 1) % depth;
+    _anderson_num_stored = std::min(_anderson_num_stored + 1, depth);
+  }
+  else {
+    _anderson_num_stored = 0;
+    _anderson_index = 0;
+  }
+
+  _anderson_last_norm = residual_norm;
+
+#pragma omp parallel for
+  for (int i=0; i < size; i++) {
+    _anderson_last_residual[i] = _scalar_flux[i] - _old_scalar_flux[i];
+    _anderson_last_flux[i] = _scalar_flux[i];
+  }
+
+#pragma omp parallel for
+  for (long i=0; i < boundary_size; i++)
+    _anderson_last_boundary_flux[i] = _boundary_flux[i];
+
+  std::swap(_anderson_last_boundary_residual, _anderson_mixed_boundary_flux);
+  _anderson_last_k_eff = _k_eff;
+  _anderson_last_k_residual = k_residual;
+
+  int m = _anderson_num_stored;
+  boundary_residual = _anderson_last_boundary_residual;
+
+  /* Form the normal equations for the least squares coefficients */
+  double* normal = new double[m * (m + 1)];
+  std::fill_n(normal, m * (m + 1), 0.);
+
+  if (m > 0) {
+#pragma omp parallel
+    {
+      double* thread_normal = new double[m * (m + 1)];
+      std::fill_n(thread_normal, m * (m + 1), 0.);
+
+#pragma omp for schedule(static) nowait
+      for (int i=0; i < size; i++) {
+        for (int j=0; j < m; j++) {
+          double f_j = _anderson_residuals[j * size + i];
+          for (int k=0; k <= j; k++)
+            thread_normal[j * (m + 1) + k] +=
+              f_j * _anderson_residuals[k * size + i];
+          thread_normal[j * (m + 1) + m] += f_j * _anderson_last_residual[i];
+        }
+      }
+
+#pragma omp for schedule(static)
+      for (long i=0; i < boundary_size; i++) {
+        for (int j=0; j < m; j++) {
+          double f_j = _anderson_boundary_residuals[j * boundary_size + i];
+          for (int k=0; k <= j; k++)
+            thread_normal[j * (m + 1) + k] +=
+              f_j * _anderson_boundary_residuals[k * boundary_size + i];
+          thread_normal[j * (m + 1) + m] += f_j * boundary_residual[i];
+        }
+      }
+
+#pragma omp critical
+      {
+        for (int j=0; j < m * (m + 1); j++)
+          normal[j] += thread_normal[j];
+      }
+
+      delete [] thread_normal;
+    }
+
+    /* Weight the eigenvalue residuals by the norm of the scalar flux */
+    for (int j=0; j < m; j++) {
+      double f_j = _anderson_k_residuals[j] * flux_norm;
+      for (int k=0; k <= j; k++)
+        normal[j * (m + 1) + k] += f_j * _anderson_k_residuals[k];
+      normal[j * (m + 1) + m] += f_j * k_residual;
+    }
+  }
+
+  /* Solve the normal equations with Gaussian elimination */
+  bool singular = (m == 0);
+  double max_diag = 0.;
+
+  for (int j=0; j < m; j++) {
+    for (int k=j+1; k < m; k++)
+      normal[j * (m + 1) + k] = normal[k * (m + 1) + j];
+    max_diag = std::max(max_diag, normal[j * (m + 1) + j]);
+  }
+
+  for (int j=0; j < m && !singular; j++) {
+
+    int pivot = j;
+    for (int k=j+1; k < m; k++) {
+      if (fabs(normal[k * (m + 1) + j]) > fabs(normal[pivot * (m + 1) + j]))
+        pivot = k;
+    }
+
+    if (fabs(normal[pivot * (m + 1) + j]) <= 1E-14 * max_diag) {
+      singular = true;
+      break;
+    }
+
+    for (int k=0; k <= m; k++)
+      std::swap(normal[j * (m + 1) + k], normal[pivot * (m + 1) + k]);
+
+    for (int k=j+1; k < m; k++) {
+      double factor = normal[k * (m + 1) + j] / normal[j * (m + 1) + j];
+      for (int l=j; l <= m; l++)
+        normal[k * (m + 1) + l] -= factor * normal[j * (m + 1) + l];
+    }
+  }
+
+  double gamma[depth];
+  for (int j=m-1; j >= 0 && !singular; j--) {
+    gamma[j] = normal[j * (m + 1) + m];
+    for (int k=j+1; k < m; k++)
+      gamma[j] -= normal[j * (m + 1) + k] * gamma[k];
+    gamma[j] /= normal[j * (m + 1) + j];
+  }
+
+  delete [] normal;
+
+  /* Extrapolate the state, keeping the sweep fluxes where negative */
+  double mixed_sum = 0.;
+
+  if (singular) {
+#pragma omp parallel for reduction(+:mixed_sum)
+    for (int i=0; i < size; i++)
+      mixed_sum += _scalar_flux[i];
+  }
+  else {
+#pragma omp parallel for reduction(+:mixed_sum)
+    for (int i=0; i < size; i++) {
+      ACC_PRECISION flux = _scalar_flux[i];
+      for (int j=0; j < m; j++)
+        flux -= gamma[j] * _anderson_fluxes[j * size + i];
+      if (flux >= 0.)
+        _scalar_flux[i] = flux;
+      mixed_sum += _scalar_flux[i];
+    }
+
+#pragma omp parallel for
+    for (long i=0; i < boundary_size; i++) {
+      FP_PRECISION flux = _boundary_flux[i];
+      for (int j=0; j < m; j++)
+        flux -= gamma[j] * _anderson_boundary_fluxes[j * boundary_size + i];
+      if (flux >= 0.)
+        _boundary_flux[i] = flux;
+    }
+
+    double k_eff = _k_eff;
+    for (int j=0; j < m; j++)
+      k_eff -= gamma[j] * _anderson_k_effs[j];
+    if (k_eff > 0.)
+      _k_eff = k_eff;
+  }
+
+  /* Store the extrapolated boundary fluxes input to the next sweep */
+#pragma omp parallel for
+  for (long i=0; i < boundary_size; i++)
+    _anderson_mixed_boundary_flux[i] = _boundary_flux[i];
+
+  _anderson_last_sum = mixed_sum;
+}
+
+
 /**
  * @brief Add the source term contribution in the transport equation to
  *        the FSR scalar flux.
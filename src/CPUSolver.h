@@ -12,9 +12,12 @@
 #ifdef __cplusplus
 #define _USE_MATH_DEFINES
 #include "Solver.h"
+#include "Communicator.h"
+#include "half_precision.h"
 #include <math.h>
 #include <omp.h>
 #include <stdlib.h>
+#include <algorithm>
 #endif
 
 
@@ -29,6 +32,25 @@
 #define track_out_flux(p,e) (track_out_flux[(p)*_num_groups + (e)])
 
 
+/**
+ * @enum boundaryFluxStorage
+ * @brief The formats used to store the Track boundary angular fluxes.
+ */
+enum boundaryFluxStorage {
+
+  /** Boundary angular fluxes stored in FP_PRECISION */
+  BOUNDARY_FLUX_FULL,
+
+  /** Half precision boundary angular fluxes scaled by the maximum angular
+   *  flux of each Track direction */
+  BOUNDARY_FLUX_HALF,
+
+  /** 16-bit integer boundary angular fluxes scaled by the maximum angular
+   *  flux of each Track direction */
+  BOUNDARY_FLUX_SCALED
+};
+
+
 /**
  * @class CPUSolver CPUSolver.h "src/CPUSolver.h"
  * @brief This a subclass of the Solver class for multi-core CPUs using
@@ -36,14 +58,121 @@
  */
 class CPUSolver : public Solver {
 
+  /** The KrylovSolver initializes the CPUSolver for its transport sweeps */
+  friend class KrylovSolver;
+
 protected:
 
   /** The number of shared memory OpenMP threads */
   int _num_threads;
 
+  /** The number of blocks of energy groups swept concurrently by the
+   *  threads in the transport sweep */
+  int _num_group_blocks;
+
   /** OpenMP mutual exclusion locks for atomic FSR scalar flux updates */
   omp_lock_t* _FSR_locks;
 
+  /** The format used to store the Track boundary angular fluxes */
+  boundaryFluxStorage _boundary_flux_storage;
+
+  /** The cumulative number of segments of the Tracks in the order of their
+   *  IDs, used to balance the Tracks swept by each thread */
+  long* _cumulative_segments;
+
+  /** The compressed 16-bit boundary angular fluxes for each Track direction,
+   *  polar angle and energy group (used in place of _boundary_flux) */
+  uint16_t* _compressed_flux;
+
+  /** The scale of the compressed boundary angular fluxes for each Track
+   *  direction */
+  FP_PRECISION* _compressed_flux_scales;
+
+  /** The differences between successive scalar fluxes from transport sweeps
+   *  (G) and their residuals (F) stored for Anderson acceleration */
+  ACC_PRECISION* _anderson_fluxes;
+  ACC_PRECISION* _anderson_residuals;
+
+  /** The scalar flux from the last transport sweep and its residual */
+  ACC_PRECISION* _anderson_last_flux;
+  ACC_PRECISION* _anderson_last_residual;
+
+  /** The differences between successive boundary angular fluxes from
+   *  transport sweeps and their residuals */
+  FP_PRECISION* _anderson_boundary_fluxes;
+  FP_PRECISION* _anderson_boundary_residuals;
+
+  /** The boundary angular fluxes from the last sweep and their residual */
+  FP_PRECISION* _anderson_last_boundary_flux;
+  FP_PRECISION* _anderson_last_boundary_residual;
+
+  /** The extrapolated boundary angular fluxes from the last iteration */
+  FP_PRECISION* _anderson_mixed_boundary_flux;
+
+  /** The differences between successive eigenvalues and their residuals,
+   *  and the eigenvalue from the last iteration and its residual */
+  double* _anderson_k_effs;
+  double* _anderson_k_residuals;
+  double _anderson_last_k_eff;
+  double _anderson_last_k_residual;
+
+  /** The number of stored differences and the index of the next one */
+  int _anderson_num_stored;
+  int _anderson_index;
+
+  /** The relative residual and total scalar flux of the last iteration */
+  double _anderson_last_norm;
+  double _anderson_last_sum;
+
+  /** The Communicator with the Solvers of the other domains of a decomposed
+   *  Geometry (NULL if the Geometry is not decomposed) */
+  Communicator* _communicator;
+
+  /** The number of neighboring domains across the domain interfaces */
+  int _num_neighbors;
+
+  /** The Communicator ranks of the neighboring domains */
+  int _neighbor_ranks[NUM_FACES];
+
+  /** The offsets of the angular fluxes sent to and received from each
+   *  neighboring domain in the send and receive buffers */
+  int _send_offsets[NUM_FACES+1];
+  int _recv_offsets[NUM_FACES+1];
+
+  /** The index in the send buffer of the outgoing angular flux of each Track
+   *  direction leaving through a domain interface, or -1 */
+  int* _interface_index;
+
+  /** The Track direction (2 * Track ID + direction) of each incoming angular
+   *  flux in the receive buffer */
+  int* _interface_fluxes_in;
+
+  /** The buffers of angular fluxes sent to and received from the
+   *  neighboring domains after each transport sweep */
+  FP_PRECISION* _send_flux;
+  FP_PRECISION* _recv_flux;
+
+  bool initializeSolver(solverMode mode);
+  void initializeTrackSchedule();
+  void getThreadTracks(int min_track, int max_track, int* first_track,
+                       int* last_track);
+  void getThreadTracks(int min_track, int max_track, int rank, int team_size,
+                       int* first_track, int* last_track);
+  void sweepGroupBlocks(int min_track, int max_track, bool tally_currents);
+  void tallyGroupBlockFlux(segment* curr_segment, int azim_index,
+                           FP_PRECISION* track_flux, FP_PRECISION* fsr_flux,
+                           int first_group, int last_group, bool atomic);
+  void transferGroupBlockFlux(int track_id, bool direction,
+                              FP_PRECISION* track_flux, int first_group,
+                              int last_group);
+  void loadBoundaryFlux(int track_id, int direction, FP_PRECISION* track_flux);
+  void storeBoundaryFlux(int track_id, int direction, FP_PRECISION* track_flux,
+                         FP_PRECISION weight);
+  void initializeInterfaces();
+  FP_PRECISION* getInterfaceFlux(int track_id, bool direction);
+  void exchangeInterfaceFluxes();
+  double sumOverDomains(double value);
+
   /**
    * @brief Computes the contribution to the FSR flux from a Track segment.
    * @param curr_segment a pointer to the Track segment of interest
@@ -56,32 +185,36 @@ protected:
 
   /**
    * @brief Computes the contribution to surface current from a segment.
-   * @param curr_segment a pointer to the Track segment of interest
+   * @param surface the CMFD mesh surface crossed by the segment (or -1)
    * @param azim_index a pointer to the azimuthal angle index for this segment
    * @param track_flux a pointer to the Track's angular flux
-   * @param fwd the direction of integration along the segment
    */
-  virtual void tallyCurrent(segment* curr_segment, int azim_index,
-                            FP_PRECISION* track_flux, bool fwd);
+  virtual void tallyCurrent(int surface, int azim_index,
+                            FP_PRECISION* track_flux);
 
   /**
    * @brief Updates the boundary flux for a Track given boundary conditions.
    * @param track_id the ID number for the Track of interest
-   * @param azim_index a pointer to the azimuthal angle index for this segment
    * @param direction the Track direction (forward - true, reverse - false)
    * @param track_flux a pointer to the Track's outgoing angular flux
    */
-  virtual void transferBoundaryFlux(int track_id, int azim_index,
-                                    bool direction, FP_PRECISION* track_flux);
+  virtual void transferBoundaryFlux(int track_id, bool direction,
+                                    FP_PRECISION* track_flux);
 
 public:
   CPUSolver(TrackGenerator* track_generator=NULL);
   virtual ~CPUSolver();
 
   int getNumThreads();
+  int getNumGroupBlocks();
+  boundaryFluxStorage getBoundaryFluxStorage();
+  Communicator* getCommunicator();
   virtual void getFluxes(FP_PRECISION* out_fluxes, int num_fluxes);
 
   void setNumThreads(int num_threads);
+  void setNumGroupBlocks(int num_blocks);
+  void setBoundaryFluxStorage(boundaryFluxStorage storage);
+  void setCommunicator(Communicator* communicator);
   virtual void setFluxes(FP_PRECISION* in_fluxes, int num_fluxes);
 
   void initializeFluxArrays();
@@ -100,6 +233,8 @@ public:
   void addSourceToScalarFlux();
   void computeKeff();
   double computeResidual(residualType res_type);
+  void updateCmfdBoundaryFlux();
+  void mixFluxes(ACC_PRECISION old_k_eff);
 
   void computeFSRFissionRates(double* fission_rates, int num_FSRs);
 };
@@ -3,6 +3,8 @@
 
 int Cell::_n = 0;
 
+int Cell::_num_fill_changes = 0;
+
 static int auto_id = DEFAULT_INIT_ID;
 
 
@@ -81,6 +83,8 @@ Cell::Cell(int id, const char* name) {
   _num_rings = 0;
   _num_sectors = 0;
   _parent = NULL;
+  _surface_kernels = NULL;
+  _num_surface_kernels = 0;
 }
 
 
@@ -94,11 +98,25 @@ Cell::~Cell() {
     delete iter->second;
   _surfaces.clear();
 
+  if (_surface_kernels != NULL)
+    delete [] _surface_kernels;
+
   if (_name != NULL)
     delete [] _name;
 }
 
 
+/**
+ * @brief Returns the number of times the fill of any Cell has been set.
+ * @details This counter allows the Solver to only look for FSRs filled with
+ *          another Material once a Cell fill has changed.
+ * @return the number of Cell fill changes
+ */
+int Cell::getNumFillChanges() {
+  return _num_fill_changes;
+}
+
+
 /**
  * @brief Return the Cell's unique ID.
  * @return the Cell's unique ID
@@ -770,6 +788,7 @@ void Cell::setName(const char* name) {
 void Cell::setFill(Material* fill) {
   _cell_type = MATERIAL;
   _fill = fill;
+  _num_fill_changes++;
 }
 
 
@@ -780,6 +799,7 @@ void Cell::setFill(Material* fill) {
 void Cell::setFill(Universe* fill) {
   _cell_type = FILL;
   _fill = fill;
+  _num_fill_changes++;
 }
 
 
@@ -973,6 +993,7 @@ void Cell::addSurface(int halfspace, Surface* surface) {
   new_surf_half->_halfspace = halfspace;
 
   _surfaces[surface->getId()] = new_surf_half;
+  buildSurfaceKernels();
 }
 
 
@@ -985,10 +1006,37 @@ void Cell::removeSurface(Surface* surface) {
   if (_surfaces.find(surface->getId()) != _surfaces.end()) {
     delete _surfaces[surface->getId()];
     _surfaces.erase(surface->getId());
+    buildSurfaceKernels();
   }
 }
 
 
+/**
+ * @brief Rebuilds the array of surface kernels for the bounding Surfaces.
+ * @details The surface kernels are a flat copy of the type and coefficients
+ *          of each bounding Surface used by Cell::containsPoint(...) and
+ *          Cell::minSurfaceDist(...) during ray tracing. They are rebuilt
+ *          each time a Surface is added or removed, and by
+ *          Geometry::initializeFSRs() in case a Surface was modified after
+ *          it was added to this Cell.
+ */
+void Cell::buildSurfaceKernels() {
+
+  if (_surface_kernels != NULL)
+    delete [] _surface_kernels;
+
+  _num_surface_kernels = _surfaces.size();
+  _surface_kernels = new surface_kernel[_num_surface_kernels];
+
+  std::map<int, surface_halfspace*>::iterator iter;
+  int i = 0;
+
+  for (iter = _surfaces.begin(); iter != _surfaces.end(); ++iter, ++i)
+    fillSurfaceKernel(&_surface_kernels[i], iter->second->_surface,
+                      iter->second->_halfspace);
+}
+
+
 /**
  * @brief Add a neighboring Cell to this Cell's collection of neighbors.
  * @param cell a pointer to the neighboring Cell
@@ -1010,13 +1058,13 @@ void Cell::addNeighborCell(Cell* cell) {
  */
 bool Cell::containsPoint(Point* point) {
 
-  /* Loop over all Surfaces inside the Cell */
-  std::map<int, surface_halfspace*>::iterator iter;
+  const surface_kernel* kernels = _surface_kernels;
 
-  for (iter = _surfaces.begin(); iter != _surfaces.end(); ++iter) {
+  /* Loop over all Surfaces inside the Cell */
+  for (int s=0; s < _num_surface_kernels; s++) {
 
     /* Return false if the Point is not in the correct Surface halfspace */
-    if (iter->second->_surface->evaluate(point) * iter->second->_halfspace
+    if (evaluateSurfaceKernel(&kernels[s], point) * kernels[s]._halfspace
         < 0.0)
       return false;
   }
@@ -1050,13 +1098,20 @@ double Cell::minSurfaceDist(LocalCoords* coords) {
   double curr_dist;
   double min_dist = INFINITY;
 
-  std::map<int, surface_halfspace*>::iterator iter;
+  /* Compute the direction cosines once for all of the Cell's Surfaces */
+  Point* point = coords->getPoint();
+  double phi = coords->getPhi();
+  double cos_phi = cos(phi);
+  double sin_phi = sin(phi);
+
+  const surface_kernel* kernels = _surface_kernels;
 
   /* Loop over all of the Cell's Surfaces */
-  for (iter = _surfaces.begin(); iter != _surfaces.end(); ++iter) {
+  for (int s=0; s < _num_surface_kernels; s++) {
 
     /* Find the minimum distance from this surface to this Point */
-    curr_dist = iter->second->_surface->getMinDistance(coords);
+    curr_dist = surfaceKernelDistance(&kernels[s], point, phi, cos_phi,
+                                      sin_phi);
 
     /* If the distance to Cell is less than current min distance, update */
     if (curr_dist < min_dist)
@@ -1184,15 +1239,20 @@ void Cell::sectorize(std::vector<Cell*>& subcells) {
 
 
 /**
- * @brief Subdivides the Cell into clones for fuel pin rings.
- * @param subcells an empty vector to store all subcells
+ * @brief Computes the radii of the ZCylinders which subdivide the Cell into
+ *        rings.
+ * @details If the Cell is bounded by an outer ZCylinder the rings have equal
+ *          areas, otherwise they have equal radius increments out to the
+ *          maximum radius. The first radius is that of the outer bounding
+ *          ZCylinder (or the maximum radius) and each ring is bounded from
+ *          above by one radius and from below by the next.
  * @param max_radius the maximum allowable radius used in the subdivisions
+ * @param x0 the x-coordinate of the center of the rings (returned)
+ * @param y0 the y-coordinate of the center of the rings (returned)
+ * @return the ring radii in decreasing order
  */
-void Cell::ringify(std::vector<Cell*>& subcells, double max_radius) {
-
-  /* If the user didn't request any rings, don't make any */
-  if (_num_rings == 0)
-        return;
+std::vector<double> Cell::computeRingRadii(double max_radius, double& x0,
+                                           double& y0) {
 
   int num_zcylinders = 0;
   ZCylinder* zcylinder1 = NULL;
@@ -1205,8 +1265,7 @@ void Cell::ringify(std::vector<Cell*>& subcells, double max_radius) {
   double y2 = 0.;
   int halfspace1 = 0;
   int halfspace2 = 0;
-  std::vector<ZCylinder*> zcylinders;
-  std::vector<Cell*> rings;
+  std::vector<double> radii;
 
   /* See if the Cell contains 1 or 2 ZCYLINDER Surfaces */
   std::map<int, surface_halfspace*>::iterator iter1;
@@ -1267,10 +1326,6 @@ void Cell::ringify(std::vector<Cell*>& subcells, double max_radius) {
                "the 2 halfspaces for each Surface.", _id, halfspace1,
                zcylinder1->getId(), halfspace2, zcylinder2->getId());
 
-  /* Loop over ZCylinders and create a new Cell clone for each ring */
-  std::vector<ZCylinder*>::iterator iter2;
-  std::vector<Cell*>::iterator iter3;
-
   /* Compute the increment, either by radius or area, to use to construct
    * the concentric rings */
   double increment;
@@ -1285,7 +1340,7 @@ void Cell::ringify(std::vector<Cell*>& subcells, double max_radius) {
   else
     increment = M_PI * fabs(radius1*radius1 - radius2*radius2) / _num_rings;
 
-  /* Generate successively smaller ZCylinders */
+  /* Generate successively smaller radii */
   for (int i=0; i < _num_rings-1; i++) {
 
     /* Compute the outer radius of the next ring */
@@ -1294,14 +1349,42 @@ void Cell::ringify(std::vector<Cell*>& subcells, double max_radius) {
     else
       radius2 = sqrt(radius1 * radius1 - (increment / M_PI));
 
-    ZCylinder* zcylinder = new ZCylinder(x1, y1, radius1);
-    zcylinders.push_back(zcylinder);
+    radii.push_back(radius1);
     radius1 = radius2;
   }
 
-  /* Store smallest, innermost ZCylinder */
-  ZCylinder* zcylinder = new ZCylinder(x1, y1, radius1);
-  zcylinders.push_back(zcylinder);
+  /* Store smallest, innermost radius */
+  radii.push_back(radius1);
+
+  x0 = x1;
+  y0 = y1;
+  return radii;
+}
+
+
+/**
+ * @brief Subdivides the Cell into clones for fuel pin rings.
+ * @param subcells an empty vector to store all subcells
+ * @param max_radius the maximum allowable radius used in the subdivisions
+ */
+void Cell::ringify(std::vector<Cell*>& subcells, double max_radius) {
+
+  /* If the user didn't request any rings, don't make any */
+  if (_num_rings == 0)
+        return;
+
+  double x1, y1;
+  std::vector<double> radii = computeRingRadii(max_radius, x1, y1);
+  std::vector<ZCylinder*> zcylinders;
+  std::vector<Cell*> rings;
+
+  /* Loop over ZCylinders and create a new Cell clone for each ring */
+  std::vector<ZCylinder*>::iterator iter2;
+  std::vector<Cell*>::iterator iter3;
+
+  /* Generate successively smaller ZCylinders */
+  for (size_t i=0; i < radii.size(); i++)
+    zcylinders.push_back(new ZCylinder(x1, y1, radii[i]));
 
   /* Create ring Cells with successively smaller ZCylinders */
   for (iter2 = zcylinders.begin(); iter2 != zcylinders.end(); ++iter2) {
@@ -1368,6 +1451,76 @@ void Cell::ringify(std::vector<Cell*>& subcells, double max_radius) {
 }
 
 
+/**
+ * @brief Counts the ring and sector boundaries which would be crossed by a
+ *        segment within this Cell once it is subdivided.
+ * @details This allows the number of segments to be estimated before
+ *          subdivideCell(...) is called. The ring radii are those computed
+ *          for ringify(...) and the sector boundaries are the half-lines
+ *          from the origin bounding each sector in sectorize(...). Cells
+ *          without rings or sectors, including the Cells created by a
+ *          subdivision, do not cross any boundaries.
+ * @param coords a pointer to the LocalCoords of the start of the segment in
+ *        the Universe containing this Cell
+ * @param length the length of the segment (cm)
+ * @param max_radius the maximum allowable radius used in the subdivisions
+ * @return the number of ring and sector boundaries crossed
+ */
+int Cell::countSubdivisionCrossings(LocalCoords* coords, double length,
+                                    double max_radius) {
+
+  if (_cell_type != MATERIAL || (_num_rings == 0 && _num_sectors == 0))
+    return 0;
+
+  double x = coords->getX();
+  double y = coords->getY();
+  double cos_phi = cos(coords->getPhi());
+  double sin_phi = sin(coords->getPhi());
+  int num_crossings = 0;
+
+  /* Count crossings of the interior ring ZCylinders */
+  if (_num_rings > 1) {
+    double x0, y0;
+    std::vector<double> radii = computeRingRadii(max_radius, x0, y0);
+    double b = (x - x0) * cos_phi + (y - y0) * sin_phi;
+    double dist_sq = (x - x0) * (x - x0) + (y - y0) * (y - y0);
+
+    for (size_t i=1; i < radii.size(); i++) {
+      double discr = b * b - dist_sq + radii[i] * radii[i];
+      if (discr <= 0.)
+        continue;
+
+      double root = sqrt(discr);
+      if (-b - root > 0. && -b - root < length)
+        num_crossings++;
+      if (-b + root > 0. && -b + root < length)
+        num_crossings++;
+    }
+  }
+
+  /* Count crossings of the half-lines bounding each sector */
+  if (_num_sectors > 1) {
+    double delta_azim = 2. * M_PI / _num_sectors;
+
+    for (int i=0; i < _num_sectors; i++) {
+      double angle = i * delta_azim - M_PI / 4.0;
+      double u = cos(angle);
+      double v = sin(angle);
+      double denom = cos_phi * v - sin_phi * u;
+      if (denom == 0.)
+        continue;
+
+      double t = (y * u - x * v) / denom;
+      double s = (x + t * cos_phi) * u + (y + t * sin_phi) * v;
+      if (t > 0. && t < length && s > 0.)
+        num_crossings++;
+    }
+  }
+
+  return num_crossings;
+}
+
+
 /**
  * @brief Subdivides a Cell into rings and sectors aligned with the z-axis.
  * @details This method uses the Cell's clone method to produce a vector of
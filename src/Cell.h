@@ -23,6 +23,7 @@
 /* Forward declarations to resolve circular dependencies */
 class Universe;
 class Surface;
+struct surface_kernel;
 
 int cell_id();
 void reset_cell_id();
@@ -74,6 +75,9 @@ private:
   /** A static counter for the number of Cells */
   static int _n;
 
+  /** A static counter for the number of times a Cell fill has been set */
+  static int _num_fill_changes;
+
   /** A monotonically increasing unique ID for each Cell created */
   int _uid;
 
@@ -122,15 +126,24 @@ private:
   /** Map of bounding Surface IDs with pointers and halfspaces (+/-1) */
   std::map<int, surface_halfspace*> _surfaces;
 
+  /** Contiguous array of type-tagged kernels for the bounding Surfaces */
+  surface_kernel* _surface_kernels;
+
+  /** The number of surface kernels */
+  int _num_surface_kernels;
+
   /* Vector of neighboring Cells */
   std::vector<Cell*> _neighbors;
 
+  std::vector<double> computeRingRadii(double max_radius, double& x0,
+                                       double& y0);
   void ringify(std::vector<Cell*>& subcells, double max_radius);
   void sectorize(std::vector<Cell*>& subcells);
 
 public:
   Cell(int id=0, const char* name="");
   virtual ~Cell();
+  static int getNumFillChanges();
   int getUid() const;
   int getId() const;
   char* getName() const;
@@ -185,6 +198,7 @@ public:
   void setParent(Cell* parent);
   void addSurface(int halfspace, Surface* surface);
   void removeSurface(Surface* surface);
+  void buildSurfaceKernels();
   void addNeighborCell(Cell* cell);
 
   bool isFissionable();
@@ -194,6 +208,8 @@ public:
 
   Cell* clone();
   void subdivideCell(double max_radius);
+  int countSubdivisionCrossings(LocalCoords* coords, double length,
+                                double max_radius);
   void buildNeighbors();
 
   std::string toString();
@@ -1,4 +1,5 @@
 #include "Cmfd.h"
+#include "TrackGenerator.h"
 
 /**
  * @brief Constructor initializes boundaries and variables that describe
@@ -13,6 +14,7 @@ Cmfd::Cmfd() {
   _polar_quad = NULL;
   _geometry = NULL;
   _materials = NULL;
+  _FSR_flux_moments = NULL;
 
   /* Global variables used in solving CMFD problem */
   _num_x = 1;
@@ -25,6 +27,7 @@ Cmfd::Cmfd() {
   _centroid_update_on = true;
   _k_nearest = 3;
   _SOR_factor = 1.0;
+  _linear_solver_type = RED_BLACK_SOR;
   _num_FSRs = 0;
 
   /* Energy group and polar angle problem parameters */
@@ -44,6 +47,12 @@ Cmfd::Cmfd() {
   _group_indices_map = NULL;
   _user_group_indices = false;
   _surface_currents = NULL;
+  _track_cells = NULL;
+  _prolongation = NULL;
+  _prolongation_IA = NULL;
+  _prolongation_JA = NULL;
+  _num_threads = 0;
+  _thread_currents = NULL;
   _cell_locks = NULL;
   _volumes = NULL;
   _lattice = NULL;
@@ -99,6 +108,18 @@ Cmfd::~Cmfd() {
   if (_surface_currents != NULL)
     delete _surface_currents;
 
+  if (_thread_currents != NULL)
+    delete [] _thread_currents;
+
+  if (_prolongation != NULL) {
+    delete [] _prolongation;
+    delete [] _prolongation_IA;
+    delete [] _prolongation_JA;
+  }
+
+  if (_track_cells != NULL)
+    delete [] _track_cells;
+
   if (_volumes != NULL)
     delete _volumes;
 
@@ -555,7 +576,7 @@ FP_PRECISION Cmfd::computeKeff(int moc_iteration) {
 
   /* Solve the eigenvalue problem */
   _k_eff = eigenvalueSolve(_A, _M, _new_flux, _source_convergence_threshold,
-                           _SOR_factor);
+                           _SOR_factor, _linear_solver_type);
 
   /* Rescale the old and new flux */
   rescaleFlux();
@@ -672,7 +693,9 @@ void Cmfd::constructMatrices(int moc_iteration) {
  * @brief Update the MOC flux in each FSR.
  * @details This method uses the condensed flux from the last MOC transport
  *          sweep and the converged flux from the eigenvalue problem to
- *          update the MOC flux in each FSR.
+ *          update the MOC flux in each FSR. The ratio used to update each
+ *          FSR is the product of the precomputed prolongation matrix with
+ *          the CMFD flux ratios (see Cmfd::generateProlongation()).
  */
 void Cmfd::updateMOCFlux() {
 
@@ -686,29 +709,32 @@ void Cmfd::updateMOCFlux() {
                             / _old_flux->getValue(i, e));
   }
 
-  /* Loop over mesh cells */
-#pragma omp parallel for
-  for (int i = 0; i < _num_x * _num_y; i++) {
+  FP_PRECISION* flux_ratio = _flux_ratio->getArray();
 
-    std::vector<int>::iterator iter;
+  /* Loop over FSRs */
+#pragma omp parallel for schedule(guided)
+  for (int r = 0; r < _num_FSRs; r++) {
+
+    /* Skip FSRs which are not in a CMFD cell */
+    if (_prolongation_IA[r] == _prolongation_IA[r+1])
+      continue;
 
     /* Loop over CMFD groups */
     for (int e = 0; e < _num_cmfd_groups; e++) {
 
-      /* Loop over FRSs in mesh cell */
-      for (iter = _cell_fsrs.at(i).begin();
-           iter != _cell_fsrs.at(i).end(); ++iter) {
-
-        FP_PRECISION update_ratio = getUpdateRatio(i, e, *iter);
+      FP_PRECISION update_ratio = 0.0;
 
-        for (int h = _group_indices[e]; h < _group_indices[e + 1]; h++) {
+      for (int k = _prolongation_IA[r]; k < _prolongation_IA[r+1]; k++)
+        update_ratio += _prolongation[k]
+          * flux_ratio[_prolongation_JA[k] * _num_cmfd_groups + e];
 
-          /* Update FSR flux using ratio of old and new CMFD flux */
-          _FSR_fluxes[*iter*_num_moc_groups + h] = update_ratio
-            * _FSR_fluxes[*iter*_num_moc_groups + h];
+      /* Update FSR flux using ratio of old and new CMFD flux */
+      for (int h = _group_indices[e]; h < _group_indices[e + 1]; h++) {
+        _FSR_fluxes[r*_num_moc_groups + h] *= update_ratio;
 
-          log_printf(DEBUG, "Updating flux in FSR: %d, cell: %d, MOC group: "
-            "%d, CMFD group: %d, ratio: %f", *iter ,i, h, e, update_ratio);
+        if (_FSR_flux_moments != NULL) {
+          _FSR_flux_moments[(r*_num_moc_groups + h)*2] *= update_ratio;
+          _FSR_flux_moments[(r*_num_moc_groups + h)*2 + 1] *= update_ratio;
         }
       }
     }
@@ -794,11 +820,21 @@ void Cmfd::setFSRVolumes(FP_PRECISION* FSR_volumes) {
  * @brief Set pointer to FSR flux array.
  * @param scalar_flux Pointer to FSR flux array
  */
-void Cmfd::setFSRFluxes(FP_PRECISION* scalar_flux) {
+void Cmfd::setFSRFluxes(ACC_PRECISION* scalar_flux) {
   _FSR_fluxes = scalar_flux;
 }
 
 
+/**
+ * @brief Set pointer to the FSR flux moment array of a linear source
+ *        solver, whose x and y moments are updated with the scalar fluxes.
+ * @param flux_moments Pointer to FSR flux moment array (or NULL)
+ */
+void Cmfd::setFSRFluxMoments(ACC_PRECISION* flux_moments) {
+  _FSR_flux_moments = flux_moments;
+}
+
+
 /**
  * @brief Set the successive over-relaxation factor for the
  *        linear solve within the diffusion eigenvalue solve.
@@ -814,6 +850,30 @@ void Cmfd::setSORRelaxationFactor(FP_PRECISION SOR_factor) {
 }
 
 
+/**
+ * @brief Set the method used to solve the linear systems within the
+ *        diffusion eigenvalue solve.
+ * @details Geometric multigrid converges in a number of cycles which is
+ *          largely independent of the CMFD mesh size and is recommended for
+ *          fine (e.g., pin-resolved) CMFD meshes. Red-black SOR is used
+ *          by default.
+ * @param solver_type the linear solver type (RED_BLACK_SOR or MULTIGRID)
+ */
+void Cmfd::setLinearSolverType(linearSolverType solver_type) {
+  _linear_solver_type = solver_type;
+}
+
+
+/**
+ * @brief Get the method used to solve the linear systems within the
+ *        diffusion eigenvalue solve.
+ * @return the linear solver type
+ */
+linearSolverType Cmfd::getLinearSolverType() {
+  return _linear_solver_type;
+}
+
+
 /**
  * @brief Get the number of coarse CMFD energy groups.
  * @return The number of CMFD energy groups
@@ -910,6 +970,10 @@ void Cmfd::initializeMaterials() {
 
 /**
  * @brief Initializes Cmfd surface currents Vector prior to first MOC iteration.
+ * @details In addition to the surface currents Vector, a private copy of the
+ *          surface currents is allocated for each OpenMP thread such that
+ *          segments may be tallied during the transport sweep without
+ *          mutual exclusion locks.
  */
 void Cmfd::initializeCurrents() {
 
@@ -917,10 +981,20 @@ void Cmfd::initializeCurrents() {
   if (_surface_currents != NULL)
     delete _surface_currents;
 
+  if (_thread_currents != NULL)
+    delete [] _thread_currents;
+
   /* Allocate memory for the Cmfd Mesh surface currents Vectors */
   _surface_currents = new Vector(_cell_locks, _num_x, _num_y,
                                  _num_cmfd_groups * NUM_SURFACES);
 
+  /* Allocate memory for the thread private surface currents */
+  int num_currents = _num_x * _num_y * _num_cmfd_groups * NUM_SURFACES;
+  _num_threads = omp_get_max_threads();
+  _thread_currents = new FP_PRECISION[_num_threads * num_currents];
+  memset(_thread_currents, 0.0,
+         sizeof(FP_PRECISION) * _num_threads * num_currents);
+
   return;
 }
 
@@ -934,6 +1008,9 @@ void Cmfd::initializeCurrents() {
  */
 void Cmfd::initializeCellMap() {
 
+  /* Clear any mesh cell FSR vectors from a previous initialization */
+  _cell_fsrs.clear();
+
   /* Allocate memory for mesh cell FSR vectors */
   for (int y = 0; y < _num_y; y++) {
     for (int x = 0; x < _num_x; x++)
@@ -1589,14 +1666,15 @@ int Cmfd::getCellByStencil(int cell_id, int stencil_id) {
 
 
 /**
- * @brief Get the ratio used to update the FSR flux after converging CMFD.
- * @details This method takes in a cmfd cell, a MOC energy group, and a FSR
- *          and returns the ratio used to update the FSR flux. There are two
- *          methods that can be used to update the flux, conventional and
- *          k-nearest centroid updating. The k-nearest centroid updating uses
- *          the k-nearest cells (with k between 1 and 9) of the current CMFD
- *          cell and the 8 neighboring CMFD cells. The stencil of cells
- *          surrounding the current cell is defined as:
+ * @brief Generate the prolongation matrix used to update the FSR flux after
+ *        converging CMFD.
+ * @details The ratio used to update the flux in each FSR is a weighted sum
+ *          of the CMFD flux ratios of the CMFD cells in the FSR's stencil.
+ *          There are two methods that can be used to update the flux,
+ *          conventional and k-nearest centroid updating. The k-nearest
+ *          centroid updating uses the k-nearest cells (with k between 1 and 9)
+ *          of the current CMFD cell and the 8 neighboring CMFD cells. The
+ *          stencil of cells surrounding the current cell is defined as:
  *
  *                             6 7 8
  *                             3 4 5
@@ -1605,42 +1683,74 @@ int Cmfd::getCellByStencil(int cell_id, int stencil_id) {
  *          where 4 is the given CMFD cell. If the cell is on the edge or corner
  *          of the geometry and there are less than k nearest neighbor cells,
  *          k is reduced to the number of neighbor cells for that instance.
- * @param cell_id The cmfd cell ID containing the FSR.
- * @param group The CMFD energy group being updated.
- * @param fsr The fsr being updated.
- * @return the ratio used to update the FSR flux.
+ *          Since the stencils are fixed once they have been generated, the
+ *          weights are stored in a sparse FSR by CMFD cell matrix in CSR
+ *          format. FSRs which are not in a CMFD cell have empty rows.
  */
-FP_PRECISION Cmfd::getUpdateRatio(int cell_id, int group, int fsr) {
+void Cmfd::generateProlongation() {
 
-  FP_PRECISION ratio = 0.0;
+  if (_prolongation != NULL) {
+    delete [] _prolongation;
+    delete [] _prolongation_IA;
+    delete [] _prolongation_JA;
+  }
+
+  /* Collect the CMFD cell and weight of each term in each FSR's row */
+  std::vector< std::vector< std::pair<int, FP_PRECISION> > > rows(_num_FSRs);
   std::vector< std::pair<int, FP_PRECISION> >::iterator iter;
-  int cell_next_id;
+  std::vector<int>::iterator fsr_iter;
+  int num_nonzeros = 0;
+
+  for (int i = 0; i < _num_x * _num_y; i++) {
+    for (fsr_iter = _cell_fsrs.at(i).begin();
+         fsr_iter != _cell_fsrs.at(i).end(); ++fsr_iter) {
+
+      int fsr = *fsr_iter;
+      std::vector< std::pair<int, FP_PRECISION> >& row = rows.at(fsr);
 
-  if (_centroid_update_on) {
+      if (_centroid_update_on) {
 
-    /* Compute the ratio for all the surrounding cells */
-    for (iter = _k_nearest_stencils[fsr].begin();
-         iter != _k_nearest_stencils[fsr].end(); ++iter) {
+        std::vector< std::pair<int, FP_PRECISION> >& stencil =
+          _k_nearest_stencils[fsr];
 
-      if (iter->first != 4) {
-        cell_next_id = getCellByStencil(cell_id, iter->first);
-        ratio += iter->second * _flux_ratio->getValue(cell_next_id, group);
+        /* Add the weights of all the surrounding cells */
+        for (iter = stencil.begin(); iter != stencil.end(); ++iter) {
+          if (iter->first != 4)
+            row.push_back(std::make_pair(getCellByStencil(i, iter->first),
+                                         iter->second));
+        }
+
+        /* INTERNAL */
+        if (stencil.size() == 1)
+          row.push_back(std::make_pair(i, FP_PRECISION(1.0)));
+        else {
+          row.push_back(std::make_pair(i, stencil[0].second));
+          for (iter = row.begin(); iter != row.end(); ++iter)
+            iter->second /= (stencil.size() - 1);
+        }
       }
-    }
+      else
+        row.push_back(std::make_pair(i, FP_PRECISION(1.0)));
 
-    /* INTERNAL */
-    if (_k_nearest_stencils[fsr].size() == 1)
-      ratio += _flux_ratio->getValue(cell_id, group);
-    else{
-      ratio += _k_nearest_stencils[fsr][0].second *
-        _flux_ratio->getValue(cell_id, group);
-      ratio /= (_k_nearest_stencils[fsr].size() - 1);
+      num_nonzeros += row.size();
     }
   }
-  else
-    ratio = _flux_ratio->getValue(cell_id, group);
 
-  return ratio;
+  /* Store the prolongation matrix in CSR format */
+  _prolongation = new FP_PRECISION[num_nonzeros];
+  _prolongation_IA = new int[_num_FSRs + 1];
+  _prolongation_JA = new int[num_nonzeros];
+
+  int k = 0;
+  for (int r = 0; r < _num_FSRs; r++) {
+    _prolongation_IA[r] = k;
+    for (iter = rows[r].begin(); iter != rows[r].end(); ++iter) {
+      _prolongation_JA[k] = iter->first;
+      _prolongation[k] = iter->second;
+      k++;
+    }
+  }
+  _prolongation_IA[_num_FSRs] = k;
 }
 
 
@@ -1670,8 +1780,10 @@ FP_PRECISION Cmfd::getDistanceToCentroid(Point* centroid, int cell_id,
   int y = cell_id / _num_x;
   FP_PRECISION dist_x, dist_y;
   bool found = false;
-  FP_PRECISION centroid_x = centroid->getX();
-  FP_PRECISION centroid_y = centroid->getY();
+
+  /* Use the centroid relative to the center of the CMFD mesh */
+  FP_PRECISION centroid_x = centroid->getX() - _lattice->getOffset()->getX();
+  FP_PRECISION centroid_y = centroid->getY() - _lattice->getOffset()->getY();
 
   /* LOWER LEFT CORNER */
   if (x > 0 && y > 0 && stencil_index == 0) {
@@ -1743,62 +1855,132 @@ FP_PRECISION Cmfd::getDistanceToCentroid(Point* centroid, int cell_id,
 }
 
 
+/**
+ * @brief Finds the CMFD cells at the ends of each Track.
+ * @details The CMFD cells in which the incoming forward and backward
+ *          boundary fluxes of each Track enter the geometry are cached such
+ *          that the boundary fluxes may be updated after each CMFD solve
+ *          without searching for the CMFD cell of each Track end. Track ends
+ *          on vacuum boundaries, which have no incoming flux, are assigned
+ *          a CMFD cell of -1. This method is for internal use only and
+ *          is called by the Solver once the Cmfd has been initialized.
+ * @param track_generator the TrackGenerator with the Tracks arranged by
+ *        parallel group as in the boundary flux array
+ */
+void Cmfd::initializeTrackCells(TrackGenerator* track_generator) {
+
+  Track** tracks = track_generator->getTracksByParallelGroup();
+  int num_tracks = track_generator->getNumTracks();
+
+  if (_track_cells != NULL)
+    delete [] _track_cells;
+
+  _track_cells = new int[2 * num_tracks];
+
+  /* Map each FSR to the CMFD cell which contains it */
+  int* FSR_cells = new int[_num_FSRs];
+  std::vector<int>::iterator iter;
+
+  for (int r=0; r < _num_FSRs; r++)
+    FSR_cells[r] = -1;
+
+  for (int i=0; i < _num_x * _num_y; i++) {
+    for (iter = _cell_fsrs.at(i).begin(); iter != _cell_fsrs.at(i).end();
+         ++iter)
+      FSR_cells[*iter] = i;
+  }
+
+  /* Find the CMFD cells at the start and end of each Track */
+#pragma omp parallel
+  {
+    Track scratch;
+
+#pragma omp for
+    for (int i=0; i < num_tracks; i++) {
+
+      Track* track = track_generator->getSegmentedTrack(tracks[i], &scratch);
+      segment* segments = track->getSegments();
+      int num_segments = track->getNumSegments();
+
+      if (tracks[i]->getBCIn() == VACUUM)
+        _track_cells[2*i] = -1;
+      else
+        _track_cells[2*i] = FSR_cells[segments[0]._region_id];
+
+      if (tracks[i]->getBCOut() == VACUUM)
+        _track_cells[2*i + 1] = -1;
+      else
+        _track_cells[2*i + 1] =
+          FSR_cells[segments[num_segments - 1]._region_id];
+    }
+  }
+
+  delete [] FSR_cells;
+}
+
+
 /**
  * @brief Update the MOC boundary fluxes.
  * @details The MOC boundary fluxes are updated using the P0 approximation.
  *          With this approximation, the boundary fluxes are updated using
  *          the ratio of new to old flux for the cell that the outgoing flux
  *          from the track enters.
- * @param tracks 2D array of Tracks
  * @param boundary_flux Array of boundary fluxes
- * @return The number of Tracks
+ * @param num_tracks The number of Tracks
  */
-void Cmfd::updateBoundaryFlux(Track** tracks, FP_PRECISION* boundary_flux,
-			      int num_tracks) {
+void Cmfd::updateBoundaryFlux(FP_PRECISION* boundary_flux, int num_tracks) {
+
+  log_printf(INFO, "updating boundary flux");
+
+  /* Loop over Tracks */
+#pragma omp parallel for schedule(guided)
+  for (int i=0; i < num_tracks; i++)
+    updateBoundaryFlux(i, &boundary_flux[i*2*_num_moc_groups*_num_polar],
+                       &boundary_flux[(i*2 + 1)*_num_moc_groups*_num_polar]);
+}
+
 
-  segment* segments;
-  segment* curr_segment;
-  int num_segments;
-  int bc;
+/**
+ * @brief Update the MOC boundary fluxes of a single Track.
+ * @details This applies the same P0 update as
+ *          Cmfd::updateBoundaryFlux(FP_PRECISION*, int) to the
+ *          angular fluxes of one Track, which may be held in a temporary
+ *          buffer by Solvers which store the boundary fluxes in a
+ *          compressed form.
+ * @param track_id the index of the Track in the boundary flux array
+ * @param fwd_flux the Track's forward angular fluxes
+ * @param bwd_flux the Track's backward angular fluxes
+ */
+void Cmfd::updateBoundaryFlux(int track_id, FP_PRECISION* fwd_flux,
+                              FP_PRECISION* bwd_flux) {
+
+  FP_PRECISION* flux_ratio = _flux_ratio->getArray();
   FP_PRECISION* track_flux;
-  FP_PRECISION ratio;
   int cell_id;
 
-  log_printf(INFO, "updating boundary flux");
+  /* Update boundary flux in forward direction */
+  cell_id = _track_cells[2*track_id];
+  track_flux = fwd_flux;
 
-  /* Loop over Tracks */
-  for (int i=0; i < num_tracks; i++) {
-
-    num_segments = tracks[i]->getNumSegments();
-    segments = tracks[i]->getSegments();
-
-    /* Update boundary flux in forward direction */
-    bc = (int)tracks[i]->getBCOut();
-    curr_segment = &segments[0];
-    track_flux = &boundary_flux[i*2*_num_moc_groups*_num_polar];
-    cell_id = convertFSRIdToCmfdCell(curr_segment->_region_id);
-
-    if (bc) {
-      for (int e=0; e < _num_moc_groups; e++) {
-        for (int p=0; p < _num_polar; p++) {
-          track_flux[p*_num_moc_groups + e] *= _flux_ratio->getValue
-            (cell_id, e);
-        }
-      }
+  if (cell_id != -1) {
+    for (int e=0; e < _num_moc_groups; e++) {
+      FP_PRECISION ratio = flux_ratio[cell_id*_num_cmfd_groups +
+                                      getCmfdGroup(e)];
+      for (int p=0; p < _num_polar; p++)
+        track_flux[p*_num_moc_groups + e] *= ratio;
     }
+  }
 
-    /* Update boundary flux in backwards direction */
-    bc = (int)tracks[i]->getBCIn();
-    curr_segment = &segments[num_segments - 1];
-    track_flux = &boundary_flux[(i*2 + 1)*_num_moc_groups*_num_polar];
+  /* Update boundary flux in backwards direction */
+  cell_id = _track_cells[2*track_id + 1];
+  track_flux = bwd_flux;
 
-    if (bc) {
-      for (int e=0; e < _num_moc_groups; e++) {
-        for (int p=0; p < _num_polar; p++) {
-          track_flux[p*_num_moc_groups + e] *= _flux_ratio->getValue
-            (cell_id, e);
-        }
-      }
+  if (cell_id != -1) {
+    for (int e=0; e < _num_moc_groups; e++) {
+      FP_PRECISION ratio = flux_ratio[cell_id*_num_cmfd_groups +
+                                      getCmfdGroup(e)];
+      for (int p=0; p < _num_polar; p++)
+        track_flux[p*_num_moc_groups + e] *= ratio;
     }
   }
 }
@@ -1829,65 +2011,86 @@ void Cmfd::setKNearest(int k_nearest) {
 /**
  * @brief Zero the surface currents for each mesh cell and energy
  *        group.
+ * @details Each thread zeroes its own private surface currents. The private
+ *          currents are reallocated if the number of OpenMP threads has
+ *          grown since they were initialized.
  */
 void Cmfd::zeroCurrents() {
+
+  if (omp_get_max_threads() > _num_threads)
+    initializeCurrents();
+
   _surface_currents->clear();
+
+  int num_currents = _num_x * _num_y * _num_cmfd_groups * NUM_SURFACES;
+
+#pragma omp parallel for schedule(static)
+  for (int t=0; t < _num_threads; t++)
+    memset(&_thread_currents[t * num_currents], 0.0,
+           sizeof(FP_PRECISION) * num_currents);
+}
+
+
+/**
+ * @brief Reduces the thread private surface currents tallied during a
+ *        transport sweep into the surface currents Vector.
+ * @details This method must be called after each transport sweep and before
+ *          the surface currents are used to construct the CMFD matrices.
+ */
+void Cmfd::reduceCurrents() {
+
+  int num_currents = _num_x * _num_y * _num_cmfd_groups * NUM_SURFACES;
+  FP_PRECISION* currents = _surface_currents->getArray();
+
+#pragma omp parallel for schedule(static)
+  for (int i=0; i < num_currents; i++) {
+    FP_PRECISION current = 0.;
+    for (int t=0; t < _num_threads; t++)
+      current += _thread_currents[t * num_currents + i];
+    currents[i] = current;
+  }
 }
 
 
 /**
- * @brief Tallies the current contribution from this segment across the
- *        the appropriate CMFD mesh cell surface.
- * @param curr_segment The current Track segment
+ * @brief Tallies the current contribution from a segment across a CMFD mesh
+ *        cell surface.
+ * @details The current is tallied into the calling thread's private surface
+ *          currents without locks. The private currents are summed into the
+ *          surface currents Vector by Cmfd::reduceCurrents().
+ * @param surface The CMFD mesh surface crossed by the segment (or -1)
  * @param track_flux The outgoing angular flux for this segment
  * @param polar_weights Array of polar weights for some azimuthal angle
- * @param fwd Boolean indicating direction of integration along segment
+ * @param first_group The first MOC energy group to tally (default 0)
+ * @param last_group One past the last MOC energy group to tally, or -1 for
+ *        all energy groups (default)
  */
-void Cmfd::tallyCurrent(segment* curr_segment, FP_PRECISION* track_flux,
-                        FP_PRECISION* polar_weights, bool fwd) {
-
-  int surf_id, cell_id;
-  int ncg = _num_cmfd_groups;
-  FP_PRECISION currents[_num_cmfd_groups];
-  memset(currents, 0.0, sizeof(FP_PRECISION) * _num_cmfd_groups);
-
-  if (fwd) {
-    if (curr_segment->_cmfd_surface_fwd != -1) {
-
-      surf_id = curr_segment->_cmfd_surface_fwd % NUM_SURFACES;
-      cell_id = curr_segment->_cmfd_surface_fwd / NUM_SURFACES;
-
-      for (int e=0; e < _num_moc_groups; e++) {
-
-        int g = getCmfdGroup(e);
+void Cmfd::tallyCurrent(int surface, FP_PRECISION* track_flux,
+                        FP_PRECISION* polar_weights, int first_group,
+                        int last_group) {
 
-        for (int p=0; p < _num_polar; p++)
-          currents[g] += track_flux(p, e) * polar_weights[p] / 2.;
-      }
+  /* Return early for segments which do not cross a CMFD surface */
+  if (surface == -1)
+    return;
 
-      /* Increment currents */
-      _surface_currents->incrementValues
-          (cell_id, surf_id*ncg, (surf_id+1)*ncg - 1, currents);
-    }
-  }
-  else {
-    if (curr_segment->_cmfd_surface_bwd != -1) {
+  int surf_id = surface % NUM_SURFACES;
+  int cell_id = surface / NUM_SURFACES;
+  int ncg = _num_cmfd_groups;
+  int num_currents = _num_x * _num_y * ncg * NUM_SURFACES;
 
-      surf_id = curr_segment->_cmfd_surface_bwd % NUM_SURFACES;
-      cell_id = curr_segment->_cmfd_surface_bwd / NUM_SURFACES;
+  /* Increment the currents in this thread's private tally */
+  FP_PRECISION* currents = &_thread_currents[omp_get_thread_num()
+      * num_currents + (cell_id * NUM_SURFACES + surf_id) * ncg];
 
-      for (int e=0; e < _num_moc_groups; e++) {
+  if (last_group < 0 || last_group > _num_moc_groups)
+    last_group = _num_moc_groups;
 
-        int g = getCmfdGroup(e);
+  for (int e=first_group; e < last_group; e++) {
 
-        for (int p=0; p < _num_polar; p++)
-          currents[g] += track_flux(p, e) * polar_weights[p] / 2.;
-      }
+    int g = getCmfdGroup(e);
 
-      /* Increment currents */
-      _surface_currents->incrementValues
-          (cell_id, surf_id*ncg, (surf_id+1)*ncg - 1, currents);
-    }
+    for (int p=0; p < _num_polar; p++)
+      currents[g] += track_flux(p, e) * polar_weights[p] / 2.;
   }
 }
 
@@ -1942,6 +2145,7 @@ void Cmfd::initialize() {
 
     /* Initialize k-nearest stencils, currents, flux, and materials */
     generateKNearestStencils();
+    generateProlongation();
     initializeCurrents();
     initializeMaterials();
   }
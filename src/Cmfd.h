@@ -24,6 +24,9 @@
 /** Forward declaration of Geometry class */
 class Geometry;
 
+/** Forward declaration of TrackGenerator class */
+class TrackGenerator;
+
 /** Comparitor for sorting k-nearest stencil std::pair objects */
 inline bool stencilCompare(const std::pair<int, FP_PRECISION>& firstElem,
                            const std::pair<int, FP_PRECISION>& secondElem) {
@@ -79,6 +82,9 @@ private:
   /** Gauss-Seidel SOR relaxation factor */
   FP_PRECISION _SOR_factor;
 
+  /** The method used to solve the linear systems in the eigenvalue solve */
+  linearSolverType _linear_solver_type;
+
   /** cmfd source convergence threshold */
   FP_PRECISION _source_convergence_threshold;
 
@@ -117,7 +123,11 @@ private:
   Material** _FSR_materials;
 
   /** The FSR scalar flux in each energy group */
-  FP_PRECISION* _FSR_fluxes;
+  ACC_PRECISION* _FSR_fluxes;
+
+  /** The x and y FSR scalar flux moments in each energy group (linear
+   *  source solvers only) */
+  ACC_PRECISION* _FSR_flux_moments;
 
   /** Vector of CMFD cell volumes */
   Vector* _volumes;
@@ -137,6 +147,13 @@ private:
   /** Vector of surface currents for each CMFD cell */
   Vector* _surface_currents;
 
+  /** The number of threads with private surface current tallies */
+  int _num_threads;
+
+  /** Thread private surface currents for each CMFD cell, surface and CMFD
+   *  group which are reduced into _surface_currents after each sweep */
+  FP_PRECISION* _thread_currents;
+
   /** Vector of vectors of FSRs containing in each cell */
   std::vector< std::vector<int> > _cell_fsrs;
 
@@ -156,6 +173,15 @@ private:
   std::map<int, std::vector< std::pair<int, FP_PRECISION> > >
     _k_nearest_stencils;
 
+  /** The CMFD cell at the start and end of each Track whose incoming
+   *  boundary fluxes are updated, or -1 for vacuum boundaries */
+  int* _track_cells;
+
+  /** The CSR prolongation weights of each CMFD cell flux ratio for each FSR */
+  FP_PRECISION* _prolongation;
+  int* _prolongation_IA;
+  int* _prolongation_JA;
+
   /** OpenMP mutual exclusion locks for atomic CMFD cell operations */
   omp_lock_t* _cell_locks;
 
@@ -171,11 +197,11 @@ private:
   void initializeMaterials();
   void initializeCurrents();
   void generateKNearestStencils();
+  void generateProlongation();
 
   /* Private getter functions */
   int getCellNext(int cell_id, int surface_id);
   int getCellByStencil(int cell_id, int stencil_id);
-  FP_PRECISION getUpdateRatio(int cell_id, int moc_group, int fsr);
   FP_PRECISION getDistanceToCentroid(Point* centroid, int cell_id,
                                      int stencil_index);
   FP_PRECISION getSurfaceDiffusionCoefficient(int cmfd_cell, int surface,
@@ -201,10 +227,14 @@ public:
   int findCmfdSurface(int cell_id, LocalCoords* coords);
   void addFSRToCell(int cell_id, int fsr_id);
   void zeroCurrents();
-  void tallyCurrent(segment* curr_segment, FP_PRECISION* track_flux,
-                    FP_PRECISION* polar_weights, bool fwd);
-  void updateBoundaryFlux(Track** tracks, FP_PRECISION* boundary_flux,
-                          int num_tracks);
+  void reduceCurrents();
+  void tallyCurrent(int surface, FP_PRECISION* track_flux,
+                    FP_PRECISION* polar_weights, int first_group=0,
+                    int last_group=-1);
+  void initializeTrackCells(TrackGenerator* track_generator);
+  void updateBoundaryFlux(FP_PRECISION* boundary_flux, int num_tracks);
+  void updateBoundaryFlux(int track_id, FP_PRECISION* fwd_flux,
+                          FP_PRECISION* bwd_flux);
 
   /* Get parameters */
   int getNumCmfdGroups();
@@ -219,9 +249,11 @@ public:
   std::vector< std::vector<int> >* getCellFSRs();
   bool isFluxUpdateOn();
   bool isCentroidUpdateOn();
+  linearSolverType getLinearSolverType();
 
   /* Set parameters */
   void setSORRelaxationFactor(FP_PRECISION SOR_factor);
+  void setLinearSolverType(linearSolverType solver_type);
   void setGeometry(Geometry* geometry);
   void setWidthX(double width);
   void setWidthY(double width);
@@ -241,7 +273,8 @@ public:
   /* Set FSR parameters */
   void setFSRMaterials(Material** FSR_materials);
   void setFSRVolumes(FP_PRECISION* FSR_volumes);
-  void setFSRFluxes(FP_PRECISION* scalar_flux);
+  void setFSRFluxes(ACC_PRECISION* scalar_flux);
+  void setFSRFluxMoments(ACC_PRECISION* flux_moments);
   void setCellFSRs(std::vector< std::vector<int> >* cell_fsrs);
 };
 
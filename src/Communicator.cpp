@@ -0,0 +1,266 @@
+#include "Communicator.h"
+
+
+/**
+ * @brief Constructor creates the ThreadCommunicators for each rank.
+ * @param num_ranks the number of ranks (domains) communicating
+ */
+ThreadCommunicatorGroup::ThreadCommunicatorGroup(int num_ranks) {
+
+  if (num_ranks <= 0)
+    log_printf(ERROR, "Unable to create a ThreadCommunicatorGroup with %d "
+               "ranks", num_ranks);
+
+  _num_ranks = num_ranks;
+  _num_waiting = 0;
+  _generation = 0;
+
+  _posted_buffers.resize(num_ranks * num_ranks, NULL);
+  _posted_sizes.resize(num_ranks * num_ranks, 0);
+  _posted_values.resize(num_ranks, NULL);
+
+  for (int r=0; r < num_ranks; r++)
+    _communicators.push_back(new ThreadCommunicator(this, r));
+}
+
+
+/**
+ * @brief Destructor deletes the ThreadCommunicators of each rank.
+ */
+ThreadCommunicatorGroup::~ThreadCommunicatorGroup() {
+  for (int r=0; r < _num_ranks; r++)
+    delete _communicators[r];
+}
+
+
+/**
+ * @brief Returns the number of ranks communicating.
+ * @return the number of ranks
+ */
+int ThreadCommunicatorGroup::getNumRanks() {
+  return _num_ranks;
+}
+
+
+/**
+ * @brief Returns the ThreadCommunicator of a rank.
+ * @param rank the rank (domain index)
+ * @return a pointer to the ThreadCommunicator
+ */
+Communicator* ThreadCommunicatorGroup::getCommunicator(int rank) {
+
+  if (rank < 0 || rank >= _num_ranks)
+    log_printf(ERROR, "Unable to return the ThreadCommunicator of rank %d "
+               "in a group of %d ranks", rank, _num_ranks);
+
+  return _communicators[rank];
+}
+
+
+/**
+ * @brief Blocks the calling thread until all ranks have reached the barrier.
+ */
+void ThreadCommunicatorGroup::barrier() {
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  int generation = _generation;
+
+  if (++_num_waiting == _num_ranks) {
+    _num_waiting = 0;
+    _generation++;
+    _condition.notify_all();
+  }
+  else {
+    while (generation == _generation)
+      _condition.wait(lock);
+  }
+}
+
+
+/**
+ * @brief Constructor sets the group and rank of the ThreadCommunicator.
+ * @param group the ThreadCommunicatorGroup holding the shared state
+ * @param rank the rank (domain index) of this Communicator
+ */
+ThreadCommunicator::ThreadCommunicator(ThreadCommunicatorGroup* group,
+                                       int rank) {
+  _group = group;
+  _rank = rank;
+}
+
+
+/**
+ * @brief Returns the rank of this Communicator.
+ * @return the rank
+ */
+int ThreadCommunicator::getRank() {
+  return _rank;
+}
+
+
+/**
+ * @brief Returns the number of ranks communicating.
+ * @return the number of ranks
+ */
+int ThreadCommunicator::getNumRanks() {
+  return _group->_num_ranks;
+}
+
+
+/**
+ * @brief Exchanges buffers of values with neighboring ranks.
+ * @details Each rank posts its send buffers in the group and copies the
+ *          buffers posted for it by its neighbors once all ranks have posted
+ *          theirs. The send buffers may be reused once all ranks have copied
+ *          them.
+ * @param num_neighbors the number of neighboring ranks
+ * @param neighbors the ranks of the neighbors
+ * @param send_buffer the values to send to the neighbors
+ * @param send_offsets the offsets of the values sent to each neighbor
+ * @param recv_buffer the values received from the neighbors
+ * @param recv_offsets the offsets of the values received from each neighbor
+ */
+void ThreadCommunicator::exchange(int num_neighbors, int* neighbors,
+                                  FP_PRECISION* send_buffer,
+                                  int* send_offsets,
+                                  FP_PRECISION* recv_buffer,
+                                  int* recv_offsets) {
+
+  int num_ranks = _group->_num_ranks;
+
+  /* Post the values sent to each neighbor */
+  for (int i=0; i < num_neighbors; i++) {
+    int index = _rank * num_ranks + neighbors[i];
+    _group->_posted_buffers[index] = &send_buffer[send_offsets[i]];
+    _group->_posted_sizes[index] = send_offsets[i+1] - send_offsets[i];
+  }
+
+  _group->barrier();
+
+  /* Copy the values posted for this rank by each neighbor */
+  for (int i=0; i < num_neighbors; i++) {
+    int index = neighbors[i] * num_ranks + _rank;
+    int size = recv_offsets[i+1] - recv_offsets[i];
+
+    if (_group->_posted_sizes[index] != size)
+      log_printf(ERROR, "Rank %d is unable to receive %d values from rank "
+                 "%d which sent %d values", _rank, size, neighbors[i],
+                 _group->_posted_sizes[index]);
+
+    std::copy(_group->_posted_buffers[index],
+              _group->_posted_buffers[index] + size,
+              &recv_buffer[recv_offsets[i]]);
+  }
+
+  _group->barrier();
+}
+
+
+/**
+ * @brief Sums an array of values over all ranks in place.
+ * @details The values are summed in the order of the ranks such that all
+ *          ranks receive exactly the same sums.
+ * @param values the values to sum
+ * @param num_values the number of values
+ */
+void ThreadCommunicator::reduceSum(double* values, int num_values) {
+
+  int num_ranks = _group->_num_ranks;
+  std::vector<double> sums(num_values, 0.);
+
+  _group->_posted_values[_rank] = values;
+  _group->barrier();
+
+  for (int r=0; r < num_ranks; r++) {
+    for (int i=0; i < num_values; i++)
+      sums[i] += _group->_posted_values[r][i];
+  }
+
+  /* Overwrite the values once all ranks have summed them */
+  _group->barrier();
+  std::copy(sums.begin(), sums.end(), values);
+}
+
+
+#ifdef MPIx
+/**
+ * @brief Constructor communicates between all processes of MPI_COMM_WORLD.
+ */
+MPICommunicator::MPICommunicator() {
+
+  int initialized;
+  MPI_Initialized(&initialized);
+
+  if (!initialized)
+    log_printf(ERROR, "Unable to create an MPICommunicator before MPI "
+               "is initialized");
+
+  _comm = MPI_COMM_WORLD;
+}
+
+
+/**
+ * @brief Returns the MPI rank of this process.
+ * @return the rank
+ */
+int MPICommunicator::getRank() {
+  int rank;
+  MPI_Comm_rank(_comm, &rank);
+  return rank;
+}
+
+
+/**
+ * @brief Returns the number of MPI processes.
+ * @return the number of ranks
+ */
+int MPICommunicator::getNumRanks() {
+  int num_ranks;
+  MPI_Comm_size(_comm, &num_ranks);
+  return num_ranks;
+}
+
+
+/**
+ * @brief Exchanges buffers of values with neighboring ranks using
+ *        non-blocking point-to-point messages.
+ * @param num_neighbors the number of neighboring ranks
+ * @param neighbors the ranks of the neighbors
+ * @param send_buffer the values to send to the neighbors
+ * @param send_offsets the offsets of the values sent to each neighbor
+ * @param recv_buffer the values received from the neighbors
+ * @param recv_offsets the offsets of the values received from each neighbor
+ */
+void MPICommunicator::exchange(int num_neighbors, int* neighbors,
+                               FP_PRECISION* send_buffer, int* send_offsets,
+                               FP_PRECISION* recv_buffer, int* recv_offsets) {
+
+  if (num_neighbors == 0)
+    return;
+
+  MPI_Datatype type = (sizeof(FP_PRECISION) == sizeof(float)) ?
+                      MPI_FLOAT : MPI_DOUBLE;
+  std::vector<MPI_Request> requests(2 * num_neighbors);
+
+  for (int i=0; i < num_neighbors; i++)
+    MPI_Irecv(&recv_buffer[recv_offsets[i]], recv_offsets[i+1] -
+              recv_offsets[i], type, neighbors[i], 0, _comm, &requests[i]);
+
+  for (int i=0; i < num_neighbors; i++)
+    MPI_Isend(&send_buffer[send_offsets[i]], send_offsets[i+1] -
+              send_offsets[i], type, neighbors[i], 0, _comm,
+              &requests[num_neighbors + i]);
+
+  MPI_Waitall(2 * num_neighbors, &requests[0], MPI_STATUSES_IGNORE);
+}
+
+
+/**
+ * @brief Sums an array of values over all MPI processes in place.
+ * @param values the values to sum
+ * @param num_values the number of values
+ */
+void MPICommunicator::reduceSum(double* values, int num_values) {
+  MPI_Allreduce(MPI_IN_PLACE, values, num_values, MPI_DOUBLE, MPI_SUM, _comm);
+}
+#endif
@@ -0,0 +1,193 @@
+/**
+ * @file Communicator.h
+ * @brief The Communicator classes.
+ * @date October 19, 2026
+ */
+
+
+#ifndef COMMUNICATOR_H_
+#define COMMUNICATOR_H_
+
+#ifdef __cplusplus
+#ifdef SWIG
+#include "Python.h"
+#endif
+#include "constants.h"
+#include "log.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#ifdef MPIx
+#include <mpi.h>
+#endif
+#endif
+
+
+/**
+ * @class Communicator Communicator.h "src/Communicator.h"
+ * @brief The communication layer between the Solvers of the domains of a
+ *        decomposed Geometry.
+ * @details Each domain is solved by a Solver with its own Communicator,
+ *          whose rank is the index of the domain. The Solvers exchange the
+ *          angular fluxes of the Tracks crossing the interfaces between
+ *          neighboring domains after each transport sweep, and sum the
+ *          fission sources and residuals over all domains. Subclasses
+ *          implement the communication between processes (MPI) or between
+ *          threads of a single process.
+ */
+class Communicator {
+
+public:
+  virtual ~Communicator() { }
+
+  /**
+   * @brief Returns the rank of this Communicator (the index of its domain).
+   * @return the rank
+   */
+  virtual int getRank() = 0;
+
+  /**
+   * @brief Returns the number of ranks (domains) communicating.
+   * @return the number of ranks
+   */
+  virtual int getNumRanks() = 0;
+
+  /**
+   * @brief Exchanges buffers of values with neighboring ranks.
+   * @details The values send_buffer[send_offsets[i]:send_offsets[i+1]] are
+   *          sent to rank neighbors[i], which sends back the values received
+   *          into recv_buffer[recv_offsets[i]:recv_offsets[i+1]]. Each pair
+   *          of neighboring ranks must call this collectively.
+   * @param num_neighbors the number of neighboring ranks
+   * @param neighbors the ranks of the neighbors
+   * @param send_buffer the values to send to the neighbors
+   * @param send_offsets the offsets of the values sent to each neighbor
+   *        (num_neighbors + 1 values)
+   * @param recv_buffer the values received from the neighbors
+   * @param recv_offsets the offsets of the values received from each
+   *        neighbor (num_neighbors + 1 values)
+   */
+  virtual void exchange(int num_neighbors, int* neighbors,
+                        FP_PRECISION* send_buffer, int* send_offsets,
+                        FP_PRECISION* recv_buffer, int* recv_offsets) = 0;
+
+  /**
+   * @brief Sums an array of values over all ranks in place.
+   * @details All ranks must call this collectively with the same number of
+   *          values, and all receive the same sums.
+   * @param values the values to sum
+   * @param num_values the number of values
+   */
+  virtual void reduceSum(double* values, int num_values) = 0;
+};
+
+
+class ThreadCommunicator;
+
+
+/**
+ * @class ThreadCommunicatorGroup Communicator.h "src/Communicator.h"
+ * @brief The shared state of the ThreadCommunicators of the domains solved
+ *        by the threads of a single process.
+ * @details This is intended for testing a domain decomposition without MPI.
+ *          Each domain must be solved concurrently by its own thread with
+ *          the ThreadCommunicator of its rank.
+ */
+class ThreadCommunicatorGroup {
+
+  friend class ThreadCommunicator;
+
+private:
+
+  /** The number of ranks */
+  int _num_ranks;
+
+  /** The ThreadCommunicators of each rank */
+  std::vector<ThreadCommunicator*> _communicators;
+
+  /** The buffers posted by each rank for the exchange with each rank */
+  std::vector<FP_PRECISION*> _posted_buffers;
+
+  /** The numbers of values posted by each rank for each rank */
+  std::vector<int> _posted_sizes;
+
+  /** The values posted by each rank for a reduction */
+  std::vector<double*> _posted_values;
+
+  /** The mutex and condition variable synchronizing the ranks */
+  std::mutex _mutex;
+  std::condition_variable _condition;
+
+  /** The number of ranks waiting at the barrier and its generation */
+  int _num_waiting;
+  int _generation;
+
+  void barrier();
+
+public:
+  ThreadCommunicatorGroup(int num_ranks);
+  virtual ~ThreadCommunicatorGroup();
+
+  int getNumRanks();
+  Communicator* getCommunicator(int rank);
+};
+
+
+/**
+ * @class ThreadCommunicator Communicator.h "src/Communicator.h"
+ * @brief A Communicator between threads of a single process.
+ * @details The values are exchanged through the buffers posted by each
+ *          rank in the ThreadCommunicatorGroup, and the ranks are
+ *          synchronized with a barrier.
+ */
+class ThreadCommunicator : public Communicator {
+
+private:
+
+  /** The group of ThreadCommunicators */
+  ThreadCommunicatorGroup* _group;
+
+  /** The rank of this Communicator */
+  int _rank;
+
+public:
+  ThreadCommunicator(ThreadCommunicatorGroup* group, int rank);
+
+  int getRank();
+  int getNumRanks();
+  void exchange(int num_neighbors, int* neighbors, FP_PRECISION* send_buffer,
+                int* send_offsets, FP_PRECISION* recv_buffer,
+                int* recv_offsets);
+  void reduceSum(double* values, int num_values);
+};
+
+
+#ifdef MPIx
+/**
+ * @class MPICommunicator Communicator.h "src/Communicator.h"
+ * @brief A Communicator between the processes of an MPI communicator.
+ * @details MPI must be initialized (eg, by importing mpi4py in Python)
+ *          before the MPICommunicator is created.
+ */
+class MPICommunicator : public Communicator {
+
+private:
+
+  /** The MPI communicator */
+  MPI_Comm _comm;
+
+public:
+  MPICommunicator();
+
+  int getRank();
+  int getNumRanks();
+  void exchange(int num_neighbors, int* neighbors, FP_PRECISION* send_buffer,
+                int* send_offsets, FP_PRECISION* recv_buffer,
+                int* recv_offsets);
+  void reduceSum(double* values, int num_values);
+};
+#endif
+
+
+#endif /* COMMUNICATOR_H_ */
@@ -8,7 +8,10 @@
  */
 ExpEvaluator::ExpEvaluator() {
   _interpolate = true;
+  _interpolation_order = 1;
   _exp_table = NULL;
+  _linear_source = false;
+  _linear_source_table = NULL;
   _polar_quad = NULL;
   _max_optical_length = MAX_OPTICAL_LENGTH;
   _exp_precision = EXP_PRECISION;
@@ -21,6 +24,9 @@ ExpEvaluator::ExpEvaluator() {
 ExpEvaluator::~ExpEvaluator() {
   if (_exp_table != NULL)
     delete [] _exp_table;
+
+  if (_linear_source_table != NULL)
+    delete [] _linear_source_table;
 }
 
 
@@ -30,7 +36,8 @@ ExpEvaluator::~ExpEvaluator() {
  */
 void ExpEvaluator::setPolarQuadrature(PolarQuad* polar_quad) {
   _polar_quad = polar_quad;
-  _two_times_num_polar = 2 * _polar_quad->getNumPolarAngles();
+  _num_polar = _polar_quad->getNumPolarAngles();
+  _two_times_num_polar = 2 * _num_polar;
 }
 
 
@@ -67,6 +74,32 @@ void ExpEvaluator::setExpPrecision(FP_PRECISION exp_precision) {
 }
 
 
+/**
+ * @brief Sets the order of the polynomials used to interpolate exponentials.
+ * @details Linear interpolation (the default) uses the tangent of the
+ *          exponential at the center of each tau bin. Quadratic and cubic
+ *          interpolation use the second and third order Taylor expansions
+ *          at the center of each bin, which meet the same precision with
+ *          far fewer and wider bins. At a precision of 1E-5 for all polar
+ *          angles, the quadratic and cubic tables are about 6 and 14 times
+ *          smaller than a linear table such that they remain in the L1
+ *          cache for many polar angles, at the cost of a few more floating
+ *          point operations per exponential. Note that the linear table
+ *          only meets the precision for a polar angle of 90 degrees.
+ * @param order the interpolation order (1 - linear, 2 - quadratic or
+ *        3 - cubic)
+ */
+void ExpEvaluator::setInterpolationOrder(int order) {
+
+  if (order < 1 || order > 3)
+    log_printf(ERROR, "Cannot set the exponential interpolation order to %d "
+               "since only linear (1), quadratic (2) and cubic (3) "
+               "interpolation are supported", order);
+
+  _interpolation_order = order;
+}
+
+
 /**
  * @brief Use linear interpolation to compute exponentials.
  */
@@ -83,6 +116,18 @@ void ExpEvaluator::useIntrinsic() {
 }
 
 
+/**
+ * @brief Sets whether to evaluate the exponential terms of the linear
+ *        source transport equation.
+ * @details If in use, initialize() also builds an interpolation table for
+ *          the F2 and H terms computed by computeLinearSourceExponentials().
+ * @param linear_source whether to evaluate the linear source terms
+ */
+void ExpEvaluator::useLinearSource(bool linear_source) {
+  _linear_source = linear_source;
+}
+
+
 /**
  * @brief Gets the maximum optical length covered with the exponential
  *        interpolation table.
@@ -111,6 +156,25 @@ bool ExpEvaluator::isUsingInterpolation() {
 }
 
 
+/**
+ * @brief Returns true if evaluating the linear source exponential terms.
+ * @return true if so, false otherwise
+ */
+bool ExpEvaluator::isUsingLinearSource() {
+  return _linear_source;
+}
+
+
+/**
+ * @brief Returns the order of the polynomials used to interpolate
+ *        exponentials.
+ * @return the interpolation order (1 - linear, 2 - quadratic or 3 - cubic)
+ */
+int ExpEvaluator::getInterpolationOrder() {
+  return _interpolation_order;
+}
+
+
 /**
  * @brief Returns the exponential table spacing.
  * @return exponential table spacing
@@ -121,7 +185,7 @@ FP_PRECISION ExpEvaluator::getTableSpacing() {
     log_printf(ERROR, "Unable to return the exponential table spacing "
                "since it has not yet been initialized");
 
-  return 1.0 / _inverse_exp_table_spacing;
+  return _exp_table_spacing;
 }
 
 
@@ -155,8 +219,16 @@ FP_PRECISION* ExpEvaluator::getExpTable() {
 
 
 /**
- * @brief If using linear interpolation, builds the table for each polar angle.
- * @param tolerance the minimum acceptable interpolation accuracy
+ * @brief If using interpolation, builds the table for each polar angle.
+ * @details The table spacing is chosen such that the error of the
+ *          interpolation polynomial of order n at the edges of a bin of
+ *          width \f$ \Delta \f$,
+ *          \f$ (\Delta/2sin(\theta_p))^{n+1}/(n+1)! \f$, is the
+ *          exponential precision. The linear table keeps its historical
+ *          spacing for \f$ sin(\theta_p) = 1 \f$, while the quadratic and
+ *          cubic tables use the smallest \f$ sin(\theta_p) \f$ such that
+ *          they meet the precision for all polar angles. The coefficients
+ *          of all polar angles for each bin are stored contiguously.
  */
 void ExpEvaluator::initialize() {
 
@@ -168,21 +240,41 @@ void ExpEvaluator::initialize() {
 
   /* Set size of interpolation table */
   int num_polar = _polar_quad->getNumPolarAngles();
-  int num_array_values = _max_optical_length * sqrt(1. / (8. * _exp_precision));
-  FP_PRECISION exp_table_spacing = _max_optical_length / num_array_values;
+  int num_coeffs = _interpolation_order + 1;
+  FP_PRECISION factorial = 1.;
+  for (int n=2; n <= num_coeffs; n++)
+    factorial *= n;
+
+  /* The smallest sine of the polar angles, for which the exponential
+   * varies the most with tau */
+  FP_PRECISION min_sin_theta = 1.;
+  for (int p=0; p < num_polar; p++)
+    min_sin_theta = std::min(min_sin_theta, _polar_quad->getSinTheta(p));
+
+  int num_array_values;
+  if (_interpolation_order == 1)
+    num_array_values = _max_optical_length * sqrt(1. / (8. * _exp_precision));
+  else
+    num_array_values = _max_optical_length /
+                       (2. * min_sin_theta *
+                        pow(factorial * _exp_precision, 1. / num_coeffs));
+
+  num_array_values = std::max(num_array_values, 1);
+  _exp_table_spacing = _max_optical_length / num_array_values;
 
   /* Increment the number of vaues in the array to ensure that a tau equal to
    * max_optical_length resides as the final entry in the table */
   num_array_values += 1;
 
   /* Compute the reciprocal of the table entry spacing */
-  _inverse_exp_table_spacing = 1.0 / exp_table_spacing;
+  _inverse_exp_table_spacing = 1.0 / _exp_table_spacing;
 
   /* Allocate array for the table */
   if (_exp_table != NULL)
     delete [] _exp_table;
 
-  _table_size = 2 * num_polar * num_array_values;
+  _bin_stride = num_coeffs * num_polar;
+  _table_size = _bin_stride * num_array_values;
   _exp_table = new FP_PRECISION[_table_size];
 
   FP_PRECISION expon;
@@ -191,25 +283,125 @@ void ExpEvaluator::initialize() {
   FP_PRECISION sin_theta;
   FP_PRECISION tau;
 
-  /* Create exponential linear interpolation table */
+  /* Create exponential interpolation table */
   for (int i=0; i < num_array_values; i++) {
     for (int p=0; p < num_polar; p++) {
       sin_theta = _polar_quad->getSinTheta(p);
+      FP_PRECISION* coeffs = &_exp_table[i * _bin_stride + p * num_coeffs];
+
+      /* Linear interpolation with the tangent of the exponential */
+      if (_interpolation_order == 1) {
+
+        /* Use the optical length at the start of the interval for the first
+         * value to avoid exponential values greater than one. */
+        if (i == 0)
+          tau = i * _exp_table_spacing;
+
+        /* Use the optical length at the interval mid-point to reduce error. */
+        else
+          tau = (i + 0.5) * _exp_table_spacing;
+
+        expon = exp(- tau / sin_theta);
+        intercept = expon * (1 + tau / sin_theta);
+        slope = - expon / sin_theta;
+        coeffs[0] = slope;
+        coeffs[1] = intercept;
+      }
+
+      /* Taylor expansion of 1 - exp(-tau/sin(theta)) at the mid-point */
+      else {
+        tau = (i + 0.5) * _exp_table_spacing;
+        expon = exp(- tau / sin_theta);
+        coeffs[0] = 1. - expon;
+        coeffs[1] = expon / sin_theta;
+
+        for (int n=2; n < num_coeffs; n++)
+          coeffs[n] = - coeffs[n-1] / (n * sin_theta);
+      }
+    }
+  }
 
-      /* Use the optical length at the start of the interval for the first value
-       * to avoid exponential values greater than one. */
-      if (i == 0)
-        tau = i * exp_table_spacing;
+  if (!_linear_source)
+    return;
 
-      /* Use the optical length at the interval mid-point to reduce error. */
-      else
-        tau = (i + 0.5) * exp_table_spacing;
+  /* The linear source terms share the bins of the linear table such that
+   * they are found with a single lookup. The second derivatives of F2 and
+   * H are at most 1/6 of that of the exponential such that the table for
+   * higher order interpolation uses the historical linear spacing with
+   * wider bins. */
+  if (_interpolation_order != 1) {
+    num_array_values = _max_optical_length *
+                       sqrt(1. / (48. * _exp_precision));
+    num_array_values = std::max(num_array_values, 1);
+    _linear_source_spacing = _max_optical_length / num_array_values;
+    num_array_values += 1;
+  }
+  else
+    _linear_source_spacing = _exp_table_spacing;
 
-      expon = exp(- tau / sin_theta);
-      intercept = expon * (1 + tau / sin_theta);
-      slope = - expon / sin_theta;
-      _exp_table[_two_times_num_polar * i + 2 * p] = slope;
-      _exp_table[_two_times_num_polar * i + 2 * p + 1] = intercept;
+  _inverse_linear_source_spacing = 1.0 / _linear_source_spacing;
+
+  if (_linear_source_table != NULL)
+    delete [] _linear_source_table;
+
+  _linear_source_table = new FP_PRECISION[num_array_values * num_polar * 6];
+
+  double F1, F2_start, F2_end, H_start, H_end;
+
+  for (int i=0; i < num_array_values; i++) {
+    for (int p=0; p < num_polar; p++) {
+      sin_theta = _polar_quad->getSinTheta(p);
+      FP_PRECISION* coeffs = &_linear_source_table[(i * num_polar + p) * 6];
+
+      /* Copy the coefficients of the exponential from the linear table */
+      if (_interpolation_order == 1) {
+        coeffs[0] = _exp_table[i * _bin_stride + 2 * p];
+        coeffs[1] = _exp_table[i * _bin_stride + 2 * p + 1];
+      }
+      else {
+        coeffs[0] = 0.;
+        coeffs[1] = 0.;
+      }
+
+      /* Interpolate F2 and H linearly between the edges of each bin */
+      evaluateLinearSourceExponentials(i * _linear_source_spacing / sin_theta,
+                                       &F1, &F2_start, &H_start);
+      evaluateLinearSourceExponentials((i + 1) * _linear_source_spacing /
+                                       sin_theta, &F1, &F2_end, &H_end);
+
+      coeffs[2] = (F2_end - F2_start) * _inverse_linear_source_spacing;
+      coeffs[3] = F2_start - coeffs[2] * i * _linear_source_spacing;
+      coeffs[4] = (H_end - H_start) * _inverse_linear_source_spacing;
+      coeffs[5] = H_start - coeffs[4] * i * _linear_source_spacing;
     }
   }
 }
+
+
+/**
+ * @brief Computes the exponential terms of the linear source transport
+ *        equation in double precision.
+ * @details The terms F1, F2 and H are defined for
+ *          computeLinearSourceExponentials(...). F2 and H are evaluated
+ *          with their Taylor series for small optical lengths for which the
+ *          closed forms would cancel.
+ * @param tau the optical length along the characteristic (not projected)
+ * @param F1 a pointer to store the F1 term
+ * @param F2 a pointer to store the F2 term
+ * @param H a pointer to store the H term
+ */
+void ExpEvaluator::evaluateLinearSourceExponentials(double tau, double* F1,
+                                                    double* F2, double* H) {
+
+  *F1 = -expm1(-tau);
+
+  if (tau < 1E-3) {
+    *H = tau * (-1. / 12. + tau * (1. / 24. + tau * (-1. / 80. +
+                                                     tau / 360.)));
+    *F2 = *H * tau;
+  }
+  else {
+    *F2 = (1. / tau + 0.5) * *F1 - 1.;
+    *H = *F2 / tau;
+  }
+}
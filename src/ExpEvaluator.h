@@ -28,24 +28,49 @@ class ExpEvaluator {
 
 private:
 
-  /** A boolean indicating whether or not to use linear interpolation */
+  /** A boolean indicating whether or not to use an interpolation table */
   bool _interpolate;
 
-  /** The inverse spacing for the exponential linear interpolation table */
+  /** The order of the interpolation polynomials (1, 2 or 3) */
+  int _interpolation_order;
+
+  /** The spacing for the exponential interpolation table */
+  FP_PRECISION _exp_table_spacing;
+
+  /** The inverse spacing for the exponential interpolation table */
   FP_PRECISION _inverse_exp_table_spacing;
 
-  /** The number of entries in the exponential linear interpolation table */
+  /** The number of entries in the exponential interpolation table */
   int _table_size;
 
-  /** The exponential linear interpolation table */
+  /** The exponential interpolation table */
   FP_PRECISION* _exp_table;
 
   /** The PolarQuad object of interest */
   PolarQuad* _polar_quad;
 
+  /** The number of polar angles */
+  int _num_polar;
+
   /** Twice the number of polar angles */
   int _two_times_num_polar;
 
+  /** The number of table entries for each tau bin (# polar x # coefficients) */
+  int _bin_stride;
+
+  /** A boolean indicating whether to evaluate the linear source terms */
+  bool _linear_source;
+
+  /** The spacing for the linear source interpolation table */
+  FP_PRECISION _linear_source_spacing;
+
+  /** The inverse spacing for the linear source interpolation table */
+  FP_PRECISION _inverse_linear_source_spacing;
+
+  /** The linear source interpolation table (slope and intercept of F1, F2
+   *  and H for each polar angle in each tau bin) */
+  FP_PRECISION* _linear_source_table;
+
   /** The maximum optical length a track is allowed to have */
   FP_PRECISION _max_optical_length;
 
@@ -60,18 +85,28 @@ public:
   void setPolarQuadrature(PolarQuad* polar_quad);
   void setMaxOpticalLength(FP_PRECISION max_optical_length);
   void setExpPrecision(FP_PRECISION exp_precision);
+  void setInterpolationOrder(int order);
   void useInterpolation();
   void useIntrinsic();
+  void useLinearSource(bool linear_source);
 
   FP_PRECISION getMaxOpticalLength();
   FP_PRECISION getExpPrecision();
   bool isUsingInterpolation();
+  bool isUsingLinearSource();
+  int getInterpolationOrder();
   FP_PRECISION getTableSpacing();
   int getTableSize();
   FP_PRECISION* getExpTable();
 
   void initialize();
   FP_PRECISION computeExponential(FP_PRECISION tau, int polar);
+  void computeLinearSourceExponentials(FP_PRECISION tau, int polar,
+                                       FP_PRECISION* F1, FP_PRECISION* F2,
+                                       FP_PRECISION* H);
+
+  static void evaluateLinearSourceExponentials(double tau, double* F1,
+                                               double* F2, double* H);
 };
 
 
@@ -79,8 +114,11 @@ public:
  * @brief Computes the exponential term for a optical length and polar angle.
  * @details This method computes \f$ 1 - exp(-\tau/sin(\theta_p)) \f$
  *          for some optical path length and polar angle. This method
- *          uses either a linear interpolation table (default) or the
- *          exponential intrinsic exp(...) function.
+ *          uses either an interpolation table (default) or the
+ *          exponential intrinsic exp(...) function. The coefficients of all
+ *          polar angles for a tau bin are contiguous in the table. The
+ *          quadratic and cubic polynomials are evaluated in the offset of
+ *          tau from the center of its bin.
  * @param tau the optical path length (e.g., sigma_t times length)
  * @param polar the polar angle index
  * @return the evaluated exponential
@@ -90,13 +128,30 @@ inline FP_PRECISION ExpEvaluator::computeExponential(FP_PRECISION tau,
 
   FP_PRECISION exponential;
 
-  /* Evaluate the exponential using the lookup table - linear interpolation */
+  /* Evaluate the exponential using the lookup table */
   if (_interpolate) {
     tau = std::min(tau, (_max_optical_length));
-    int index = floor(tau * _inverse_exp_table_spacing);
-    index *= _two_times_num_polar;
-    exponential = (1. - (_exp_table[index + 2 * polar] * tau +
-                  _exp_table[index + 2 * polar + 1]));
+    int bin = floor(tau * _inverse_exp_table_spacing);
+
+    /* Linear interpolation */
+    if (_interpolation_order == 1) {
+      int index = bin * _two_times_num_polar;
+      exponential = (1. - (_exp_table[index + 2 * polar] * tau +
+                    _exp_table[index + 2 * polar + 1]));
+    }
+
+    /* Quadratic or cubic interpolation about the center of the bin */
+    else {
+      FP_PRECISION* coeffs = &_exp_table[bin * _bin_stride +
+                                         polar * (_interpolation_order + 1)];
+      FP_PRECISION dt = tau - (bin + 0.5) * _exp_table_spacing;
+
+      if (_interpolation_order == 2)
+        exponential = coeffs[0] + dt * (coeffs[1] + dt * coeffs[2]);
+      else
+        exponential = coeffs[0] + dt * (coeffs[1] + dt * (coeffs[2] +
+                                                          dt * coeffs[3]));
+    }
   }
 
   /* Evalute the exponential using the intrinsic exp(...) function */
@@ -108,4 +163,54 @@ inline FP_PRECISION ExpEvaluator::computeExponential(FP_PRECISION tau,
   return exponential;
 }
 
+
+/**
+ * @brief Computes the exponential terms of the linear source transport
+ *        equation for an optical length and polar angle.
+ * @details For \f$ \tau_p = \tau/sin(\theta_p) \f$, the terms are
+ *          \f$ F_1 = 1 - exp(-\tau_p) \f$,
+ *          \f$ F_2 = (1/\tau_p + 1/2) F_1 - 1 \f$ and
+ *          \f$ H = F_2 / \tau_p \f$. If interpolation is in use, the
+ *          three terms are linearly interpolated from the same tau bin of a
+ *          single table, except for F1 with quadratic or cubic
+ *          interpolation which is evaluated by computeExponential(...).
+ * @param tau the optical path length (e.g., sigma_t times length)
+ * @param polar the polar angle index
+ * @param F1 a pointer to store the F1 term
+ * @param F2 a pointer to store the F2 term
+ * @param H a pointer to store the H term
+ */
+inline void ExpEvaluator::computeLinearSourceExponentials(FP_PRECISION tau,
+                                                          int polar,
+                                                          FP_PRECISION* F1,
+                                                          FP_PRECISION* F2,
+                                                          FP_PRECISION* H) {
+
+  /* Evaluate the terms using the lookup table */
+  if (_interpolate) {
+    FP_PRECISION tau_table = std::min(tau, (_max_optical_length));
+    int bin = floor(tau_table * _inverse_linear_source_spacing);
+    FP_PRECISION* coeffs = &_linear_source_table[(bin * _num_polar + polar)
+                                                 * 6];
+    if (_interpolation_order == 1)
+      *F1 = 1. - (coeffs[0] * tau_table + coeffs[1]);
+    else
+      *F1 = computeExponential(tau, polar);
+
+    *F2 = coeffs[2] * tau_table + coeffs[3];
+    *H = coeffs[4] * tau_table + coeffs[5];
+  }
+
+  /* Evaluate the terms using the exponential intrinsic */
+  else {
+    double F1_exact, F2_exact, H_exact;
+    evaluateLinearSourceExponentials(tau / _polar_quad->getSinTheta(polar),
+                                     &F1_exact, &F2_exact, &H_exact);
+    *F1 = F1_exact;
+    *F2 = F2_exact;
+    *H = H_exact;
+  }
+}
+
+
 #endif /* EXPEVALUATOR_H_ */
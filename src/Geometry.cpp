@@ -20,6 +20,19 @@ Geometry::Geometry() {
 
   /* Initialize CMFD object to NULL */
   _cmfd = NULL;
+
+  _x_symmetry = false;
+  _y_symmetry = false;
+  _x_symmetry_plane = 0.;
+  _y_symmetry_plane = 0.;
+
+  _num_instances = 0;
+
+  /* The whole Geometry is solved in a single domain by default */
+  _num_domains_x = 1;
+  _num_domains_y = 1;
+  _domain_index_x = 0;
+  _domain_index_y = 0;
 }
 
 
@@ -40,6 +53,9 @@ Geometry::~Geometry() {
     _FSRs_to_keys.clear();
   }
 
+  /* Free any segment templates left over from modular ray tracing */
+  clearSegmentTemplates();
+
   /* Remove all Materials in the Geometry */
   std::map<int, Material*> materials = getAllMaterials();
   std::map<int, Cell*> cells = getAllCells();
@@ -91,37 +107,71 @@ double Geometry::getWidthZ() {
 
 /**
  * @brief Return the minimum x-coordinate contained by the Geometry.
+ * @details This is the x symmetry plane if only the half of the Geometry
+ *          above it is solved, or the x-min interface of this domain if the
+ *          Geometry is decomposed into domains.
  * @return the minimum x-coordinate (cm)
  */
 double Geometry::getMinX() {
-  return _root_universe->getMinX();
+
+  double min_x = _x_symmetry ? _x_symmetry_plane : _root_universe->getMinX();
+  if (_domain_index_x == 0)
+    return min_x;
+
+  double max_x = _root_universe->getMaxX();
+  return min_x + (max_x - min_x) * _domain_index_x / _num_domains_x;
 }
 
 
 /**
  * @brief Return the maximum x-coordinate contained by the Geometry.
+ * @details This is the x-max interface of this domain if the Geometry is
+ *          decomposed into domains.
  * @return the maximum x-coordinate (cm)
  */
 double Geometry::getMaxX() {
-  return _root_universe->getMaxX();
+
+  double max_x = _root_universe->getMaxX();
+  if (_domain_index_x == _num_domains_x - 1)
+    return max_x;
+
+  double min_x = _x_symmetry ? _x_symmetry_plane : _root_universe->getMinX();
+  return min_x + (max_x - min_x) * (_domain_index_x + 1) / _num_domains_x;
 }
 
 
 /**
  * @brief Return the minimum y-coordinate contained by the Geometry.
+ * @details This is the y-min interface of this domain if the Geometry is
+ *          decomposed into domains.
  * @return the minimum y-coordinate (cm)
  */
 double Geometry::getMinY() {
-  return _root_universe->getMinY();
+
+  double min_y = _root_universe->getMinY();
+  if (_domain_index_y == 0)
+    return min_y;
+
+  double max_y = _y_symmetry ? _y_symmetry_plane : _root_universe->getMaxY();
+  return min_y + (max_y - min_y) * _domain_index_y / _num_domains_y;
 }
 
 
 /**
  * @brief Return the maximum y-coordinate contained by the Geometry.
+ * @details This is the y symmetry plane if only the half of the Geometry
+ *          below it is solved, or the y-max interface of this domain if the
+ *          Geometry is decomposed into domains.
  * @return the maximum y-coordinate (cm)
  */
 double Geometry::getMaxY() {
-  return _root_universe->getMaxY();
+
+  double max_y = _y_symmetry ? _y_symmetry_plane : _root_universe->getMaxY();
+  if (_domain_index_y == _num_domains_y - 1)
+    return max_y;
+
+  double min_y = _root_universe->getMinY();
+  return min_y + (max_y - min_y) * (_domain_index_y + 1) / _num_domains_y;
 }
 
 
@@ -149,6 +199,10 @@ double Geometry::getMaxZ() {
  * @return the boundary conditions for the minimum x-coordinate in the Geometry
  */
 boundaryType Geometry::getMinXBoundaryType() {
+  if (_domain_index_x > 0)
+    return INTERFACE;
+  if (_x_symmetry)
+    return REFLECTIVE;
   return _root_universe->getMinXBoundaryType();
 }
 
@@ -159,6 +213,8 @@ boundaryType Geometry::getMinXBoundaryType() {
  * @return the boundary conditions for the maximum z-coordinate in the Geometry
  */
 boundaryType Geometry::getMaxXBoundaryType() {
+  if (_domain_index_x < _num_domains_x - 1)
+    return INTERFACE;
   return _root_universe->getMaxXBoundaryType();
 }
 
@@ -169,6 +225,8 @@ boundaryType Geometry::getMaxXBoundaryType() {
  * @return the boundary conditions for the minimum y-coordinate in the Geometry
  */
 boundaryType Geometry::getMinYBoundaryType() {
+  if (_domain_index_y > 0)
+    return INTERFACE;
   return _root_universe->getMinYBoundaryType();
 }
 
@@ -179,10 +237,72 @@ boundaryType Geometry::getMinYBoundaryType() {
  * @return the boundary conditions for the maximum y-coordinate in the Geometry
  */
 boundaryType Geometry::getMaxYBoundaryType() {
+  if (_domain_index_y < _num_domains_y - 1)
+    return INTERFACE;
+  if (_y_symmetry)
+    return REFLECTIVE;
   return _root_universe->getMaxYBoundaryType();
 }
 
 
+/**
+ * @brief Returns whether only the half of the Geometry above its x symmetry
+ *        plane is solved.
+ * @return whether the x symmetry is used
+ */
+bool Geometry::getXSymmetry() {
+  return _x_symmetry;
+}
+
+
+/**
+ * @brief Returns whether only the half of the Geometry below its y symmetry
+ *        plane is solved.
+ * @return whether the y symmetry is used
+ */
+bool Geometry::getYSymmetry() {
+  return _y_symmetry;
+}
+
+
+/**
+ * @brief Returns the number of domains the Geometry is decomposed into
+ *        along the x-axis.
+ * @return the number of domains along the x-axis
+ */
+int Geometry::getNumDomainsX() {
+  return _num_domains_x;
+}
+
+
+/**
+ * @brief Returns the number of domains the Geometry is decomposed into
+ *        along the y-axis.
+ * @return the number of domains along the y-axis
+ */
+int Geometry::getNumDomainsY() {
+  return _num_domains_y;
+}
+
+
+/**
+ * @brief Returns the index along the x-axis of the domain which is solved.
+ * @return the domain index along the x-axis
+ */
+int Geometry::getDomainIndexX() {
+  return _domain_index_x;
+}
+
+
+/**
+ * @brief Returns the index along the y-axis of the domain which is solved.
+ * @return the domain index along the y-axis
+ */
+int Geometry::getDomainIndexY() {
+  return _domain_index_y;
+}
+
+
 /**
  * @brief Returns the number of flat source regions in the Geometry.
  * @return number of FSRs
@@ -402,6 +522,246 @@ void Geometry::setCmfd(Cmfd* cmfd) {
 }
 
 
+/**
+ * @brief Sizes the FSR maps and the segment templates for ray tracing by a
+ *        number of concurrent threads.
+ * @details The thread-safe maps are sized for the number of OpenMP threads
+ *          when the Geometry is created. This must be called before Tracks
+ *          are segmentized by more threads, such as when the Solver traces
+ *          the Tracks on-the-fly with more threads than the TrackGenerator.
+ * @param num_threads the number of threads
+ */
+void Geometry::setNumThreads(int num_threads) {
+  _FSR_keys_map.setNumThreads(num_threads);
+  _FSR_instances_map.setNumThreads(num_threads);
+  _segment_templates.setNumThreads(num_threads);
+}
+
+
+/**
+ * @brief Solves only the half or quarter of a mirror symmetric Geometry.
+ * @details Full core models with the same boundary conditions on opposite
+ *          sides of the Geometry are often symmetric about the planes
+ *          through the center of the core. With x symmetry, only the half of
+ *          the Geometry above the x symmetry plane is solved, with a
+ *          reflective boundary at the symmetry plane, and similarly the half
+ *          below the y symmetry plane with y symmetry. The Tracks and FSRs
+ *          are only generated within the solved part of the Geometry, which
+ *          divides the ray tracing, the memory and the transport sweeps by
+ *          the symmetry factor. The symmetry of the Geometry is verified by
+ *          comparing the Materials along many lines across the Geometry with
+ *          those of their mirror images. Points in the parts of the Geometry
+ *          which are not solved are mapped to their mirror images when their
+ *          Cells and FSRs are found, such that the FSR fluxes may be queried
+ *          throughout the full Geometry. This must be called before the
+ *          Tracks are generated, and a CMFD mesh must cover the solved part
+ *          of the Geometry. This may be called from Python as follows:
+ *
+ * @code
+ *          geometry.useSymmetry(True, True)
+ * @endcode
+ *
+ * @param x_symmetry whether to solve only the half above the x symmetry plane
+ * @param y_symmetry whether to solve only the half below the y symmetry plane
+ */
+void Geometry::useSymmetry(bool x_symmetry, bool y_symmetry) {
+
+  if (_root_universe == NULL)
+    log_printf(ERROR, "Unable to use the symmetry of the Geometry before "
+               "its root Universe is set");
+
+  if (_FSR_keys_map.size() != 0)
+    log_printf(ERROR, "Unable to use the symmetry of the Geometry after its "
+               "FSRs have been created");
+
+  if (_num_domains_x * _num_domains_y > 1)
+    log_printf(ERROR, "Unable to use the symmetry of the Geometry after it "
+               "has been decomposed into domains");
+
+  /* Verify the symmetry of the full Geometry */
+  _x_symmetry = false;
+  _y_symmetry = false;
+
+  if (x_symmetry) {
+    boundaryType bc = getMinXBoundaryType();
+    if (bc != getMaxXBoundaryType() || (bc != REFLECTIVE && bc != VACUUM))
+      log_printf(ERROR, "Unable to use the x symmetry of the Geometry since "
+                 "its x-min and x-max boundaries are not both REFLECTIVE or "
+                 "VACUUM");
+
+    _x_symmetry_plane = (getMinX() + getMaxX()) / 2.;
+
+    if (!isMirrorSymmetric(true))
+      log_printf(ERROR, "Unable to use the x symmetry of the Geometry since "
+                 "it is not mirror symmetric about x = %f", _x_symmetry_plane);
+  }
+
+  if (y_symmetry) {
+    boundaryType bc = getMinYBoundaryType();
+    if (bc != getMaxYBoundaryType() || (bc != REFLECTIVE && bc != VACUUM))
+      log_printf(ERROR, "Unable to use the y symmetry of the Geometry since "
+                 "its y-min and y-max boundaries are not both REFLECTIVE or "
+                 "VACUUM");
+
+    _y_symmetry_plane = (getMinY() + getMaxY()) / 2.;
+
+    if (!isMirrorSymmetric(false))
+      log_printf(ERROR, "Unable to use the y symmetry of the Geometry since "
+                 "it is not mirror symmetric about y = %f", _y_symmetry_plane);
+  }
+
+  _x_symmetry = x_symmetry;
+  _y_symmetry = y_symmetry;
+
+  if (x_symmetry || y_symmetry)
+    log_printf(NORMAL, "Solving 1/%d of the Geometry using its symmetry",
+               (x_symmetry ? 2 : 1) * (y_symmetry ? 2 : 1));
+}
+
+
+/**
+ * @brief Restricts the Geometry to one of the domains of a spatial domain
+ *        decomposition.
+ * @details The Geometry (or the part of it which is solved using its
+ *          symmetry) is decomposed into a uniform grid of rectangular
+ *          domains. Each domain is solved by its own TrackGenerator and
+ *          Solver, typically on its own MPI rank, which only hold the Tracks,
+ *          segments and FSRs within the domain. The interfaces between
+ *          domains have INTERFACE boundary conditions, across which the
+ *          Solvers exchange the angular fluxes of the Tracks through a
+ *          Communicator. Since all domains have the same widths, their Track
+ *          laydowns are identical and each Track leaving a domain continues
+ *          on the same Track of the neighboring domain. The domains are
+ *          numbered by the Communicator ranks domain_index_y * num_domains_x
+ *          + domain_index_x. This must be called before the Tracks are
+ *          generated. This may be called from Python as follows:
+ *
+ * @code
+ *          geometry.setDomain(2, 2, rank % 2, rank / 2)
+ * @endcode
+ *
+ * @param num_domains_x the number of domains along the x-axis
+ * @param num_domains_y the number of domains along the y-axis
+ * @param domain_index_x the index along the x-axis of the domain to solve
+ * @param domain_index_y the index along the y-axis of the domain to solve
+ */
+void Geometry::setDomain(int num_domains_x, int num_domains_y,
+                         int domain_index_x, int domain_index_y) {
+
+  if (_root_universe == NULL)
+    log_printf(ERROR, "Unable to decompose the Geometry into domains before "
+               "its root Universe is set");
+
+  if (_FSR_keys_map.size() != 0)
+    log_printf(ERROR, "Unable to decompose the Geometry into domains after "
+               "its FSRs have been created");
+
+  if (num_domains_x <= 0 || num_domains_y <= 0)
+    log_printf(ERROR, "Unable to decompose the Geometry into %d x %d "
+               "domains", num_domains_x, num_domains_y);
+
+  if (domain_index_x < 0 || domain_index_x >= num_domains_x ||
+      domain_index_y < 0 || domain_index_y >= num_domains_y)
+    log_printf(ERROR, "Unable to solve domain (%d, %d) of the Geometry "
+               "decomposed into %d x %d domains", domain_index_x,
+               domain_index_y, num_domains_x, num_domains_y);
+
+  /* Check the boundary conditions of the undecomposed Geometry */
+  _num_domains_x = 1;
+  _num_domains_y = 1;
+  _domain_index_x = 0;
+  _domain_index_y = 0;
+
+  if ((num_domains_x > 1 && getMinXBoundaryType() == PERIODIC) ||
+      (num_domains_y > 1 && getMinYBoundaryType() == PERIODIC))
+    log_printf(ERROR, "Unable to decompose the Geometry into domains across "
+               "its PERIODIC boundaries");
+
+  _num_domains_x = num_domains_x;
+  _num_domains_y = num_domains_y;
+  _domain_index_x = domain_index_x;
+  _domain_index_y = domain_index_y;
+
+  log_printf(NORMAL, "Solving domain (%d, %d) of %d x %d domains of the "
+             "Geometry", domain_index_x, domain_index_y, num_domains_x,
+             num_domains_y);
+}
+
+
+/**
+ * @brief Determines whether the Geometry is mirror symmetric about the plane
+ *        through its center perpendicular to the x- or y-axis.
+ * @details The Materials along NUM_SYMMETRY_LINES lines across the Geometry
+ *          perpendicular to the plane are compared with those of their
+ *          mirror images. The lines are traced through the nested Universe
+ *          hierarchy, and adjacent Cells with the same Material are merged
+ *          such that the FSR subdivisions of the Cells need not be symmetric.
+ * @param x_plane whether to check the symmetry about the x (or y) plane
+ * @return whether the Geometry is mirror symmetric
+ */
+bool Geometry::isMirrorSymmetric(bool x_plane) {
+
+  double min = x_plane ? getMinX() : getMinY();
+  double max = x_plane ? getMaxX() : getMaxY();
+  double min_perp = x_plane ? getMinY() : getMinX();
+  double max_perp = x_plane ? getMaxY() : getMaxX();
+
+  if (std::isinf(max - min) || std::isinf(max_perp - min_perp))
+    log_printf(ERROR, "Unable to check the symmetry of a Geometry which is "
+               "not bounded in x and y");
+
+  for (int i=0; i < NUM_SYMMETRY_LINES; i++) {
+
+    double perp = min_perp + (max_perp - min_perp) * (i + 0.5) /
+                  NUM_SYMMETRY_LINES;
+    LocalCoords coords(x_plane ? min : perp, x_plane ? perp : min, 0.);
+    coords.setUniverse(_root_universe);
+    coords.setPhi(x_plane ? 0. : M_PI / 2.);
+
+    /* The Materials along the line and the positions where they end */
+    std::vector<Material*> materials;
+    std::vector<double> ends;
+
+    Cell* cell = findFirstCell(&coords);
+
+    while (cell != NULL) {
+
+      Material* material = cell->getFillMaterial();
+
+      double dist = findNextSurfaceDist(&coords);
+      coords.prune();
+      coords.adjustCoords(dist + TINY_MOVE);
+      double end = x_plane ? coords.getX() : coords.getY();
+
+      /* Merge adjacent Cells with the same Material */
+      if (materials.size() > 0 && materials.back() == material)
+        ends.back() = end;
+      else {
+        materials.push_back(material);
+        ends.push_back(end);
+      }
+
+      cell = findCellContainingCoords(&coords);
+    }
+
+    coords.prune();
+
+    /* Compare the Materials and their boundaries with their mirror images */
+    int num_materials = materials.size();
+    for (int m=0; m < num_materials; m++) {
+      if (materials[m] != materials[num_materials-1-m])
+        return false;
+      if (m < num_materials - 1 &&
+          fabs((ends[m] - min) - (max - ends[num_materials-2-m]))
+          > SYMMETRY_THRESH)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+
 /**
  * @brief Find the Cell that this LocalCoords object is in at the lowest level
  *        of the nested Universe hierarchy.
@@ -415,7 +775,9 @@ void Geometry::setCmfd(Cmfd* cmfd) {
  *          or Universe that it is in. If the LocalCoords is outside the bounds
  *          of the Geometry or on the boundaries this method will return NULL;
  *          otherwise it will return a pointer to the Cell that is found by the
- *          recursive Geometry::findCell(...) method.
+ *          recursive Geometry::findCell(...) method. If the Geometry is
+ *          reduced by symmetry, a LocalCoords in a region which is not solved
+ *          is first moved to its mirror image.
  * @param coords pointer to a LocalCoords object
  * @return returns a pointer to a Cell if found, NULL if no Cell found
  */
@@ -425,6 +787,7 @@ Cell* Geometry::findCellContainingCoords(LocalCoords* coords) {
   Cell* cell;
 
   if (univ->getId() == _root_universe->getId()) {
+    applySymmetry(coords);
     if (!withinBounds(coords))
       return NULL;
   }
@@ -438,6 +801,28 @@ Cell* Geometry::findCellContainingCoords(LocalCoords* coords) {
 }
 
 
+/**
+ * @brief Moves a LocalCoords in a part of the Geometry which is not solved
+ *        due to its symmetry to its mirror image.
+ * @details The LocalCoords' coordinates and azimuthal angle are reflected
+ *          about the symmetry planes which it lies beyond. This is a no-op
+ *          for a Geometry which is not reduced by symmetry.
+ * @param coords pointer to the highest level of a LocalCoords linked list
+ */
+void Geometry::applySymmetry(LocalCoords* coords) {
+
+  if (_x_symmetry && coords->getX() < _x_symmetry_plane) {
+    coords->setX(2 * _x_symmetry_plane - coords->getX());
+    coords->setPhi(M_PI - coords->getPhi());
+  }
+
+  if (_y_symmetry && coords->getY() > _y_symmetry_plane) {
+    coords->setY(2 * _y_symmetry_plane - coords->getY());
+    coords->setPhi(2 * M_PI - coords->getPhi());
+  }
+}
+
+
 /**
  * @brief Find the first Cell of a Track segment with a starting Point that is
  *        represented by the LocalCoords method parameter.
@@ -505,35 +890,7 @@ Cell* Geometry::findNextCell(LocalCoords* coords) {
   /* If the current coords is inside a Cell, look for next Cell */
   else {
 
-    /* Descend universes until at the lowest level.
-     * At each universe/lattice level get distance to next
-     * universe or lattice cell. Recheck min_dist. */
-    while (coords != NULL) {
-
-      /* If we reach a LocalCoord in a Lattice, find the distance to the
-       * nearest lattice cell boundary */
-      if (coords->getType() == LAT) {
-        Lattice* lattice = coords->getLattice();
-        dist = lattice->minSurfaceDist(coords);
-      }
-      /* If we reach a LocalCoord in a Universe, find the distance to the
-       * nearest cell surface */
-      else {
-        Cell* cell = coords->getCell();
-        dist = cell->minSurfaceDist(coords);
-      }
-
-      /* Recheck min distance */
-      min_dist = std::min(dist, min_dist);
-
-      /* Descend one level */
-      if (coords->getNext() == NULL)
-	break;
-      else
- 	coords = coords->getNext();
-    }
-
-    coords = coords->getHighestLevel();
+    min_dist = findNextSurfaceDist(coords);
     coords->prune();
 
     /* Check for distance to nearest CMFD mesh cell boundary */
@@ -543,14 +900,95 @@ Cell* Geometry::findNextCell(LocalCoords* coords) {
       min_dist = std::min(dist, min_dist);
     }
 
+    /* Check for distance to the symmetry planes and domain interfaces */
+    min_dist = std::min(min_dist, findInternalBoundaryDist(coords));
+
     /* Move point and get next cell */
     coords->adjustCoords(min_dist + TINY_MOVE);
 
+    /* Do not move a point beyond a symmetry plane to its mirror image or
+     * beyond a domain interface */
+    if (!withinBounds(coords))
+      return NULL;
+
     return findCellContainingCoords(coords);
   }
 }
 
 
+/**
+ * @brief Finds the distance along a LocalCoords' trajectory to the nearest
+ *        Surface or Lattice cell boundary at any level of the nested
+ *        Universe hierarchy.
+ * @param coords pointer to the highest level of a LocalCoords linked list
+ * @return the distance to the nearest boundary (cm)
+ */
+double Geometry::findNextSurfaceDist(LocalCoords* coords) {
+
+  double dist;
+  double min_dist = std::numeric_limits<double>::infinity();
+
+  /* Descend universes until at the lowest level.
+   * At each universe/lattice level get distance to next
+   * universe or lattice cell. Recheck min_dist. */
+  while (coords != NULL) {
+
+    /* If we reach a LocalCoord in a Lattice, find the distance to the
+     * nearest lattice cell boundary */
+    if (coords->getType() == LAT) {
+      Lattice* lattice = coords->getLattice();
+      dist = lattice->minSurfaceDist(coords);
+    }
+    /* If we reach a LocalCoord in a Universe, find the distance to the
+     * nearest cell surface */
+    else {
+      Cell* cell = coords->getCell();
+      dist = cell->minSurfaceDist(coords);
+    }
+
+    /* Recheck min distance */
+    min_dist = std::min(dist, min_dist);
+
+    /* Descend one level */
+    coords = coords->getNext();
+  }
+
+  return min_dist;
+}
+
+
+/**
+ * @brief Finds the distance along a LocalCoords' trajectory to the symmetry
+ *        planes and domain interfaces bounding the part of the Geometry
+ *        which is solved.
+ * @details These boundaries lie inside the root Universe and need not
+ *          coincide with any Surface or Lattice cell boundary.
+ * @param coords pointer to the highest level of a LocalCoords linked list
+ * @return the distance to the nearest internal boundary (cm), or infinity if
+ *         the trajectory does not cross one
+ */
+double Geometry::findInternalBoundaryDist(LocalCoords* coords) {
+
+  double min_dist = std::numeric_limits<double>::infinity();
+  double cos_phi = cos(coords->getPhi());
+  double sin_phi = sin(coords->getPhi());
+
+  if (cos_phi < 0. && (_x_symmetry || _domain_index_x > 0))
+    min_dist = std::min(min_dist, (getMinX() - coords->getX()) / cos_phi);
+
+  if (cos_phi > 0. && _domain_index_x < _num_domains_x - 1)
+    min_dist = std::min(min_dist, (getMaxX() - coords->getX()) / cos_phi);
+
+  if (sin_phi < 0. && _domain_index_y > 0)
+    min_dist = std::min(min_dist, (getMinY() - coords->getY()) / sin_phi);
+
+  if (sin_phi > 0. && (_y_symmetry || _domain_index_y < _num_domains_y - 1))
+    min_dist = std::min(min_dist, (getMaxY() - coords->getY()) / sin_phi);
+
+  return std::max(min_dist, 0.);
+}
+
+
 /**
  * @brief Find and return the ID of the flat source region that a given
  *        LocalCoords object resides within.
@@ -559,13 +997,42 @@ Cell* Geometry::findNextCell(LocalCoords* coords) {
  */
 int Geometry::findFSRId(LocalCoords* coords) {
 
-  int fsr_id;
-  LocalCoords* curr = coords;
-  curr = coords->getLowestLevel();
+  LocalCoords* curr = coords->getLowestLevel();
 
   /* Generate unique FSR key */
   std::string fsr_key = getFSRKey(coords);
 
+  /* If FSR has already been encountered, the FSR data is not needed */
+  if (_FSR_keys_map.contains(fsr_key))
+    return findFSRId(fsr_key, NULL, -1, -1);
+
+  /* Find the Material and CMFD cell in case the FSR must be added */
+  Cell* cell = findCellContainingCoords(curr);
+  int mat_id = cell->getFillMaterial()->getId();
+  int cmfd_cell = -1;
+  if (_cmfd != NULL)
+    cmfd_cell = _cmfd->findCmfdCell(coords->getHighestLevel());
+
+  return findFSRId(fsr_key, coords->getHighestLevel()->getPoint(),
+                   mat_id, cmfd_cell);
+}
+
+
+/**
+ * @brief Find and return the ID of the flat source region with a given key,
+ *        adding it to the FSR map if it has not yet been encountered.
+ * @param fsr_key the unique FSR key
+ * @param point a characteristic Point in the Root Universe within the FSR
+ *        (only used if the FSR has not yet been encountered)
+ * @param mat_id the ID of the Material filling the FSR
+ * @param cmfd_cell the CMFD cell containing the FSR (if CMFD is used)
+ * @return the FSR ID for the FSR key
+ */
+int Geometry::findFSRId(std::string& fsr_key, Point* point, int mat_id,
+                        int cmfd_cell) {
+
+  int fsr_id;
+
   /* If FSR has not been encountered, update FSR maps and vectors */
   if (!_FSR_keys_map.contains(fsr_key)) {
 
@@ -586,19 +1053,13 @@ int Geometry::findFSRId(LocalCoords* coords) {
       fsr_data* fsr = new fsr_data;
       fsr->_fsr_id = fsr_id;
       _FSR_keys_map.update(fsr_key, fsr);
-      Point* point = new Point();
-      point->setCoords(coords->getHighestLevel()->getX(),
-                       coords->getHighestLevel()->getY(),
-                       coords->getHighestLevel()->getZ());
-
-      /* Get the cell that contains coords */
-      Cell* cell = findCellContainingCoords(curr);
-      fsr->_point = point;
-      fsr->_mat_id = cell->getFillMaterial()->getId();
+      fsr->_point = new Point();
+      fsr->_point->setCoords(point->getX(), point->getY(), point->getZ());
+      fsr->_mat_id = mat_id;
 
       /* If CMFD acceleration is on, add FSR CMFD cell to FSR data */
       if (_cmfd != NULL)
-        fsr->_cmfd_cell = _cmfd->findCmfdCell(coords->getHighestLevel());
+        fsr->_cmfd_cell = cmfd_cell;
     }
   }
 
@@ -640,6 +1101,114 @@ int Geometry::getFSRId(LocalCoords* coords) {
 }
 
 
+/**
+ * @brief Finds the sum of the instance offsets of the Cells and Lattice
+ *        cells over a range of levels of a LocalCoords.
+ * @details Each instance of a Material-filled Cell in the CSG tree is
+ *          indexed by the sum of the offsets at each level of its LocalCoords
+ *          (see Geometry::initializeInstanceOffsets(...)).
+ * @param first the LocalCoords at the first level to include
+ * @param last the LocalCoords at the last level to include (NULL for the
+ *        lowest level)
+ * @return the sum of the instance offsets over the levels
+ */
+long Geometry::getInstanceOffset(LocalCoords* first, LocalCoords* last) {
+
+  LocalCoords* curr = first;
+  long offset = 0;
+
+  while (curr != NULL) {
+    if (curr->getType() == LAT) {
+      Lattice* lattice = curr->getLattice();
+      int lat_cell = curr->getLatticeX() + lattice->getNumX() *
+          (curr->getLatticeY() + lattice->getNumY() * curr->getLatticeZ());
+      offset += _lattice_offsets.at(lattice->getId())[lat_cell];
+    }
+    else
+      offset += _cell_offsets.at(std::make_pair(curr->getUniverse()->getId(),
+                                                curr->getCell()->getId()));
+
+    if (curr == last)
+      break;
+
+    curr = curr->getNext();
+  }
+
+  return offset;
+}
+
+
+/**
+ * @brief Returns the ID of the FSR of a Cell instance if it has already been
+ *        found by Geometry::addFSRInstance(...).
+ * @param instance the index of the Cell instance (and CMFD cell)
+ * @return the FSR ID, or -1 if the instance has not been found
+ */
+int Geometry::findFSRInstance(long instance) {
+
+  if (!_FSR_instances_map.contains(instance))
+    return -1;
+
+  return _FSR_instances_map.at(instance)->_fsr_id;
+}
+
+
+/**
+ * @brief Finds the FSR of a Cell instance by its FSR key and remembers it
+ *        for Geometry::findFSRInstance(...).
+ * @param instance the index of the Cell instance (and CMFD cell)
+ * @param fsr_key the FSR key of the instance
+ * @return the FSR ID
+ */
+int Geometry::addFSRInstance(long instance, std::string& fsr_key) {
+
+  fsr_data* fsr = NULL;
+
+  try {
+    fsr = _FSR_keys_map.at(fsr_key);
+  }
+  catch(std::exception &e) {
+    log_printf(ERROR, "Could not find FSR ID with key: %s. Try creating "
+               "geometry with finer track spacing", fsr_key.c_str());
+  }
+
+  _FSR_instances_map.insert(instance, fsr);
+
+  return fsr->_fsr_id;
+}
+
+
+/**
+ * @brief Return the ID of the flat source region that a given LocalCoords
+ *        object resides within without forming its FSR key.
+ * @details The FSR is found by the index of the Cell instance in the CSG
+ *          tree, combined with the CMFD cell if CMFD is used. The FSR of
+ *          each instance is only found by its FSR key the first time the
+ *          instance is encountered, such that later lookups only use integer
+ *          keys. This must only be used once the FSRs have been found by ray
+ *          tracing.
+ * @param coords a LocalCoords object pointer
+ * @return the FSR ID for a given LocalCoords object
+ */
+int Geometry::lookupFSRId(LocalCoords* coords) {
+
+  long instance = getInstanceOffset(coords->getHighestLevel(), NULL);
+
+  /* FSRs are split by the CMFD cells */
+  if (_cmfd != NULL)
+    instance += _num_instances * _cmfd->findCmfdCell(coords->getHighestLevel());
+
+  int fsr_id = findFSRInstance(instance);
+
+  if (fsr_id == -1) {
+    std::string fsr_key = getFSRKey(coords);
+    fsr_id = addFSRInstance(instance, fsr_key);
+  }
+
+  return fsr_id;
+}
+
+
 /**
  * @brief Return the characteristic point for a given FSR ID
  * @param fsr_id the FSR ID
@@ -693,6 +1262,25 @@ Point* Geometry::getFSRCentroid(int fsr_id) {
  */
 std::string Geometry::getFSRKey(LocalCoords* coords) {
 
+  std::stringstream key;
+
+  /* If CMFD is on, write the CMFD lattice cell to the key, followed by
+   * each level of the lattice / universe / cell hierarchy */
+  key << getCmfdKey(coords);
+  key << getLevelsKey(coords->getHighestLevel(), NULL);
+
+  return key.str();
+}
+
+
+/**
+ * @brief Generate the portion of an FSR key identifying the CMFD cell in
+ *        which a LocalCoords lies.
+ * @param coords a LocalCoords object pointer
+ * @return the CMFD portion of the FSR key (empty if CMFD is not used)
+ */
+std::string Geometry::getCmfdKey(LocalCoords* coords) {
+
   std::stringstream key;
   LocalCoords* curr = coords->getHighestLevel();
   std::ostringstream curr_level_key;
@@ -706,7 +1294,28 @@ std::string Geometry::getFSRKey(LocalCoords* coords) {
       key << curr_level_key.str() << ") : ";
   }
 
-  /* Descend the linked list hierarchy until the lowest level has
+  return key.str();
+}
+
+
+/**
+ * @brief Generate the portion of an FSR key describing a range of levels in
+ *        the lattice / universe / cell hierarchy.
+ * @details The key describes each level from the first LocalCoords down to
+ *          and including the last LocalCoords. If the last LocalCoords is
+ *          NULL, the key describes each level down to the lowest level and
+ *          is terminated by the ID of the Cell at the lowest level.
+ * @param first the LocalCoords at the first level to include in the key
+ * @param last the LocalCoords at the last level to include in the key
+ * @return the portion of the FSR key for the levels
+ */
+std::string Geometry::getLevelsKey(LocalCoords* first, LocalCoords* last) {
+
+  std::stringstream key;
+  LocalCoords* curr = first;
+  std::ostringstream curr_level_key;
+
+  /* Descend the linked list hierarchy until the last (or lowest) level has
    * been reached */
   while (curr != NULL) {
 
@@ -734,6 +1343,10 @@ std::string Geometry::getFSRKey(LocalCoords* coords) {
       key << "UNIV = " << curr_level_key.str() << " : ";
     }
 
+    /* If the last level was requested, the key is complete */
+    if (curr == last)
+      return key.str();
+
     /* If lowest coords reached break; otherwise get next coords */
     if (curr->getNext() == NULL)
       break;
@@ -766,9 +1379,10 @@ std::string Geometry::getFSRKey(LocalCoords* coords) {
 void Geometry::subdivideCells() {
 
   /* Compute the max radius as the distance from the center to a corner
-  * of the geometry. */
-  double dx = getWidthX() / 2.0;
-  double dy = getWidthY() / 2.0;
+  * of the geometry. The root Universe is used such that the Cells are
+  * subdivided the same way in each domain. */
+  double dx = (_root_universe->getMaxX() - _root_universe->getMinX()) / 2.0;
+  double dy = (_root_universe->getMaxY() - _root_universe->getMinY()) / 2.0;
   double max_radius = sqrt(dx*dx + dy*dy);
 
   /* Recursively subdivide Cells into rings and sectors */
@@ -792,6 +1406,19 @@ void Geometry::initializeFSRs(bool neighbor_cells) {
   /* Build collections of neighbor Cells for optimized ray tracing */
   if (neighbor_cells)
     _root_universe->buildNeighbors();
+
+  /* Refresh the surface kernels in case Surfaces were modified */
+  std::map<int, Cell*> all_cells = getAllCells();
+  std::map<int, Cell*>::iterator iter;
+  for (iter = all_cells.begin(); iter != all_cells.end(); ++iter)
+    iter->second->buildSurfaceKernels();
+
+  /* Index the instances of the subdivided Cells for tracing Tracks again */
+  std::map<int, long> num_instances;
+  _cell_offsets.clear();
+  _lattice_offsets.clear();
+  _FSR_instances_map.clear();
+  _num_instances = initializeInstanceOffsets(_root_universe, num_instances);
 }
 
 
@@ -801,22 +1428,21 @@ void Geometry::initializeFSRs(bool neighbor_cells) {
  * @details This method starts at the beginning of a Track and finds successive
  *          intersection points with FSRs as the Track crosses through the
  *          Geometry and creates segment structs and adds them to the Track.
+ *          If segment templates are used, the segments crossed within each
+ *          cell of the lowest level Lattices are traced once for each unique
+ *          Lattice cell Universe, azimuthal angle and entry point and reused
+ *          for all other Tracks entering the same Universe at the same point
+ *          (see Geometry::segmentizeLatticeCell(...)).
  * @param track a pointer to a track to segmentize
+ * @param use_templates whether to use segment templates (default is false)
  */
-void Geometry::segmentize(Track* track) {
+void Geometry::segmentize(Track* track, bool use_templates) {
 
   /* Track starting Point coordinates and azimuthal angle */
   double x0 = track->getStart()->getX();
   double y0 = track->getStart()->getY();
   double z0 = track->getStart()->getZ();
   double phi = track->getPhi();
-  double delta_x, delta_y;
-
-  /* Length of each segment */
-  FP_PRECISION length;
-  Material* material;
-  int fsr_id;
-  int num_segments;
 
   /* Use a LocalCoords for the start and end of each segment */
   LocalCoords start(x0, y0, z0);
@@ -828,7 +1454,6 @@ void Geometry::segmentize(Track* track) {
 
   /* Find the Cell containing the Track starting Point */
   Cell* curr = findFirstCell(&end);
-  Cell* prev;
 
   /* If starting Point was outside the bounds of the Geometry */
   if (curr == NULL)
@@ -839,63 +1464,554 @@ void Geometry::segmentize(Track* track) {
    * move it to the next Cell, create a new segment, and add it to the
    * Geometry */
   while (curr != NULL) {
+    if (use_templates)
+      curr = segmentizeLatticeCell(track, &start, &end, curr);
+    else
+      curr = segmentizeCell(track, &start, &end, curr);
+  }
+
+  log_printf(DEBUG, "Created %d segments for Track: %s",
+             track->getNumSegments(), track->toString().c_str());
+
+  /* Truncate the linked list for the LocalCoords */
+  start.prune();
+  end.prune();
+}
+
+
+/**
+ * @brief Traces the segments of a Track again once its FSRs have been found.
+ * @details This is used to trace Tracks on-the-fly in each transport sweep.
+ *          The Track is traced as by Geometry::segmentize(...), but the FSR
+ *          of each segment is looked up by the instance of its Cell in the
+ *          CSG tree, without forming FSR keys or creating FSRs (see
+ *          Geometry::lookupFSRId(...)). If segment templates are used, any
+ *          template not recorded by Geometry::segmentize(...), such as for
+ *          Tracks read from a file, is recorded as it would be there.
+ * @param track a pointer to a Track to segmentize
+ * @param use_templates whether to use segment templates (default is false)
+ */
+void Geometry::retrace(Track* track, bool use_templates) {
+
+  /* Track starting Point coordinates and azimuthal angle */
+  double x0 = track->getStart()->getX();
+  double y0 = track->getStart()->getY();
+  double z0 = track->getStart()->getZ();
+  double phi = track->getPhi();
+
+  /* Use a LocalCoords for the start and end of each segment */
+  LocalCoords start(x0, y0, z0);
+  LocalCoords end(x0, y0, z0);
+  start.setUniverse(_root_universe);
+  end.setUniverse(_root_universe);
+  start.setPhi(phi);
+  end.setPhi(phi);
+
+  /* Find the Cell containing the Track starting Point */
+  Cell* curr = findFirstCell(&end);
+
+  /* If starting Point was outside the bounds of the Geometry */
+  if (curr == NULL)
+    log_printf(ERROR, "Could not find a material-filled Cell containing the "
+               "start Point of this Track: %s", track->toString().c_str());
+
+  /* Trace each segment until the Track leaves the Geometry */
+  while (curr != NULL) {
+    if (use_templates)
+      curr = segmentizeLatticeCell(track, &start, &end, curr, true);
+    else
+      curr = segmentizeCell(track, &start, &end, curr, true);
+  }
+
+  /* Truncate the linked list for the LocalCoords */
+  start.prune();
+  end.prune();
+}
 
-    end.copyCoords(&start);
-    end.setPhi(phi);
 
-    /* Find the next Cell along the Track's trajectory */
-    prev = curr;
-    curr = findNextCell(&end);
+/**
+ * @brief Creates the Track segment from a LocalCoords to the next Cell
+ *        boundary along the Track and adds it to the Track.
+ * @param track a pointer to the Track being segmentized
+ * @param start a LocalCoords to store the start of the segment
+ * @param end the LocalCoords at the current point along the Track, which
+ *        is moved to the start of the next segment
+ * @param curr the Cell containing the current point along the Track
+ * @param retrace whether to look up the FSR among the FSRs already found
+ *        without forming its FSR key (default is false)
+ * @return the Cell containing the start of the next segment (NULL if the
+ *         Track has left the Geometry)
+ */
+Cell* Geometry::segmentizeCell(Track* track, LocalCoords* start,
+                               LocalCoords* end, Cell* curr, bool retrace) {
 
-    /* Checks that segment does not have the same start and end Points */
-    if (start.getX() == end.getX() && start.getY() == end.getY())
-      log_printf(ERROR, "Created segment with same start and end "
-                 "point: x = %f, y = %f", start.getX(), start.getY());
+  double phi = end->getPhi();
 
-    /* Find the segment length, Material and FSR ID */
-    length = FP_PRECISION(end.getPoint()->distanceToPoint(start.getPoint()));
-    material = prev->getFillMaterial();
-    fsr_id = findFSRId(&start);
+  end->copyCoords(start);
+  end->setPhi(phi);
 
-    /* Create a new Track segment */
-    segment* new_segment = new segment;
-    new_segment->_material = material;
-    new_segment->_length = length;
-    new_segment->_region_id = fsr_id;
+  /* Find the next Cell along the Track's trajectory */
+  curr = findNextCell(end);
 
-    log_printf(DEBUG, "segment start x = %f, y = %f; end x = %f, y = %f",
-               start.getX(), start.getY(), end.getX(), end.getY());
+  /* Checks that segment does not have the same start and end Points */
+  if (start->getX() == end->getX() && start->getY() == end->getY())
+    log_printf(ERROR, "Created segment with same start and end "
+               "point: x = %f, y = %f", start->getX(), start->getY());
 
-    /* Save indicies of CMFD Mesh surfaces that the Track segment crosses */
-    if (_cmfd != NULL) {
+  /* Create a new Track segment with its length and FSR ID */
+  segment new_segment;
+  new_segment._length =
+      FP_PRECISION(end->getPoint()->distanceToPoint(start->getPoint()));
+  if (retrace)
+    new_segment._region_id = lookupFSRId(start);
+  else
+    new_segment._region_id = findFSRId(start);
+  int cmfd_surface_fwd = -1;
+  int cmfd_surface_bwd = -1;
+
+  log_printf(DEBUG, "segment start x = %f, y = %f; end x = %f, y = %f",
+             start->getX(), start->getY(), end->getX(), end->getY());
+
+  /* Save indicies of CMFD Mesh surfaces that the Track segment crosses */
+  if (_cmfd != NULL) {
+
+    /* Find cmfd cell that segment lies in */
+    int cmfd_cell = _cmfd->findCmfdCell(start);
+
+    /* Reverse nudge from surface to determine whether segment start or end
+     * points lie on a CMFD surface. */
+    start->adjustCoords(-TINY_MOVE);
+    end->adjustCoords(-TINY_MOVE);
+
+    cmfd_surface_fwd = _cmfd->findCmfdSurface(cmfd_cell, end);
+    cmfd_surface_bwd = _cmfd->findCmfdSurface(cmfd_cell, start);
+
+    /* Re-nudge segments from surface */
+    start->adjustCoords(TINY_MOVE);
+    end->adjustCoords(TINY_MOVE);
+  }
+
+  /* Add the segment to the Track */
+  track->addSegment(&new_segment, cmfd_surface_fwd, cmfd_surface_bwd);
+
+  return curr;
+}
+
+
+/**
+ * @brief Creates the Track segments from a LocalCoords to the boundary of the
+ *        lowest level Lattice cell containing it using a segment template.
+ * @details If the Lattice cell boundary is reached before any Surface or
+ *          Lattice boundary at a higher level in the hierarchy (or CMFD mesh
+ *          boundary), the segments within the Lattice cell depend only on the
+ *          Lattice, the Universe filling the cell, the azimuthal angle and
+ *          the local entry point. If a segment template exists for these,
+ *          its segments are stitched onto the Track with FSR keys formed from
+ *          the levels above the Lattice cell and the template's keys for the
+ *          levels below, and the Track is moved to the Lattice cell boundary
+ *          exactly as it would be by Geometry::findNextCell(...). Otherwise
+ *          the Lattice cell is traced Cell by Cell and a new template is
+ *          recorded. If the Lattice cell is cut by a higher level boundary, a
+ *          single segment is traced without using a template. When tracing
+ *          again, the FSRs of the stitched segments are found by the Cell
+ *          instances above the Lattice cell and the template's instance
+ *          offsets below it, while new templates are recorded as above.
+ * @param track a pointer to the Track being segmentized
+ * @param start a LocalCoords to store the start of each segment
+ * @param end the LocalCoords at the current point along the Track, which
+ *        is moved to the first point beyond the Lattice cell
+ * @param curr the Cell containing the current point along the Track
+ * @param retrace whether the Track is traced again once its FSRs have been
+ *        found (default is false)
+ * @return the Cell containing the start of the next segment (NULL if the
+ *         Track has left the Geometry)
+ */
+Cell* Geometry::segmentizeLatticeCell(Track* track, LocalCoords* start,
+                                      LocalCoords* end, Cell* curr,
+                                      bool retrace) {
 
-      /* Find cmfd cell that segment lies in */
-      int cmfd_cell = _cmfd->findCmfdCell(&start);
+  LocalCoords* lat_coords = findTemplateLattice(end);
 
-      /* Reverse nudge from surface to determine whether segment start or end
-       * points lie on a CMFD surface. */
-      start.adjustCoords(-TINY_MOVE);
-      end.adjustCoords(-TINY_MOVE);
+  /* Trace a single segment if not within a Lattice */
+  if (lat_coords == NULL)
+    return segmentizeCell(track, start, end, curr, retrace);
 
-      new_segment->_cmfd_surface_fwd = _cmfd->findCmfdSurface(cmfd_cell, &end);
-      new_segment->_cmfd_surface_bwd =
-        _cmfd->findCmfdSurface(cmfd_cell, &start);
+  /* Find the distance to the boundary of the Lattice cell */
+  double lat_dist = lat_coords->getLattice()->minSurfaceDist(lat_coords);
 
-      /* Re-nudge segments from surface */
-      start.adjustCoords(TINY_MOVE);
-      end.adjustCoords(TINY_MOVE);
+  /* Find the distance to the nearest boundary at any higher level */
+  double min_dist = std::numeric_limits<double>::infinity();
+  LocalCoords* coords = end->getHighestLevel();
+  while (coords != lat_coords) {
+    if (coords->getType() == LAT)
+      min_dist = std::min(min_dist,
+                          coords->getLattice()->minSurfaceDist(coords));
+    else
+      min_dist = std::min(min_dist, coords->getCell()->minSurfaceDist(coords));
+    coords = coords->getNext();
+  }
+
+  if (_cmfd != NULL)
+    min_dist = std::min(min_dist, _cmfd->getLattice()->minSurfaceDist(
+                                  end->getHighestLevel()));
+
+  min_dist = std::min(min_dist,
+                      findInternalBoundaryDist(end->getHighestLevel()));
+
+  /* Trace a single segment if the Lattice cell is cut at a higher level */
+  if (min_dist < lat_dist - TINY_MOVE)
+    return segmentizeCell(track, start, end, curr, retrace);
+
+  /* Find the distance to the first point beyond the Lattice cell */
+  double advance = std::min(lat_dist, min_dist) + TINY_MOVE;
+
+  double phi = end->getPhi();
+  double x0 = end->getHighestLevel()->getX();
+  double y0 = end->getHighestLevel()->getY();
+  double z0 = end->getHighestLevel()->getZ();
+  template_key key = getTemplateKey(lat_coords);
+  bool found = _segment_templates.contains(key);
+
+  /* Stitch the segments from an existing template onto the Track */
+  if (found) {
+
+    segment_template* templ = _segment_templates.at(key);
+    int num_segments = templ->_segments.size();
+    int cmfd_cell = -1;
+    if (_cmfd != NULL)
+      cmfd_cell = _cmfd->findCmfdCell(end);
+
+    /* Find the FSRs by the Cell instances when tracing again, or else by
+     * the FSR keys formed from the levels above the Lattice cell */
+    std::string prefix;
+    long prefix_instance = 0;
+    if (retrace) {
+      prefix_instance = getInstanceOffset(end->getHighestLevel(), lat_coords);
+      if (_cmfd != NULL)
+        prefix_instance += _num_instances * cmfd_cell;
+    }
+    else
+      prefix = getCmfdKey(end) +
+               getLevelsKey(end->getHighestLevel(), lat_coords);
+
+    for (int i=0; i < num_segments; i++) {
+
+      template_segment* templ_segment = &templ->_segments[i];
+      segment new_segment;
+      new_segment._length = templ_segment->_length;
+
+      if (retrace) {
+        long instance = prefix_instance + templ_segment->_instance;
+        new_segment._region_id = findFSRInstance(instance);
+        if (new_segment._region_id == -1) {
+          std::string fsr_key = getCmfdKey(end) +
+              getLevelsKey(end->getHighestLevel(), lat_coords) +
+              templ_segment->_key;
+          new_segment._region_id = addFSRInstance(instance, fsr_key);
+        }
+      }
+      else {
+        std::string fsr_key = prefix + templ_segment->_key;
+        Point point;
+        point.setCoords(x0 + cos(phi) * templ_segment->_offset,
+                        y0 + sin(phi) * templ_segment->_offset, z0);
+        new_segment._region_id =
+            findFSRId(fsr_key, &point, templ_segment->_material->getId(),
+                      cmfd_cell);
+      }
+
+      int cmfd_surface_fwd = -1;
+      int cmfd_surface_bwd = -1;
+
+      /* Only the Lattice cell boundaries may lie on CMFD surfaces */
+      if (_cmfd != NULL) {
+        if (i == 0) {
+          LocalCoords surface(x0, y0, z0);
+          surface.setPhi(phi);
+          surface.adjustCoords(-TINY_MOVE);
+          cmfd_surface_bwd = _cmfd->findCmfdSurface(cmfd_cell, &surface);
+        }
+        if (i == num_segments - 1) {
+          LocalCoords surface(x0, y0, z0);
+          surface.setPhi(phi);
+          surface.adjustCoords(advance - TINY_MOVE);
+          cmfd_surface_fwd = _cmfd->findCmfdSurface(cmfd_cell, &surface);
+        }
+      }
+
+      track->addSegment(&new_segment, cmfd_surface_fwd, cmfd_surface_bwd);
     }
 
-    /* Add the segment to the Track */
-    track->addSegment(new_segment);
+    /* Move to the first point beyond the Lattice cell */
+    end->prune();
+    end->adjustCoords(advance);
+
+    if (!withinBounds(end))
+      return NULL;
+
+    return findCellContainingCoords(end);
   }
 
-  log_printf(DEBUG, "Created %d segments for Track: %s",
-             track->getNumSegments(), track->toString().c_str());
+  /* Trace the Lattice cell Cell by Cell and record a new template */
+  std::string prefix = getCmfdKey(end) +
+                       getLevelsKey(end->getHighestLevel(), lat_coords);
+  segment_template* templ = new segment_template;
+  LocalCoords* next_lat_coords;
+
+  do {
+    Material* material = curr->getFillMaterial();
+    curr = segmentizeCell(track, start, end, curr);
+
+    /* Record the segment relative to the entry point */
+    segment* curr_segment = track->getSegment(track->getNumSegments()-1);
+    Point* point = start->getHighestLevel()->getPoint();
+    template_segment templ_segment;
+    templ_segment._length = curr_segment->_length;
+    templ_segment._material = material;
+    templ_segment._offset = sqrt((point->getX() - x0) * (point->getX() - x0) +
+                                 (point->getY() - y0) * (point->getY() - y0));
+    templ_segment._instance =
+        getInstanceOffset(findTemplateLattice(start)->getNext(), NULL);
+    templ_segment._key = getLevelsKey(findTemplateLattice(start)->getNext(),
+                                      NULL);
+    templ->_segments.push_back(templ_segment);
+
+    if (curr == NULL)
+      break;
+
+    next_lat_coords = findTemplateLattice(end);
+
+  } while (next_lat_coords != NULL && prefix == getCmfdKey(end) +
+           getLevelsKey(end->getHighestLevel(), next_lat_coords));
+
+  /* Store the template unless another thread has already done so */
+  _segment_templates.insert(key, templ);
+  if (_segment_templates.at(key) != templ)
+    delete templ;
+
+  return curr;
+}
+
+
+/**
+ * @brief Finds the LocalCoords at the lowest Lattice level in the hierarchy.
+ * @param coords a LocalCoords object pointer
+ * @return the LocalCoords at the lowest Lattice level (NULL if the
+ *         LocalCoords does not lie within a Lattice)
+ */
+LocalCoords* Geometry::findTemplateLattice(LocalCoords* coords) {
+
+  LocalCoords* curr = coords->getHighestLevel();
+  LocalCoords* lat_coords = NULL;
+
+  while (curr != NULL) {
+    if (curr->getType() == LAT && curr->getNext() != NULL)
+      lat_coords = curr;
+    curr = curr->getNext();
+  }
+
+  return lat_coords;
+}
+
+
+/**
+ * @brief Generate the key for a segment template from the Lattice, the
+ *        Universe filling the Lattice cell, the azimuthal angle and the
+ *        local entry point into the Lattice cell.
+ * @param lat_coords the LocalCoords at the Lattice level
+ * @return the segment template key
+ */
+template_key Geometry::getTemplateKey(LocalCoords* lat_coords) {
+
+  template_key key;
+  LocalCoords* univ_coords = lat_coords->getNext();
+
+  key._lattice_id = lat_coords->getLattice()->getId();
+  key._universe_id = univ_coords->getUniverse()->getId();
+  key._phi = (long long) round(univ_coords->getPhi() / TEMPLATE_COORD_THRESH);
+  key._x = (long long) round(univ_coords->getX() / TEMPLATE_COORD_THRESH);
+  key._y = (long long) round(univ_coords->getY() / TEMPLATE_COORD_THRESH);
+
+  return key;
+}
+
+
+/**
+ * @brief Returns the number of segment templates created by modular ray
+ *        tracing.
+ * @return the number of segment templates
+ */
+int Geometry::getNumSegmentTemplates() {
+  return _segment_templates.size();
+}
+
+
+/**
+ * @brief Frees the FSR keys of the segment templates created by modular ray
+ *        tracing.
+ * @details The FSR keys are only needed to find the FSR of each Cell instance
+ *          once. This is called by the TrackGenerator once the Tracks have
+ *          been traced again to find the FSR instances for on-the-fly ray
+ *          tracing, which keeps the segment templates.
+ */
+void Geometry::clearSegmentTemplateKeys() {
+
+  if (_segment_templates.size() != 0) {
+    segment_template** values = _segment_templates.values();
+
+    for (int i=0; i < _segment_templates.size(); i++)
+      for (size_t s=0; s < values[i]->_segments.size(); s++)
+        std::string().swap(values[i]->_segments[s]._key);
+    delete[] values;
+  }
+}
+
+
+/**
+ * @brief Deletes all segment templates created by modular ray tracing.
+ * @details Segment templates are only needed during ray tracing and are
+ *          cleared by the TrackGenerator once all Tracks are segmentized,
+ *          unless the Tracks are traced again on-the-fly.
+ */
+void Geometry::clearSegmentTemplates() {
+
+  if (_segment_templates.size() != 0) {
+    segment_template** values = _segment_templates.values();
+
+    for (int i=0; i < _segment_templates.size(); i++)
+      delete values[i];
+    delete[] values;
+
+    _segment_templates.clear();
+  }
+}
+
+
+/**
+ * @brief Counts the number of segments a Track would be split into without
+ *        creating any segments or FSRs.
+ * @details This method performs the same traversal of the CSG tree as
+ *          Geometry::segmentize(...), including crossings of the CMFD mesh,
+ *          but only counts the Cells crossed by the Track. It does not insert
+ *          any FSR keys into the FSR map and may be safely called before
+ *          Track generation and concurrently from multiple threads. Neither
+ *          the Cells nor the CMFD mesh need to have been initialized: the
+ *          ring and sector boundaries of Cells which have not yet been
+ *          subdivided are counted analytically, and the CMFD mesh is
+ *          computed from the Geometry bounds.
+ * @param track a pointer to a Track to trace across the Geometry
+ * @return the number of segments along the Track
+ */
+int Geometry::countSegments(Track* track) {
+
+  /* Track starting Point coordinates and azimuthal angle */
+  double x0 = track->getStart()->getX();
+  double y0 = track->getStart()->getY();
+  double z0 = track->getStart()->getZ();
+  double phi = track->getPhi();
+
+  /* Maximum ring radius used by subdivideCells() */
+  double dx = (_root_universe->getMaxX() - _root_universe->getMinX()) / 2.0;
+  double dy = (_root_universe->getMaxY() - _root_universe->getMinY()) / 2.0;
+  double max_radius = sqrt(dx*dx + dy*dy);
+
+  int num_segments = 0;
+
+  /* Use a LocalCoords for the start of each segment */
+  LocalCoords coords(x0, y0, z0);
+  coords.setUniverse(_root_universe);
+  coords.setPhi(phi);
+
+  /* Find the Cell containing the Track starting Point */
+  Cell* curr = findFirstCell(&coords);
+
+  /* If starting Point was outside the bounds of the Geometry */
+  if (curr == NULL)
+    log_printf(ERROR, "Could not find a material-filled Cell containing the "
+               "start Point of this Track: %s", track->toString().c_str());
+
+  /* Move the LocalCoords to each successive Cell until it leaves the
+   * Geometry */
+  while (curr != NULL) {
+
+    /* Find the distance to the next Surface, Lattice cell, CMFD mesh cell,
+     * symmetry plane or domain interface */
+    double dist = findNextSurfaceDist(&coords);
+    dist = std::min(dist, findCmfdMeshDist(&coords));
+    dist = std::min(dist, findInternalBoundaryDist(&coords));
+
+    /* Find the maximum ring radius used by Lattice::subdivideCells(...) */
+    double radius = max_radius;
+    LocalCoords* lowest = &coords;
+    while (lowest->getNext() != NULL) {
+      if (lowest->getType() == LAT) {
+        Lattice* lattice = lowest->getLattice();
+        double width_x = lattice->getWidthX();
+        double width_y = lattice->getWidthY();
+        radius = std::min(radius, sqrt(width_x*width_x/4.0 +
+                                       width_y*width_y/4.0));
+      }
+      lowest = lowest->getNext();
+    }
+
+    /* Count this segment and the ring and sector segments within it */
+    num_segments += 1 + lowest->getCell()->countSubdivisionCrossings(
+        lowest, dist, radius);
+
+    /* Move the LocalCoords to the next Cell */
+    coords.prune();
+    coords.adjustCoords(dist + TINY_MOVE);
+
+    if (!withinBounds(&coords))
+      break;
+
+    curr = findCellContainingCoords(&coords);
+  }
 
   /* Truncate the linked list for the LocalCoords */
-  start.prune();
-  end.prune();
+  coords.prune();
+
+  return num_segments;
+}
+
+
+/**
+ * @brief Finds the distance along a LocalCoords' trajectory to the nearest
+ *        CMFD mesh cell boundary.
+ * @details The uniform CMFD mesh spanning the Geometry bounds is used so
+ *          that the distance may be found before the CMFD Lattice is
+ *          initialized by initializeCmfd().
+ * @param coords pointer to the highest level of a LocalCoords linked list
+ * @return the distance to the nearest CMFD mesh cell boundary (cm), or
+ *         infinity if there is no CMFD mesh
+ */
+double Geometry::findCmfdMeshDist(LocalCoords* coords) {
+
+  double min_dist = std::numeric_limits<double>::infinity();
+
+  if (_cmfd == NULL)
+    return min_dist;
+
+  double cos_phi = cos(coords->getPhi());
+  double sin_phi = sin(coords->getPhi());
+  double width_x = getWidthX() / _cmfd->getNumX();
+  double width_y = getWidthY() / _cmfd->getNumY();
+  double x = coords->getX() - getMinX();
+  double y = coords->getY() - getMinY();
+
+  if (cos_phi > 0.)
+    min_dist = std::min(min_dist,
+                        ((floor(x / width_x) + 1.) * width_x - x) / cos_phi);
+  else if (cos_phi < 0.)
+    min_dist = std::min(min_dist, (floor(x / width_x) * width_x - x) / cos_phi);
+
+  if (sin_phi > 0.)
+    min_dist = std::min(min_dist,
+                        ((floor(y / width_y) + 1.) * width_y - y) / sin_phi);
+  else if (sin_phi < 0.)
+    min_dist = std::min(min_dist, (floor(y / width_y) * width_y - y) / sin_phi);
+
+  return min_dist;
 }
 
 
@@ -916,6 +2032,7 @@ void Geometry::initializeFSRVectors() {
   /* allocate vectors */
   int num_FSRs = _FSR_keys_map.size();
   _FSRs_to_keys = std::vector<std::string>(num_FSRs);
+  std::vector<fsr_data*> FSRs_to_data(num_FSRs);
 
   /* fill vectors key and material ID information */
 #pragma omp parallel for
@@ -924,15 +2041,13 @@ void Geometry::initializeFSRVectors() {
     fsr_data* fsr = value_list[i];
     int fsr_id = fsr->_fsr_id;
     _FSRs_to_keys.at(fsr_id) = key;
+    FSRs_to_data.at(fsr_id) = fsr;
   }
 
-  /* add cmfd information serially */
+  /* add cmfd information serially in order of FSR ID */
   if (_cmfd != NULL) {
-    for (int i=0; i < num_FSRs; i++) {
-      fsr_data* fsr = value_list[i];
-      int fsr_id = fsr->_fsr_id;
-      _cmfd->addFSRToCell(fsr->_cmfd_cell, fsr_id);
-    }
+    for (int r=0; r < num_FSRs; r++)
+      _cmfd->addFSRToCell(FSRs_to_data.at(r)->_cmfd_cell, r);
   }
 
   /* Delete key and value lists */
@@ -941,6 +2056,161 @@ void Geometry::initializeFSRVectors() {
 }
 
 
+/**
+ * @brief Renumbers the FSRs in the FSR key map.
+ * @details This is used by the TrackGenerator to order the FSRs after ray
+ *          tracing and must be called before Geometry::initializeFSRVectors().
+ * @param new_FSR_ids an array of the new ID of each FSR indexed by its
+ *        current ID
+ */
+void Geometry::renumberFSRs(int* new_FSR_ids) {
+
+  fsr_data **value_list = _FSR_keys_map.values();
+  int num_FSRs = _FSR_keys_map.size();
+
+#pragma omp parallel for
+  for (int i=0; i < num_FSRs; i++)
+    value_list[i]->_fsr_id = new_FSR_ids[value_list[i]->_fsr_id];
+
+  delete[] value_list;
+}
+
+
+/**
+ * @brief Estimates the number of FSRs in the Geometry from its CSG structure.
+ * @details The estimate counts each instance of a Material-filled Cell in
+ *          the nested Universe / Lattice hierarchy, multiplied by the number
+ *          of rings and sectors the Cell will be subdivided into. It is exact
+ *          when every ring and sector intersects its Cell and any CMFD mesh
+ *          is aligned with the Lattice cell boundaries; otherwise the number
+ *          of FSRs found by ray tracing may differ. This method may be called
+ *          before Track generation and does not modify the Geometry:
+ *
+ * @code
+ *          num_FSRs = geometry.estimateNumFSRs()
+ * @endcode
+ *
+ * @param univ the Universe of interest (default is NULL)
+ * @return the estimated number of FSRs in the Universe
+ */
+int Geometry::estimateNumFSRs(Universe* univ) {
+
+  /* If no Universe was passed in as an argument, then this is the first
+   * recursive call from a user via Python, so get the base Universe */
+  if (univ == NULL)
+    univ = _root_universe;
+
+  if (univ == NULL)
+    log_printf(ERROR, "Unable to estimate the number of FSRs since the "
+               "Geometry does not contain a root Universe");
+
+  int num_FSRs = 0;
+
+  /* Sum the FSRs in each Cell, recursing into any fill Universes */
+  if (univ->getType() == SIMPLE) {
+    std::map<int, Cell*> cells = univ->getCells();
+    std::map<int, Cell*>::iterator iter;
+
+    for (iter = cells.begin(); iter != cells.end(); ++iter) {
+      Cell* cell = iter->second;
+
+      if (cell->getType() == MATERIAL)
+        num_FSRs += std::max(cell->getNumRings(), 1) *
+                    std::max(cell->getNumSectors(), 1);
+      else if (cell->getType() == FILL)
+        num_FSRs += estimateNumFSRs(cell->getFillUniverse());
+    }
+  }
+
+  /* Sum the FSRs in each Lattice cell, counting each unique Universe once */
+  else {
+    Lattice* lattice = static_cast<Lattice*>(univ);
+    std::map<int, int> univ_FSRs;
+
+    for (int k=0; k < lattice->getNumZ(); k++) {
+      for (int j=0; j < lattice->getNumY(); j++) {
+        for (int i=0; i < lattice->getNumX(); i++) {
+          Universe* fill = lattice->getUniverse(i, j, k);
+
+          if (univ_FSRs.find(fill->getId()) == univ_FSRs.end())
+            univ_FSRs[fill->getId()] = estimateNumFSRs(fill);
+
+          num_FSRs += univ_FSRs[fill->getId()];
+        }
+      }
+    }
+  }
+
+  return num_FSRs;
+}
+
+
+/**
+ * @brief Indexes the instances of the Material-filled Cells in a Universe.
+ * @details Each instance of a Material-filled Cell in the nested Universe /
+ *          Lattice hierarchy is given a unique index. The instances beneath
+ *          each Cell of a Universe, and each cell of a Lattice, are numbered
+ *          contiguously from an offset, such that the index of an instance is
+ *          the sum of the offsets along its path through the CSG tree. This
+ *          is used by Geometry::lookupFSRId(...) to find FSRs without forming
+ *          their FSR keys and is called by Geometry::initializeFSRs() once
+ *          the Cells have been subdivided.
+ * @param univ the Universe of interest
+ * @param num_instances a map of the number of instances in each Universe
+ *        already indexed, keyed by Universe ID
+ * @return the number of instances in the Universe
+ */
+long Geometry::initializeInstanceOffsets(Universe* univ,
+                                         std::map<int, long>& num_instances) {
+
+  /* Each Universe is only indexed once */
+  if (num_instances.find(univ->getId()) != num_instances.end())
+    return num_instances[univ->getId()];
+
+  long offset = 0;
+
+  /* Number the instances in each Cell, recursing into any fill Universes */
+  if (univ->getType() == SIMPLE) {
+    std::map<int, Cell*> cells = univ->getCells();
+    std::map<int, Cell*>::iterator iter;
+
+    for (iter = cells.begin(); iter != cells.end(); ++iter) {
+      Cell* cell = iter->second;
+      _cell_offsets[std::make_pair(univ->getId(), cell->getId())] = offset;
+
+      if (cell->getType() == MATERIAL)
+        offset++;
+      else if (cell->getType() == FILL)
+        offset += initializeInstanceOffsets(cell->getFillUniverse(),
+                                            num_instances);
+    }
+  }
+
+  /* Number the instances in each Lattice cell */
+  else {
+    Lattice* lattice = static_cast<Lattice*>(univ);
+    int num_x = lattice->getNumX();
+    int num_y = lattice->getNumY();
+    std::vector<long> offsets(num_x * num_y * lattice->getNumZ());
+
+    for (int k=0; k < lattice->getNumZ(); k++) {
+      for (int j=0; j < num_y; j++) {
+        for (int i=0; i < num_x; i++) {
+          offsets[i + num_x * (j + num_y * k)] = offset;
+          offset += initializeInstanceOffsets(lattice->getUniverse(i, j, k),
+                                              num_instances);
+        }
+      }
+    }
+
+    _lattice_offsets[lattice->getId()] = offsets;
+  }
+
+  num_instances[univ->getId()] = offset;
+  return offset;
+}
+
+
 /**
  * @brief Determines the fissionability of each Universe within this Geometry.
  * @details A Universe is determined fissionable if it contains a Cell
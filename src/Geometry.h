@@ -66,6 +66,102 @@ struct fsr_data {
   }
 };
 
+/**
+ * @struct template_segment
+ * @brief A template_segment represents a segment within a segment_template
+ *        relative to the point at which a Track enters a Lattice cell.
+ */
+struct template_segment {
+
+  /** The length of the segment (cm) */
+  FP_PRECISION _length;
+
+  /** A pointer to the Material in which the segment lies */
+  Material* _material;
+
+  /** The distance from the template's entry point to the segment start */
+  double _offset;
+
+  /** The offset of the segment's Cell instance beneath the Lattice cell */
+  long _instance;
+
+  /** The FSR key for the Universe levels beneath the Lattice cell */
+  std::string _key;
+};
+
+
+/**
+ * @struct template_key
+ * @brief A template_key identifies a segment_template by the Lattice, the
+ *        Universe filling the Lattice cell, the azimuthal angle and the
+ *        local entry point into the Lattice cell.
+ * @details The angle and the entry point are rounded to the resolution
+ *          TEMPLATE_COORD_THRESH.
+ */
+struct template_key {
+
+  /** The ID of the Lattice */
+  int _lattice_id;
+
+  /** The ID of the Universe filling the Lattice cell */
+  int _universe_id;
+
+  /** The rounded azimuthal angle */
+  long long _phi;
+
+  /** The rounded x-coordinate of the entry point */
+  long long _x;
+
+  /** The rounded y-coordinate of the entry point */
+  long long _y;
+
+  /** Compares two template keys for the segment template map */
+  bool operator==(const template_key& other) const {
+    return _lattice_id == other._lattice_id &&
+           _universe_id == other._universe_id && _phi == other._phi &&
+           _x == other._x && _y == other._y;
+  }
+};
+
+
+#ifndef SWIG
+namespace std {
+
+/**
+ * @brief Hashes a template_key for the segment template map.
+ */
+template <>
+struct hash<template_key> {
+  size_t operator()(const template_key& key) const {
+    size_t seed = std::hash<int>()(key._lattice_id);
+    long long values[4] = {key._universe_id, key._phi, key._x, key._y};
+    for (int i=0; i < 4; i++)
+      seed ^= std::hash<long long>()(values[i]) + 0x9e3779b9 +
+              (seed << 6) + (seed >> 2);
+    return seed;
+  }
+};
+
+}
+#endif
+
+
+/**
+ * @struct segment_template
+ * @brief A segment_template stores the segments crossed by a Track within a
+ *        Lattice cell for modular ray tracing.
+ * @details Segment templates are keyed by the Lattice, the Universe filling
+ *          the Lattice cell, the azimuthal angle and the local point at which
+ *          the Track enters the Lattice cell. Each template is traced once and
+ *          stitched into every other Track entering an instance of the same
+ *          Lattice cell Universe at the same local point.
+ */
+struct segment_template {
+
+  /** The segments crossed within the Lattice cell */
+  std::vector<template_segment> _segments;
+};
+
 void reset_auto_ids();
 
 
@@ -98,6 +194,32 @@ private:
    *  containing the Geometry. */
   boundaryType _y_max_bc;
 
+  /** Whether only the half of the Geometry above its x symmetry plane is
+   *  solved, with a reflective boundary at the symmetry plane */
+  bool _x_symmetry;
+
+  /** Whether only the half of the Geometry below its y symmetry plane is
+   *  solved, with a reflective boundary at the symmetry plane */
+  bool _y_symmetry;
+
+  /** The x-coordinate of the x symmetry plane */
+  double _x_symmetry_plane;
+
+  /** The y-coordinate of the y symmetry plane */
+  double _y_symmetry_plane;
+
+  /** The number of domains the Geometry is decomposed into along x */
+  int _num_domains_x;
+
+  /** The number of domains the Geometry is decomposed into along y */
+  int _num_domains_y;
+
+  /** The index along x of the domain of the Geometry which is solved */
+  int _domain_index_x;
+
+  /** The index along y of the domain of the Geometry which is solved */
+  int _domain_index_y;
+
   /** An map of FSR key hashes to unique fsr_data structs */
   ParallelHashMap<std::string, fsr_data*> _FSR_keys_map;
 
@@ -113,8 +235,47 @@ private:
   /* A map of all Material in the Geometry for optimization purposes */
   std::map<int, Material*> _all_materials;
 
+  /** A map of segment template keys to segment templates used for modular
+   *  ray tracing */
+  ParallelHashMap<template_key, segment_template*> _segment_templates;
+
+  /** The number of instances of Material-filled Cells in the root Universe */
+  long _num_instances;
+
+  /** The index of the first instance beneath each Cell of each Universe,
+   *  keyed by the Universe and Cell IDs */
+  std::map<std::pair<int, int>, long> _cell_offsets;
+
+  /** The index of the first instance beneath each Lattice cell, keyed by
+   *  the Lattice ID */
+  std::map<int, std::vector<long> > _lattice_offsets;
+
+  /** A map of the instance index (and CMFD cell) of each FSR to its
+   *  fsr_data, filled as Tracks are traced again */
+  ParallelHashMap<long, fsr_data*> _FSR_instances_map;
+
   Cell* findFirstCell(LocalCoords* coords);
   Cell* findNextCell(LocalCoords* coords);
+  double findNextSurfaceDist(LocalCoords* coords);
+  double findInternalBoundaryDist(LocalCoords* coords);
+  double findCmfdMeshDist(LocalCoords* coords);
+  bool isMirrorSymmetric(bool x_plane);
+  int findFSRId(std::string& fsr_key, Point* point, int mat_id, int cmfd_cell);
+  long getInstanceOffset(LocalCoords* first, LocalCoords* last);
+  int findFSRInstance(long instance);
+  int addFSRInstance(long instance, std::string& fsr_key);
+  int lookupFSRId(LocalCoords* coords);
+  long initializeInstanceOffsets(Universe* univ,
+                                 std::map<int, long>& num_instances);
+  std::string getCmfdKey(LocalCoords* coords);
+  std::string getLevelsKey(LocalCoords* first, LocalCoords* last);
+  LocalCoords* findTemplateLattice(LocalCoords* coords);
+  template_key getTemplateKey(LocalCoords* lat_coords);
+  Cell* segmentizeCell(Track* track, LocalCoords* start, LocalCoords* end,
+                       Cell* curr, bool retrace=false);
+  Cell* segmentizeLatticeCell(Track* track, LocalCoords* start,
+                              LocalCoords* end, Cell* curr,
+                              bool retrace=false);
 
 public:
 
@@ -135,6 +296,12 @@ public:
   boundaryType getMaxXBoundaryType();
   boundaryType getMinYBoundaryType();
   boundaryType getMaxYBoundaryType();
+  bool getXSymmetry();
+  bool getYSymmetry();
+  int getNumDomainsX();
+  int getNumDomainsY();
+  int getDomainIndexX();
+  int getDomainIndexY();
   Universe* getRootUniverse();
   int getNumFSRs();
   int getNumEnergyGroups();
@@ -157,10 +324,15 @@ public:
 
   /* Set parameters */
   void setCmfd(Cmfd* cmfd);
+  void setNumThreads(int num_threads);
   void setFSRCentroid(int fsr, Point* centroid);
+  void useSymmetry(bool x_symmetry, bool y_symmetry);
+  void setDomain(int num_domains_x, int num_domains_y, int domain_index_x,
+                 int domain_index_y);
 
   /* Find methods */
   Cell* findCellContainingCoords(LocalCoords* coords);
+  void applySymmetry(LocalCoords* coords);
   Material* findFSRMaterial(int fsr_id);
   int findFSRId(LocalCoords* coords);
   Cell* findCellContainingFSR(int fsr_id);
@@ -168,9 +340,16 @@ public:
   /* Other worker methods */
   void subdivideCells();
   void initializeFSRs(bool neighbor_cells=false);
-  void segmentize(Track* track);
+  void segmentize(Track* track, bool use_templates=false);
+  void retrace(Track* track, bool use_templates=false);
+  int getNumSegmentTemplates();
+  void clearSegmentTemplates();
+  void clearSegmentTemplateKeys();
   void initializeFSRVectors();
+  void renumberFSRs(int* new_FSR_ids);
   void computeFissionability(Universe* univ=NULL);
+  int estimateNumFSRs(Universe* univ=NULL);
+  int countSegments(Track* track);
 
   std::string toString();
   void printString();
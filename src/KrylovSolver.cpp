@@ -0,0 +1,1216 @@
+#include "KrylovSolver.h"
+
+
+/**
+ * @brief Computes the dot product of two vectors.
+ * @param x the first vector
+ * @param y the second vector
+ * @param size the length of the vectors
+ * @return the dot product accumulated in double precision
+ */
+static double dotProduct(ACC_PRECISION* x, ACC_PRECISION* y, int size) {
+
+  double dot = 0.;
+
+#pragma omp parallel for reduction(+:dot)
+  for (int i=0; i < size; i++)
+    dot += double(x[i]) * y[i];
+
+  return dot;
+}
+
+
+/**
+ * @brief Orthogonalizes a vector against a set of orthonormal vectors.
+ * @details The modified Gram-Schmidt process is applied twice to retain
+ *          the orthogonality of the Krylov vectors. The projections are
+ *          added to a column of an upper Hessenberg matrix.
+ * @param vectors the orthonormal vectors stored contiguously
+ * @param num_vectors the number of orthonormal vectors
+ * @param w the vector to orthogonalize
+ * @param size the length of the vectors
+ * @param column the column of the upper Hessenberg matrix
+ * @param stride the stride between rows of the upper Hessenberg matrix
+ * @return the norm of the orthogonalized vector
+ */
+static double orthogonalize(ACC_PRECISION* vectors, int num_vectors,
+                            ACC_PRECISION* w, int size, double* column,
+                            int stride) {
+
+  for (int i=0; i < num_vectors; i++)
+    column[i * stride] = 0.;
+
+  for (int pass=0; pass < 2; pass++) {
+    for (int i=0; i < num_vectors; i++) {
+
+      ACC_PRECISION* v = &vectors[i * size];
+      double projection = dotProduct(w, v, size);
+      column[i * stride] += projection;
+
+#pragma omp parallel for
+      for (int j=0; j < size; j++)
+        w[j] -= projection * v[j];
+    }
+  }
+
+  return sqrt(dotProduct(w, w, size));
+}
+
+
+/**
+ * @brief Computes the eigenvalues of a real upper Hessenberg matrix.
+ * @details The eigenvalues are computed with the shifted QR algorithm in
+ *          complex arithmetic. Each QR step factors the active block of the
+ *          shifted matrix with Givens rotations and multiplies the factors
+ *          in reverse order, using the eigenvalue of the trailing 2 x 2
+ *          block closest to its last diagonal element as the shift. The
+ *          eigenvalue of the last row is deflated once its subdiagonal
+ *          element is negligible. Since the matrix is real, eigenvalues with
+ *          a negligible imaginary part are made real and the others are
+ *          paired into exact complex conjugates.
+ * @param a the upper Hessenberg matrix
+ * @param n the size of the matrix
+ * @param ld the stride between rows of the matrix
+ * @param eigenvalues the eigenvalues
+ */
+static void computeHessenbergEigenvalues(double* a, int n, int ld,
+                                         std::complex<double>* eigenvalues) {
+
+  std::complex<double>* h = new std::complex<double>[n * n];
+  std::complex<double>* cs = new std::complex<double>[n];
+  std::complex<double>* sn = new std::complex<double>[n];
+
+  double anorm = 0.;
+  for (int i=0; i < n; i++) {
+    for (int j=0; j < n; j++) {
+      h[i*n+j] = (j >= i - 1) ? a[i*ld+j] : 0.;
+      anorm = std::max(anorm, fabs(a[i*ld+j]));
+    }
+  }
+
+  int last = n - 1;
+  int num_steps = 0;
+
+  while (last >= 0) {
+
+    /* Find the first row of the unreduced block ending at the last row */
+    int first = last;
+    while (first > 0) {
+      double diag = std::abs(h[first*n+first]) +
+                    std::abs(h[(first-1)*n+first-1]);
+      if (diag == 0.)
+        diag = anorm;
+      if (std::abs(h[first*n+first-1]) <= DBL_EPSILON * diag) {
+        h[first*n+first-1] = 0.;
+        break;
+      }
+      first--;
+    }
+
+    /* Deflate the eigenvalue of the last row */
+    if (first == last) {
+      eigenvalues[last] = h[last*n+last];
+      last--;
+      num_steps = 0;
+      continue;
+    }
+
+    if (num_steps == 30 * n)
+      log_printf(ERROR, "Unable to compute the eigenvalues of the "
+                 "%d x %d Hessenberg matrix", n, n);
+
+    /* Compute the shift from the trailing 2 x 2 block */
+    std::complex<double> h11 = h[(last-1)*n+last-1];
+    std::complex<double> h12 = h[(last-1)*n+last];
+    std::complex<double> h21 = h[last*n+last-1];
+    std::complex<double> h22 = h[last*n+last];
+    std::complex<double> mean = 0.5 * (h11 + h22);
+    std::complex<double> root = sqrt(0.25 * (h11 - h22) * (h11 - h22) +
+                                     h12 * h21);
+    std::complex<double> shift = mean + root;
+    if (std::abs(mean - root - h22) < std::abs(shift - h22))
+      shift = mean - root;
+
+    /* Perturb the shift of stagnating steps to break cycles */
+    num_steps++;
+    if (num_steps % 10 == 0)
+      shift += std::abs(h21) * std::complex<double>(0.75, 0.5);
+
+    /* Factor the shifted block as QR with Givens rotations */
+    for (int k=first; k <= last; k++)
+      h[k*n+k] -= shift;
+
+    for (int k=first; k < last; k++) {
+      std::complex<double> x = h[k*n+k];
+      std::complex<double> y = h[(k+1)*n+k];
+      double norm = sqrt(std::norm(x) + std::norm(y));
+
+      cs[k] = (norm == 0.) ? 1. : x / norm;
+      sn[k] = (norm == 0.) ? 0. : y / norm;
+
+      for (int j=k; j <= last; j++) {
+        std::complex<double> u = h[k*n+j];
+        std::complex<double> v = h[(k+1)*n+j];
+        h[k*n+j] = std::conj(cs[k]) * u + std::conj(sn[k]) * v;
+        h[(k+1)*n+j] = -sn[k] * u + cs[k] * v;
+      }
+    }
+
+    /* Multiply the factors in reverse order and remove the shift */
+    for (int k=first; k < last; k++) {
+      for (int i=first; i <= std::min(k+1, last); i++) {
+        std::complex<double> u = h[i*n+k];
+        std::complex<double> v = h[i*n+k+1];
+        h[i*n+k] = u * cs[k] + v * sn[k];
+        h[i*n+k+1] = -u * std::conj(sn[k]) + v * std::conj(cs[k]);
+      }
+    }
+
+    for (int k=first; k <= last; k++)
+      h[k*n+k] += shift;
+  }
+
+  /* Make the eigenvalues of the real matrix real or conjugate pairs */
+  double tol = std::max(anorm, DBL_MIN) * 1E-10;
+  bool* paired = new bool[n];
+
+  for (int i=0; i < n; i++) {
+    paired[i] = fabs(eigenvalues[i].imag()) <= tol;
+    if (paired[i])
+      eigenvalues[i] = eigenvalues[i].real();
+  }
+
+  for (int i=0; i < n; i++) {
+    if (paired[i] || eigenvalues[i].imag() < 0.)
+      continue;
+
+    int partner = -1;
+    for (int j=0; j < n; j++) {
+      if (!paired[j] && eigenvalues[j].imag() < 0. && (partner < 0 ||
+          std::abs(eigenvalues[j] - std::conj(eigenvalues[i])) <
+          std::abs(eigenvalues[partner] - std::conj(eigenvalues[i]))))
+        partner = j;
+    }
+
+    if (partner < 0)
+      continue;
+
+    eigenvalues[i] = 0.5 * (eigenvalues[i] + std::conj(eigenvalues[partner]));
+    eigenvalues[partner] = std::conj(eigenvalues[i]);
+    paired[i] = true;
+    paired[partner] = true;
+  }
+
+  delete [] h;
+  delete [] cs;
+  delete [] sn;
+  delete [] paired;
+}
+
+
+/**
+ * @brief Computes the eigenvector of a real upper Hessenberg matrix for a
+ *        known eigenvalue.
+ * @details The eigenvector is computed with two steps of inverse iteration
+ *          and is normalized to unit length.
+ * @param a the upper Hessenberg matrix
+ * @param n the size of the matrix
+ * @param ld the stride between rows of the matrix
+ * @param eigenvalue the eigenvalue
+ * @param y the eigenvector
+ */
+static void computeHessenbergEigenvector(double* a, int n, int ld,
+                                         std::complex<double> eigenvalue,
+                                         std::complex<double>* y) {
+
+  std::complex<double>* lu = new std::complex<double>[n * n];
+  int* pivots = new int[n];
+
+  /* Perturb the eigenvalue such that the shifted matrix is not singular */
+  double anorm = 0.;
+  for (int i=0; i < n; i++)
+    for (int j=std::max(i-1, 0); j < n; j++)
+      anorm += fabs(a[i*ld+j]);
+
+  double eps = std::max(anorm, 1.) * 1E-10;
+  std::complex<double> shift = eigenvalue + eps;
+
+  for (int i=0; i < n; i++) {
+    for (int j=0; j < n; j++)
+      lu[i*n+j] = a[i*ld+j];
+    lu[i*n+i] -= shift;
+  }
+
+  /* LU factorization with partial pivoting */
+  for (int j=0; j < n; j++) {
+
+    int pivot = j;
+    for (int i=j+1; i < n; i++) {
+      if (std::abs(lu[i*n+j]) > std::abs(lu[pivot*n+j]))
+        pivot = i;
+    }
+
+    pivots[j] = pivot;
+    if (pivot != j) {
+      for (int k=0; k < n; k++)
+        std::swap(lu[j*n+k], lu[pivot*n+k]);
+    }
+
+    if (std::abs(lu[j*n+j]) < eps)
+      lu[j*n+j] = eps;
+
+    for (int i=j+1; i < n; i++) {
+      lu[i*n+j] /= lu[j*n+j];
+      for (int k=j+1; k < n; k++)
+        lu[i*n+k] -= lu[i*n+j] * lu[j*n+k];
+    }
+  }
+
+  for (int i=0; i < n; i++)
+    y[i] = 1.;
+
+  for (int iter=0; iter < 2; iter++) {
+
+    /* Forward and back substitution */
+    for (int i=0; i < n; i++)
+      std::swap(y[i], y[pivots[i]]);
+
+    for (int i=0; i < n; i++) {
+      for (int k=0; k < i; k++)
+        y[i] -= lu[i*n+k] * y[k];
+    }
+
+    for (int i=n-1; i >= 0; i--) {
+      for (int k=i+1; k < n; k++)
+        y[i] -= lu[i*n+k] * y[k];
+      y[i] /= lu[i*n+i];
+    }
+
+    double norm = 0.;
+    for (int i=0; i < n; i++)
+      norm += std::norm(y[i]);
+
+    norm = sqrt(norm);
+    for (int i=0; i < n; i++)
+      y[i] /= norm;
+  }
+
+  delete [] lu;
+  delete [] pivots;
+}
+
+
+/**
+ * @brief Applies a shifted QR step to a real upper Hessenberg matrix.
+ * @details The QR factorization \f$ QR = H - \mu I \f$ (or
+ *          \f$ (H - \mu I)(H - \bar{\mu} I) \f$ for complex shifts) is
+ *          computed with Householder reflections and the matrix is replaced
+ *          by \f$ Q^T H Q \f$. The orthogonal matrix is accumulated into
+ *          the matrix of the implicit restart.
+ * @param a the upper Hessenberg matrix
+ * @param n the size of the matrix
+ * @param ld the stride between rows of the matrix
+ * @param shift the shift
+ * @param q the accumulated orthogonal matrix (n x n)
+ */
+static void applyShiftedQR(double* a, int n, int ld,
+                           std::complex<double> shift, double* q) {
+
+  double* b = new double[n * n];
+  double* p = new double[n * n];
+  double* tmp = new double[n * n];
+  double* v = new double[n];
+
+  /* Form the shifted matrix */
+  for (int i=0; i < n; i++) {
+    for (int j=0; j < n; j++) {
+      b[i*n+j] = a[i*ld+j];
+
+      if (shift.imag() != 0.) {
+        b[i*n+j] = 0.;
+        for (int k=0; k < n; k++)
+          b[i*n+j] += a[i*ld+k] * a[k*ld+j];
+        b[i*n+j] -= 2. * shift.real() * a[i*ld+j];
+      }
+    }
+
+    b[i*n+i] -= (shift.imag() != 0.) ? -std::norm(shift) : shift.real();
+  }
+
+  for (int i=0; i < n; i++)
+    for (int j=0; j < n; j++)
+      p[i*n+j] = (i == j) ? 1. : 0.;
+
+  /* Householder QR factorization accumulating P = H_0 H_1 ... */
+  for (int j=0; j < n-1; j++) {
+
+    double norm = 0.;
+    for (int i=j; i < n; i++)
+      norm += b[i*n+j] * b[i*n+j];
+    norm = sqrt(norm);
+
+    if (norm == 0.)
+      continue;
+
+    double alpha = (b[j*n+j] > 0.) ? -norm : norm;
+    for (int i=0; i < n; i++)
+      v[i] = (i < j) ? 0. : b[i*n+j];
+    v[j] -= alpha;
+
+    double v_norm = 0.;
+    for (int i=j; i < n; i++)
+      v_norm += v[i] * v[i];
+
+    if (v_norm == 0.)
+      continue;
+
+    /* Apply the reflection to the left of B */
+    for (int k=j; k < n; k++) {
+      double dot = 0.;
+      for (int i=j; i < n; i++)
+        dot += v[i] * b[i*n+k];
+      for (int i=j; i < n; i++)
+        b[i*n+k] -= 2. * dot / v_norm * v[i];
+    }
+
+    /* Apply the reflection to the right of P */
+    for (int i=0; i < n; i++) {
+      double dot = 0.;
+      for (int k=j; k < n; k++)
+        dot += p[i*n+k] * v[k];
+      for (int k=j; k < n; k++)
+        p[i*n+k] -= 2. * dot / v_norm * v[k];
+    }
+  }
+
+  /* Replace H with P^T H P */
+  for (int i=0; i < n; i++) {
+    for (int j=0; j < n; j++) {
+      tmp[i*n+j] = 0.;
+      for (int k=0; k < n; k++)
+        tmp[i*n+j] += a[i*ld+k] * p[k*n+j];
+    }
+  }
+
+  for (int i=0; i < n; i++) {
+    for (int j=0; j < n; j++) {
+      a[i*ld+j] = 0.;
+      if (i <= j + 1) {
+        for (int k=0; k < n; k++)
+          a[i*ld+j] += p[k*n+i] * tmp[k*n+j];
+      }
+    }
+  }
+
+  /* Accumulate Q = Q P */
+  for (int i=0; i < n; i++) {
+    for (int j=0; j < n; j++) {
+      tmp[i*n+j] = 0.;
+      for (int k=0; k < n; k++)
+        tmp[i*n+j] += q[i*n+k] * p[k*n+j];
+    }
+  }
+
+  std::copy(tmp, tmp + n * n, q);
+
+  delete [] b;
+  delete [] p;
+  delete [] tmp;
+  delete [] v;
+}
+
+
+/**
+ * @brief Compares two eigenvalues by decreasing magnitude, with complex
+ *        conjugates ordered by decreasing imaginary part.
+ * @details The magnitudes of exact complex conjugates are equal, such that
+ *          each conjugate pair is ordered with the positive imaginary part
+ *          first.
+ */
+static bool eigenvalueCompare(const std::complex<double>& first,
+                              const std::complex<double>& second) {
+
+  double first_abs = std::abs(first);
+  double second_abs = std::abs(second);
+
+  if (first_abs != second_abs)
+    return first_abs > second_abs;
+  else
+    return first.imag() > second.imag();
+}
+
+
+/**
+ * @class ScalarFluxGuard
+ * @brief Restores a Solver's scalar flux array when it goes out of scope.
+ * @details The KrylovSolver points the Solver's scalar flux at its Krylov
+ *          vectors for each transport sweep. The guard restores the Solver's
+ *          own array even if the sweep throws an exception.
+ */
+class ScalarFluxGuard {
+
+private:
+
+  /** The Solver's scalar flux array pointer */
+  ACC_PRECISION*& _solver_flux;
+
+  /** The Solver's own scalar flux array */
+  ACC_PRECISION* _saved_flux;
+
+public:
+
+  /**
+   * @brief Constructor saves the Solver's scalar flux array.
+   * @param scalar_flux the Solver's scalar flux array pointer
+   */
+  ScalarFluxGuard(ACC_PRECISION*& scalar_flux)
+    : _solver_flux(scalar_flux), _saved_flux(scalar_flux) {}
+
+  /**
+   * @brief Destructor restores the Solver's scalar flux array.
+   */
+  ~ScalarFluxGuard() {
+    _solver_flux = _saved_flux;
+  }
+};
+
+
+/**
+ * @brief Constructor initializes an empty KrylovSolver for a CPUSolver.
+ * @param solver a pointer to the CPUSolver used to apply transport sweeps
+ */
+KrylovSolver::KrylovSolver(CPUSolver* solver) {
+
+  if (solver == NULL)
+    log_printf(ERROR, "Unable to create a KrylovSolver without a Solver");
+
+  /* The Krylov vectors do not include the linear source moments */
+  if (dynamic_cast<CPULSSolver*>(solver) != NULL)
+    log_printf(ERROR, "Unable to create a KrylovSolver for a CPULSSolver");
+
+  _solver = solver;
+  _size = 0;
+  _krylov_size = 20;
+  _log_interval = 10;
+  _arnoldi_vectors = NULL;
+  _gmres_vectors = NULL;
+  _gmres_source = NULL;
+  _hessenberg = NULL;
+  _num_sweeps = 0;
+  _num_modes = 0;
+  _eigenvalues = NULL;
+  _eigenvectors = NULL;
+}
+
+
+/**
+ * @brief Destructor deletes the Krylov vectors and eigenmodes.
+ */
+KrylovSolver::~KrylovSolver() {
+
+  if (_arnoldi_vectors != NULL)
+    delete [] _arnoldi_vectors;
+
+  if (_gmres_vectors != NULL)
+    delete [] _gmres_vectors;
+
+  if (_gmres_source != NULL)
+    delete [] _gmres_source;
+
+  if (_hessenberg != NULL)
+    delete [] _hessenberg;
+
+  if (_eigenvalues != NULL)
+    delete [] _eigenvalues;
+
+  if (_eigenvectors != NULL)
+    delete [] _eigenvectors;
+}
+
+
+/**
+ * @brief Returns the maximum dimension of the Krylov subspaces.
+ * @return the maximum dimension of the Krylov subspaces
+ */
+int KrylovSolver::getKrylovSize() {
+  return _krylov_size;
+}
+
+
+/**
+ * @brief Returns the number of transport sweeps performed by the last
+ *        calculation.
+ * @return the number of transport sweeps
+ */
+int KrylovSolver::getNumSweeps() {
+  return _num_sweeps;
+}
+
+
+/**
+ * @brief Returns the number of eigenmodes computed by computeEigenmodes(...).
+ * @return the number of eigenmodes
+ */
+int KrylovSolver::getNumModes() {
+  return _num_modes;
+}
+
+
+/**
+ * @brief Returns the real part of an eigenvalue.
+ * @param mode the index of the eigenmode (0 for the fundamental mode)
+ * @return the real part of the eigenvalue
+ */
+double KrylovSolver::getEigenvalue(int mode) {
+
+  if (mode < 0 || mode >= _num_modes)
+    log_printf(ERROR, "Unable to get eigenvalue %d since %d eigenmodes "
+               "have been computed", mode, _num_modes);
+
+  return _eigenvalues[mode].real();
+}
+
+
+/**
+ * @brief Returns the imaginary part of an eigenvalue.
+ * @param mode the index of the eigenmode (0 for the fundamental mode)
+ * @return the imaginary part of the eigenvalue
+ */
+double KrylovSolver::getEigenvalueImag(int mode) {
+
+  if (mode < 0 || mode >= _num_modes)
+    log_printf(ERROR, "Unable to get eigenvalue %d since %d eigenmodes "
+               "have been computed", mode, _num_modes);
+
+  return _eigenvalues[mode].imag();
+}
+
+
+/**
+ * @brief Fills an array with the real part of the scalar fluxes of an
+ *        eigenmode.
+ * @details The eigenmodes are normalized to unit length and rotated such
+ *          that their largest value is real and positive, which makes the
+ *          fundamental mode positive. Although this method
+ *          appears to require three arguments, in reality it only requires
+ *          two due to SWIG and would be called from within Python as follows:
+ *
+ * @code
+ *          num_fluxes = num_groups * num_FSRs
+ *          fluxes = krylov_solver.getEigenvector(0, num_fluxes)
+ * @endcode
+ *
+ * @param mode the index of the eigenmode (0 for the fundamental mode)
+ * @param out_fluxes an array of FSR scalar fluxes in each energy group
+ * @param num_fluxes the total number of FSR flux values
+ */
+void KrylovSolver::getEigenvector(int mode, FP_PRECISION* out_fluxes,
+                                  int num_fluxes) {
+
+  if (mode < 0 || mode >= _num_modes)
+    log_printf(ERROR, "Unable to get eigenvector %d since %d eigenmodes "
+               "have been computed", mode, _num_modes);
+
+  if (num_fluxes != _size)
+    log_printf(ERROR, "Unable to get eigenvector %d with %d flux values "
+               "since the eigenmodes have %d flux values", mode,
+               num_fluxes, _size);
+
+#pragma omp parallel for
+  for (int i=0; i < _size; i++)
+    out_fluxes[i] = _eigenvectors[mode * _size + i].real();
+}
+
+
+/**
+ * @brief Fills an array with the imaginary part of the scalar fluxes of an
+ *        eigenmode.
+ * @details The imaginary part is zero for eigenmodes with real eigenvalues.
+ *          Although this method appears to require three arguments, in
+ *          reality it only requires two due to SWIG and would be called from
+ *          within Python as follows:
+ *
+ * @code
+ *          num_fluxes = num_groups * num_FSRs
+ *          fluxes = krylov_solver.getEigenvectorImag(1, num_fluxes)
+ * @endcode
+ *
+ * @param mode the index of the eigenmode (0 for the fundamental mode)
+ * @param out_fluxes an array of FSR scalar fluxes in each energy group
+ * @param num_fluxes the total number of FSR flux values
+ */
+void KrylovSolver::getEigenvectorImag(int mode, FP_PRECISION* out_fluxes,
+                                      int num_fluxes) {
+
+  if (mode < 0 || mode >= _num_modes)
+    log_printf(ERROR, "Unable to get eigenvector %d since %d eigenmodes "
+               "have been computed", mode, _num_modes);
+
+  if (num_fluxes != _size)
+    log_printf(ERROR, "Unable to get eigenvector %d with %d flux values "
+               "since the eigenmodes have %d flux values", mode,
+               num_fluxes, _size);
+
+#pragma omp parallel for
+  for (int i=0; i < _size; i++)
+    out_fluxes[i] = _eigenvectors[mode * _size + i].imag();
+}
+
+
+/**
+ * @brief Sets the maximum dimension of the Krylov subspaces.
+ * @details This is the number of GMRES iterations between restarts and the
+ *          minimum number of Arnoldi vectors between implicit restarts. The
+ *          memory required for the Krylov vectors is proportional to this
+ *          dimension times the number of FSRs and energy groups.
+ * @param krylov_size the maximum dimension of the Krylov subspaces
+ */
+void KrylovSolver::setKrylovSize(int krylov_size) {
+
+  if (krylov_size < 2)
+    log_printf(ERROR, "Unable to set the Krylov subspace size to %d since "
+               "it is less than 2", krylov_size);
+
+  _krylov_size = krylov_size;
+}
+
+
+/**
+ * @brief Sets the interval between transport sweeps which are reported at
+ *        the NORMAL log level.
+ * @details The other transport sweeps are reported at the INFO log level.
+ * @param interval the number of transport sweeps between NORMAL reports
+ */
+void KrylovSolver::setLogInterval(int interval) {
+
+  if (interval <= 0)
+    log_printf(ERROR, "Unable to set the log interval to %d since it is "
+               "not a positive number", interval);
+
+  _log_interval = interval;
+}
+
+
+/**
+ * @brief Initializes the Solver's data structures and the Krylov vectors.
+ * @param mode the solution type (FORWARD or ADJOINT)
+ */
+void KrylovSolver::initializeSolver(solverMode mode) {
+
+  Geometry* geometry = _solver->getGeometry();
+
+  if (geometry == NULL || _solver->getTrackGenerator() == NULL)
+    log_printf(ERROR, "Unable to use a KrylovSolver with a Solver which "
+               "does not contain a TrackGenerator");
+
+  /* The boundary angular fluxes are not part of the Krylov vectors */
+  if (geometry->getMinXBoundaryType() != VACUUM ||
+      geometry->getMaxXBoundaryType() != VACUUM ||
+      geometry->getMinYBoundaryType() != VACUUM ||
+      geometry->getMaxYBoundaryType() != VACUUM)
+    log_printf(ERROR, "Unable to use a KrylovSolver since all boundary "
+               "conditions must be VACUUM");
+
+  if (_solver->_cmfd != NULL && _solver->_cmfd->isFluxUpdateOn())
+    log_printf(ERROR, "Unable to use a KrylovSolver with CMFD acceleration");
+
+  /* The Krylov iterations overwrite the Solver's fluxes, which can not be
+   * used to warm start a subsequent calculation */
+  _solver->initializeSolver(mode);
+  _solver->_num_iterations = 0;
+  _solver->zeroTrackFluxes();
+
+  int size = geometry->getNumFSRs() * geometry->getNumEnergyGroups();
+
+  /* Allocate the GMRES vectors */
+  if (_gmres_vectors != NULL)
+    delete [] _gmres_vectors;
+  if (_gmres_source != NULL)
+    delete [] _gmres_source;
+  if (_hessenberg != NULL)
+    delete [] _hessenberg;
+
+  _size = size;
+  _gmres_vectors = new ACC_PRECISION[(_krylov_size + 1) * _size];
+  _gmres_source = new ACC_PRECISION[_size];
+  _hessenberg = new double[(_krylov_size + 1) * _krylov_size];
+  _num_sweeps = 0;
+}
+
+
+/**
+ * @brief Performs a transport sweep with the source from a scalar flux.
+ * @details The Solver's scalar flux array is pointed at the input fluxes to
+ *          compute the source and at the output fluxes for the transport
+ *          sweep, such that no fluxes are copied. The Solver's own array is
+ *          restored after the sweep.
+ * @param op the source used in the sweep (scatter, fission or total)
+ * @param in_fluxes the scalar fluxes used to compute the source
+ * @param out_fluxes the scalar fluxes computed by the transport sweep
+ */
+void KrylovSolver::transportSweep(krylovOperator op,
+                                  ACC_PRECISION* in_fluxes,
+                                  ACC_PRECISION* out_fluxes) {
+
+  ScalarFluxGuard guard(_solver->_scalar_flux);
+  _solver->_scalar_flux = in_fluxes;
+
+  if (op == SCATTER_OPERATOR)
+    _solver->computeFSRScatterSources();
+  else if (op == FISSION_OPERATOR)
+    _solver->computeFSRFissionSources();
+  else
+    _solver->computeFSRSources();
+
+  _solver->_scalar_flux = out_fluxes;
+  _solver->transportSweep();
+  _solver->addSourceToScalarFlux();
+  _num_sweeps++;
+
+  if (_num_sweeps % _log_interval == 0)
+    log_printf(NORMAL, "Performed transport sweep number %d", _num_sweeps);
+  else
+    log_printf(INFO, "Performed transport sweep number %d", _num_sweeps);
+}
+
+
+/**
+ * @brief Applies a linear transport operator to a scalar flux.
+ * @details The TRANSPORT_OPERATOR subtracts the contribution of the fixed
+ *          sources, which are stored in the GMRES source vector.
+ * @param op the operator to apply
+ * @param in_fluxes the scalar fluxes the operator is applied to
+ * @param out_fluxes the result of the operator
+ */
+void KrylovSolver::applyOperator(krylovOperator op,
+                                 ACC_PRECISION* in_fluxes,
+                                 ACC_PRECISION* out_fluxes) {
+
+  transportSweep(op, in_fluxes, out_fluxes);
+
+  if (op == SCATTER_OPERATOR) {
+#pragma omp parallel for
+    for (int i=0; i < _size; i++)
+      out_fluxes[i] = in_fluxes[i] - out_fluxes[i];
+  }
+  else if (op == TRANSPORT_OPERATOR) {
+#pragma omp parallel for
+    for (int i=0; i < _size; i++)
+      out_fluxes[i] = in_fluxes[i] - out_fluxes[i] + _gmres_source[i];
+  }
+}
+
+
+/**
+ * @brief Solves a linear system with a transport operator using restarted
+ *        GMRES.
+ * @param op the operator of the linear system
+ * @param b the right hand side
+ * @param x the initial guess which is overwritten with the solution
+ * @param tol the tolerance on the residual relative to the right hand side
+ * @param max_iters the maximum number of GMRES iterations
+ * @return the number of GMRES iterations
+ */
+int KrylovSolver::solveGMRES(krylovOperator op, ACC_PRECISION* b,
+                             ACC_PRECISION* x, double tol, int max_iters) {
+
+  int m = _krylov_size;
+  double* cs = new double[m];
+  double* sn = new double[m];
+  double* g = new double[m + 1];
+  double* y = new double[m];
+
+  int num_iters = 0;
+  double residual = 0.;
+  double b_norm = sqrt(dotProduct(b, b, _size));
+
+  if (b_norm == 0.)
+    b_norm = 1.;
+
+  while (true) {
+
+    /* Compute the residual of the initial guess */
+    ACC_PRECISION* r = _gmres_vectors;
+    applyOperator(op, x, r);
+
+#pragma omp parallel for
+    for (int i=0; i < _size; i++)
+      r[i] = b[i] - r[i];
+
+    residual = sqrt(dotProduct(r, r, _size));
+
+    if (residual <= tol * b_norm || num_iters >= max_iters)
+      break;
+
+#pragma omp parallel for
+    for (int i=0; i < _size; i++)
+      r[i] /= residual;
+
+    std::fill_n(g, m + 1, 0.);
+    g[0] = residual;
+
+    /* Arnoldi process with Givens rotations of the Hessenberg matrix */
+    int j;
+    for (j=0; j < m && num_iters < max_iters; j++) {
+
+      ACC_PRECISION* w = &_gmres_vectors[(j+1) * _size];
+      applyOperator(op, &_gmres_vectors[j * _size], w);
+      num_iters++;
+
+      double w_norm = orthogonalize(_gmres_vectors, j+1, w, _size,
+                                    &_hessenberg(0,j), _krylov_size);
+      _hessenberg(j+1,j) = w_norm;
+
+      if (w_norm > 0.) {
+#pragma omp parallel for
+        for (int i=0; i < _size; i++)
+          w[i] /= w_norm;
+      }
+
+      for (int i=0; i < j; i++) {
+        double h = _hessenberg(i,j);
+        _hessenberg(i,j) = cs[i] * h + sn[i] * _hessenberg(i+1,j);
+        _hessenberg(i+1,j) = -sn[i] * h + cs[i] * _hessenberg(i+1,j);
+      }
+
+      double denom = sqrt(_hessenberg(j,j) * _hessenberg(j,j) +
+                          _hessenberg(j+1,j) * _hessenberg(j+1,j));
+      cs[j] = _hessenberg(j,j) / denom;
+      sn[j] = _hessenberg(j+1,j) / denom;
+      _hessenberg(j,j) = denom;
+      _hessenberg(j+1,j) = 0.;
+      g[j+1] = -sn[j] * g[j];
+      g[j] = cs[j] * g[j];
+
+      residual = fabs(g[j+1]);
+      log_printf(DEBUG, "GMRES iteration %d:\tres = %1.3E", num_iters,
+                 residual / b_norm);
+
+      if (residual <= tol * b_norm) {
+        j++;
+        break;
+      }
+    }
+
+    /* Update the solution with the least squares solution */
+    for (int i=j-1; i >= 0; i--) {
+      y[i] = g[i];
+      for (int k=i+1; k < j; k++)
+        y[i] -= _hessenberg(i,k) * y[k];
+      y[i] /= _hessenberg(i,i);
+    }
+
+#pragma omp parallel for
+    for (int i=0; i < _size; i++) {
+      for (int k=0; k < j; k++)
+        x[i] += y[k] * _gmres_vectors[k * _size + i];
+    }
+
+    if (residual <= tol * b_norm || num_iters >= max_iters)
+      break;
+  }
+
+  if (residual > tol * b_norm)
+    log_printf(WARNING, "Unable to converge GMRES in %d iterations",
+               max_iters);
+
+  delete [] cs;
+  delete [] sn;
+  delete [] g;
+  delete [] y;
+
+  return num_iters;
+}
+
+
+/**
+ * @brief Computes the scalar flux for a fixed source with GMRES.
+ * @details This solves the same fixed source problem as
+ *          Solver::computeSource(...), i.e.
+ *          \f$ (I - T (S + F / k)) \phi = T Q \f$ for the user-defined fixed
+ *          sources \f$ Q \f$, with restarted GMRES rather than source
+ *          iteration. The scalar flux is stored in the Solver's flux arrays.
+ *          This method may be called from Python as follows:
+ *
+ * @code
+ *          krylov_solver = openmoc.KrylovSolver(solver)
+ *          krylov_solver.computeSource(max_iters=100, k_eff=0.981)
+ * @endcode
+ *
+ * @param max_iters the maximum number of GMRES iterations
+ * @param mode the solution type (FORWARD or ADJOINT)
+ * @param k_eff the sub/super-critical eigenvalue (default 1.0)
+ * @param tol the tolerance on the residual relative to the fixed source
+ */
+void KrylovSolver::computeSource(int max_iters, solverMode mode,
+                                 double k_eff, double tol) {
+
+  if (k_eff <= 0.)
+    log_printf(ERROR, "The KrylovSolver is unable to compute the source with "
+               "keff = %f since it is not a positive value", k_eff);
+
+  log_printf(NORMAL, "Computing the source with GMRES...");
+
+  initializeSolver(mode);
+  _solver->_k_eff = k_eff;
+
+  /* The GMRES solution is computed in the Solver's scalar flux array */
+  ACC_PRECISION* scalar_flux = _solver->_scalar_flux;
+  _solver->flattenFSRFluxes(0.0);
+
+  /* Compute the uncollided flux from the fixed sources */
+  transportSweep(TRANSPORT_OPERATOR, scalar_flux, _gmres_source);
+
+  int num_iters = solveGMRES(TRANSPORT_OPERATOR, _gmres_source, scalar_flux,
+                             tol, max_iters);
+
+  _solver->storeFSRFluxes();
+  _solver->resetMaterials(mode);
+
+  log_printf(NORMAL, "Converged the source in %d GMRES iterations "
+             "(%d transport sweeps)", num_iters, _num_sweeps);
+}
+
+
+/**
+ * @brief Computes the eigenmodes with the largest eigenvalues with the
+ *        Implicitly Restarted Arnoldi Method.
+ * @details The Arnoldi process is applied to the operator
+ *          \f$ (I - T S)^{-1} T F \f$, whose eigenvalues are the
+ *          \f$ k \f$-eigenvalues of the transport problem, and each
+ *          application of the operator solves a fixed scatter source problem
+ *          with GMRES. After each Arnoldi process the unwanted Ritz values
+ *          are removed from the Krylov subspace by shifted QR steps of the
+ *          Hessenberg matrix. This method may be called from Python as
+ *          follows:
+ *
+ * @code
+ *          krylov_solver = openmoc.KrylovSolver(solver)
+ *          krylov_solver.computeEigenmodes(num_modes=5)
+ *          k_eff = krylov_solver.getEigenvalue(0)
+ * @endcode
+ *
+ * @param mode the solution type (FORWARD or ADJOINT)
+ * @param num_modes the number of eigenmodes to compute
+ * @param outer_tol the tolerance on the relative residual of the eigenmodes
+ * @param inner_tol the tolerance on the relative residual of each GMRES solve
+ * @param max_iters the maximum number of implicit restarts
+ */
+void KrylovSolver::computeEigenmodes(solverMode mode, int num_modes,
+                                     double outer_tol, double inner_tol,
+                                     int max_iters) {
+
+  if (num_modes <= 0)
+    log_printf(ERROR, "Unable to compute %d eigenmodes since it is not a "
+               "positive number", num_modes);
+
+  log_printf(NORMAL, "Computing %d eigenmodes...", num_modes);
+
+  initializeSolver(mode);
+
+  if (num_modes >= _size - 1)
+    log_printf(ERROR, "Unable to compute %d eigenmodes with %d flux values",
+               num_modes, _size);
+
+  /* The dimension of the Arnoldi subspace */
+  int m = std::min(std::max(_krylov_size, 2 * num_modes + 1), _size);
+
+  if (_arnoldi_vectors != NULL)
+    delete [] _arnoldi_vectors;
+
+  _arnoldi_vectors = new ACC_PRECISION[(m + 1) * _size];
+  double* hessenberg = new double[(m + 1) * m];
+  double* q = new double[m * m];
+  std::complex<double>* ritz_values = new std::complex<double>[m];
+  std::complex<double>* ritz_vectors =
+    new std::complex<double>[num_modes * m];
+  double* residuals = new double[num_modes];
+
+  std::fill_n(hessenberg, (m + 1) * m, 0.);
+
+  /* Start from a flat scalar flux */
+  for (int i=0; i < _size; i++)
+    _arnoldi_vectors[i] = 1. / sqrt(double(_size));
+
+  int num_kept = 0;
+  int num_inner = 0;
+  bool converged = false;
+
+  for (int iter=0; iter < max_iters; iter++) {
+
+    /* Extend the Arnoldi process to m vectors */
+    for (int j=num_kept; j < m; j++) {
+
+      ACC_PRECISION* v = &_arnoldi_vectors[j * _size];
+      ACC_PRECISION* w = &_arnoldi_vectors[(j+1) * _size];
+
+      /* Solve (I - TS) w = TF v starting from TF v */
+      transportSweep(FISSION_OPERATOR, v, _gmres_source);
+      std::copy(_gmres_source, _gmres_source + _size, w);
+      num_inner += solveGMRES(SCATTER_OPERATOR, _gmres_source, w, inner_tol,
+                              1000);
+
+      double w_norm = orthogonalize(_arnoldi_vectors, j+1, w, _size,
+                                    &hessenberg[j], m);
+      hessenberg[(j+1)*m + j] = w_norm;
+
+      if (w_norm == 0.)
+        log_printf(ERROR, "The Arnoldi process found an invariant subspace "
+                   "of dimension %d", j+1);
+
+#pragma omp parallel for
+      for (int i=0; i < _size; i++)
+        w[i] /= w_norm;
+    }
+
+    /* Compute the Ritz values */
+    computeHessenbergEigenvalues(hessenberg, m, m, ritz_values);
+    std::sort(ritz_values, ritz_values + m, eigenvalueCompare);
+
+    /* Compute the residuals of the wanted Ritz pairs */
+    double beta = hessenberg[m*m + m-1];
+    double max_residual = 0.;
+
+    for (int k=0; k < num_modes; k++) {
+      computeHessenbergEigenvector(hessenberg, m, m, ritz_values[k],
+                                   &ritz_vectors[k * m]);
+      residuals[k] = fabs(beta) * std::abs(ritz_vectors[k * m + m-1]) /
+                     std::abs(ritz_values[k]);
+      max_residual = std::max(max_residual, residuals[k]);
+    }
+
+    log_printf(NORMAL, "Arnoldi iteration %d:\tk_eff = %1.6f\tres = %1.3E",
+               iter, ritz_values[0].real(), max_residual);
+
+    if (max_residual < outer_tol) {
+      converged = true;
+      break;
+    }
+
+    /* Keep complex conjugate Ritz values together */
+    num_kept = num_modes;
+    if (ritz_values[num_kept-1].imag() > 0.)
+      num_kept++;
+
+    /* Remove the unwanted Ritz values with shifted QR steps */
+    for (int i=0; i < m; i++)
+      for (int j=0; j < m; j++)
+        q[i*m+j] = (i == j) ? 1. : 0.;
+
+    for (int i=num_kept; i < m; i++) {
+      if (ritz_values[i].imag() >= 0.)
+        applyShiftedQR(hessenberg, m, m, ritz_values[i], q);
+    }
+
+    /* Update the Arnoldi vectors and residual with the restart */
+    double sigma = q[(m-1)*m + num_kept-1];
+    double beta_kept = hessenberg[num_kept*m + num_kept-1];
+
+#pragma omp parallel
+    {
+      double* row = new double[num_kept + 1];
+
+#pragma omp for schedule(static)
+      for (int i=0; i < _size; i++) {
+        for (int l=0; l <= num_kept; l++) {
+          row[l] = 0.;
+          for (int k=0; k < m; k++)
+            row[l] += _arnoldi_vectors[k * _size + i] * q[k*m + l];
+        }
+
+        double f = row[num_kept] * beta_kept +
+                   _arnoldi_vectors[m * _size + i] * beta * sigma;
+
+        for (int l=0; l < num_kept; l++)
+          _arnoldi_vectors[l * _size + i] = row[l];
+        _arnoldi_vectors[num_kept * _size + i] = f;
+      }
+
+      delete [] row;
+    }
+
+    ACC_PRECISION* f = &_arnoldi_vectors[num_kept * _size];
+    double f_norm = sqrt(dotProduct(f, f, _size));
+
+#pragma omp parallel for
+    for (int i=0; i < _size; i++)
+      f[i] /= f_norm;
+
+    for (int i=0; i <= m; i++) {
+      for (int j=0; j < m; j++) {
+        if (j >= num_kept || i > num_kept)
+          hessenberg[i*m + j] = 0.;
+      }
+    }
+
+    hessenberg[num_kept*m + num_kept-1] = f_norm;
+  }
+
+  if (!converged)
+    log_printf(WARNING, "Unable to converge the eigenmodes in %d "
+               "implicit restarts", max_iters);
+
+  /* Compute the eigenmodes from the Ritz vectors */
+  if (_eigenvalues != NULL)
+    delete [] _eigenvalues;
+  if (_eigenvectors != NULL)
+    delete [] _eigenvectors;
+
+  _num_modes = num_modes;
+  _eigenvalues = new std::complex<double>[_num_modes];
+  _eigenvectors = new std::complex<double>[_num_modes * _size];
+
+  for (int k=0; k < _num_modes; k++) {
+
+    _eigenvalues[k] = ritz_values[k];
+    std::complex<double>* y = &ritz_vectors[k * m];
+    std::complex<double>* eigenvector = &_eigenvectors[k * _size];
+
+    /* Rotate the complex Ritz vector such that its largest value is real */
+    int max_index = 0;
+    double max_value = 0.;
+
+    for (int i=0; i < _size; i++) {
+      std::complex<double> value = 0.;
+      for (int j=0; j < m; j++)
+        value += y[j] * double(_arnoldi_vectors[j * _size + i]);
+      if (std::abs(value) > max_value) {
+        max_value = std::abs(value);
+        max_index = i;
+      }
+    }
+
+    std::complex<double> phase = 0.;
+    for (int j=0; j < m; j++)
+      phase += y[j] * double(_arnoldi_vectors[j * _size + max_index]);
+    phase = std::conj(phase) / std::abs(phase);
+
+#pragma omp parallel for
+    for (int i=0; i < _size; i++) {
+      std::complex<double> value = 0.;
+      for (int j=0; j < m; j++)
+        value += y[j] * double(_arnoldi_vectors[j * _size + i]);
+      eigenvector[i] = value * phase;
+    }
+
+    double norm = 0.;
+    for (int i=0; i < _size; i++)
+      norm += std::norm(eigenvector[i]);
+    norm = sqrt(norm);
+
+#pragma omp parallel for
+    for (int i=0; i < _size; i++)
+      eigenvector[i] /= norm;
+  }
+
+  _solver->resetMaterials(mode);
+
+  log_printf(NORMAL, "Computed %d eigenmodes with %d GMRES iterations "
+             "(%d transport sweeps)", _num_modes, num_inner, _num_sweeps);
+
+  delete [] hessenberg;
+  delete [] q;
+  delete [] ritz_values;
+  delete [] ritz_vectors;
+  delete [] residuals;
+}
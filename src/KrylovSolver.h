@@ -0,0 +1,132 @@
+/**
+ * @file KrylovSolver.h
+ * @brief The KrylovSolver class.
+ * @date October 19, 2026
+ */
+
+
+#ifndef KRYLOVSOLVER_H_
+#define KRYLOVSOLVER_H_
+
+#ifdef __cplusplus
+#ifdef SWIG
+#include "Python.h"
+#endif
+#include "CPUSolver.h"
+#include "CPULSSolver.h"
+#include <algorithm>
+#include <complex>
+#include <float.h>
+#endif
+
+
+/** Indexing macro for the upper Hessenberg matrix of the Arnoldi and GMRES
+ *  processes with _krylov_size columns */
+#define _hessenberg(i,j) (_hessenberg[(i)*_krylov_size + (j)])
+
+
+/**
+ * @enum krylovOperator
+ * @brief The transport operators applied to the Krylov vectors.
+ */
+enum krylovOperator {
+
+  /** The scattering operator \f$ \phi - T S \phi \f$ */
+  SCATTER_OPERATOR,
+
+  /** The fission operator \f$ T F \phi \f$ */
+  FISSION_OPERATOR,
+
+  /** The fixed source operator \f$ \phi - T (S + F / k) \phi \f$ */
+  TRANSPORT_OPERATOR
+};
+
+
+/**
+ * @class KrylovSolver KrylovSolver.h "src/KrylovSolver.h"
+ * @brief A Krylov subspace solver for MOC fixed source and eigenmode
+ *        calculations.
+ * @details The KrylovSolver solves the fixed source problem with restarted
+ *          GMRES and computes the eigenmodes with largest eigenvalues with
+ *          the Implicitly Restarted Arnoldi Method (IRAM). The transport
+ *          operators are applied by pointing a CPUSolver's scalar flux array
+ *          at the Krylov vectors, such that no fluxes are copied between
+ *          the Solver and the Krylov subspace. Since the boundary angular
+ *          fluxes are not part of the Krylov vectors, the Geometry must use
+ *          VACUUM boundary conditions. The KrylovSolver may not be used with
+ *          a CPULSSolver since its linear source moments are not part of
+ *          the Krylov vectors either.
+ */
+class KrylovSolver {
+
+private:
+
+  /** The CPUSolver used to apply the transport operators */
+  CPUSolver* _solver;
+
+  /** The number of flux values (# FSRs x # energy groups) */
+  int _size;
+
+  /** The maximum dimension of the Krylov subspaces */
+  int _krylov_size;
+
+  /** The number of transport sweeps between NORMAL log reports */
+  int _log_interval;
+
+  /** The Krylov vectors of the outer Arnoldi process */
+  ACC_PRECISION* _arnoldi_vectors;
+
+  /** The Krylov vectors of the inner GMRES process */
+  ACC_PRECISION* _gmres_vectors;
+
+  /** The right hand side of the GMRES process */
+  ACC_PRECISION* _gmres_source;
+
+  /** The upper Hessenberg matrix of the GMRES process */
+  double* _hessenberg;
+
+  /** The total number of transport sweeps */
+  int _num_sweeps;
+
+  /** The number of converged eigenmodes */
+  int _num_modes;
+
+  /** The eigenvalues of each eigenmode */
+  std::complex<double>* _eigenvalues;
+
+  /** The scalar flux of each eigenmode */
+  std::complex<double>* _eigenvectors;
+
+  void initializeSolver(solverMode mode);
+  void transportSweep(krylovOperator op, ACC_PRECISION* in_fluxes,
+                      ACC_PRECISION* out_fluxes);
+  void applyOperator(krylovOperator op, ACC_PRECISION* in_fluxes,
+                     ACC_PRECISION* out_fluxes);
+  int solveGMRES(krylovOperator op, ACC_PRECISION* b, ACC_PRECISION* x,
+                 double tol, int max_iters);
+
+public:
+  KrylovSolver(CPUSolver* solver);
+  virtual ~KrylovSolver();
+
+  int getKrylovSize();
+  int getNumSweeps();
+  int getNumModes();
+  double getEigenvalue(int mode);
+  double getEigenvalueImag(int mode);
+  void getEigenvector(int mode, FP_PRECISION* out_fluxes, int num_fluxes);
+  void getEigenvectorImag(int mode, FP_PRECISION* out_fluxes,
+                          int num_fluxes);
+
+  void setKrylovSize(int krylov_size);
+  void setLogInterval(int interval);
+
+  void computeSource(int max_iters=1000, solverMode mode=FORWARD,
+                     double k_eff=1.0, double tol=1E-6);
+  void computeEigenmodes(solverMode mode=FORWARD, int num_modes=5,
+                         double outer_tol=1E-5, double inner_tol=1E-6,
+                         int max_iters=300);
+};
+
+
+#endif /* KRYLOVSOLVER_H_ */
@@ -32,7 +32,7 @@
 template <class K, class V>
 class FixedHashMap {
   struct node {
-    node(K k_in, V v_in) : next(NULL), key(k_in), value(v_in) {}
+    node(K k_in, V v_in) : key(k_in), value(v_in), next(NULL) {}
     K key;
     V value;
     node *next;
@@ -119,6 +119,7 @@ class ParallelHashMap {
     V* values();
     void clear();
     void print_buckets();
+    void setNumThreads(int num_threads);
 };
 
 
@@ -443,6 +444,8 @@ ParallelHashMap<K,V>::ParallelHashMap(size_t M, size_t L) {
     omp_init_lock(&_locks[i]);
 
   _announce = new paddedPointer[_num_threads];
+  for (size_t t=0; t<_num_threads; t++)
+    _announce[t].value = NULL;
 }
 
 
@@ -849,4 +852,28 @@ void ParallelHashMap<K,V>::print_buckets() {
   _announce[tid].value = NULL;
 }
 
+
+
+/**
+ * @brief Sets the number of threads which may concurrently access the map.
+ * @details Each thread announces the table it is reading such that the
+ *      number of threads must be at least the number of OpenMP threads in
+ *      any parallel region accessing the map. The announcements are only
+ *      reallocated if the number of threads increases. This must not be
+ *      called while any thread is accessing the map.
+ * @param num_threads the number of threads
+ */
+template <class K, class V>
+void ParallelHashMap<K,V>::setNumThreads(int num_threads) {
+
+  if (num_threads <= (int)_num_threads)
+    return;
+
+  delete [] _announce;
+  _num_threads = num_threads;
+  _announce = new paddedPointer[_num_threads];
+  for (size_t t=0; t<_num_threads; t++)
+    _announce[t].value = NULL;
+}
+
 #endif
@@ -31,6 +31,10 @@ Solver::Solver(TrackGenerator* track_generator) {
   _fixed_sources = NULL;
   _reduced_sources = NULL;
 
+  _dirty_components = ALL_COMPONENTS;
+  _num_fill_changes = -1;
+  _warm_start = false;
+
   if (track_generator != NULL)
     setTrackGenerator(track_generator);
 
@@ -42,6 +46,9 @@ Solver::Solver(TrackGenerator* track_generator) {
 
   _num_iterations = 0;
   setConvergenceThreshold(1E-5);
+  _anderson_depth = 0;
+  _iteration_callback = NULL;
+  _iteration_callback_data = NULL;
   _user_fluxes = false;
 
   _timer = new Timer();
@@ -181,11 +188,21 @@ double Solver::getTotalTime() {
 }
 
 
+/**
+ * @brief Returns the number of previous iterates used by Anderson
+ *        acceleration of the source iteration.
+ * @return the Anderson acceleration depth (0 if not used)
+ */
+int Solver::getAndersonDepth() {
+  return _anderson_depth;
+}
+
+
 /**
  * @brief Returns the converged eigenvalue \f$ k_{eff} \f$.
  * @return the converged eigenvalue \f$ k_{eff} \f$
  */
-FP_PRECISION Solver::getKeff() {
+ACC_PRECISION Solver::getKeff() {
   return _k_eff;
 }
 
@@ -221,6 +238,22 @@ bool Solver::isUsingDoublePrecision() {
 }
 
 
+/**
+ * @brief Returns whether the solver is using mixed floating point precision.
+ * @details Mixed precision solvers store Track angular fluxes and segments
+ *          in single precision while accumulating the FSR scalar fluxes,
+ *          \f$ k_{eff} \f$ and residuals in double precision.
+ * @return true if using mixed precision float point arithmetic
+ */
+bool Solver::isUsingMixedPrecision() {
+#ifdef MIXED
+  return true;
+#else
+  return false;
+#endif
+}
+
+
 /**
  * @brief Returns whether the Solver uses linear interpolation to
  *        compute exponentials.
@@ -231,6 +264,43 @@ bool Solver::isUsingExponentialInterpolation() {
 }
 
 
+/**
+ * @brief Returns the order of the polynomials used to interpolate
+ *        exponentials.
+ * @return the interpolation order (1 - linear, 2 - quadratic or 3 - cubic)
+ */
+int Solver::getExpInterpolationOrder() {
+  return _exp_evaluator->getInterpolationOrder();
+}
+
+
+/**
+ * @brief Returns whether each calculation starts from the previous solution.
+ * @return true if warm starting from the previous solution
+ */
+bool Solver::isUsingWarmStart() {
+  return _warm_start;
+}
+
+
+/**
+ * @brief Returns the function called after each source iteration.
+ * @return the iteration callback (NULL if none has been set)
+ */
+iterationCallback Solver::getIterationCallback() {
+  return _iteration_callback;
+}
+
+
+/**
+ * @brief Returns the user data passed to the iteration callback.
+ * @return the iteration callback data (NULL if none has been set)
+ */
+void* Solver::getIterationCallbackData() {
+  return _iteration_callback_data;
+}
+
+
 /**
  * @brief Returns the source for some energy group for a flat source region
  * @details This is a helper routine used by the openmoc.process module.
@@ -324,6 +394,148 @@ FP_PRECISION Solver::getFlux(int fsr_id, int group) {
 }
 
 
+/**
+ * @brief Fills an array with the total source in each FSR and energy group.
+ * @details This is a bulk version of getFSRSource(...) which computes the
+ *          sources for all FSRs at once. This method may be called from
+ *          Python as follows:
+ *
+ * @code
+ *          num_sources = num_groups * num_FSRs
+ *          sources = solver.getFSRSources(num_sources)
+ * @endcode
+ *
+ * @param out_sources an array of FSR sources in each energy group
+ * @param num_sources the total number of FSR source values
+ */
+void Solver::getFSRSources(FP_PRECISION* out_sources, int num_sources) {
+
+  if (num_sources != _num_groups * _num_FSRs)
+    log_printf(ERROR, "Unable to get FSR sources since there are "
+               "%d groups and %d FSRs which does not match the requested "
+               "%d source values", _num_groups, _num_FSRs, num_sources);
+
+  else if (_scalar_flux == NULL)
+    log_printf(ERROR, "Unable to return the FSR sources "
+               "since they have not yet been computed");
+
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+
+    Material* material = _FSR_materials[r];
+    FP_PRECISION* sigma_s = material->getSigmaS();
+    FP_PRECISION* fiss_mat = material->getFissionMatrix();
+
+    for (int G=0; G < _num_groups; G++) {
+
+      FP_PRECISION fission_source = 0.0;
+      FP_PRECISION scatter_source = 0.0;
+
+      for (int g=0; g < _num_groups; g++) {
+        scatter_source += sigma_s[G*_num_groups+g] * _scalar_flux(r,g);
+        fission_source += fiss_mat[G*_num_groups+g] * _scalar_flux(r,g);
+      }
+
+      out_sources[r*_num_groups+G] = (fission_source / _k_eff +
+                                      scatter_source + _fixed_sources(r,G)) *
+                                     ONE_OVER_FOUR_PI;
+    }
+  }
+}
+
+
+/**
+ * @brief Fills an array with the volume of each FSR.
+ * @details This method may be called from Python as follows:
+ *
+ * @code
+ *          volumes = solver.getFSRVolumes(num_FSRs)
+ * @endcode
+ *
+ * @param out_volumes an array of FSR volumes
+ * @param num_volumes the number of FSRs
+ */
+void Solver::getFSRVolumes(FP_PRECISION* out_volumes, int num_volumes) {
+
+  if (num_volumes != _num_FSRs)
+    log_printf(ERROR, "Unable to get %d FSR volumes since there are %d "
+               "FSRs", num_volumes, _num_FSRs);
+
+  else if (_FSR_volumes == NULL)
+    log_printf(ERROR, "Unable to get the FSR volumes since they "
+               "have not yet been computed");
+
+  memcpy(out_volumes, _FSR_volumes, _num_FSRs * sizeof(FP_PRECISION));
+}
+
+
+/**
+ * @brief Returns a pointer to the Solver's FSR scalar flux array.
+ * @details This method exposes the scalar fluxes to Python as a read-only
+ *          NumPy array which shares its memory with the Solver, rather than
+ *          copying the fluxes as getFluxes(...) does. The NumPy array holds
+ *          a reference to the Solver such that the fluxes are not freed
+ *          while the array exists. The array must be retrieved again after
+ *          the flux arrays are reallocated by a new calculation.
+ *
+ * @code
+ *          fluxes = solver.getFluxesView()
+ *          fluxes = fluxes.reshape((num_FSRs, num_groups))
+ * @endcode
+ *
+ * @param view_values a pointer to the FSR scalar flux array
+ * @param num_values the number of FSR scalar flux values
+ */
+void Solver::getFluxesView(ACC_PRECISION** view_values, int* num_values) {
+
+  if (_scalar_flux == NULL)
+    log_printf(ERROR, "Unable to return a view of the FSR scalar fluxes "
+               "since they have not yet been allocated");
+
+  *view_values = _scalar_flux;
+  *num_values = _num_FSRs * _num_groups;
+}
+
+
+/**
+ * @brief Returns a pointer to the Solver's FSR reduced source array.
+ * @details The reduced sources are the total source divided by the total
+ *          cross-section and \f$ 4\pi \f$ in each FSR and energy group.
+ *          They are exposed to Python as a read-only NumPy array in the same
+ *          way as getFluxesView(...).
+ * @param view_values a pointer to the FSR reduced source array
+ * @param num_values the number of FSR reduced source values
+ */
+void Solver::getReducedSourcesView(FP_PRECISION** view_values,
+                                   int* num_values) {
+
+  if (_reduced_sources == NULL)
+    log_printf(ERROR, "Unable to return a view of the FSR sources "
+               "since they have not yet been allocated");
+
+  *view_values = _reduced_sources;
+  *num_values = _num_FSRs * _num_groups;
+}
+
+
+/**
+ * @brief Returns a pointer to the Solver's FSR volume array.
+ * @details The volumes are exposed to Python as a read-only NumPy array in
+ *          the same way as getFluxesView(...).
+ * @param view_values a pointer to the FSR volume array
+ * @param num_values the number of FSRs
+ */
+void Solver::getFSRVolumesView(FP_PRECISION** view_values, int* num_values) {
+
+  if (_FSR_volumes == NULL)
+    log_printf(ERROR, "Unable to return a view of the FSR volumes "
+               "since they have not yet been computed");
+
+  *view_values = _FSR_volumes;
+  *num_values = _num_FSRs;
+}
+
+
 /**
  * @brief Sets the Geometry for the Solver.
  * @details This is a private setter method for the Solver and is not
@@ -337,6 +549,7 @@ void Solver::setGeometry(Geometry* geometry) {
                "Geometry has not yet initialized FSRs");
 
   _geometry = geometry;
+  _dirty_components = ALL_COMPONENTS;
 }
 
 
@@ -394,6 +607,7 @@ void Solver::setPolarQuadrature(PolarQuad* polar_quad) {
   _polar_quad = polar_quad;
   _num_polar = _polar_quad->getNumPolarAngles();
   _polar_times_groups = _num_groups * _num_polar;
+  _dirty_components |= QUADRATURE_COMPONENT | EXP_COMPONENT | FLUX_COMPONENT;
 }
 
 
@@ -412,6 +626,90 @@ void Solver::setConvergenceThreshold(FP_PRECISION threshold) {
 }
 
 
+/**
+ * @brief Sets the number of previous iterates used by Anderson acceleration
+ *        of the source iteration.
+ * @details Anderson acceleration extrapolates the scalar flux from the
+ *          previous source iterations to reduce the number of transport
+ *          sweeps needed to converge computeFlux(...), computeSource(...)
+ *          and, when CMFD is not used, computeEigenvalue(...). A depth of 0
+ *          (the default) disables the acceleration, while depths of 3 to 5
+ *          are typically adequate.
+ *          This may be called from Python as follows:
+ *
+ * @code
+ *          solver.setAndersonDepth(5)
+ *          solver.computeEigenvalue()
+ * @endcode
+ *
+ * @param depth the number of previous iterates (0 to disable)
+ */
+void Solver::setAndersonDepth(int depth) {
+
+  if (depth < 0)
+    log_printf(ERROR, "Unable to set the Anderson acceleration depth to %d "
+               "since it is negative", depth);
+
+  _anderson_depth = depth;
+}
+
+
+/**
+ * @brief Sets whether each calculation starts from the previous solution.
+ * @details By default, computeFlux(...), computeSource(...) and
+ *          computeEigenvalue(...) start from flat scalar fluxes, zero
+ *          boundary angular fluxes and an eigenvalue of one. With a warm
+ *          start, they instead start from the fluxes and eigenvalue of the
+ *          previous calculation, which reduces the number of iterations of
+ *          parameter studies in which each calculation only slightly
+ *          perturbs the previous one. The previous solution is discarded
+ *          if the flux arrays must be reallocated, for instance when the
+ *          TrackGenerator or the polar quadrature are changed.
+ *
+ * @code
+ *          solver.setWarmStart(True)
+ *          for boron in concentrations:
+ *            update_cross_sections(boron)
+ *            solver.computeEigenvalue()
+ * @endcode
+ *
+ * @param warm_start whether to start from the previous solution
+ */
+void Solver::setWarmStart(bool warm_start) {
+  _warm_start = warm_start;
+}
+
+
+/**
+ * @brief Sets a function to be called after each source iteration.
+ * @details The callback is given the iteration number, the eigenvalue, the
+ *          residual and the time elapsed since the start of the solve, and
+ *          may be used to monitor computeFlux(...), computeSource(...) and
+ *          computeEigenvalue(...) while they run. From Python, any callable
+ *          may be used as the callback, and a NULL callback (None) removes
+ *          it. Since the Python interface releases the GIL during the solve,
+ *          the callable may for instance forward the progress to another
+ *          Python thread:
+ *
+ * @code
+ *          def progress(iteration, k_eff, residual, time):
+ *            print('{0} {1:.6f} {2:.3E} {3:.1f}s'.format(
+ *              iteration, k_eff, residual, time))
+ *
+ *          solver.setIterationCallback(progress)
+ *          solver.computeEigenvalue()
+ * @endcode
+ *
+ * @param callback the function to call after each iteration (or NULL)
+ * @param callback_data user data passed through to the callback
+ */
+void Solver::setIterationCallback(iterationCallback callback,
+                                  void* callback_data) {
+  _iteration_callback = callback;
+  _iteration_callback_data = callback_data;
+}
+
+
 /**
  * @brief Assign a fixed source for a flat source region and energy group.
  * @param fsr_id the flat source region ID
@@ -420,6 +718,7 @@ void Solver::setConvergenceThreshold(FP_PRECISION threshold) {
  */
 void Solver::setFixedSourceByFSR(int fsr_id, int group, FP_PRECISION source) {
   _fix_src_FSR_map[std::pair<int, int>(fsr_id, group)] = source;
+  _dirty_components |= SOURCE_COMPONENT;
 }
 
 
@@ -440,6 +739,8 @@ void Solver::setFixedSourceByCell(Cell* cell, int group, FP_PRECISION source) {
   }
   else
     _fix_src_cell_map[std::pair<Cell*, int>(cell, group)] = source;
+
+  _dirty_components |= SOURCE_COMPONENT;
 }
 
 
@@ -452,6 +753,7 @@ void Solver::setFixedSourceByCell(Cell* cell, int group, FP_PRECISION source) {
 void Solver::setFixedSourceByMaterial(Material* material, int group,
                                       FP_PRECISION source) {
   _fix_src_material_map[std::pair<Material*, int>(material, group)] = source;
+  _dirty_components |= SOURCE_COMPONENT;
 }
 
 
@@ -461,6 +763,7 @@ void Solver::setFixedSourceByMaterial(Material* material, int group,
  */
 void Solver::setMaxOpticalLength(FP_PRECISION max_optical_length) {
   _exp_evaluator->setMaxOpticalLength(max_optical_length);
+  _dirty_components |= EXP_COMPONENT;
 }
 
 
@@ -473,6 +776,29 @@ void Solver::setMaxOpticalLength(FP_PRECISION max_optical_length) {
  */
 void Solver::setExpPrecision(FP_PRECISION precision) {
   _exp_evaluator->setExpPrecision(precision);
+  _dirty_components |= EXP_COMPONENT;
+}
+
+
+/**
+ * @brief Sets the order of the polynomials used to interpolate the
+ *        exponential in the transport equation.
+ * @details Quadratic and cubic interpolation tables meet the exponential
+ *          precision with far fewer entries than the default linear
+ *          table, which keeps the table in the L1 cache for many polar
+ *          angles or a tight precision. This may be set from Python as
+ *          follows:
+ *
+ * @code
+ *          solver.setExpInterpolationOrder(3)
+ * @endcode
+ *
+ * @param order the interpolation order (1 - linear, 2 - quadratic or
+ *        3 - cubic)
+ */
+void Solver::setExpInterpolationOrder(int order) {
+  _exp_evaluator->setInterpolationOrder(order);
+  _dirty_components |= EXP_COMPONENT;
 }
 
 
@@ -482,6 +808,7 @@ void Solver::setExpPrecision(FP_PRECISION precision) {
  */
 void Solver::useExponentialInterpolation() {
   _exp_evaluator->useInterpolation();
+  _dirty_components |= EXP_COMPONENT;
 }
 
 
@@ -491,6 +818,7 @@ void Solver::useExponentialInterpolation() {
  */
 void Solver::useExponentialIntrinsic() {
   _exp_evaluator->useIntrinsic();
+  _dirty_components |= EXP_COMPONENT;
 }
 
 
@@ -592,21 +920,22 @@ void Solver::initializeFSRs() {
   _polar_times_groups = _num_groups * _num_polar;
   _num_materials = _geometry->getNumMaterials();
 
+  /* Find the Material in each FSR, which is also that of its segments */
+  _track_generator->initializeSegments();
+  Material** FSR_materials = _track_generator->getFSRMaterials();
+
   /* Get an array of volumes indexed by FSR  */
   _FSR_volumes = _track_generator->getFSRVolumes();
 
   /* Generate the FSR centroids */
   _track_generator->generateFSRCentroids();
 
-  /* Attach the correct materials to each track segment */
-  _track_generator->initializeSegments();
-
   /* Allocate an array of Material pointers indexed by FSR */
   _FSR_materials = new Material*[_num_FSRs];
 
   /* Loop over all FSRs to extract FSR material pointers */
   for (int r=0; r < _num_FSRs; r++) {
-    _FSR_materials[r] = _geometry->findFSRMaterial(r);
+    _FSR_materials[r] = FSR_materials[r];
     log_printf(INFO, "FSR ID = %d has Material ID = %d and volume = %f ",
                r, _FSR_materials[r]->getId(), _FSR_volumes[r]);
   }
@@ -711,9 +1040,11 @@ void Solver::initializeCmfd() {
   _cmfd->setFSRVolumes(_FSR_volumes);
   _cmfd->setFSRMaterials(_FSR_materials);
   _cmfd->setFSRFluxes(_scalar_flux);
+  _cmfd->setFSRFluxMoments(NULL);
   _cmfd->setPolarQuadrature(_polar_quad);
   _cmfd->setGeometry(_geometry);
   _cmfd->initialize();
+  _cmfd->initializeTrackCells(_track_generator);
 }
 
 
@@ -829,32 +1160,27 @@ void Solver::computeFlux(int max_iters, solverMode mode,
 
   /* Start the timer to record the total time to converge the flux */
   _timer->startTimer();
+  double start_time = omp_get_wtime();
 
   /* Initialize keff to 1 for FSR source calculations */
-  _k_eff = 1.;
+  setKeff(1.);
 
+  /* Use the fluxes of a previous calculation unless the user requested the
+   * use of only fixed sources, or no previous calculation was performed */
+  bool previous_fluxes = (!only_fixed_source || _warm_start) &&
+                         _num_iterations > 0;
   _num_iterations = 0;
-  FP_PRECISION residual = 0.;
+  double residual = 0.;
 
   /* Initialize data structures */
-  initializeFSRs();
-  initializeMaterials(mode);
-  countFissionableFSRs();
-  initializePolarQuadrature();
-  initializeExpEvaluator();
+  previous_fluxes &= initializeSolver(mode);
 
-  /* Initialize new flux arrays if a) the user requested the use of
-   * only fixed sources or b) no previous simulation was performed which
-   * initialized and computed the flux (e.g., an eigenvalue calculation) */
-  if (only_fixed_source || _num_iterations == 0) {
-    initializeFluxArrays();
+  if (!previous_fluxes) {
     flattenFSRFluxes(0.0);
     storeFSRFluxes();
+    zeroTrackFluxes();
   }
 
-  initializeSourceArrays();
-  zeroTrackFluxes();
-
   /* Compute the sum of fixed, total and scattering sources */
   computeFSRSources();
 
@@ -864,10 +1190,15 @@ void Solver::computeFlux(int max_iters, solverMode mode,
     transportSweep();
     addSourceToScalarFlux();
     residual = computeResidual(SCALAR_FLUX);
+
+    if (_anderson_depth > 0)
+      mixFluxes(_k_eff);
+
     storeFSRFluxes();
     _num_iterations++;
 
     log_printf(NORMAL, "Iteration %d:\tres = %1.3E", i, residual);
+    reportIteration(i, residual, start_time);
 
     /* Check for convergence */
     if (i > 1 && residual < _converge_thresh)
@@ -939,25 +1270,24 @@ void Solver::computeSource(int max_iters, solverMode mode,
 
   /* Start the timer to record the total time to converge the flux */
   _timer->startTimer();
+  double start_time = omp_get_wtime();
 
   /* Set the eigenvalue to the user-specified value */
-  _k_eff = k_eff;
+  setKeff(k_eff);
 
+  bool warm_start = _warm_start && _num_iterations > 0;
   _num_iterations = 0;
-  FP_PRECISION residual = 0.;
+  double residual = 0.;
 
   /* Initialize data structures */
-  initializeFSRs();
-  initializeMaterials(mode);
-  initializePolarQuadrature();
-  initializeExpEvaluator();
-  initializeFluxArrays();
-  initializeSourceArrays();
+  warm_start &= initializeSolver(mode);
 
   /* Guess unity scalar flux for each region */
-  flattenFSRFluxes(1.0);
-  storeFSRFluxes();
-  zeroTrackFluxes();
+  if (!warm_start) {
+    flattenFSRFluxes(1.0);
+    storeFSRFluxes();
+    zeroTrackFluxes();
+  }
 
   /* Source iteration loop */
   for (int i=0; i < max_iters; i++) {
@@ -966,10 +1296,15 @@ void Solver::computeSource(int max_iters, solverMode mode,
     transportSweep();
     addSourceToScalarFlux();
     residual = computeResidual(res_type);
+
+    if (_anderson_depth > 0)
+      mixFluxes(_k_eff);
+
     storeFSRFluxes();
     _num_iterations++;
 
     log_printf(NORMAL, "Iteration %d:\tres = %1.3E", i, residual);
+    reportIteration(i, residual, start_time);
 
     /* Check for convergence */
     if (i > 1 && residual < _converge_thresh)
@@ -1024,27 +1359,26 @@ void Solver::computeEigenvalue(int max_iters, solverMode mode,
 
   /* Start the timer to record the total time to converge the source */
   _timer->startTimer();
+  double start_time = omp_get_wtime();
 
+  bool warm_start = _warm_start && _num_iterations > 0;
   _num_iterations = 0;
-  FP_PRECISION residual = 0.;
-
-  /* An initial guess for the eigenvalue */
-  _k_eff = 1.0;
+  double residual = 0.;
 
   /* Initialize data structures */
-  initializeFSRs();
-  initializeMaterials(mode);
-  countFissionableFSRs();
-  initializePolarQuadrature();
-  initializeExpEvaluator();
-  initializeFluxArrays();
-  initializeSourceArrays();
+  warm_start &= initializeSolver(mode);
   initializeCmfd();
 
-  /* Set scalar flux to unity for each region */
-  flattenFSRFluxes(1.0);
-  storeFSRFluxes();
-  zeroTrackFluxes();
+  if (!warm_start) {
+
+    /* An initial guess for the eigenvalue */
+    setKeff(1.0);
+
+    /* Set scalar flux to unity for each region */
+    flattenFSRFluxes(1.0);
+    storeFSRFluxes();
+    zeroTrackFluxes();
+  }
 
   /* Source iteration loop */
   for (int i=0; i < max_iters; i++) {
@@ -1054,9 +1388,10 @@ void Solver::computeEigenvalue(int max_iters, solverMode mode,
     addSourceToScalarFlux();
 
     /* Solve CMFD diffusion problem and update MOC flux */
+    ACC_PRECISION old_k_eff = _k_eff;
     if (_cmfd != NULL && _cmfd->isFluxUpdateOn()) {
       _k_eff = _cmfd->computeKeff(i);
-      _cmfd->updateBoundaryFlux(_tracks, _boundary_flux, _tot_num_tracks);
+      updateCmfdBoundaryFlux();
     }
     else
       computeKeff();
@@ -1065,8 +1400,14 @@ void Solver::computeEigenvalue(int max_iters, solverMode mode,
                "\tres = %1.3E", i, _k_eff, residual);
 
     residual = computeResidual(res_type);
+
+    /* Accelerate the source iteration when not using CMFD */
+    if (_anderson_depth > 0 && (_cmfd == NULL || !_cmfd->isFluxUpdateOn()))
+      mixFluxes(old_k_eff);
+
     storeFSRFluxes();
     _num_iterations++;
+    reportIteration(i, residual, start_time);
 
     /* Check for convergence */
     if (i > 1 && residual < _converge_thresh)
@@ -1083,6 +1424,27 @@ void Solver::computeEigenvalue(int max_iters, solverMode mode,
 }
 
 
+/**
+ * @brief Updates the Track boundary angular fluxes with the ratios of the
+ *        new to old CMFD fluxes following a CMFD solve.
+ */
+void Solver::updateCmfdBoundaryFlux() {
+  _cmfd->updateBoundaryFlux(_boundary_flux, _tot_num_tracks);
+}
+
+
+/**
+ * @brief Applies Anderson acceleration to the scalar flux following a
+ *        transport sweep.
+ * @details Solvers which support Anderson acceleration must override this
+ *          method.
+ * @param old_k_eff the eigenvalue used in the source of the transport sweep
+ */
+void Solver::mixFluxes(ACC_PRECISION old_k_eff) {
+  log_printf(ERROR, "Anderson acceleration is not supported by this Solver");
+}
+
+
 /**
  * @brief Deletes the Timer's timing entries for each timed code section
  *        code in the source convergence loop.
@@ -1092,6 +1454,141 @@ void Solver::clearTimerSplits() {
 }
 
 
+/**
+ * @brief Reports the progress of a source iteration to the iteration
+ *        callback, if one has been set.
+ * @param iteration the iteration number
+ * @param residual the residual of the iteration
+ * @param start_time the wall clock time at the start of the solve (seconds)
+ */
+void Solver::reportIteration(int iteration, double residual,
+                             double start_time) {
+
+  if (_iteration_callback != NULL)
+    _iteration_callback(iteration, _k_eff, residual,
+                        omp_get_wtime() - start_time,
+                        _iteration_callback_data);
+}
+
+
+/**
+ * @brief Sets the eigenvalue used to scale the fission source.
+ * @param k_eff the eigenvalue
+ */
+void Solver::setKeff(ACC_PRECISION k_eff) {
+  _k_eff = k_eff;
+}
+
+
+/**
+ * @brief Records the largest total cross-section of a Material and flags
+ *        the exponential evaluator to be rebuilt if it has grown.
+ * @param material the Material of interest
+ */
+void Solver::checkMaxSigmaT(Material* material) {
+
+  FP_PRECISION* sigma_t = material->getSigmaT();
+  FP_PRECISION max_sigma_t = 0.;
+
+  for (int e=0; e < material->getNumEnergyGroups(); e++)
+    max_sigma_t = std::max(max_sigma_t, sigma_t[e]);
+
+  std::map<Material*, FP_PRECISION>::iterator iter;
+  iter = _max_sigma_t.find(material);
+
+  if (iter == _max_sigma_t.end() || max_sigma_t > iter->second)
+    _dirty_components |= EXP_COMPONENT;
+
+  _max_sigma_t[material] = max_sigma_t;
+}
+
+
+/**
+ * @brief Flags the exponential evaluator to be rebuilt if the optical
+ *        lengths of the Track segments may have grown since it was built.
+ * @details The exponential interpolation table and the segment splitting
+ *          depend on the largest optical length of the segments, which
+ *          only changes with the total cross-sections of the Materials.
+ */
+void Solver::checkCrossSections() {
+
+  std::map<int, Material*> materials = _geometry->getAllMaterials();
+  std::map<int, Material*>::iterator m_iter;
+
+  for (m_iter = materials.begin(); m_iter != materials.end(); ++m_iter)
+    checkMaxSigmaT(m_iter->second);
+}
+
+
+/**
+ * @brief Initializes the data structures for a calculation.
+ * @details Only the components which have changed since the previous
+ *          calculation are rebuilt. Setting the TrackGenerator rebuilds all
+ *          components, while the FSRs are rebuilt when the Geometry fills
+ *          an FSR with another Material and the exponential evaluator when
+ *          a total cross-section grows. The cached FSR Materials are only
+ *          compared with those of the Geometry once a Cell fill has been
+ *          set since the previous calculation. The Materials are initialized for
+ *          every calculation such that cross-section updates are used.
+ * @param mode the solution type (FORWARD or ADJOINT)
+ * @return whether the flux arrays of the previous calculation were kept
+ */
+bool Solver::initializeSolver(solverMode mode) {
+
+  int num_FSRs = _num_FSRs;
+  int num_groups = _num_groups;
+
+  /* Rebuild the FSRs if the Geometry's FSRs or Materials have changed */
+  if (_FSR_materials == NULL || _geometry->getNumFSRs() != _num_FSRs ||
+      _geometry->getNumEnergyGroups() != _num_groups)
+    _dirty_components |= FSR_COMPONENT;
+
+  else if (!(_dirty_components & FSR_COMPONENT) &&
+           Cell::getNumFillChanges() != _num_fill_changes) {
+    for (int r=0; r < _num_FSRs; r++) {
+      if (_geometry->findFSRMaterial(r) != _FSR_materials[r]) {
+        _dirty_components |= FSR_COMPONENT;
+        break;
+      }
+    }
+  }
+
+  _num_fill_changes = Cell::getNumFillChanges();
+
+  if (_dirty_components & FSR_COMPONENT) {
+    initializeFSRs();
+    _dirty_components |= EXP_COMPONENT | SOURCE_COMPONENT;
+
+    if (_num_FSRs != num_FSRs || _num_groups != num_groups)
+      _dirty_components |= QUADRATURE_COMPONENT | FLUX_COMPONENT;
+  }
+
+  initializeMaterials(mode);
+  countFissionableFSRs();
+  checkCrossSections();
+
+  if (_dirty_components & QUADRATURE_COMPONENT) {
+    initializePolarQuadrature();
+    _dirty_components |= EXP_COMPONENT;
+  }
+
+  if (_dirty_components & EXP_COMPONENT)
+    initializeExpEvaluator();
+
+  bool kept_fluxes = !(_dirty_components & FLUX_COMPONENT);
+
+  if (_dirty_components & FLUX_COMPONENT)
+    initializeFluxArrays();
+
+  if (_dirty_components & SOURCE_COMPONENT)
+    initializeSourceArrays();
+
+  _dirty_components = 0;
+
+  return kept_fluxes;
+}
+
+
 /**
  * @brief Prints a report of the timing statistics to the console.
  */
@@ -86,6 +86,43 @@ enum residualType {
 };
 
 
+/**
+ * @enum solverComponent
+ * @brief The data structures of the Solver which are only rebuilt between
+ *        calculations when they have changed.
+ */
+enum solverComponent {
+
+  /** The FSR volumes, centroids and Materials */
+  FSR_COMPONENT = 1,
+
+  /** The polar quadrature and the polar weights */
+  QUADRATURE_COMPONENT = 2,
+
+  /** The exponential evaluator and the segment splitting */
+  EXP_COMPONENT = 4,
+
+  /** The scalar and boundary angular flux arrays */
+  FLUX_COMPONENT = 8,
+
+  /** The source arrays and the fixed sources */
+  SOURCE_COMPONENT = 16,
+
+  /** All of the components */
+  ALL_COMPONENTS = 31
+};
+
+
+/**
+ * @brief A function called by the Solver after each source iteration.
+ * @details The arguments are the iteration number, the eigenvalue, the
+ *          residual, the time elapsed since the start of the solve (seconds)
+ *          and the user data given to Solver::setIterationCallback(...).
+ */
+typedef void (*iterationCallback)(int iteration, double k_eff,
+                                  double residual, double time, void* data);
+
+
 /**
  * @class Solver Solver.h "src/Solver.h"
  * @brief This is an abstract base class which different Solver subclasses
@@ -93,6 +130,9 @@ enum residualType {
  */
 class Solver {
 
+  /** The KrylovSolver applies transport sweeps to its own flux vectors */
+  friend class KrylovSolver;
+
 protected:
 
   /** The number of azimuthal angles */
@@ -149,10 +189,10 @@ protected:
   FP_PRECISION* _boundary_flux;
 
   /** The scalar flux for each energy group in each FSR */
-  FP_PRECISION* _scalar_flux;
+  ACC_PRECISION* _scalar_flux;
 
   /** The old scalar flux for each energy group in each FSR */
-  FP_PRECISION* _old_scalar_flux;
+  ACC_PRECISION* _old_scalar_flux;
 
   /** Optional user-specified fixed sources in each FSR and energy group */
   FP_PRECISION* _fixed_sources;
@@ -170,7 +210,7 @@ protected:
   FP_PRECISION* _reduced_sources;
 
   /** The current iteration's approximation to k-effective */
-  FP_PRECISION _k_eff;
+  ACC_PRECISION _k_eff;
 
   /** The number of source iterations needed to reach convergence */
   int _num_iterations;
@@ -178,6 +218,29 @@ protected:
   /** The tolerance for converging the source/flux */
   FP_PRECISION _converge_thresh;
 
+  /** The number of previous iterates used by Anderson acceleration of the
+   *  source iteration (0 if Anderson acceleration is not used) */
+  int _anderson_depth;
+
+  /** An optional function called after each source iteration */
+  iterationCallback _iteration_callback;
+
+  /** The user data passed to the iteration callback */
+  void* _iteration_callback_data;
+
+  /** The components (solverComponent) to rebuild for the next calculation */
+  int _dirty_components;
+
+  /** The number of Cell fill changes when the FSR Materials were checked */
+  int _num_fill_changes;
+
+  /** Whether to start each calculation from the previous solution */
+  bool _warm_start;
+
+  /** The largest total cross-section of each Material used to build the
+   *  exponential evaluator */
+  std::map<Material*, FP_PRECISION> _max_sigma_t;
+
   /** An ExpEvaluator to compute exponentials in the transport equation */
   ExpEvaluator* _exp_evaluator;
 
@@ -195,6 +258,11 @@ protected:
   int _num_parallel_track_groups;
 
   void clearTimerSplits();
+  void reportIteration(int iteration, double residual, double start_time);
+  virtual void setKeff(ACC_PRECISION k_eff);
+  void checkMaxSigmaT(Material* material);
+  virtual void checkCrossSections();
+  virtual bool initializeSolver(solverMode mode);
 
 public:
   Solver(TrackGenerator* track_generator=NULL);
@@ -209,19 +277,34 @@ public:
   int getNumPolarAngles();
   int getNumIterations();
   double getTotalTime();
-  FP_PRECISION getKeff();
+  ACC_PRECISION getKeff();
   FP_PRECISION getConvergenceThreshold();
+  int getAndersonDepth();
   FP_PRECISION getMaxOpticalLength();
   bool isUsingDoublePrecision();
+  bool isUsingMixedPrecision();
   bool isUsingExponentialInterpolation();
+  int getExpInterpolationOrder();
+  bool isUsingWarmStart();
+  iterationCallback getIterationCallback();
+  void* getIterationCallbackData();
 
   virtual FP_PRECISION getFSRSource(int fsr_id, int group);
   virtual FP_PRECISION getFlux(int fsr_id, int group);
   virtual void getFluxes(FP_PRECISION* out_fluxes, int num_fluxes) = 0;
+  virtual void getFSRSources(FP_PRECISION* out_sources, int num_sources);
+  virtual void getFSRVolumes(FP_PRECISION* out_volumes, int num_volumes);
+  virtual void getFluxesView(ACC_PRECISION** view_values, int* num_values);
+  virtual void getReducedSourcesView(FP_PRECISION** view_values,
+                                     int* num_values);
+  virtual void getFSRVolumesView(FP_PRECISION** view_values, int* num_values);
 
   virtual void setTrackGenerator(TrackGenerator* track_generator);
   virtual void setPolarQuadrature(PolarQuad* polar_quad);
   virtual void setConvergenceThreshold(FP_PRECISION threshold);
+  void setAndersonDepth(int depth);
+  void setWarmStart(bool warm_start);
+  void setIterationCallback(iterationCallback callback, void* callback_data);
   virtual void setFluxes(FP_PRECISION* in_fluxes, int num_fluxes) = 0;
   void setFixedSourceByFSR(int fsr_id, int group, FP_PRECISION source);
   void setFixedSourceByCell(Cell* cell, int group, FP_PRECISION source);
@@ -229,6 +312,7 @@ public:
                                 FP_PRECISION source);
   void setMaxOpticalLength(FP_PRECISION max_optical_length);
   void setExpPrecision(FP_PRECISION precision);
+  void setExpInterpolationOrder(int order);
   void useExponentialInterpolation();
   void useExponentialIntrinsic();
 
@@ -317,6 +401,9 @@ public:
    */
   virtual void transportSweep() = 0;
 
+  virtual void updateCmfdBoundaryFlux();
+  virtual void mixFluxes(ACC_PRECISION old_k_eff);
+
   void computeFlux(int max_iters=1000, solverMode mode=FORWARD,
                    bool only_fixed_source=true);
   void computeSource(int max_iters=1000, solverMode mode=FORWARD,
@@ -230,16 +230,14 @@ bool Surface::isCoordOnSurface(LocalCoords* coord) {
 
 /**
  * @brief Finds the minimum distance to a Surface.
- * @details Finds the miniumum distance to a Surface from a LocalCoords
- *          with a trajectory defined by an angle to this Surface. If the
+ * @details Finds the miniumum distance to a Surface from a Point with a
+ *          trajectory defined by an angle to this Surface. If the
  *          trajectory will not intersect the Surface, returns INFINITY.
- * @param coords a pointer to a localcoords object
+ * @param point a pointer to the Point of interest
+ * @param phi the angle defining the trajectory in radians
  * @return the minimum distance to the Surface
  */
-double Surface::getMinDistance(LocalCoords* coords) {
-
-  Point* point = coords->getPoint();
-  double phi = coords->getPhi();
+double Surface::getMinDistance(Point* point, double phi) {
 
   /* Point array for intersections with this Surface */
   Point intersections[2];
@@ -268,6 +266,73 @@ double Surface::getMinDistance(LocalCoords* coords) {
 }
 
 
+/**
+ * @brief Finds the minimum distance to a Surface.
+ * @details Finds the miniumum distance to a Surface from a LocalCoords
+ *          with a trajectory defined by an angle to this Surface. If the
+ *          trajectory will not intersect the Surface, returns INFINITY.
+ * @param coords a pointer to a localcoords object
+ * @return the minimum distance to the Surface
+ */
+double Surface::getMinDistance(LocalCoords* coords) {
+  return getMinDistance(coords->getPoint(), coords->getPhi());
+}
+
+
+/**
+ * @brief Fills a surface kernel with the type and coefficients of a Surface.
+ * @details The coefficients are copied such that
+ *          evaluateSurfaceKernel(...) reproduces Surface::evaluate(...)
+ *          exactly. Surface types without a specialized kernel keep a
+ *          pointer to the Surface and use its virtual methods.
+ * @param kernel a pointer to the surface kernel to fill
+ * @param surface a pointer to the Surface
+ * @param halfspace the halfspace of the Surface (+/-1)
+ */
+void fillSurfaceKernel(surface_kernel* kernel, Surface* surface,
+                       int halfspace) {
+
+  kernel->_type = surface->getSurfaceType();
+  kernel->_halfspace = halfspace;
+  kernel->_surface = surface;
+  kernel->_A = 0.;
+  kernel->_B = 0.;
+  kernel->_C = 0.;
+  kernel->_D = 0.;
+  kernel->_E = 0.;
+
+  switch (kernel->_type) {
+  case PLANE:
+  case XPLANE:
+  case YPLANE:
+  case ZPLANE:
+    {
+      Plane* plane = static_cast<Plane*>(surface);
+      kernel->_A = plane->getA();
+      kernel->_B = plane->getB();
+      kernel->_C = plane->getC();
+      kernel->_D = plane->getD();
+      break;
+    }
+  case ZCYLINDER:
+    {
+      ZCylinder* zcylinder = static_cast<ZCylinder*>(surface);
+      double x = zcylinder->getX0();
+      double y = zcylinder->getY0();
+      double radius = zcylinder->getRadius();
+      kernel->_A = 1.;
+      kernel->_B = 1.;
+      kernel->_C = -2.*x;
+      kernel->_D = -2.*y;
+      kernel->_E = x*x + y*y - radius*radius;
+      break;
+    }
+  default:
+    break;
+  }
+}
+
+
 /**
  * @brief Prints a string representation of all of the Surface's objects to
  *        the console.
@@ -829,145 +894,14 @@ double ZCylinder::getMaxZ(int halfspace) {
  */
 int ZCylinder::intersection(Point* point, double angle, Point* points) {
 
-  double x0 = point->getX();
-  double y0 = point->getY();
-  double z0 = point->getZ();
-  double xcurr, ycurr, zcurr;
-  int num = 0;                        /* Number of intersection Points */
-  double a, b, c, q, discr;
-
-  /* If the track is vertical in y */
-  if ((fabs(angle - M_PI_2)) < 1.0e-10) {
-
-    /* Solve for where the line x = x0 and the Surface F(x,y) intersect
-     * Find the y where F(x0, y) = 0
-     * Substitute x0 into F(x,y) and rearrange to put in
-     * the form of the quadratic formula: ay^2 + by + c = 0 
-     * This is simplified for a z-cylinder with a vertical axis */
-    a = 1.;
-    b = _D;
-    c = _A * x0 * x0 + _C * x0 + _E;
-
-    discr = b*b - 4*c;
-
-    /* There are no intersections */
-    if (discr < 0)
-      return 0;
-
-    /* There is one intersection (ie on the Surface) */
-    else if (discr == 0) {
-      xcurr = x0;
-      ycurr = -b / 2;
-      zcurr = z0;
-      points[num].setCoords(xcurr, ycurr, zcurr);
-
-      /* Check that point is in same direction as angle */
-      if (angle < M_PI && ycurr > y0)
-        num++;
-      else if (angle > M_PI && ycurr < y0)
-        num++;
-
-      return num;
-    }
-
-    /* There are two intersections */
-    else {
-      xcurr = x0;
-      ycurr = (-b + sqrt(discr)) / 2;
-      zcurr = z0;
-      points[num].setCoords(xcurr, ycurr, zcurr);
-      if (angle < M_PI && ycurr > y0)
-        num++;
-      else if (angle > M_PI && ycurr < y0)
-        num++;
-
-      xcurr = x0;
-      ycurr = (-b - sqrt(discr)) / 2;
-      zcurr = z0;
-      points[num].setCoords(xcurr, ycurr, zcurr);
-      if (angle < M_PI && ycurr > y0)
-        num++;
-      else if (angle > M_PI && ycurr < y0)
-        num++;
-
-      return num;
-    }
-  }
-
-  /* If the track isn't vertical */
-  else {
-    /* Solve for where the line y-y0 = m*(x-x0) and the Surface F(x,y)
-     * intersect. Find the (x,y) where F(x, y0 + m*(x-x0)) = 0
-     * Substitute the point-slope formula for y into F(x,y) and
-     * rearrange to put in the form of the quadratic formula:
-     * ax^2 + bx + c = 0
-     */
-    double m = tan(angle);
-    q = y0 - m * x0;
-    a = 1 + m * m;
-    b = 2 * m * q + _C + _D * m;
-    c = q * q + _D * q + _E;
-
-    discr = b*b - 4*a*c;
-
-    /* Boolean value describing whether the track is traveling to the right */
-    bool right = angle < M_PI / 2. || angle > 3. * M_PI / 2.;
-
-    /* There are no intersections */
-    if (discr < 0)
-      return 0;
-
-    /* There is one intersection (ie on the Surface) */
-    else if (discr == 0) {
-
-      /* Determine the point of intersection */
-      xcurr = -b / (2*a);
-      ycurr = y0 + m * (points[num].getX() - x0);
-      zcurr = z0;
-      points[num].setCoords(xcurr, ycurr, zcurr);
+  double xs[2], ys[2];
+  int num = zcylinderIntersection(_A, _C, _D, _E, point->getX(),
+                                  point->getY(), angle, xs, ys);
 
-      /* Increase the number of intersections if the intersection is in the
-       * direction of the track is heading */
-      if (right && xcurr > x0)
-        num++;
-      else if (!right && xcurr < x0)
-        num++;
+  for (int i=0; i < num; i++)
+    points[i].setCoords(xs[i], ys[i], point->getZ());
 
-      return num;
-    }
-
-    /* There are two intersections */
-    else {
-
-      /* Determine the point of intersection */
-      xcurr = (-b + sqrt(discr)) / (2*a);
-      ycurr = y0 + m * (xcurr - x0);
-      zcurr = z0;
-      points[num].setCoords(xcurr, ycurr, zcurr);
-
-      /* Increase the number of intersections if the intersection is in the
-       * direction of the track is heading */
-      if (right && xcurr > x0)
-        num++;
-      else if (!right && xcurr < x0)
-        num++;
-
-      /* Determine the point of intersection */
-      xcurr = (-b - sqrt(discr)) / (2*a);
-      ycurr = y0 + m * (xcurr - x0);
-      zcurr = z0;
-      points[num].setCoords(xcurr, ycurr, zcurr);
-
-      /* Increase the number of intersections if the intersection is in the
-       * direction of the track is heading */
-      if (right && xcurr > x0)
-        num++;
-      else if (!right && xcurr < x0)
-        num++;
-
-      return num;
-    }
-  }
+  return num;
 }
 
 
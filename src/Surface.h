@@ -170,6 +170,7 @@ public:
 
   bool isPointOnSurface(Point* point);
   bool isCoordOnSurface(LocalCoords* coord);
+  double getMinDistance(Point* point, double phi);
   double getMinDistance(LocalCoords* coords);
 
   /**
@@ -396,4 +397,254 @@ inline double ZCylinder::evaluate(const Point* point) const {
 }
 
 
+/**
+ * @struct surface_kernel
+ * @brief A flattened, type-tagged copy of a Surface's coefficients.
+ * @details Cells store a contiguous array of surface kernels for their
+ *          bounding Surfaces so that ray tracing can evaluate halfspaces and
+ *          compute intersection distances with a switch over the Surface
+ *          type rather than through virtual calls and temporary Points.
+ *          Planes use the coefficients of \f$ Ax + By + Cz + D = 0 \f$ while
+ *          ZCylinders use \f$ Ax^2 + By^2 + Cx + Dy + E = 0 \f$.
+ */
+struct surface_kernel {
+
+  /** The type of the Surface (ie, XPLANE, ZCYLINDER, etc) */
+  surfaceType _type;
+
+  /** The halfspace of the Surface bounding the Cell (+/-1) */
+  int _halfspace;
+
+  /** The coefficients of the Surface's potential equation */
+  double _A, _B, _C, _D, _E;
+
+  /** A pointer to the Surface for types without a specialized kernel */
+  Surface* _surface;
+};
+
+
+void fillSurfaceKernel(surface_kernel* kernel, Surface* surface,
+                       int halfspace);
+
+
+/**
+ * @brief Evaluate a Point using a surface kernel's potential equation.
+ * @details This returns the same value as Surface::evaluate(...) for
+ *          the Surface from which the kernel was filled.
+ * @param kernel a pointer to the surface kernel
+ * @param point a pointer to the Point of interest
+ * @return the value of the Point in the Surface's potential equation
+ */
+inline double evaluateSurfaceKernel(const surface_kernel* kernel,
+                                    const Point* point) {
+
+  double x = point->getX();
+  double y = point->getY();
+
+  switch (kernel->_type) {
+  case XPLANE:
+  case YPLANE:
+  case ZPLANE:
+  case PLANE:
+    return (kernel->_A * x + kernel->_B * y + kernel->_C * point->getZ() +
+            kernel->_D);
+  case ZCYLINDER:
+    return (kernel->_A * x * x + kernel->_B * y * y + kernel->_C * x +
+            kernel->_D * y + kernel->_E);
+  default:
+    return kernel->_surface->evaluate(point);
+  }
+}
+
+
+/**
+ * @brief Finds the intersection Points of a trajectory with a ZCylinder.
+ * @details The ZCylinder is given by the coefficients of its potential
+ *          equation \f$ Ax^2 + y^2 + Cx + Dy + E = 0 \f$. The quadratic for
+ *          the intersections of the line through (x0,y0) with the ZCylinder
+ *          is solved in y for vertical trajectories and in x otherwise, and
+ *          only intersections in the direction of the trajectory are
+ *          returned. This is used by both ZCylinder::intersection(...) and
+ *          surfaceKernelDistance(...) so that ray tracing with and without
+ *          surface kernels finds identical segment lengths.
+ * @param A the coefficient of \f$ x^2 \f$
+ * @param C the coefficient of \f$ x \f$
+ * @param D the coefficient of \f$ y \f$
+ * @param E the constant coefficient
+ * @param x0 the x-coordinate of the start of the trajectory
+ * @param y0 the y-coordinate of the start of the trajectory
+ * @param angle the azimuthal angle of the trajectory in radians
+ * @param xs an array of length 2 to store the intersection x-coordinates
+ * @param ys an array of length 2 to store the intersection y-coordinates
+ * @return the number of intersection Points (0, 1 or 2)
+ */
+inline int zcylinderIntersection(double A, double C, double D, double E,
+                                 double x0, double y0, double angle,
+                                 double* xs, double* ys) {
+
+  int num = 0;
+  double a, b, c, q, discr;
+
+  /* If the track is vertical in y */
+  if ((fabs(angle - M_PI_2)) < 1.0e-10) {
+
+    /* Solve for where the line x = x0 and the Surface F(x,y) intersect
+     * Find the y where F(x0, y) = 0
+     * Substitute x0 into F(x,y) and rearrange to put in
+     * the form of the quadratic formula: ay^2 + by + c = 0
+     * This is simplified for a z-cylinder with a vertical axis */
+    b = D;
+    c = A * x0 * x0 + C * x0 + E;
+
+    discr = b*b - 4*c;
+
+    /* There are no intersections */
+    if (discr < 0)
+      return 0;
+
+    double roots[2] = {-b / 2, -b / 2};
+    int num_roots = 1;
+
+    /* There are two intersections */
+    if (discr > 0) {
+      roots[0] = (-b + sqrt(discr)) / 2;
+      roots[1] = (-b - sqrt(discr)) / 2;
+      num_roots = 2;
+    }
+
+    /* Check that each point is in same direction as angle */
+    for (int i=0; i < num_roots; i++) {
+      if ((angle < M_PI && roots[i] > y0) || (angle > M_PI && roots[i] < y0)) {
+        xs[num] = x0;
+        ys[num] = roots[i];
+        num++;
+      }
+    }
+  }
+
+  /* If the track isn't vertical */
+  else {
+    /* Solve for where the line y-y0 = m*(x-x0) and the Surface F(x,y)
+     * intersect. Find the (x,y) where F(x, y0 + m*(x-x0)) = 0
+     * Substitute the point-slope formula for y into F(x,y) and
+     * rearrange to put in the form of the quadratic formula:
+     * ax^2 + bx + c = 0
+     */
+    double m = tan(angle);
+    q = y0 - m * x0;
+    a = 1 + m * m;
+    b = 2 * m * q + C + D * m;
+    c = q * q + D * q + E;
+
+    discr = b*b - 4*a*c;
+
+    /* Boolean value describing whether the track is traveling to the right */
+    bool right = angle < M_PI / 2. || angle > 3. * M_PI / 2.;
+
+    /* There are no intersections */
+    if (discr < 0)
+      return 0;
+
+    double roots[2] = {-b / (2*a), -b / (2*a)};
+    int num_roots = 1;
+
+    /* There are two intersections */
+    if (discr > 0) {
+      roots[0] = (-b + sqrt(discr)) / (2*a);
+      roots[1] = (-b - sqrt(discr)) / (2*a);
+      num_roots = 2;
+    }
+
+    /* Keep the intersections in the direction the track is heading */
+    for (int i=0; i < num_roots; i++) {
+      if ((right && roots[i] > x0) || (!right && roots[i] < x0)) {
+        xs[num] = roots[i];
+        ys[num] = y0 + m * (roots[i] - x0);
+        num++;
+      }
+    }
+  }
+
+  return num;
+}
+
+
+/**
+ * @brief Computes the distance along a trajectory to a surface kernel.
+ * @details The trajectory starts at the Point (x,y,z) and has the direction
+ *          cosines (cos_phi, sin_phi) in the xy-plane. Only intersections
+ *          in the forward direction are considered. If the trajectory does
+ *          not intersect the Surface, INFINITY is returned. Kernels of
+ *          Surface types without a specialized form fall back to
+ *          Surface::getMinDistance(...).
+ * @param kernel a pointer to the surface kernel
+ * @param point a pointer to the Point at the start of the trajectory
+ * @param phi the azimuthal angle of the trajectory in radians
+ * @param cos_phi the cosine of the azimuthal angle of the trajectory
+ * @param sin_phi the sine of the azimuthal angle of the trajectory
+ * @return the distance to the nearest forward intersection
+ */
+inline double surfaceKernelDistance(const surface_kernel* kernel,
+                                    Point* point, double phi,
+                                    double cos_phi, double sin_phi) {
+
+  double x = point->getX();
+  double y = point->getY();
+  double dist;
+
+  switch (kernel->_type) {
+
+  /* The trajectory is parallel to a plane perpendicular to the x-axis */
+  case XPLANE:
+    if (fabs(cos_phi) < 1.e-10)
+      return INFINITY;
+    dist = -(kernel->_A * x + kernel->_D) / (kernel->_A * cos_phi);
+    return (dist > 0.0) ? dist : INFINITY;
+
+  /* The trajectory is parallel to a plane perpendicular to the y-axis */
+  case YPLANE:
+    if (fabs(sin_phi) < 1.e-10)
+      return INFINITY;
+    dist = -(kernel->_B * y + kernel->_D) / (kernel->_B * sin_phi);
+    return (dist > 0.0) ? dist : INFINITY;
+
+  /* Trajectories in the xy-plane never cross a plane perpendicular to z */
+  case ZPLANE:
+    return INFINITY;
+
+  case PLANE:
+    if ((fabs(cos_phi) < 1.e-10 && fabs(kernel->_A) > 1.e-10) ||
+        (fabs(sin_phi) < 1.e-10 && fabs(kernel->_B) > 1.e-10))
+      return INFINITY;
+    dist = -(kernel->_A * x + kernel->_B * y +
+             kernel->_C * point->getZ() + kernel->_D) /
+      (kernel->_A * cos_phi + kernel->_B * sin_phi);
+    return (dist > 0.0) ? dist : INFINITY;
+
+  /* Use the same intersection Points as ZCylinder::intersection(...) */
+  case ZCYLINDER:
+    {
+      double xs[2], ys[2];
+      int num_inters = zcylinderIntersection(kernel->_A, kernel->_C,
+                                             kernel->_D, kernel->_E, x, y,
+                                             phi, xs, ys);
+      dist = INFINITY;
+
+      for (int i=0; i < num_inters; i++) {
+        double dx = xs[i] - x;
+        double dy = ys[i] - y;
+        double dist_i = sqrt(dx*dx + dy*dy);
+        if (dist_i < dist)
+          dist = dist_i;
+      }
+
+      return dist;
+    }
+
+  default:
+    return kernel->_surface->getMinDistance(point, phi);
+  }
+}
+
+
 #endif /* SURFACE_H_ */
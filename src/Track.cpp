@@ -13,6 +13,8 @@ Track::Track() {
   /* Initialize the reflective track index to -1, indicating it has not
    * been set */
   _reflective_track_index = -1;
+
+  _num_traced_segments = 0;
 }
 
 
@@ -105,10 +107,23 @@ void Track::setReflectiveTrackIndex(const int index) {
  * @details This method assumes that segments are added in order of their
  *          starting location from the Track's start point.
  * @param to_add a pointer to the segment to add
+ * @param cmfd_surface_fwd the CMFD mesh surface crossed by the segment end
+ *        point (-1 if none)
+ * @param cmfd_surface_bwd the CMFD mesh surface crossed by the segment start
+ *        point (-1 if none)
  */
-void Track::addSegment(segment* to_add) {
+void Track::addSegment(segment* to_add, int cmfd_surface_fwd,
+                       int cmfd_surface_bwd) {
   try {
     _segments.push_back(*to_add);
+
+    if (cmfd_surface_fwd != -1 || cmfd_surface_bwd != -1) {
+      cmfd_crossing crossing;
+      crossing._segment = _segments.size() - 1;
+      crossing._surface_fwd = cmfd_surface_fwd;
+      crossing._surface_bwd = cmfd_surface_bwd;
+      _cmfd_crossings.push_back(crossing);
+    }
   }
   catch (std::exception &e) {
     log_printf(ERROR, "Unable to add a segment to Track");
@@ -123,6 +138,16 @@ void Track::addSegment(segment* to_add) {
 void Track::removeSegment(int index) {
   try {
     _segments.erase(_segments.begin()+index);
+
+    /* Remove the segment's CMFD crossing and shift those which follow */
+    for (int c=_cmfd_crossings.size()-1; c >= 0; c--) {
+      if (_cmfd_crossings[c]._segment > index)
+        _cmfd_crossings[c]._segment--;
+      else if (_cmfd_crossings[c]._segment == index)
+        _cmfd_crossings.erase(_cmfd_crossings.begin()+c);
+      else
+        break;
+    }
   }
   catch (std::exception &e) {
     log_printf(ERROR, "Unable to remove a segment from Track");
@@ -133,14 +158,33 @@ void Track::removeSegment(int index) {
 /**
  * @brief Inserts a segment pointer into this Track's list of segments.
  * @details This method appends the new segment directly behind another
- *          segment in the Track. This is a helper method for the
- *          TrackGenerator::splitTracks(...) routine.
+ *          segment in the Track.
  * @param index the index of the segment to insert behind in the list
  * @param segment a pointer to the segment to insert
+ * @param cmfd_surface_fwd the CMFD mesh surface crossed by the segment end
+ *        point (-1 if none)
+ * @param cmfd_surface_bwd the CMFD mesh surface crossed by the segment start
+ *        point (-1 if none)
  */
-void Track::insertSegment(int index, segment* segment) {
+void Track::insertSegment(int index, segment* segment, int cmfd_surface_fwd,
+                          int cmfd_surface_bwd) {
   try {
     _segments.insert(_segments.begin()+index, *segment);
+
+    /* Shift the CMFD crossings which follow the new segment */
+    int c = _cmfd_crossings.size();
+    while (c > 0 && _cmfd_crossings[c-1]._segment >= index) {
+      _cmfd_crossings[c-1]._segment++;
+      c--;
+    }
+
+    if (cmfd_surface_fwd != -1 || cmfd_surface_bwd != -1) {
+      cmfd_crossing crossing;
+      crossing._segment = index;
+      crossing._surface_fwd = cmfd_surface_fwd;
+      crossing._surface_bwd = cmfd_surface_bwd;
+      _cmfd_crossings.insert(_cmfd_crossings.begin()+c, crossing);
+    }
   }
   catch (std::exception &e) {
     log_printf(ERROR, "Unable to insert a segment into Track");
@@ -353,11 +397,59 @@ int Track::getReflectiveTrackIndex() const {
 }
 
 
+/**
+ * @brief Returns the ID of the CMFD mesh surface crossed by the end point
+ *        of a segment along this Track.
+ * @param segment index into the Track's segments container
+ * @return the CMFD mesh surface ID, or -1 if no surface is crossed
+ */
+int Track::getCmfdSurfaceFwd(int segment) {
+
+  for (int c=0; c < (int)_cmfd_crossings.size(); c++) {
+    if (_cmfd_crossings[c]._segment == segment)
+      return _cmfd_crossings[c]._surface_fwd;
+  }
+
+  return -1;
+}
+
+
+/**
+ * @brief Returns the ID of the CMFD mesh surface crossed by the start point
+ *        of a segment along this Track.
+ * @param segment index into the Track's segments container
+ * @return the CMFD mesh surface ID, or -1 if no surface is crossed
+ */
+int Track::getCmfdSurfaceBwd(int segment) {
+
+  for (int c=0; c < (int)_cmfd_crossings.size(); c++) {
+    if (_cmfd_crossings[c]._segment == segment)
+      return _cmfd_crossings[c]._surface_bwd;
+  }
+
+  return -1;
+}
+
+
 /**
  * @brief Deletes each of this Track's segments.
  */
 void Track::clearSegments() {
   _segments.clear();
+  _cmfd_crossings.clear();
+}
+
+
+/**
+ * @brief Deletes each of this Track's segments and frees their memory,
+ *        keeping only the number of segments.
+ * @details This is used for on-the-fly ray tracing, where the segments are
+ *          traced again each time they are needed rather than stored.
+ */
+void Track::discardSegments() {
+  _num_traced_segments = _segments.size();
+  std::vector<segment>().swap(_segments);
+  std::vector<cmfd_crossing>().swap(_cmfd_crossings);
 }
 
 
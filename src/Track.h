@@ -23,29 +23,37 @@
  * @struct segment
  * @brief A segment represents a line segment within a single flat source
  *        region along a track.
+ * @details Segments only store the data needed by the transport sweep, which
+ *          streams through every segment in each iteration. The Material of
+ *          a segment is that of its flat source region and the CMFD mesh
+ *          surfaces crossed by the few segments ending on the mesh are
+ *          stored by each Track as cmfd_crossings.
  */
 struct segment {
 
   /** The length of the segment (cm) */
   FP_PRECISION _length;
 
-  /** A pointer to the material in which this segment resides */
-  Material* _material;
-
   /** The ID for flat source region in which this segment resides */
   int _region_id;
+};
+
+
+/**
+ * @struct cmfd_crossing
+ * @brief A cmfd_crossing represents the CMFD mesh surfaces crossed by the
+ *        start or end point of a segment along a track.
+ */
+struct cmfd_crossing {
 
-  /** The ID for the mesh surface crossed by the Track end point */
-  int _cmfd_surface_fwd;
+  /** The index of the segment along the Track */
+  int _segment;
 
-  /** The ID for the mesh surface crossed by the Track start point */
-  int _cmfd_surface_bwd;
+  /** The ID for the mesh surface crossed by the segment end point */
+  int _surface_fwd;
 
-  /** Constructor initializes CMFD surfaces */
-  segment() {
-    _cmfd_surface_fwd = -1;
-    _cmfd_surface_bwd = -1;
-  }
+  /** The ID for the mesh surface crossed by the segment start point */
+  int _surface_bwd;
 };
 
 
@@ -82,6 +90,14 @@ private:
   /** A dynamically sized vector of segments making up this Track */
   std::vector<segment> _segments;
 
+  /** The CMFD mesh surfaces crossed by the segments, in order of the
+   *  segments along the Track */
+  std::vector<cmfd_crossing> _cmfd_crossings;
+
+  /** The number of segments found by ray tracing if they have been
+   *  discarded for on-the-fly ray tracing */
+  int _num_traced_segments;
+
   /** The next Track when traveling along this Track in the "forward"
    * direction. */
   Track* _track_in;
@@ -134,6 +150,11 @@ public:
   segment* getSegment(int s);
   segment* getSegments();
   int getNumSegments();
+  cmfd_crossing* getCmfdCrossings();
+  int getNumCmfdCrossings();
+  int getNumTracedSegments();
+  int getCmfdSurfaceFwd(int segment);
+  int getCmfdSurfaceBwd(int segment);
   Track *getTrackIn() const;
   Track *getTrackOut() const;
   bool isNextIn() const;
@@ -143,10 +164,13 @@ public:
   bool getTransferFluxIn() const;
   bool getTransferFluxOut() const;
 
-  void addSegment(segment* to_add);
+  void addSegment(segment* to_add, int cmfd_surface_fwd=-1,
+                  int cmfd_surface_bwd=-1);
   void removeSegment(int index);
-  void insertSegment(int index, segment* segment);
+  void insertSegment(int index, segment* segment, int cmfd_surface_fwd=-1,
+                     int cmfd_surface_bwd=-1);
   void clearSegments();
+  void discardSegments();
   std::string toString();
 };
 
@@ -215,4 +239,36 @@ inline int Track::getNumSegments() {
 }
 
 
+/**
+ * @brief Returns a pointer to the CMFD mesh surface crossings of the Track's
+ *        segments, in order of the segments along the Track.
+ * @return a pointer to the first CMFD mesh surface crossing
+ */
+inline cmfd_crossing* Track::getCmfdCrossings() {
+  return _cmfd_crossings.data();
+}
+
+
+/**
+ * @brief Return the number of segments along this Track which cross a CMFD
+ *        mesh surface.
+ * @return the number of CMFD mesh surface crossings
+ */
+inline int Track::getNumCmfdCrossings() {
+  return _cmfd_crossings.size();
+}
+
+
+/**
+ * @brief Return the number of segments found by ray tracing along this Track,
+ *        whether or not they are stored.
+ * @return the number of traced segments
+ */
+inline int Track::getNumTracedSegments() {
+  if (_segments.empty())
+    return _num_traced_segments;
+  return _segments.size();
+}
+
+
 #endif /* TRACK_H_ */
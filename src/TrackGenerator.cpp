@@ -20,6 +20,13 @@ TrackGenerator::TrackGenerator(Geometry* geometry, const int num_azim,
   _z_coord = 0.0;
   _phi = NULL;
   _FSR_locks = NULL;
+  _FSR_materials = NULL;
+  _modular = false;
+  _num_modules_x = 1;
+  _num_modules_y = 1;
+  _FSR_ordering = FSR_ORDER_RAY_TRACING;
+  _segment_formation = EXPLICIT_SEGMENTS;
+  _max_optical_length = 0.;
 }
 
 
@@ -46,6 +53,9 @@ TrackGenerator::~TrackGenerator() {
 
   if (_FSR_locks != NULL)
     delete [] _FSR_locks;
+
+  if (_FSR_materials != NULL)
+    delete [] _FSR_materials;
 }
 
 
@@ -96,6 +106,22 @@ omp_lock_t* TrackGenerator::getFSRLocks() {
 }
 
 
+/**
+ * @brief Returns an array of the Material filling each FSR.
+ * @details The Materials are those found in each FSR by the last call to
+ *          TrackGenerator::initializeSegments().
+ * @return an array of Material pointers indexed by FSR ID
+ */
+Material** TrackGenerator::getFSRMaterials() {
+
+  if (_FSR_materials == NULL)
+    log_printf(ERROR, "Unable to return the FSR Materials since they "
+               "have not yet been initialized");
+
+  return _FSR_materials;
+}
+
+
 /**
  * @brief Return the total number of Tracks generated.
  * @return The number of Tracks generated
@@ -193,13 +219,27 @@ int TrackGenerator::getNumSegments() {
   for (int i=0; i < _num_azim; i++) {
 #pragma omp parallel for reduction(+:num_segments)
     for (int j=0; j < _num_tracks[i]; j++)
-      num_segments += _tracks[i][j].getNumSegments();
+      num_segments += getNumSegments(&_tracks[i][j]);
   }
 
   return num_segments;
 }
 
 
+/**
+ * @brief Return the number of segments along a Track.
+ * @details This is the number of segments stored by the Track, or the
+ *          number which are traced for it with on-the-fly ray tracing.
+ * @param track a pointer to the Track
+ * @return the number of segments along the Track
+ */
+int TrackGenerator::getNumSegments(Track* track) {
+  if (_segment_formation == OTF_SEGMENTS)
+    return track->getNumTracedSegments();
+  return track->getNumSegments();
+}
+
+
 /**
  * @brief Returns a 2D jagged array of the Tracks.
  * @details The first index into the array is the azimuthal angle and the
@@ -284,6 +324,7 @@ FP_PRECISION* TrackGenerator::getFSRVolumes() {
     int azim_index, fsr_id;
     segment* curr_segment;
     FP_PRECISION volume;
+    Track scratch;
 
     /* Calculate each FSR's "volume" by accumulating the total length of *
      * all Track segments multipled by the Track "widths" for each FSR.  */
@@ -291,10 +332,11 @@ FP_PRECISION* TrackGenerator::getFSRVolumes() {
 #pragma omp for
       for (int j=0; j < _num_tracks[i]; j++) {
 
+        Track* track = getSegmentedTrack(&_tracks[i][j], &scratch);
         azim_index = _tracks[i][j].getAzimAngleIndex();
 
-        for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
-          curr_segment = _tracks[i][j].getSegment(s);
+        for (int s=0; s < track->getNumSegments(); s++) {
+          curr_segment = track->getSegment(s);
           volume = curr_segment->_length * _azim_weights[azim_index];
           fsr_id = curr_segment->_region_id;
 
@@ -329,18 +371,24 @@ FP_PRECISION TrackGenerator::getFSRVolume(int fsr_id) {
     log_printf(ERROR, "Unable to get the volume for FSR %d since the FSR IDs "
                "lie in the range (0, %d)", fsr_id, _geometry->getNumFSRs());
 
-  segment* curr_segment;
   FP_PRECISION volume = 0;
 
-  /* Calculate the FSR's "volume" by accumulating the total length of *
-   * all Track segments multipled by the Track "widths" for the FSR.  */
-  for (int i=0; i < _num_azim; i++) {
-#pragma omp parallel for reduction(+:volume) private(curr_segment)
-    for (int j=0; j < _num_tracks[i]; j++) {
-      for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
-        curr_segment = _tracks[i][j].getSegment(s);
-        if (curr_segment->_region_id == fsr_id)
-          volume += curr_segment->_length * _azim_weights[i];
+#pragma omp parallel reduction(+:volume)
+  {
+    segment* curr_segment;
+    Track scratch;
+
+    /* Calculate the FSR's "volume" by accumulating the total length of *
+     * all Track segments multipled by the Track "widths" for the FSR.  */
+    for (int i=0; i < _num_azim; i++) {
+#pragma omp for
+      for (int j=0; j < _num_tracks[i]; j++) {
+        Track* track = getSegmentedTrack(&_tracks[i][j], &scratch);
+        for (int s=0; s < track->getNumSegments(); s++) {
+          curr_segment = track->getSegment(s);
+          if (curr_segment->_region_id == fsr_id)
+            volume += curr_segment->_length * _azim_weights[i];
+        }
       }
     }
   }
@@ -363,15 +411,17 @@ FP_PRECISION TrackGenerator::getMaxOpticalLength() {
     FP_PRECISION length;
     Material* material;
     FP_PRECISION* sigma_t;
+    Track scratch;
 
     /* Iterate over all tracks, segments, groups to find max optical length */
     for (int i=0; i < _num_azim; i++) {
 #pragma omp for reduction(max:max_optical_length)
       for (int j=0; j < _num_tracks[i]; j++) {
-        for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
-          curr_segment = _tracks[i][j].getSegment(s);
+        Track* track = getSegmentedTrack(&_tracks[i][j], &scratch);
+        for (int s=0; s < track->getNumSegments(); s++) {
+          curr_segment = track->getSegment(s);
           length = curr_segment->_length;
-          material = curr_segment->_material;
+          material = _FSR_materials[curr_segment->_region_id];
           sigma_t = material->getSigmaT();
 
           for (int e=0; e < material->getNumEnergyGroups(); e++)
@@ -403,6 +453,136 @@ void TrackGenerator::setNumThreads(int num_threads) {
 }
 
 
+/**
+ * @brief Returns whether segment templates are used for modular ray tracing.
+ * @return true if modular ray tracing is used; false otherwise
+ */
+bool TrackGenerator::isModularRayTracing() {
+  return _modular;
+}
+
+
+/**
+ * @brief Returns the ordering with which the FSRs are numbered after ray
+ *        tracing.
+ * @return the FSR ordering
+ */
+fsrOrdering TrackGenerator::getFSROrdering() {
+  return _FSR_ordering;
+}
+
+
+/**
+ * @brief Returns whether the segments are stored or traced on-the-fly.
+ * @return the segment formation (EXPLICIT_SEGMENTS or OTF_SEGMENTS)
+ */
+segmentationType TrackGenerator::getSegmentFormation() {
+  return _segment_formation;
+}
+
+
+/**
+ * @brief Sets whether to use segment templates for modular ray tracing.
+ * @details With modular ray tracing, the segments crossed by a Track within
+ *          each cell of the lowest level Lattices are traced once for each
+ *          unique Lattice cell Universe, azimuthal angle and entry point and
+ *          reused wherever another Track enters the same Universe at the same
+ *          point. Templates are only reused where the track laydown causes
+ *          Tracks to enter Lattice cells at the same points, which may be
+ *          guaranteed with TrackGenerator::setNumModules(...).
+ *
+ * @code
+ *          track_generator.setModularRayTracing(True)
+ *          track_generator.setNumModules(51, 51)
+ * @endcode
+ *
+ * @param modular whether to use modular ray tracing
+ */
+void TrackGenerator::setModularRayTracing(bool modular) {
+  _modular = modular;
+}
+
+
+/**
+ * @brief Sets the number of modules along x and y with which to align the
+ *        Track laydown.
+ * @details The number of Tracks starting on the x-axis (y-axis) for each
+ *          azimuthal angle is rounded up to a multiple of the number of
+ *          modules along x (y). For a Geometry with uniformly sized Lattice
+ *          cells, setting the number of modules to the number of Lattice
+ *          cells along each axis ensures that Tracks for each azimuthal angle
+ *          enter every Lattice cell at the same local points, so that each
+ *          segment template is reused by modular ray tracing. The effective
+ *          track spacing is reduced as a result.
+ * @param num_modules_x the number of modules along x
+ * @param num_modules_y the number of modules along y
+ */
+void TrackGenerator::setNumModules(int num_modules_x, int num_modules_y) {
+
+  if (num_modules_x <= 0 || num_modules_y <= 0)
+    log_printf(ERROR, "Unable to set the number of modules to %d x %d for the "
+               "TrackGenerator since it must be positive", num_modules_x,
+               num_modules_y);
+
+  _num_modules_x = num_modules_x;
+  _num_modules_y = num_modules_y;
+  _contains_tracks = false;
+  _use_input_file = false;
+  _tracks_filename = "";
+}
+
+
+/**
+ * @brief Sets the ordering with which the FSRs are numbered after ray tracing.
+ * @details FSRs are found concurrently by the threads ray tracing the Tracks
+ *          and are by default left in the order in which they are found.
+ *          The FSRs may instead be renumbered along a Hilbert curve such
+ *          that consecutive segments on a Track for any azimuthal angle
+ *          access nearby FSR data in the transport sweep and that the FSR
+ *          IDs are the same for any number of threads, or numbered in the
+ *          order in which they are first crossed by the Tracks:
+ *
+ * @code
+ *          track_generator.setFSROrdering(openmoc.FSR_ORDER_HILBERT)
+ * @endcode
+ *
+ * @param ordering the FSR ordering (FSR_ORDER_RAY_TRACING,
+ *        FSR_ORDER_FIRST_TOUCH or FSR_ORDER_HILBERT)
+ */
+void TrackGenerator::setFSROrdering(fsrOrdering ordering) {
+  _FSR_ordering = ordering;
+  _contains_tracks = false;
+  _use_input_file = false;
+  _tracks_filename = "";
+}
+
+
+/**
+ * @brief Sets whether the segments are stored or traced on-the-fly.
+ * @details By default, the segments along each Track are traced once and
+ *          stored for the transport sweeps. With on-the-fly ray tracing,
+ *          only the number of segments along each Track is kept after ray
+ *          tracing and the segments are traced again for each Track in each
+ *          transport sweep (and by each of the routines which otherwise loop
+ *          over the stored segments). The FSRs are then looked up by the
+ *          instance of their Cell in the CSG tree rather than by their FSR
+ *          keys, and any segment templates of modular ray tracing are kept.
+ *          This trades the time for ray tracing in each sweep for the memory
+ *          for the segments, which is most of the memory for large models:
+ *
+ * @code
+ *          track_generator.setSegmentFormation(openmoc.OTF_SEGMENTS)
+ * @endcode
+ *
+ * @param segment_formation the segment formation (EXPLICIT_SEGMENTS or
+ *        OTF_SEGMENTS)
+ */
+void TrackGenerator::setSegmentFormation(segmentationType segment_formation) {
+  _segment_formation = segment_formation;
+  _contains_tracks = false;
+}
+
+
 /**
  * @brief Sets the z-coord where the 2D Tracks should be created.
  * @param z_coord the z-coord where the 2D Tracks should be created.
@@ -550,6 +730,8 @@ void TrackGenerator::retrieveSegmentCoords(double* coords, int length_coords) {
   double x0, x1, y0, y1, z;
   double phi;
   segment* segments;
+  Track scratch;
+  Track* track;
 
   int counter = 0;
 
@@ -563,9 +745,10 @@ void TrackGenerator::retrieveSegmentCoords(double* coords, int length_coords) {
       z = _tracks[i][j].getStart()->getZ();
       phi = _tracks[i][j].getPhi();
 
-      segments = _tracks[i][j].getSegments();
+      track = getSegmentedTrack(&_tracks[i][j], &scratch);
+      segments = track->getSegments();
 
-      for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
+      for (int s=0; s < track->getNumSegments(); s++) {
         curr_segment = &segments[s];
 
         coords[counter] = curr_segment->_region_id;
@@ -675,6 +858,7 @@ void TrackGenerator::generateTracks(bool neighbor_cells) {
   initializeTrackUids();
   initializeFSRLocks();
   initializeVolumes();
+  initializeSegments();
 
   return;
 }
@@ -727,21 +911,36 @@ void TrackGenerator::initializeTrackFileDirectory() {
   if ((!stat(directory.str().c_str(), &st)) == 0)
     mkdir(directory.str().c_str(), S_IRWXU);
 
-  if (_geometry->getCmfd() != NULL) {
-    test_filename << directory.str() << "/"
-                  << _num_azim*2.0 << "_angles_"
-                  << _spacing << "_cm_spacing_z_"
-                  << _z_coord << "_("
-                  << _geometry->getCmfd()->getNumX()
+  test_filename << directory.str() << "/"
+                << _num_azim*2.0 << "_angles_"
+                << _spacing << "_cm_spacing_z_"
+                << _z_coord;
+
+  if (_num_modules_x != 1 || _num_modules_y != 1)
+    test_filename << "_(" << _num_modules_x << "x" << _num_modules_y
+                  << ")_modules";
+
+  if (_geometry->getXSymmetry() || _geometry->getYSymmetry())
+    test_filename << "_(" << _geometry->getXSymmetry() << "x"
+                  << _geometry->getYSymmetry() << ")_symmetry";
+
+  if (_geometry->getNumDomainsX() != 1 || _geometry->getNumDomainsY() != 1)
+    test_filename << "_(" << _geometry->getNumDomainsX() << "x"
+                  << _geometry->getNumDomainsY() << ")_domains_("
+                  << _geometry->getDomainIndexX() << ","
+                  << _geometry->getDomainIndexY() << ")";
+
+  if (_FSR_ordering == FSR_ORDER_FIRST_TOUCH)
+    test_filename << "_first_touch";
+  else if (_FSR_ordering == FSR_ORDER_HILBERT)
+    test_filename << "_hilbert";
+
+  if (_geometry->getCmfd() != NULL)
+    test_filename << "_(" << _geometry->getCmfd()->getNumX()
                   << "x" << _geometry->getCmfd()->getNumY()
                   << ")_cmfd.data";
-    }
-  else{
-    test_filename << directory.str() << "/"
-                  << _num_azim*2.0 << "_angles_"
-                  << _spacing << "_cm_spacing_z_"
-                  << _z_coord << ".data";
-  }
+  else
+    test_filename << ".data";
 
   _tracks_filename = test_filename.str();
 
@@ -756,6 +955,51 @@ void TrackGenerator::initializeTrackFileDirectory() {
 }
 
 
+/**
+ * @brief Computes the effective azimuthal angles and the number of Tracks
+ *        starting on the x- and y-axes for each azimuthal angle.
+ * @details The number of Tracks is chosen for each azimuthal angle such that
+ *          the Tracks wrap cyclically across the Geometry with an effective
+ *          spacing close to the user-specified track spacing, aligned with
+ *          the number of modules for modular ray tracing. This laydown
+ *          depends only on the Geometry's bounding box and may be computed
+ *          before any Tracks are allocated.
+ * @param num_x array of length _num_azim for the number of Tracks starting
+ *        on the x-axis for each azimuthal angle
+ * @param num_y array of length _num_azim for the number of Tracks starting
+ *        on the y-axis for each azimuthal angle
+ * @param phi array of length _num_azim for the effective azimuthal angles
+ */
+void TrackGenerator::computeTrackLaydown(int* num_x, int* num_y, double* phi) {
+
+  double iazim = _num_azim*2.0;
+  double width_x = _geometry->getWidthX();
+  double width_y = _geometry->getWidthY();
+
+  for (int i = 0; i < _num_azim; i++) {
+
+    /* A desired azimuthal angle for the user-specified number of
+     * azimuthal angles */
+    double phi_desired = 2.0 * M_PI / iazim * (0.5 + i);
+
+    /* The number of intersections with x,y-axes */
+    num_x[i] = (int) (fabs(width_x / _spacing * sin(phi_desired))) + 1;
+    num_y[i] = (int) (fabs(width_y / _spacing * cos(phi_desired))) + 1;
+
+    /* Align the laydown with the modules for modular ray tracing */
+    num_x[i] = ((num_x[i] - 1) / _num_modules_x + 1) * _num_modules_x;
+    num_y[i] = ((num_y[i] - 1) / _num_modules_y + 1) * _num_modules_y;
+
+    /* Effective/actual angle (not the angle we desire, but close) */
+    phi[i] = atan((width_y * num_x[i]) / (width_x * num_y[i]));
+
+    /* Fix angles in range(pi/2, pi) */
+    if (phi_desired > M_PI / 2)
+      phi[i] = M_PI - phi[i];
+  }
+}
+
+
 /**
  * @brief Initializes Track azimuthal angles, start and end Points.
  * @details This method computes the azimuthal angles and effective track
@@ -774,31 +1018,18 @@ void TrackGenerator::initializeTracks() {
   double* d_eff = new double[_num_azim];
 
   double x1, x2;
-  double iazim = _num_azim*2.0;
   double width_x = _geometry->getWidthX();
   double width_y = _geometry->getWidthY();
 
-  /* Determine azimuthal angles and track spacing */
-  for (int i = 0; i < _num_azim; i++) {
-
-    /* A desired azimuthal angle for the user-specified number of
-     * azimuthal angles */
-    double phi = 2.0 * M_PI / iazim * (0.5 + i);
+  /* Determine azimuthal angles and the number of Tracks per angle */
+  computeTrackLaydown(_num_x, _num_y, _phi);
 
-    /* The number of intersections with x,y-axes */
-    _num_x[i] = (int) (fabs(width_x / _spacing * sin(phi))) + 1;
-    _num_y[i] = (int) (fabs(width_y / _spacing * cos(phi))) + 1;
+  /* Determine effective track spacing */
+  for (int i = 0; i < _num_azim; i++) {
 
     /* Total number of Tracks */
     _num_tracks[i] = _num_x[i] + _num_y[i];
 
-    /* Effective/actual angle (not the angle we desire, but close) */
-    _phi[i] = atan((width_y * _num_x[i]) / (width_x * _num_y[i]));
-
-    /* Fix angles in range(pi/2, pi) */
-    if (phi > M_PI / 2)
-      _phi[i] = M_PI - _phi[i];
-
     /* Effective Track spacing (not spacing we desire, but close) */
     dx_eff[i] = (width_x / _num_x[i]);
     dy_eff[i] = (width_y / _num_y[i]);
@@ -1270,16 +1501,23 @@ void TrackGenerator::initializeBoundaryConditions() {
           track->setBCIn(_geometry->getMaxXBoundaryType());
       }
 
-      /* Set connecting tracks in forward direction */
+      /* Set connecting tracks in forward direction. The Tracks leaving
+       * through a domain interface continue on the same Track of the
+       * neighboring domain as if the interface were periodic. */
+      bool periodic_out = track->getBCOut() == PERIODIC ||
+                          track->getBCOut() == INTERFACE;
+      bool periodic_in = track->getBCIn() == PERIODIC ||
+                         track->getBCIn() == INTERFACE;
+
       if (j < _num_y[i]) {
         track->setNextOut(false);
-        if (track->getBCOut() == PERIODIC)
+        if (periodic_out)
           track->setTrackOut(&_tracks[i][j + _num_x[i]]);
         else
           track->setTrackOut(&_tracks[ic][j + _num_x[i]]);
       }
       else{
-        if (track->getBCOut() == PERIODIC) {
+        if (periodic_out) {
           track->setNextOut(false);
           track->setTrackOut(&_tracks[i][j - _num_y[i]]);
         }
@@ -1291,7 +1529,7 @@ void TrackGenerator::initializeBoundaryConditions() {
 
       /* Set connecting tracks in backward direction */
       if (j < _num_x[i]) {
-        if (track->getBCIn() == PERIODIC) {
+        if (periodic_in) {
           track->setNextIn(true);
           track->setTrackIn(&_tracks[i][j + _num_y[i]]);
         }
@@ -1302,7 +1540,7 @@ void TrackGenerator::initializeBoundaryConditions() {
       }
       else{
         track->setNextIn(true);
-        if (track->getBCIn() == PERIODIC)
+        if (periodic_in)
           track->setTrackIn(&_tracks[i][j - _num_x[i]]);
         else
           track->setTrackIn(&_tracks[ic][j - _num_x[i]]);
@@ -1314,6 +1552,82 @@ void TrackGenerator::initializeBoundaryConditions() {
 }
 
 
+/**
+ * @brief Finds the Track directions leaving the Geometry through a surface
+ *        and those continuing them through the opposite surface.
+ * @details The Track directions are identified by twice the Track UID plus
+ *          zero for the forward and one for the reverse direction, and are
+ *          ordered by azimuthal angle and Track index. A Track direction
+ *          leaving through one surface continues on the same Track direction
+ *          entering through the opposite surface as for periodic boundary
+ *          conditions. This is used to exchange the angular fluxes across
+ *          the interfaces between the domains of a decomposed Geometry,
+ *          which have identical Track laydowns. The arrays may be NULL to
+ *          only count the Track directions.
+ * @param surface the surface (SURFACE_X_MIN, SURFACE_Y_MIN, SURFACE_X_MAX
+ *        or SURFACE_Y_MAX)
+ * @param fluxes_out the Track directions leaving through the surface
+ * @param fluxes_in the Track directions continuing them through the opposite
+ *        surface
+ * @return the number of Track directions leaving through the surface
+ */
+int TrackGenerator::getBoundaryFluxes(int surface, int* fluxes_out,
+                                      int* fluxes_in) {
+
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to find the Track directions leaving through "
+               "surface %d since Tracks have not yet been generated.",
+               surface);
+
+  int num_fluxes = 0;
+
+  for (int a=0; a < _num_azim; a++) {
+    for (int j=0; j < _num_tracks[a]; j++) {
+
+      int surface_out, surface_in, track_out, track_in;
+
+      /* The surface and Track continuing the forward direction */
+      if (j < _num_y[a]) {
+        surface_out = (a < _num_azim/2) ? SURFACE_X_MAX : SURFACE_X_MIN;
+        track_out = j + _num_x[a];
+      }
+      else {
+        surface_out = SURFACE_Y_MAX;
+        track_out = j - _num_y[a];
+      }
+
+      /* The surface and Track continuing the reverse direction */
+      if (j < _num_x[a]) {
+        surface_in = SURFACE_Y_MIN;
+        track_in = j + _num_y[a];
+      }
+      else {
+        surface_in = (a < _num_azim/2) ? SURFACE_X_MIN : SURFACE_X_MAX;
+        track_in = j - _num_x[a];
+      }
+
+      if (surface_out == surface) {
+        if (fluxes_out != NULL) {
+          fluxes_out[num_fluxes] = 2 * _tracks[a][j].getUid();
+          fluxes_in[num_fluxes] = 2 * _tracks[a][track_out].getUid();
+        }
+        num_fluxes++;
+      }
+
+      if (surface_in == surface) {
+        if (fluxes_out != NULL) {
+          fluxes_out[num_fluxes] = 2 * _tracks[a][j].getUid() + 1;
+          fluxes_in[num_fluxes] = 2 * _tracks[a][track_in].getUid() + 1;
+        }
+        num_fluxes++;
+      }
+    }
+  }
+
+  return num_fluxes;
+}
+
+
 /**
  * @brief Generate segments for each Track across the Geometry.
  */
@@ -1327,14 +1641,39 @@ void TrackGenerator::segmentize() {
    * Tracks were not read in from an input file */
   if (!_use_input_file) {
 
+    /* Size the Geometry's maps for concurrent access by all threads */
+    _geometry->setNumThreads(omp_get_max_threads());
+
     /* Loop over all Tracks */
     for (int i=0; i < _num_azim; i++) {
 #pragma omp parallel for private(track)
       for (int j=0; j < _num_tracks[i]; j++) {
         track = &_tracks[i][j];
-        _geometry->segmentize(track);
+        _geometry->segmentize(track, _modular);
+
+        /* Keep only the number of segments if tracing on-the-fly, once the
+         * Track is traced again to find the FSR of each Cell instance */
+        if (_segment_formation == OTF_SEGMENTS) {
+          track->clearSegments();
+          _geometry->retrace(track, _modular);
+          track->discardSegments();
+        }
       }
     }
+
+    /* Free the segment templates unless Tracks are traced again */
+    if (_modular) {
+      log_printf(INFO, "Ray traced %d segment templates",
+                 _geometry->getNumSegmentTemplates());
+      if (_segment_formation == EXPLICIT_SEGMENTS)
+        _geometry->clearSegmentTemplates();
+
+      /* The FSR keys are no longer needed once the FSR instances are found */
+      else
+        _geometry->clearSegmentTemplateKeys();
+    }
+
+    renumberFSRs();
   }
 
   _geometry->initializeFSRVectors();
@@ -1345,6 +1684,151 @@ void TrackGenerator::segmentize() {
 }
 
 
+/**
+ * @brief Computes the index of a point along a Hilbert curve.
+ * @param n the number of cells along each axis of the grid traversed by
+ *        the curve (a power of two)
+ * @param x the x index of the grid cell
+ * @param y the y index of the grid cell
+ * @return the index of the grid cell along the curve
+ */
+static long hilbertIndex(int n, int x, int y) {
+
+  long index = 0;
+
+  for (int s=n/2; s > 0; s /= 2) {
+    int rx = (x & s) > 0;
+    int ry = (y & s) > 0;
+    index += (long)s * s * ((3 * rx) ^ ry);
+
+    /* Rotate the quadrant such that the curve enters it at the origin */
+    if (ry == 0) {
+      if (rx == 1) {
+        x = n - 1 - x;
+        y = n - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+
+  return index;
+}
+
+
+/**
+ * @brief Renumbers the FSRs after ray tracing with the FSR ordering.
+ * @details The FSR IDs assigned during ray tracing depend on the order in
+ *          which the threads find each FSR. This assigns new IDs in the
+ *          order in which the Tracks first cross each FSR, or along a Hilbert
+ *          curve through the midpoint of the first segment in each FSR, and
+ *          updates the region ID of each segment and the Geometry's FSR key
+ *          map. This must be called before the Geometry's FSR vectors and
+ *          the FSR volumes are initialized.
+ */
+void TrackGenerator::renumberFSRs() {
+
+  if (_FSR_ordering == FSR_ORDER_RAY_TRACING)
+    return;
+
+  log_printf(INFO, "Renumbering FSRs...");
+
+  int num_FSRs = _geometry->getFSRKeysMap().size();
+  int* first_touch = new int[num_FSRs];
+  double* points = new double[2*num_FSRs];
+  int num_touched = 0;
+  Track scratch;
+
+  for (int r=0; r < num_FSRs; r++)
+    first_touch[r] = -1;
+
+  /* Find the order in which the Tracks first cross each FSR */
+  for (int i=0; i < _num_azim; i++) {
+    double cos_phi = cos(_phi[i]);
+    double sin_phi = sin(_phi[i]);
+
+    for (int j=0; j < _num_tracks[i]; j++) {
+      Track* track = getSegmentedTrack(&_tracks[i][j], &scratch);
+      double x = track->getStart()->getX();
+      double y = track->getStart()->getY();
+
+      for (int s=0; s < track->getNumSegments(); s++) {
+        segment* curr_segment = track->getSegment(s);
+        int fsr_id = curr_segment->_region_id;
+        double length = curr_segment->_length;
+
+        if (first_touch[fsr_id] == -1) {
+          first_touch[fsr_id] = num_touched++;
+          points[2*fsr_id] = x + 0.5 * length * cos_phi;
+          points[2*fsr_id+1] = y + 0.5 * length * sin_phi;
+        }
+
+        x += length * cos_phi;
+        y += length * sin_phi;
+      }
+    }
+  }
+
+  /* Number any FSRs not crossed by a Track last */
+  for (int r=0; r < num_FSRs; r++) {
+    if (first_touch[r] == -1) {
+      first_touch[r] = num_touched++;
+      points[2*r] = 0.;
+      points[2*r+1] = 0.;
+    }
+  }
+
+  int* new_FSR_ids = new int[num_FSRs];
+
+  if (_FSR_ordering == FSR_ORDER_FIRST_TOUCH) {
+    for (int r=0; r < num_FSRs; r++)
+      new_FSR_ids[r] = first_touch[r];
+  }
+
+  /* Sort the FSRs along a Hilbert curve on a 2^16 x 2^16 grid, breaking
+   * ties by the first touch order so that the ordering is deterministic */
+  else {
+    int n = 1 << 16;
+    double min_x = _geometry->getMinX();
+    double min_y = _geometry->getMinY();
+    double scale_x = (n - 1) / _geometry->getWidthX();
+    double scale_y = (n - 1) / _geometry->getWidthY();
+    std::vector< std::pair<long, int> > order(num_FSRs);
+    std::vector<int> touched_FSRs(num_FSRs);
+
+    for (int r=0; r < num_FSRs; r++) {
+      int ix = std::min(std::max(int((points[2*r] - min_x) * scale_x), 0),
+                        n - 1);
+      int iy = std::min(std::max(int((points[2*r+1] - min_y) * scale_y), 0),
+                        n - 1);
+      order[r] = std::make_pair(hilbertIndex(n, ix, iy), first_touch[r]);
+      touched_FSRs[first_touch[r]] = r;
+    }
+
+    std::sort(order.begin(), order.end());
+
+    for (int r=0; r < num_FSRs; r++)
+      new_FSR_ids[touched_FSRs[order[r].second]] = r;
+  }
+
+  /* Update the FSR IDs of all stored segments and in the FSR key map */
+  for (int i=0; i < _num_azim; i++) {
+#pragma omp parallel for
+    for (int j=0; j < _num_tracks[i]; j++) {
+      for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
+        segment* curr_segment = _tracks[i][j].getSegment(s);
+        curr_segment->_region_id = new_FSR_ids[curr_segment->_region_id];
+      }
+    }
+  }
+
+  _geometry->renumberFSRs(new_FSR_ids);
+
+  delete [] first_touch;
+  delete [] points;
+  delete [] new_FSR_ids;
+}
+
+
 /**
  * @brief Writes all Track and segment data to a "*.tracks" binary file.
  * @details Storing Tracks in a binary file saves time by eliminating ray
@@ -1390,22 +1874,34 @@ void TrackGenerator::dumpTracksToFile() {
   double phi;
   int azim_angle_index;
   int num_segments;
-  std::vector<segment*> _segments;
   Cmfd* cmfd = _geometry->getCmfd();
 
   segment* curr_segment;
+  cmfd_crossing* crossings;
+  int num_crossings;
+  Track scratch;
   double length;
   int material_id;
   int region_id;
   int cmfd_surface_fwd;
   int cmfd_surface_bwd;
 
+  /* Find the ID of the Material in each FSR from the FSR data */
+  int num_FSRs = _geometry->getNumFSRs();
+  int* FSR_material_ids = new int[num_FSRs];
+  fsr_data** fsr_data_list = _geometry->getFSRKeysMap().values();
+
+  for (int i=0; i < num_FSRs; i++)
+    FSR_material_ids[fsr_data_list[i]->_fsr_id] = fsr_data_list[i]->_mat_id;
+
+  delete [] fsr_data_list;
+
   /* Loop over all Tracks */
   for (int i=0; i < _num_azim; i++) {
     for (int j=0; j < _num_tracks[i]; j++) {
 
       /* Get data for this Track */
-      curr_track = &_tracks[i][j];
+      curr_track = getSegmentedTrack(&_tracks[i][j], &scratch);
       x0 = curr_track->getStart()->getX();
       y0 = curr_track->getStart()->getY();
       z0 = curr_track->getStart()->getZ();
@@ -1427,14 +1923,17 @@ void TrackGenerator::dumpTracksToFile() {
       fwrite(&azim_angle_index, sizeof(int), 1, out);
       fwrite(&num_segments, sizeof(int), 1, out);
 
+      crossings = curr_track->getCmfdCrossings();
+      num_crossings = curr_track->getNumCmfdCrossings();
+
       /* Loop over all segments for this Track */
-      for (int s=0; s < num_segments; s++) {
+      for (int s=0, c=0; s < num_segments; s++) {
 
         /* Get data for this segment */
         curr_segment = curr_track->getSegment(s);
         length = curr_segment->_length;
-        material_id = curr_segment->_material->getId();
         region_id = curr_segment->_region_id;
+        material_id = FSR_material_ids[region_id];
 
         /* Write data for this segment to the Track file */
         fwrite(&length, sizeof(double), 1, out);
@@ -1443,8 +1942,13 @@ void TrackGenerator::dumpTracksToFile() {
 
         /* Write CMFD-related data for the Track if needed */
         if (cmfd != NULL) {
-          cmfd_surface_fwd = curr_segment->_cmfd_surface_fwd;
-          cmfd_surface_bwd = curr_segment->_cmfd_surface_bwd;
+          cmfd_surface_fwd = -1;
+          cmfd_surface_bwd = -1;
+          if (c < num_crossings && crossings[c]._segment == s) {
+            cmfd_surface_fwd = crossings[c]._surface_fwd;
+            cmfd_surface_bwd = crossings[c]._surface_bwd;
+            c++;
+          }
           fwrite(&cmfd_surface_fwd, sizeof(int), 1, out);
           fwrite(&cmfd_surface_bwd, sizeof(int), 1, out);
         }
@@ -1460,13 +1964,14 @@ void TrackGenerator::dumpTracksToFile() {
   int fsr_id;
   double x, y, z;
 
+  delete [] FSR_material_ids;
+
   /* Write number of FSRs */
-  int num_FSRs = _geometry->getNumFSRs();
   fwrite(&num_FSRs, sizeof(int), 1, out);
 
   /* Write FSR vector maps to file */
   std::string* fsr_key_list = FSR_keys_map.keys();
-  fsr_data** fsr_data_list = FSR_keys_map.values();
+  fsr_data_list = FSR_keys_map.values();
   for (int i=0; i < num_FSRs; i++) {
 
     /* Write key to file from FSR_keys_map */
@@ -1603,12 +2108,10 @@ bool TrackGenerator::readTracksFromFile() {
   int material_id;
   int region_id;
 
-  int cmfd_surface_fwd;
-  int cmfd_surface_bwd;
+  int cmfd_surface_fwd = -1;
+  int cmfd_surface_bwd = -1;
   segment curr_segment;
 
-  std::map<int, Material*> materials = _geometry->getAllMaterials();
-
   /* Loop over Tracks */
   for (int i=0; i < _num_azim; i++) {
     _tracks[i] = new Track[_num_tracks[i]];
@@ -1640,22 +2143,25 @@ bool TrackGenerator::readTracksFromFile() {
         ret = fread(&material_id, sizeof(int), 1, in);
         ret = fread(&region_id, sizeof(int), 1, in);
 
-        /* Initialize segment with the data */
+        /* Initialize segment with the data (the Material is that of
+         * the FSR) */
         curr_segment._length = length;
-        curr_segment._material = materials[material_id];
         curr_segment._region_id = region_id;
 
         /* Import CMFD-related data if needed */
         if (cmfd != NULL) {
           ret = fread(&cmfd_surface_fwd, sizeof(int), 1, in);
           ret = fread(&cmfd_surface_bwd, sizeof(int), 1, in);
-          curr_segment._cmfd_surface_fwd = cmfd_surface_fwd;
-          curr_segment._cmfd_surface_bwd = cmfd_surface_bwd;
         }
 
         /* Add this segment to the Track */
-        curr_track->addSegment(&curr_segment);
+        curr_track->addSegment(&curr_segment, cmfd_surface_fwd,
+                               cmfd_surface_bwd);
       }
+
+      /* Keep only the number of segments if tracing on-the-fly */
+      if (_segment_formation == OTF_SEGMENTS)
+        curr_track->discardSegments();
     }
   }
 
@@ -1746,6 +2252,10 @@ bool TrackGenerator::readTracksFromFile() {
  */
 void TrackGenerator::correctFSRVolume(int fsr_id, FP_PRECISION fsr_volume) {
 
+  if (_segment_formation == OTF_SEGMENTS)
+    log_printf(ERROR, "Unable to correct the volume of FSR %d since the "
+               "segments are traced on-the-fly", fsr_id);
+
   if (!_contains_tracks)
     log_printf(ERROR, "Unable to correct FSR volume since "
 	       "tracks have not yet been generated");
@@ -1832,38 +2342,43 @@ void TrackGenerator::generateFSRCentroids() {
   }
 
   /* Generate the fsr centroids */
-  for (int i=0; i < _num_azim; i++) {
-#pragma omp parallel for
-    for (int j=0; j < _num_tracks[i]; j++) {
+#pragma omp parallel
+  {
+    Track scratch;
 
-      int num_segments = _tracks[i][j].getNumSegments();
-      segment* segments = _tracks[i][j].getSegments();
-      double x = _tracks[i][j].getStart()->getX();
-      double y = _tracks[i][j].getStart()->getY();
-      double z = _tracks[i][j].getStart()->getZ();
-      double phi = _tracks[i][j].getPhi();
+    for (int i=0; i < _num_azim; i++) {
+#pragma omp for
+      for (int j=0; j < _num_tracks[i]; j++) {
 
-      for (int s=0; s < num_segments; s++) {
-        segment* curr_segment = &segments[s];
-        int fsr = curr_segment->_region_id;
-        double volume = FSR_volumes[fsr];
-
-        /* Set FSR mutual exclusion lock */
-        omp_set_lock(&_FSR_locks[fsr]);
-
-        centroids[fsr]->setX(centroids[fsr]->getX() + _azim_weights[i] *
-                             (x + cos(phi) * curr_segment->_length / 2.0) *
-                             curr_segment->_length / FSR_volumes[fsr]);
-        centroids[fsr]->setY(centroids[fsr]->getY() + _azim_weights[i] *
-                             (y + sin(phi) * curr_segment->_length / 2.0) *
-                             curr_segment->_length / FSR_volumes[fsr]);
-        centroids[fsr]->setZ(z);
-
-        /* Release FSR mutual exclusion lock */
-        omp_unset_lock(&_FSR_locks[fsr]);
-
-        x += cos(phi) * curr_segment->_length;
-        y += sin(phi) * curr_segment->_length;
+        Track* track = getSegmentedTrack(&_tracks[i][j], &scratch);
+        int num_segments = track->getNumSegments();
+        segment* segments = track->getSegments();
+        double x = _tracks[i][j].getStart()->getX();
+        double y = _tracks[i][j].getStart()->getY();
+        double z = _tracks[i][j].getStart()->getZ();
+        double phi = _tracks[i][j].getPhi();
+
+        for (int s=0; s < num_segments; s++) {
+          segment* curr_segment = &segments[s];
+          int fsr = curr_segment->_region_id;
+
+          /* Set FSR mutual exclusion lock */
+          omp_set_lock(&_FSR_locks[fsr]);
+
+          centroids[fsr]->setX(centroids[fsr]->getX() + _azim_weights[i] *
+                               (x + cos(phi) * curr_segment->_length / 2.0) *
+                               curr_segment->_length / FSR_volumes[fsr]);
+          centroids[fsr]->setY(centroids[fsr]->getY() + _azim_weights[i] *
+                               (y + sin(phi) * curr_segment->_length / 2.0) *
+                               curr_segment->_length / FSR_volumes[fsr]);
+          centroids[fsr]->setZ(z);
+
+          /* Release FSR mutual exclusion lock */
+          omp_unset_lock(&_FSR_locks[fsr]);
+
+          x += cos(phi) * curr_segment->_length;
+          y += sin(phi) * curr_segment->_length;
+        }
       }
     }
   }
@@ -1884,7 +2399,9 @@ void TrackGenerator::generateFSRCentroids() {
  *        maximum optical length for the problem.
  * @details This routine is needed so that all segment lengths fit
  *          within the exponential interpolation table used in the MOC
- *          transport sweep.
+ *          transport sweep. With on-the-fly ray tracing, the maximum optical
+ *          length is kept and the segments are split each time they are
+ *          traced.
  * @param max_optical_length the maximum optical length
  */
 void TrackGenerator::splitSegments(FP_PRECISION max_optical_length) {
@@ -1893,84 +2410,147 @@ void TrackGenerator::splitSegments(FP_PRECISION max_optical_length) {
     log_printf(ERROR, "Unable to split segments since "
 	       "tracks have not yet been generated");
 
-#pragma omp parallel
-  {
-
-    int num_cuts, min_num_cuts;
-    segment* curr_segment;
-
-    FP_PRECISION length, tau;
-    int fsr_id;
-    Material* material;
-    FP_PRECISION* sigma_t;
-    int num_groups;
-    int cmfd_surface_fwd, cmfd_surface_bwd;
+  if (_segment_formation == OTF_SEGMENTS) {
+    _max_optical_length = max_optical_length;
 
-    /* Iterate over all Tracks */
+    /* Count the segments along each Track after splitting */
     for (int i=0; i < _num_azim; i++) {
-#pragma omp for
+#pragma omp parallel for
       for (int j=0; j < _num_tracks[i]; j++) {
-        for (int s=0; s < _tracks[i][j].getNumSegments(); s+=min_num_cuts) {
-
-          /* Extract data from this segment to compute it optical length */
-          curr_segment = _tracks[i][j].getSegment(s);
-          material = curr_segment->_material;
-          length = curr_segment->_length;
-          fsr_id = curr_segment->_region_id;
-          cmfd_surface_fwd = curr_segment->_cmfd_surface_fwd;
-          cmfd_surface_bwd = curr_segment->_cmfd_surface_bwd;
+        _geometry->retrace(&_tracks[i][j], _modular);
+        splitTrackSegments(&_tracks[i][j], max_optical_length);
+        _tracks[i][j].discardSegments();
+      }
+    }
+    return;
+  }
 
-          /* Compute number of segments to split this segment into */
-          min_num_cuts = 1;
-          num_groups = material->getNumEnergyGroups();
-          sigma_t = material->getSigmaT();
+  /* Iterate over all Tracks */
+  for (int i=0; i < _num_azim; i++) {
+#pragma omp parallel for
+    for (int j=0; j < _num_tracks[i]; j++)
+      splitTrackSegments(&_tracks[i][j], max_optical_length);
+  }
+}
 
-          for (int g=0; g < num_groups; g++) {
-            tau = length * sigma_t[g];
-            num_cuts = ceil(tau / max_optical_length);
-            min_num_cuts = std::max(num_cuts, min_num_cuts);
-          }
 
-          /* If the segment does not need subdivisions, go to next segment */
-          if (min_num_cuts == 1)
-            continue;
+/**
+ * @brief Splits the segments along a Track into sub-segments no longer than
+ *        a maximum optical length.
+ * @param track a pointer to the Track
+ * @param max_optical_length the maximum optical length
+ */
+void TrackGenerator::splitTrackSegments(Track* track,
+                                        FP_PRECISION max_optical_length) {
+
+  int num_segments = track->getNumSegments();
+  int num_crossings = track->getNumCmfdCrossings();
+  segment* segments = track->getSegments();
+  bool split = false;
+
+  /* Find whether any segment is too long before copying the segments */
+  for (int s=0; s < num_segments && !split; s++) {
+    Material* material = _FSR_materials[segments[s]._region_id];
+    FP_PRECISION* sigma_t = material->getSigmaT();
+
+    for (int g=0; g < material->getNumEnergyGroups(); g++) {
+      if (segments[s]._length * sigma_t[g] > max_optical_length)
+        split = true;
+    }
+  }
 
-          /* Split the segment into sub-segments */
-          for (int k=0; k < min_num_cuts; k++) {
+  if (!split)
+    return;
 
-            /* Create a new Track segment */
-            segment* new_segment = new segment;
-            new_segment->_material = material;
-            new_segment->_length = length / FP_PRECISION(min_num_cuts);
-            new_segment->_region_id = fsr_id;
+  std::vector<segment> old_segments(segments, segments + num_segments);
+  std::vector<cmfd_crossing> crossings(track->getCmfdCrossings(),
+                                       track->getCmfdCrossings() +
+                                       num_crossings);
+  int num_cuts, min_num_cuts;
+  segment new_segment;
+  int cmfd_surface_fwd, cmfd_surface_bwd;
+
+  /* Rebuild the Track's segments, splitting those which are too long */
+  track->clearSegments();
+
+  for (int s=0, c=0; s < num_segments; s++) {
+
+    /* Extract data from this segment to compute it optical length */
+    segment* curr_segment = &old_segments[s];
+    Material* material = _FSR_materials[curr_segment->_region_id];
+    FP_PRECISION length = curr_segment->_length;
+    FP_PRECISION* sigma_t = material->getSigmaT();
+    cmfd_surface_fwd = -1;
+    cmfd_surface_bwd = -1;
+
+    if (c < num_crossings && crossings[c]._segment == s) {
+      cmfd_surface_fwd = crossings[c]._surface_fwd;
+      cmfd_surface_bwd = crossings[c]._surface_bwd;
+      c++;
+    }
 
-            /* Assign CMFD surface boundaries */
-            if (k == 0)
-              new_segment->_cmfd_surface_bwd = cmfd_surface_bwd;
+    /* Compute number of segments to split this segment into */
+    min_num_cuts = 1;
 
-            if (k == min_num_cuts-1)
-              new_segment->_cmfd_surface_fwd = cmfd_surface_fwd;
+    for (int g=0; g < material->getNumEnergyGroups(); g++) {
+      num_cuts = ceil(length * sigma_t[g] / max_optical_length);
+      min_num_cuts = std::max(num_cuts, min_num_cuts);
+    }
 
-            /* Insert the new segment to the Track */
-            _tracks[i][j].insertSegment(s+k+1, new_segment);
-          }
+    /* Split the segment into sub-segments, assigning the CMFD surface
+     * boundaries to the first and last sub-segments */
+    new_segment._length = length / FP_PRECISION(min_num_cuts);
+    new_segment._region_id = curr_segment->_region_id;
 
-          /* Remove the original segment from the Track */
-          _tracks[i][j].removeSegment(s);
-        }
-      }
-    }
+    for (int k=0; k < min_num_cuts; k++)
+      track->addSegment(&new_segment,
+                        (k == min_num_cuts-1) ? cmfd_surface_fwd : -1,
+                        (k == 0) ? cmfd_surface_bwd : -1);
   }
 }
 
 
 /**
- * @brief Initialize track segments with pointers to FSR Materials.
+ * @brief Returns a Track with the segments along a given Track.
+ * @details With stored segments, this is the Track itself. With on-the-fly
+ *          ray tracing, the segments are traced again into a scratch Track
+ *          owned by the caller (one for each thread), whose segment storage
+ *          is reused from one Track to the next, and split to the maximum
+ *          optical length if needed. The FSRs are looked up without forming
+ *          FSR keys (see Geometry::retrace(...)). Only the segments and CMFD
+ *          crossings of the returned Track should be used.
+ * @param track a pointer to the Track
+ * @param scratch a pointer to a Track to trace the segments into
+ * @return a pointer to the Track with the segments
+ */
+Track* TrackGenerator::getSegmentedTrack(Track* track, Track* scratch) {
+
+  if (_segment_formation == EXPLICIT_SEGMENTS)
+    return track;
+
+  Point* start = track->getStart();
+  Point* end = track->getEnd();
+  scratch->clearSegments();
+  scratch->setValues(start->getX(), start->getY(), start->getZ(),
+                     end->getX(), end->getY(), end->getZ(), track->getPhi());
+  scratch->setAzimAngleIndex(track->getAzimAngleIndex());
+  _geometry->retrace(scratch, _modular);
+
+  if (_max_optical_length > 0.)
+    splitTrackSegments(scratch, _max_optical_length);
+
+  return scratch;
+}
+
+
+/**
+ * @brief Initializes the Material filling each FSR.
  * @details This is called by the Solver at simulation time. This
  *          initialization is necessary since Materials in each FSR
  *          may be interchanged by the user in between different
- *          simulations. This method links each segment and fsr_data
- *          struct with the current Material found in each FSR.
+ *          simulations. This method links each fsr_data struct with the
+ *          current Material found in each FSR. Segments do not store their
+ *          Material, which is that of the FSR in which they lie.
  */
 void TrackGenerator::initializeSegments() {
 
@@ -1978,40 +2558,23 @@ void TrackGenerator::initializeSegments() {
     log_printf(ERROR, "Unable to initialize segments since "
 	       "tracks have not yet been generated");
 
-  /* Get all of the Materials from the Geometry */
-  std::map<int, Material*> materials = _geometry->getAllMaterials();
-
   /* Get the mappings of FSR to keys to fsr_data to update Materials */
   ParallelHashMap<std::string, fsr_data*>& FSR_keys_map =
       _geometry->getFSRKeysMap();
   std::vector<std::string>& FSRs_to_keys = _geometry->getFSRsToKeys();
+  int num_FSRs = _geometry->getNumFSRs();
 
-#pragma omp parallel
-  {
-
-    int region_id, mat_id;
-    segment* curr_segment;
-    Material* mat;
+  if (_FSR_materials != NULL)
+    delete [] _FSR_materials;
 
-    /* Set the Material for each FSR */
-#pragma omp for
-    for (int r=0; r < _geometry->getNumFSRs(); r++) {
-      mat = _geometry->findFSRMaterial(r);
-      FSR_keys_map.at(FSRs_to_keys.at(r))->_mat_id = mat->getId();
-    }
+  _FSR_materials = new Material*[num_FSRs];
+  _geometry->setNumThreads(omp_get_max_threads());
 
-    /* Set the Material for each segment */
-    for (int i=0; i < _num_azim; i++) {
-#pragma omp for
-      for (int j=0; j < _num_tracks[i]; j++) {
-        for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
-          curr_segment = _tracks[i][j].getSegment(s);
-          region_id = curr_segment->_region_id;
-          mat_id = FSR_keys_map.at(FSRs_to_keys.at(region_id))->_mat_id;
-          curr_segment->_material = materials[mat_id];
-        }
-      }
-    }
+  /* Set the Material for each FSR */
+#pragma omp parallel for
+  for (int r=0; r < num_FSRs; r++) {
+    _FSR_materials[r] = _geometry->findFSRMaterial(r);
+    FSR_keys_map.at(FSRs_to_keys.at(r))->_mat_id = _FSR_materials[r]->getId();
   }
 }
 
@@ -2036,3 +2599,210 @@ double TrackGenerator::getPhi(int azim) {
   else
     return 2 * M_PI - _phi[azim - _num_azim];
 }
+
+
+/**
+ * @brief Estimates the number of Tracks without generating them.
+ * @details The number of Tracks depends only on the Geometry's bounding box,
+ *          the number of azimuthal angles and the track spacing, so the
+ *          estimate is exact.
+ * @return the number of Tracks which will be generated
+ */
+int TrackGenerator::estimateNumTracks() {
+
+  if (_geometry == NULL)
+    log_printf(ERROR, "Unable to estimate the number of Tracks since no "
+               "Geometry has been set for the TrackGenerator");
+
+  int* num_x = new int[_num_azim];
+  int* num_y = new int[_num_azim];
+  double* phi = new double[_num_azim];
+  computeTrackLaydown(num_x, num_y, phi);
+
+  int num_tracks = 0;
+  for (int i=0; i < _num_azim; i++)
+    num_tracks += num_x[i] + num_y[i];
+
+  delete [] num_x;
+  delete [] num_y;
+  delete [] phi;
+
+  return num_tracks;
+}
+
+
+/**
+ * @brief Estimates the number of Track segments without ray tracing every
+ *        Track across the Geometry.
+ * @details A subset of the Tracks in the laydown used by generateTracks(...)
+ *          is traced across the Geometry, distributed across azimuthal
+ *          angles in proportion to the number of Tracks per angle and evenly
+ *          spaced within each angle. The number of segments crossed by each
+ *          sampled Track is counted without creating any segments or FSRs,
+ *          and the total is extrapolated to all Tracks. If the number of
+ *          samples exceeds the number of Tracks, the count is exact. The
+ *          additional segments created by splitSegments(...) to bound the
+ *          optical length of each segment are not included. The Geometry is
+ *          not modified: ring and sector subdivisions are counted without
+ *          subdividing any Cells and the CMFD mesh is not initialized.
+ *
+ * @code
+ *          num_segments = track_generator.estimateNumSegments(num_samples=500)
+ * @endcode
+ *
+ * @param num_samples the approximate number of Tracks to trace (default 1000)
+ * @return the estimated number of segments
+ */
+long TrackGenerator::estimateNumSegments(int num_samples) {
+
+  if (_geometry == NULL)
+    log_printf(ERROR, "Unable to estimate the number of segments since no "
+               "Geometry has been set for the TrackGenerator");
+
+  if (num_samples <= 0)
+    log_printf(ERROR, "Unable to estimate the number of segments with %d "
+               "sample Tracks since it is not a positive integer", num_samples);
+
+  int* num_x = new int[_num_azim];
+  int* num_y = new int[_num_azim];
+  double* phi = new double[_num_azim];
+  computeTrackLaydown(num_x, num_y, phi);
+
+  double width_x = _geometry->getWidthX();
+  double width_y = _geometry->getWidthY();
+  double min_x = _geometry->getMinX();
+  double min_y = _geometry->getMinY();
+  int tot_num_tracks = estimateNumTracks();
+  double num_segments = 0.;
+
+  for (int i=0; i < _num_azim; i++) {
+
+    int num_tracks = num_x[i] + num_y[i];
+    double dx_eff = width_x / num_x[i];
+    double dy_eff = width_y / num_y[i];
+
+    /* Sample Tracks in proportion to the number of Tracks at this angle */
+    int num_sampled = (int) (double(num_samples) * num_tracks / tot_num_tracks);
+    num_sampled = std::min(std::max(num_sampled, 1), num_tracks);
+    long sampled_segments = 0;
+
+#pragma omp parallel for reduction(+:sampled_segments)
+    for (int s=0; s < num_sampled; s++) {
+
+      int j = int((s + 0.5) * num_tracks / num_sampled);
+      double x0, y0;
+
+      /* Compute start point for Tracks starting on x-axis */
+      if (j < num_x[i]) {
+        y0 = 0.;
+        if (i < _num_azim / 2)
+          x0 = dx_eff * (num_x[i] - j - 0.5);
+        else
+          x0 = dx_eff * (0.5 + j);
+      }
+
+      /* Compute start point for Tracks starting on y-axis */
+      else {
+        y0 = dy_eff * (0.5 + j - num_x[i]);
+        if (i < _num_azim / 2)
+          x0 = 0.;
+        else
+          x0 = width_x;
+      }
+
+      /* Compute the end point and recalibrate the Track to the origin */
+      Track track;
+      track.getStart()->setCoords(x0, y0, _z_coord);
+      computeEndPoint(track.getStart(), track.getEnd(), phi[i],
+                      width_x, width_y);
+      double x1 = track.getEnd()->getX();
+      double y1 = track.getEnd()->getY();
+      track.setValues(x0 + min_x, y0 + min_y, _z_coord,
+                      x1 + min_x, y1 + min_y, _z_coord, phi[i]);
+
+      sampled_segments += _geometry->countSegments(&track);
+    }
+
+    num_segments += double(sampled_segments) * num_tracks / num_sampled;
+  }
+
+  delete [] num_x;
+  delete [] num_y;
+  delete [] phi;
+
+  return long(num_segments + 0.5);
+}
+
+
+/**
+ * @brief Estimates the memory required for ray tracing and a CPUSolver
+ *        before Tracks are generated.
+ * @details This method predicts the number of FSRs from the Geometry's CSG
+ *          structure, the number of Tracks from the track laydown and the
+ *          number of segments by ray tracing a sample of Tracks. These are
+ *          used to estimate the memory footprint of the Tracks, segments and
+ *          FSR data structures as well as the boundary angular flux and FSR
+ *          scalar flux and source arrays allocated by the Solver. A report
+ *          is printed to the screen and the total is returned so that jobs
+ *          may be sized (or rejected) before ray tracing:
+ *
+ * @code
+ *          memory = track_generator.estimateMemory(num_polar=3)
+ *          if memory > 64000.:
+ *            raise MemoryError('Model requires {0} MB'.format(memory))
+ * @endcode
+ *
+ * @param num_polar the number of polar angles in the Solver's PolarQuad
+ * @param num_samples the approximate number of Tracks to trace (default 1000)
+ * @return the estimated memory footprint (MB)
+ */
+double TrackGenerator::estimateMemory(int num_polar, int num_samples) {
+
+  if (num_polar <= 0)
+    log_printf(ERROR, "Unable to estimate memory for %d polar angles since it "
+               "is not a positive integer", num_polar);
+
+  double num_FSRs = _geometry->estimateNumFSRs();
+  double num_tracks = estimateNumTracks();
+  double num_segments = estimateNumSegments(num_samples);
+  double num_groups = _geometry->getNumEnergyGroups();
+  double mega = 1.E6;
+
+  /* Ray tracing data stored by the TrackGenerator and Geometry */
+  double track_memory = num_tracks * sizeof(Track) / mega;
+  double segment_memory = num_segments * sizeof(segment) / mega;
+
+  /* Segments traced on-the-fly are not stored */
+  if (_segment_formation == OTF_SEGMENTS)
+    segment_memory = 0.;
+  double FSR_memory = num_FSRs * (sizeof(fsr_data) + 2 * sizeof(Point) +
+                      2 * sizeof(std::string) + sizeof(omp_lock_t) +
+                      sizeof(FP_PRECISION)) / mega;
+
+  /* Boundary angular fluxes for the forward and reverse Track directions */
+  double boundary_flux_memory = 2 * num_tracks * num_polar * num_groups *
+                                sizeof(FP_PRECISION) / mega;
+
+  /* Scalar fluxes, old scalar fluxes, reduced and fixed sources by FSR */
+  double FSR_array_memory = num_FSRs * (4 * num_groups * sizeof(FP_PRECISION)
+                            + sizeof(Material*)) / mega;
+
+  double total_memory = track_memory + segment_memory + FSR_memory +
+                        boundary_flux_memory + FSR_array_memory;
+
+  log_printf(TITLE, "RESOURCE ESTIMATE");
+  log_printf(RESULT, "# FSRs:                  %d", int(num_FSRs));
+  log_printf(RESULT, "# tracks:                %d", int(num_tracks));
+  log_printf(RESULT, "# segments:              %ld", long(num_segments));
+  log_printf(SEPARATOR, "-");
+  log_printf(RESULT, "Tracks:                  %1.4E MB", track_memory);
+  log_printf(RESULT, "Segments:                %1.4E MB", segment_memory);
+  log_printf(RESULT, "FSR data:                %1.4E MB", FSR_memory);
+  log_printf(RESULT, "Boundary fluxes:         %1.4E MB", boundary_flux_memory);
+  log_printf(RESULT, "FSR fluxes and sources:  %1.4E MB", FSR_array_memory);
+  log_printf(SEPARATOR, "-");
+  log_printf(RESULT, "Total:                   %1.4E MB", total_memory);
+  log_printf(SEPARATOR, "-");
+
+  return total_memory;
+}
@@ -21,9 +21,42 @@
 #include <sstream>
 #include <unistd.h>
 #include <omp.h>
+#include <algorithm>
+#include <vector>
 #endif
 
 
+/**
+ * @enum fsrOrdering
+ * @brief The orderings with which FSRs are numbered after ray tracing.
+ */
+enum fsrOrdering {
+
+  /** The order in which the FSRs are found by the threads ray tracing */
+  FSR_ORDER_RAY_TRACING,
+
+  /** The order in which the FSRs are first crossed by the Tracks */
+  FSR_ORDER_FIRST_TOUCH,
+
+  /** The order along a Hilbert curve through a point in each FSR */
+  FSR_ORDER_HILBERT
+};
+
+
+/**
+ * @enum segmentationType
+ * @brief The ways in which the Track segments are formed for the Solver.
+ */
+enum segmentationType {
+
+  /** The segments are traced once and stored with each Track */
+  EXPLICIT_SEGMENTS,
+
+  /** The segments are traced again each time they are needed */
+  OTF_SEGMENTS
+};
+
+
 /**
  * @class TrackGenerator TrackGenerator.h "src/TrackGenerator.h"
  * @brief The TrackGenerator is dedicated to generating and storing Tracks
@@ -86,15 +119,37 @@ private:
   /** OpenMP mutual exclusion locks for atomic FSR operations */
   omp_lock_t* _FSR_locks;
 
+  /** The Material filling each FSR */
+  Material** _FSR_materials;
+
   /** Boolean whether the Tracks have been generated (true) or not (false) */
   bool _contains_tracks;
 
   /** The z-coord where the 2D Tracks should be created */
   double _z_coord;
 
+  /** Whether to use segment templates for modular ray tracing */
+  bool _modular;
+
+  /** The number of modules along x and y with which the Track laydown is
+   *  aligned for modular ray tracing */
+  int _num_modules_x;
+  int _num_modules_y;
+
+  /** The ordering with which to number the FSRs after ray tracing */
+  fsrOrdering _FSR_ordering;
+
+  /** Whether the segments are stored or traced on-the-fly */
+  segmentationType _segment_formation;
+
+  /** The maximum optical length to which segments traced on-the-fly are
+   *  split (zero if they are not split) */
+  FP_PRECISION _max_optical_length;
+
   void computeEndPoint(Point* start, Point* end,  const double phi,
                        const double width_x, const double width_y);
 
+  void computeTrackLaydown(int* num_x, int* num_y, double* phi);
   void initializeTrackFileDirectory();
   void initializeTracks();
   void recalibrateTracksToOrigin();
@@ -104,6 +159,8 @@ private:
   void initializeVolumes();
   void initializeFSRLocks();
   void segmentize();
+  void renumberFSRs();
+  void splitTrackSegments(Track* track, FP_PRECISION max_optical_length);
   void dumpTracksToFile();
   bool readTracksFromFile();
 
@@ -123,6 +180,7 @@ public:
   int getNumTracksByParallelGroup(int group);
   int getNumParallelTrackGroups();
   int getNumSegments();
+  int getNumSegments(Track* track);
   Track** getTracks();
   Track** getTracksByParallelGroup();
   FP_PRECISION* getAzimWeights();
@@ -132,6 +190,10 @@ public:
   FP_PRECISION getMaxOpticalLength();
   double getZCoord();
   omp_lock_t* getFSRLocks();
+  Material** getFSRMaterials();
+  bool isModularRayTracing();
+  fsrOrdering getFSROrdering();
+  segmentationType getSegmentFormation();
 
   /* Set parameters */
   void setNumAzim(int num_azim);
@@ -139,16 +201,27 @@ public:
   void setGeometry(Geometry* geometry);
   void setNumThreads(int num_threads);
   void setZCoord(double z_coord);
+  void setModularRayTracing(bool modular);
+  void setNumModules(int num_modules_x, int num_modules_y);
+  void setFSROrdering(fsrOrdering ordering);
+  void setSegmentFormation(segmentationType segment_formation);
 
   /* Worker functions */
   bool containsTracks();
   void retrieveTrackCoords(double* coords, int num_tracks);
   void retrieveSegmentCoords(double* coords, int num_segments);
+  int getBoundaryFluxes(int surface, int* fluxes_out, int* fluxes_in);
+  Track* getSegmentedTrack(Track* track, Track* scratch);
   void generateTracks(bool neighbor_cells=false);
   void correctFSRVolume(int fsr_id, FP_PRECISION fsr_volume);
   void generateFSRCentroids();
   void splitSegments(FP_PRECISION max_optical_length);
   void initializeSegments();
+
+  /* Resource estimation before ray tracing */
+  int estimateNumTracks();
+  long estimateNumSegments(int num_samples=1000);
+  double estimateMemory(int num_polar=3, int num_samples=1000);
 };
 
 #endif /* TRACKGENERATOR_H_ */
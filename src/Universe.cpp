@@ -1395,26 +1395,30 @@ double Lattice::minSurfaceDist(LocalCoords* coords) {
   int lat_x = getLatX(coords->getPoint());
   int lat_y = getLatY(coords->getPoint());
   double phi = coords->getPhi();
+  double cos_phi = cos(phi);
+  double sin_phi = sin(phi);
 
-  /* Create planes representing the boundaries of the lattice cell */
-  XPlane xplane(0.0);
-  YPlane yplane(0.0);
+  /* Create plane kernels representing the boundaries of the lattice cell */
+  surface_kernel xplane = {XPLANE, 0, 1., 0., 0., 0., 0., NULL};
+  surface_kernel yplane = {YPLANE, 0, 0., 1., 0., 0., 0., NULL};
 
   /* Get the min distance for X PLANE  */
   if (phi < M_PI_2)
-    xplane.setX(((lat_x+1) * _width_x - _width_x*_num_x/2.0 + _offset.getX()));
+    xplane._D = -((lat_x+1) * _width_x - _width_x*_num_x/2.0 + _offset.getX());
   else
-    xplane.setX((lat_x * _width_x - _width_x*_num_x/2.0 + _offset.getX()));
+    xplane._D = -(lat_x * _width_x - _width_x*_num_x/2.0 + _offset.getX());
 
-  double dist_x = xplane.getMinDistance(coords);
+  double dist_x = surfaceKernelDistance(&xplane, coords->getPoint(), phi,
+                                        cos_phi, sin_phi);
 
   /* Get the min distance for Y PLANE */
   if (phi < M_PI)
-    yplane.setY(((lat_y+1) * _width_y - _width_y*_num_y/2.0 + _offset.getY()));
+    yplane._D = -((lat_y+1) * _width_y - _width_y*_num_y/2.0 + _offset.getY());
   else
-    yplane.setY((lat_y * _width_y - _width_y*_num_y/2.0 + _offset.getY()));
+    yplane._D = -(lat_y * _width_y - _width_y*_num_y/2.0 + _offset.getY());
 
-  double dist_y = yplane.getMinDistance(coords);
+  double dist_y = surfaceKernelDistance(&yplane, coords->getPoint(), phi,
+                                        cos_phi, sin_phi);
 
   /* return shortest distance to next lattice cell */
   return std::min(dist_x, dist_y);
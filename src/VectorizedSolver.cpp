@@ -18,7 +18,9 @@ VectorizedSolver::VectorizedSolver(TrackGenerator* track_generator) :
   if (track_generator != NULL)
     setTrackGenerator(track_generator);
 
+#ifdef USE_MKL
   vmlSetMode(VML_EP);
+#endif
 }
 
 
@@ -147,6 +149,11 @@ void VectorizedSolver::initializeMaterials(solverMode mode) {
  */
 void VectorizedSolver::initializeFluxArrays() {
 
+  if (_boundary_flux_storage != BOUNDARY_FLUX_FULL)
+    log_printf(ERROR, "Unable to initialize the fluxes since the "
+               "VectorizedSolver does not support compressed boundary "
+               "angular fluxes");
+
   /* Delete old flux arrays if they exist */
   if (_boundary_flux != NULL)
     MM_FREE(_boundary_flux);
@@ -172,9 +179,9 @@ void VectorizedSolver::initializeFluxArrays() {
     size *= sizeof(FP_PRECISION);
     _boundary_flux = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
 
-    size = _num_FSRs * _num_groups * sizeof(FP_PRECISION);
-    _scalar_flux = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
-    _old_scalar_flux = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
+    size = _num_FSRs * _num_groups * sizeof(ACC_PRECISION);
+    _scalar_flux = (ACC_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
+    _old_scalar_flux = (ACC_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
 
     size = _num_threads * _num_groups * sizeof(FP_PRECISION);
     _delta_psi = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
@@ -279,11 +286,12 @@ void VectorizedSolver::normalizeFluxes() {
 
   FP_PRECISION* nu_sigma_f;
   FP_PRECISION volume;
-  FP_PRECISION tot_fission_source;
-  FP_PRECISION norm_factor;
+  ACC_PRECISION tot_fission_source;
+  ACC_PRECISION norm_factor;
 
-  int size = _num_FSRs * _num_groups * sizeof(FP_PRECISION);
-  FP_PRECISION* fission_sources = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
+  int size = _num_FSRs * _num_groups * sizeof(ACC_PRECISION);
+  ACC_PRECISION* fission_sources =
+    (ACC_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
 
   /* Compute total fission source for each FSR, energy group */
 #pragma omp parallel for private(volume, nu_sigma_f) schedule(guided)
@@ -297,24 +305,27 @@ void VectorizedSolver::normalizeFluxes() {
     for (int v=0; v < _num_vector_lengths; v++) {
 
       /* Loop over each energy group within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
       for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
         fission_sources(r,e) = nu_sigma_f[e] * _scalar_flux(r,e);
 
       /* Loop over each energy group within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
       for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
         fission_sources(r,e) *= volume;
     }
   }
 
-  /* Compute the total fission source */
+  /* Compute the total fission source over all domains */
   size = _num_FSRs * _num_groups;
-#ifdef SINGLE
+#ifndef USE_MKL
+  tot_fission_source = pairwise_sum<ACC_PRECISION>(fission_sources, size);
+#elif defined(SINGLE) && !defined(MIXED)
   tot_fission_source = cblas_sasum(size, fission_sources, 1);
 #else
   tot_fission_source = cblas_dasum(size, fission_sources, 1);
 #endif
+  tot_fission_source = sumOverDomains(tot_fission_source);
 
   /* Deallocate memory for fission source array */
   MM_FREE(fission_sources);
@@ -326,7 +337,13 @@ void VectorizedSolver::normalizeFluxes() {
              tot_fission_source, norm_factor);
 
   /* Normalize the FSR scalar fluxes */
-#ifdef SINGLE
+#ifndef USE_MKL
+#pragma omp parallel for simd schedule(guided)
+  for (int i=0; i < size; i++) {
+    _scalar_flux[i] *= norm_factor;
+    _old_scalar_flux[i] *= norm_factor;
+  }
+#elif defined(SINGLE) && !defined(MIXED)
   cblas_sscal(size, norm_factor, _scalar_flux, 1);
   cblas_sscal(size, norm_factor, _old_scalar_flux, 1);
 #else
@@ -337,7 +354,11 @@ void VectorizedSolver::normalizeFluxes() {
   /* Normalize the Track angular boundary fluxes */
   size = 2 * _tot_num_tracks * _num_polar * _num_groups;
 
-#ifdef SINGLE
+#ifndef USE_MKL
+#pragma omp parallel for simd schedule(guided)
+  for (int i=0; i < size; i++)
+    _boundary_flux[i] *= norm_factor;
+#elif SINGLE
   cblas_sscal(size, norm_factor, _boundary_flux, 1);
 #else
   cblas_dscal(size, norm_factor, _boundary_flux, 1);
@@ -356,7 +377,6 @@ void VectorizedSolver::computeFSRSources() {
 
 #pragma omp parallel default(none)
   {
-    int tid;
     Material* material;
     FP_PRECISION* sigma_t;
     FP_PRECISION* sigma_s;
@@ -373,7 +393,6 @@ void VectorizedSolver::computeFSRSources() {
 #pragma omp for schedule(guided)
     for (int r=0; r < _num_FSRs; r++) {
 
-      tid = omp_get_thread_num();
       material = _FSR_materials[r];
       sigma_t = material->getSigmaT();
       sigma_s = material->getSigmaS();
@@ -383,14 +402,17 @@ void VectorizedSolver::computeFSRSources() {
       for (int G=0; G < _num_groups; G++) {
         for (int v=0; v < _num_vector_lengths; v++) {
 
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
           for (int g=v*VEC_LENGTH; g < (v+1)*VEC_LENGTH; g++) {
             scatter_sources[g] = sigma_s[G*_num_groups+g] * _scalar_flux(r,g);
             fission_sources[g] = fiss_mat[G*_num_groups+g] * _scalar_flux(r,g);
           }
         }
 
-#ifdef SINGLE
+#ifndef USE_MKL
+        scatter_source=pairwise_sum<FP_PRECISION>(scatter_sources, _num_groups);
+        fission_source=pairwise_sum<FP_PRECISION>(fission_sources, _num_groups);
+#elif SINGLE
         scatter_source=cblas_sasum(_num_groups, scatter_sources, 1);
         fission_source=cblas_sasum(_num_groups, fission_sources, 1);
 #else
@@ -434,17 +456,17 @@ void VectorizedSolver::addSourceToScalarFlux() {
     for (int v=0; v < _num_vector_lengths; v++) {
 
       /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
       for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
         _scalar_flux(r,e) *= 0.5;
 
       /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
       for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
         _scalar_flux(r,e) = _scalar_flux(r,e) / (sigma_t[e] * volume);
 
       /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
       for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
         _scalar_flux(r,e) += FOUR_PI * _reduced_sources(r,e);
     }
@@ -459,13 +481,13 @@ void VectorizedSolver::addSourceToScalarFlux() {
  */
 void VectorizedSolver::computeKeff() {
 
-  FP_PRECISION fission;
+  ACC_PRECISION fission;
 
-  int size = _num_FSRs * sizeof(FP_PRECISION);
-  FP_PRECISION* FSR_rates = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
+  int size = _num_FSRs * sizeof(ACC_PRECISION);
+  ACC_PRECISION* FSR_rates = (ACC_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
 
-  size = _num_threads * _num_groups * sizeof(FP_PRECISION);
-  FP_PRECISION* group_rates = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
+  size = _num_threads * _num_groups * sizeof(ACC_PRECISION);
+  ACC_PRECISION* group_rates = (ACC_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
 
 #pragma omp parallel
   {
@@ -487,12 +509,15 @@ void VectorizedSolver::computeKeff() {
       for (int v=0; v < _num_vector_lengths; v++) {
 
         /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
         for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
           group_rates[tid+e] = sigma[e] * _scalar_flux(r,e);
       }
 
-#ifdef SINGLE
+#ifndef USE_MKL
+      FSR_rates[r] = pairwise_sum<ACC_PRECISION>(&group_rates[tid],
+                                                 _num_groups) * volume;
+#elif defined(SINGLE) && !defined(MIXED)
       FSR_rates[r] = cblas_sasum(_num_groups, &group_rates[tid], 1) * volume;
 #else
       FSR_rates[r] = cblas_dasum(_num_groups, &group_rates[tid], 1) * volume;
@@ -500,12 +525,15 @@ void VectorizedSolver::computeKeff() {
     }
   }
 
-  /* Reduce new fission rates across FSRs */
-#ifdef SINGLE
+  /* Reduce new fission rates across FSRs and domains */
+#ifndef USE_MKL
+  fission = pairwise_sum<ACC_PRECISION>(FSR_rates, _num_FSRs);
+#elif defined(SINGLE) && !defined(MIXED)
   fission = cblas_sasum(_num_FSRs, FSR_rates, 1);
 #else
   fission = cblas_dasum(_num_FSRs, FSR_rates, 1);
 #endif
+  fission = sumOverDomains(fission);
 
   _k_eff *= fission;
 
@@ -548,22 +576,22 @@ void VectorizedSolver::tallyScalarFlux(segment* curr_segment,
     for (int v=0; v < _num_vector_lengths; v++) {
 
       /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
       for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
         delta_psi[e] = track_flux(p,e) - _reduced_sources(fsr_id,e);
 
       /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
       for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
         delta_psi[e] *= exponentials(p,e);
 
       /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
       for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
         fsr_flux[e] += delta_psi[e] * _polar_weights(azim_index,p);
 
       /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
       for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
         track_flux(p,e) -= delta_psi[e];
     }
@@ -572,7 +600,11 @@ void VectorizedSolver::tallyScalarFlux(segment* curr_segment,
   /* Atomically increment the FSR scalar flux from the temporary array */
   omp_set_lock(&_FSR_locks[fsr_id]);
   {
-#ifdef SINGLE
+#if defined(MIXED) || !defined(USE_MKL)
+#pragma omp simd
+    for (int e=0; e < _num_groups; e++)
+      _scalar_flux(fsr_id,e) += fsr_flux[e];
+#elif SINGLE
     vsAdd(_num_groups, &_scalar_flux(fsr_id,0), fsr_flux,
           &_scalar_flux(fsr_id,0));
 #else
@@ -594,8 +626,9 @@ void VectorizedSolver::tallyScalarFlux(segment* curr_segment,
 void VectorizedSolver::computeExponentials(segment* curr_segment,
                                            FP_PRECISION* exponentials) {
 
+  int fsr_id = curr_segment->_region_id;
   FP_PRECISION length = curr_segment->_length;
-  FP_PRECISION* sigma_t = curr_segment->_material->getSigmaT();
+  FP_PRECISION* sigma_t = _FSR_materials[fsr_id]->getSigmaT();
 
   /* Evaluate the exponentials using the linear interpolation table */
   if (_exp_evaluator->isUsingInterpolation()) {
@@ -615,16 +648,17 @@ void VectorizedSolver::computeExponentials(segment* curr_segment,
     FP_PRECISION* sin_thetas = _polar_quad->getSinThetas();
     FP_PRECISION* taus = &_thread_taus[tid*_polar_times_groups];
 
+#ifdef USE_MKL
     /* Initialize the tau argument for the exponentials */
     for (int p=0; p < _num_polar; p++) {
 
       for (int v=0; v < _num_vector_lengths; v++) {
 
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
         for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
           taus(p,e) = -sigma_t[e] * length;
 
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
         for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
           taus(p,e) /= sin_thetas[p];
       }
@@ -642,11 +676,28 @@ void VectorizedSolver::computeExponentials(segment* curr_segment,
 
       for (int v=0; v < _num_vector_lengths; v++) {
 
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
         for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
           exponentials(p,e) = 1.0 - exponentials(p,e);
       }
     }
+#else
+    /* Initialize the tau argument for the exponentials */
+    for (int p=0; p < _num_polar; p++) {
+
+      FP_PRECISION inv_sin_theta = 1. / sin_thetas[p];
+
+      for (int v=0; v < _num_vector_lengths; v++) {
+
+#pragma omp simd
+        for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
+          taus(p,e) = sigma_t[e] * length * inv_sin_theta;
+      }
+    }
+
+    /* Evaluate one minus the exponentials with the portable SIMD kernel */
+    one_minus_exp(taus, exponentials, _polar_times_groups);
+#endif
   }
 }
 
@@ -658,12 +709,10 @@ void VectorizedSolver::computeExponentials(segment* curr_segment,
  *          or periodic Track. For vacuum boundary conditions, the outgoing flux
  *          is tallied as leakage.
  * @param track_id the ID number for the Track of interest
- * @param azim_index a pointer to the azimuthal angle index for this segment
  * @param direction the Track direction (forward - true, reverse - false)
  * @param track_flux a pointer to the Track's outgoing angular flux
  */
-void VectorizedSolver::transferBoundaryFlux(int track_id, int azim_index,
-                                            bool direction,
+void VectorizedSolver::transferBoundaryFlux(int track_id, bool direction,
                                             FP_PRECISION* track_flux) {
   int start;
   bool transfer_flux;
@@ -683,7 +732,11 @@ void VectorizedSolver::transferBoundaryFlux(int track_id, int azim_index,
     track_out_id = _tracks[track_id]->getTrackIn()->getUid();
   }
 
-  FP_PRECISION* track_out_flux = &_boundary_flux(track_out_id,0,0,start);
+  /* Send the outgoing flux to the neighboring domain across an interface */
+  FP_PRECISION* track_out_flux = getInterfaceFlux(track_id, direction);
+
+  if (track_out_flux == NULL)
+    track_out_flux = &_boundary_flux(track_out_id,0,0,start);
 
   /* Loop over polar angles and energy groups */
   for (int p=0; p < _num_polar; p++) {
@@ -692,7 +745,7 @@ void VectorizedSolver::transferBoundaryFlux(int track_id, int azim_index,
     for (int v=0; v < _num_vector_lengths; v++) {
 
       /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
       for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
         track_out_flux(p,e) = track_flux(p,e) * transfer_flux;
     }
@@ -15,8 +15,17 @@
 #include <math.h>
 #include <omp.h>
 #include <stdlib.h>
+#include "vector_exp.h"
+#endif
+
+/* Intel's MKL is used for the vector math with Intel's compiler, and the
+ * portable SIMD kernels in vector_exp.h otherwise */
+#if defined(ICPC) || defined(INTEL)
+#define USE_MKL
+#ifdef __cplusplus
 #include <mkl.h>
 #endif
+#endif
 
 /** Indexing scheme for the optical length (\f$ l\Sigma_t \f$) for a
  *  given Track segment for each polar angle and energy group */
@@ -30,11 +39,10 @@
 /**
  * @class VectorizedSolver VectorizedSolver.h "src/VectorizedSolver.h"
  * @brief This is a subclass of the CPUSolver class which uses memory-aligned
- *        data structures and Intel's auto-vectorization.
- * @note This class is only compiled if the Intel compiler is used when building
- *       OpenMOC. If building OpenMOC with the "--with-icpc" flag, then this
- *       class will be available in the "openmoc.intel.single" or
- *       "openmoc.intel.double" Python module.
+ *        data structures and OpenMP SIMD vectorization.
+ * @note The exponentials and scalar flux tallies use Intel's MKL when
+ *       OpenMOC is built with the Intel compiler ("--with-icpc"), and
+ *       portable SIMD kernels with any other compiler supporting OpenMP 4.0.
  */
 class VectorizedSolver : public CPUSolver {
 
@@ -55,7 +63,7 @@ protected:
 
   void tallyScalarFlux(segment* curr_segment, int azim_index,
                        FP_PRECISION* track_flux, FP_PRECISION* fsr_flux);
-  void transferBoundaryFlux(int track_id, int azim_index, bool direction,
+  void transferBoundaryFlux(int track_id, bool direction,
                             FP_PRECISION* track_flux);
   void computeExponentials(segment* curr_segment, FP_PRECISION* exponentials);
 
@@ -917,6 +917,122 @@ void GPUSolver::getFluxes(FP_PRECISION* out_fluxes, int num_fluxes) {
 }
 
 
+/**
+ * @brief Fills an array with the total source in each FSR and energy group.
+ * @details The scalar fluxes and fixed sources are copied from the GPU in
+ *          bulk and the sources are computed on the host.
+ * @param out_sources an array of FSR sources in each energy group
+ * @param num_sources the total number of FSR source values
+ */
+void GPUSolver::getFSRSources(FP_PRECISION* out_sources, int num_sources) {
+
+  if (num_sources != _num_groups * _num_FSRs)
+    log_printf(ERROR, "Unable to get FSR sources since there are "
+               "%d groups and %d FSRs which does not match the requested "
+               "%d source values", _num_groups, _num_FSRs, num_sources);
+
+  else if (_scalar_flux.size() == 0)
+    log_printf(ERROR, "Unable to return the FSR sources "
+               "since they have not yet been computed");
+
+  FP_PRECISION* scalar_flux = new FP_PRECISION[num_sources];
+  FP_PRECISION* fixed_sources = new FP_PRECISION[num_sources];
+
+  cudaMemcpy((void*)scalar_flux,
+             (void*)thrust::raw_pointer_cast(&_scalar_flux[0]),
+             num_sources * sizeof(FP_PRECISION), cudaMemcpyDeviceToHost);
+  cudaMemcpy((void*)fixed_sources,
+             (void*)thrust::raw_pointer_cast(&_fixed_sources[0]),
+             num_sources * sizeof(FP_PRECISION), cudaMemcpyDeviceToHost);
+
+  for (int r=0; r < _num_FSRs; r++) {
+
+    Material* host_material = _geometry->findFSRMaterial(r);
+    FP_PRECISION* sigma_s = host_material->getSigmaS();
+    FP_PRECISION* fiss_mat = host_material->getFissionMatrix();
+
+    for (int G=0; G < _num_groups; G++) {
+
+      FP_PRECISION fission_source = 0.0;
+      FP_PRECISION scatter_source = 0.0;
+
+      for (int g=0; g < _num_groups; g++) {
+        scatter_source += sigma_s[G*_num_groups+g] *
+                          scalar_flux[r*_num_groups+g];
+        fission_source += fiss_mat[G*_num_groups+g] *
+                          scalar_flux[r*_num_groups+g];
+      }
+
+      out_sources[r*_num_groups+G] = (fission_source / _k_eff +
+                                      scatter_source +
+                                      fixed_sources[r*_num_groups+G]) *
+                                     ONE_OVER_FOUR_PI;
+    }
+  }
+
+  delete [] scalar_flux;
+  delete [] fixed_sources;
+}
+
+
+/**
+ * @brief Fills an array with the volume of each FSR from the GPU.
+ * @param out_volumes an array of FSR volumes
+ * @param num_volumes the number of FSRs
+ */
+void GPUSolver::getFSRVolumes(FP_PRECISION* out_volumes, int num_volumes) {
+
+  if (num_volumes != _num_FSRs)
+    log_printf(ERROR, "Unable to get %d FSR volumes since there are %d "
+               "FSRs", num_volumes, _num_FSRs);
+
+  else if (_FSR_volumes == NULL)
+    log_printf(ERROR, "Unable to get the FSR volumes since they "
+               "have not yet been computed");
+
+  cudaMemcpy((void*)out_volumes, (void*)_FSR_volumes,
+             _num_FSRs * sizeof(FP_PRECISION), cudaMemcpyDeviceToHost);
+}
+
+
+/**
+ * @brief The FSR scalar fluxes on the GPU cannot be viewed from the host.
+ * @details The fluxes may instead be copied with getFluxes(...).
+ * @param view_values a pointer to the FSR scalar flux array
+ * @param num_values the number of FSR scalar flux values
+ */
+void GPUSolver::getFluxesView(ACC_PRECISION** view_values, int* num_values) {
+  log_printf(ERROR, "Unable to return a view of the FSR scalar fluxes on "
+             "the GPU; use getFluxes(...) instead");
+}
+
+
+/**
+ * @brief The FSR reduced sources on the GPU cannot be viewed from the host.
+ * @details The total sources may instead be copied with getFSRSources(...).
+ * @param view_values a pointer to the FSR reduced source array
+ * @param num_values the number of FSR reduced source values
+ */
+void GPUSolver::getReducedSourcesView(FP_PRECISION** view_values,
+                                      int* num_values) {
+  log_printf(ERROR, "Unable to return a view of the FSR sources on "
+             "the GPU; use getFSRSources(...) instead");
+}
+
+
+/**
+ * @brief The FSR volumes on the GPU cannot be viewed from the host.
+ * @details The volumes may instead be copied with getFSRVolumes(...).
+ * @param view_values a pointer to the FSR volume array
+ * @param num_values the number of FSRs
+ */
+void GPUSolver::getFSRVolumesView(FP_PRECISION** view_values,
+                                  int* num_values) {
+  log_printf(ERROR, "Unable to return a view of the FSR volumes on "
+             "the GPU; use getFSRVolumes(...) instead");
+}
+
+
 /**
  * @brief Sets the number of thread blocks (>0) for CUDA kernels.
  * @param num_blocks the number of thread blocks
@@ -1073,6 +1189,11 @@ void GPUSolver::initializePolarQuadrature() {
  */
 void GPUSolver::initializeExpEvaluator() {
 
+  if (_exp_evaluator->isUsingInterpolation() &&
+      _exp_evaluator->getInterpolationOrder() != 1)
+    log_printf(ERROR, "Unable to initialize the exponential evaluator on "
+               "the GPU since only linear interpolation is supported");
+
   Solver::initializeExpEvaluator();
 
   log_printf(INFO, "Initializing the exponential evaluator on the GPU...");
@@ -1208,6 +1329,10 @@ void GPUSolver::initializeTracks() {
 
   log_printf(INFO, "Initializing tracks on the GPU...");
 
+  if (_track_generator->getSegmentFormation() == OTF_SEGMENTS)
+    log_printf(ERROR, "Unable to initialize Tracks on the GPU since the "
+               "segments are traced on-the-fly rather than stored");
+
   /* Delete old Tracks array if it exists */
   if (_dev_tracks != NULL)
     cudaFree(_dev_tracks);
@@ -1223,7 +1348,8 @@ void GPUSolver::initializeTracks() {
 
     for (int i=0; i < _tot_num_tracks; i++) {
 
-      clone_track(_tracks[i], &_dev_tracks[i], _material_IDs_to_indices);
+      clone_track(_tracks[i], &_dev_tracks[i], _FSR_materials,
+                  _material_IDs_to_indices);
 
       /* Get indices to next tracks along "forward" and "reverse" directions */
       index = _tracks[i]->getTrackIn()->getUid();
@@ -1311,6 +1437,20 @@ void GPUSolver::initializeSourceArrays() {
 }
 
 
+/**
+ * @brief Initializes all of the data structures on the GPU.
+ * @details The GPUSolver stores the FSR Materials by index on the device,
+ *          so changes to the Geometry's Materials can not be detected and
+ *          all components are rebuilt for each calculation.
+ * @param mode the solution type (FORWARD or ADJOINT)
+ * @return whether the flux arrays of the previous calculation were kept
+ */
+bool GPUSolver::initializeSolver(solverMode mode) {
+  _dirty_components = ALL_COMPONENTS;
+  return Solver::initializeSolver(mode);
+}
+
+
 /**
  * @brief Populates array of fixed sources assigned by FSR.
  */
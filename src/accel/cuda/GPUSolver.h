@@ -103,6 +103,8 @@ private:
   /** Map of Material IDs to indices in _materials array */
   std::map<int, int> _material_IDs_to_indices;
 
+  bool initializeSolver(solverMode mode);
+
 public:
 
   GPUSolver(TrackGenerator* track_generator=NULL);
@@ -118,6 +120,11 @@ public:
   FP_PRECISION getFSRSource(int fsr_id, int group);
   FP_PRECISION getFlux(int fsr_id, int group);
   void getFluxes(FP_PRECISION* out_fluxes, int num_fluxes);
+  void getFSRSources(FP_PRECISION* out_sources, int num_sources);
+  void getFSRVolumes(FP_PRECISION* out_volumes, int num_volumes);
+  void getFluxesView(ACC_PRECISION** view_values, int* num_values);
+  void getReducedSourcesView(FP_PRECISION** view_values, int* num_values);
+  void getFSRVolumesView(FP_PRECISION** view_values, int* num_values);
 
   void setNumThreadBlocks(int num_blocks);
   void setNumThreadsPerBlock(int num_threads);
@@ -79,10 +79,11 @@ void clone_material(Material* material_h, dev_material* material_d) {
  *          directly.
  * @param track_h pointer to a Track on the host
  * @param track_d pointer to a dev_track on the GPU
+ * @param FSR_materials array of the Material in each FSR
  * @param material_IDs_to_indices map of material IDs to indices
  *        in the _materials array.
  */
-void clone_track(Track* track_h, dev_track* track_d,
+void clone_track(Track* track_h, dev_track* track_d, Material** FSR_materials,
      		 std::map<int, int> &material_IDs_to_indices) {
 
   dev_segment* dev_segments;
@@ -106,7 +107,7 @@ void clone_track(Track* track_h, dev_track* track_d,
     host_segments[s]._length = curr->_length;
     host_segments[s]._region_uid = curr->_region_id;
     host_segments[s]._material_index =
-      material_IDs_to_indices[curr->_material->getId()];
+      material_IDs_to_indices[FSR_materials[curr->_region_id]->getId()];
   }
 
   cudaMemcpy((void*)dev_segments, (void*)host_segments,
@@ -11,5 +11,5 @@
 #include <map>
 
 void clone_material(Material* material_h, dev_material* material_d);
-void clone_track(Track* track_h, dev_track* track_d,
-                        std::map<int, int> &material_IDs_to_indices);
+void clone_track(Track* track_h, dev_track* track_d, Material** FSR_materials,
+                 std::map<int, int> &material_IDs_to_indices);
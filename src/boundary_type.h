@@ -23,7 +23,10 @@ enum boundaryType {
   PERIODIC,
 
   /** No boundary type (typically an interface between flat source regions) */
-  BOUNDARY_NONE
+  BOUNDARY_NONE,
+
+  /** An interface with a neighboring domain of a decomposed Geometry */
+  INTERFACE
 };
 
 #endif /* BOUNDARY_TYPE_H_ */
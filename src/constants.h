@@ -9,6 +9,15 @@
 #define CONSTANTS_H_
 
 
+/** The floating point precision of the FSR scalar flux accumulators,
+ *  \f$ k_{eff} \f$ and the reductions over FSRs. Mixed precision builds
+ *  (-DMIXED) define this as double while the Track angular fluxes and
+ *  segments use the single precision FP_PRECISION of the build. */
+#ifndef ACC_PRECISION
+#define ACC_PRECISION FP_PRECISION
+#endif
+
+
 /** The minimum auto ID used for Surfaces, Cells, Materials and Universes */
 #define DEFAULT_INIT_ID 10000
 
@@ -35,6 +44,17 @@
 /** Error threshold to determine if a point is to be considered on a Surface */
 #define ON_SURFACE_THRESH 1E-12
 
+/** Resolution with which Track entry points into Lattice cells are matched
+ *  to segment templates for modular ray tracing */
+#define TEMPLATE_COORD_THRESH 1E-10
+
+/** The number of lines across the Geometry along which its Materials are
+ *  compared with their mirror images to verify a symmetry */
+#define NUM_SYMMETRY_LINES 1000
+
+/** Tolerance (cm) for the positions of mirror image Material boundaries */
+#define SYMMETRY_THRESH 1E-6
+
 /** Tolerance for difference of the sum of polar weights with respect to 1.0 */
 #define POLAR_WEIGHT_SUM_TOL 1E-5
 
@@ -59,6 +79,14 @@
 #define MIN_LINEAR_SOLVE_ITERATIONS 10
 #define MAX_LINEAR_SOLVE_ITERATIONS 1000
 
+/** The number of red-black Gauss-Seidel sweeps before and after each coarse
+ *  grid correction, and on the coarsest grid, of a multigrid cycle */
+#define NUM_MULTIGRID_SMOOTHINGS 2
+#define NUM_MULTIGRID_COARSEST_SMOOTHINGS 50
+
+/** The maximum number of CMFD cells on the coarsest multigrid level */
+#define MAX_MULTIGRID_COARSEST_CELLS 16
+
 /** The faces and edges that collectively make up the surfaces of a
  *  horizontal slice of a rectangular prism. The faces are denoted
  *  as "f" and edges denoted as "e" on the illustration below:
@@ -0,0 +1,98 @@
+/**
+ * @file half_precision.h
+ * @brief Utility functions for the conversion of floating point numbers to
+ *        and from IEEE 754 half precision (binary16).
+ * @date October 19, 2026
+ */
+
+#ifndef HALF_PRECISION_H_
+#define HALF_PRECISION_H_
+
+#include <stdint.h>
+#include <string.h>
+
+
+/**
+ * @brief Converts a single precision float to half precision.
+ * @details The conversion rounds to the nearest half precision number (ties
+ *          to even) and supports subnormal numbers, infinities and NaNs.
+ * @param value the single precision number to convert
+ * @return the bits of the half precision number
+ */
+inline uint16_t float_to_half(float value) {
+
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(float));
+
+  uint16_t sign = (bits >> 16) & 0x8000;
+  uint32_t abs_bits = bits & 0x7FFFFFFF;
+
+  /* Overflow to infinity, and NaN */
+  if (abs_bits >= 0x47800000) {
+    if (abs_bits > 0x7F800000)
+      return sign | 0x7E00;
+    return sign | 0x7C00;
+  }
+
+  /* Underflow to zero */
+  if (abs_bits < 0x33000000)
+    return sign;
+
+  /* Subnormal half precision numbers */
+  if (abs_bits < 0x38800000) {
+    int shift = 126 - (abs_bits >> 23);
+    uint32_t mantissa = (abs_bits & 0x7FFFFF) | 0x800000;
+    uint32_t half = mantissa >> shift;
+    uint32_t remainder = mantissa & ((1u << shift) - 1);
+    uint32_t halfway = 1u << (shift - 1);
+
+    if (remainder > halfway || (remainder == halfway && (half & 1)))
+      half++;
+
+    return sign | half;
+  }
+
+  /* Normal half precision numbers with the exponent rebiased from 127 to 15 */
+  uint32_t half = (abs_bits - 0x38000000) >> 13;
+  uint32_t remainder = abs_bits & 0x1FFF;
+
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+    half++;
+
+  return sign | half;
+}
+
+
+/**
+ * @brief Converts a half precision number to single precision.
+ * @param half the bits of the half precision number
+ * @return the single precision number
+ */
+inline float half_to_float(uint16_t half) {
+
+  uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+  uint32_t exponent = (half >> 10) & 0x1F;
+  uint32_t mantissa = half & 0x3FF;
+  uint32_t bits;
+  float value;
+
+  /* Zero and subnormal numbers are multiples of 2^-24 */
+  if (exponent == 0) {
+    value = mantissa * 5.9604644775390625E-8f;
+    return sign ? -value : value;
+  }
+
+  /* Infinities and NaNs */
+  else if (exponent == 31)
+    bits = sign | 0x7F800000 | (mantissa << 13);
+
+  /* Normal numbers */
+  else
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+
+  memcpy(&value, &bits, sizeof(float));
+  return value;
+}
+
+
+#endif /* HALF_PRECISION_H_ */
@@ -1,5 +1,37 @@
 #include "linalg.h"
 
+
+/**
+ * @struct multigridLevels
+ * @brief The Matrix objects and work Vectors on each level of a geometric
+ *        multigrid hierarchy. Level 0 is the fine grid whose Matrix is
+ *        owned by the caller.
+ */
+struct multigridLevels {
+
+  /** The (Galerkin) Matrix on each level */
+  std::vector<Matrix*> A;
+
+  /** The solution, right hand side and residual Vectors on each level */
+  std::vector<Vector*> X;
+  std::vector<Vector*> B;
+  std::vector<Vector*> R;
+
+  /** The prolongated coarse grid correction on each level and its product
+   *  with the level's Matrix */
+  std::vector<Vector*> E;
+  std::vector<Vector*> AE;
+
+  /** OpenMP mutual exclusion locks for the cells of each coarse level */
+  std::vector<omp_lock_t*> cell_locks;
+};
+
+
+static void initializeMultigridLevels(Matrix* A, multigridLevels* levels);
+static void deleteMultigridLevels(multigridLevels* levels);
+static void multigridIterate(multigridLevels* levels, Vector* X, Vector* B,
+                             FP_PRECISION tol);
+
 /**
  * @brief Solves a generalized eigenvalue problem using the Power method.
  * @details This function takes in a loss + streaming Matrix (A),
@@ -14,10 +46,13 @@
  * @param X the flux Vector object
  * @param tol the power method and linear solve source convergence threshold
  * @param SOR_factor the successive over-relaxation factor
+ * @param solver_type the method used to solve the linear system in each
+ *        power iteration (RED_BLACK_SOR by default)
  * @return k_eff the dominant eigenvalue
  */
 FP_PRECISION eigenvalueSolve(Matrix* A, Matrix* M, Vector* X, FP_PRECISION tol,
-                             FP_PRECISION SOR_factor) {
+                             FP_PRECISION SOR_factor,
+                             linearSolverType solver_type) {
 
   log_printf(INFO, "Computing the Matrix-Vector eigenvalue...");
 
@@ -48,6 +83,11 @@ FP_PRECISION eigenvalueSolve(Matrix* A, Matrix* M, Vector* X, FP_PRECISION tol,
   FP_PRECISION residual, _k_eff;
   int iter;
 
+  /* The multigrid levels are constructed once for all power iterations */
+  multigridLevels levels;
+  if (solver_type == MULTIGRID)
+    initializeMultigridLevels(A, &levels);
+
   /* Compute and normalize the initial source */
   matrixMultiplication(M, X, &old_source);
   old_source.scaleByValue(num_rows / old_source.getSum());
@@ -57,7 +97,10 @@ FP_PRECISION eigenvalueSolve(Matrix* A, Matrix* M, Vector* X, FP_PRECISION tol,
   for (iter = 0; iter < MAX_LINALG_POWER_ITERATIONS; iter++) {
 
     /* Solve X = A^-1 * old_source */
-    linearSolve(A, M, X, &old_source, tol*1e1, SOR_factor);
+    if (solver_type == MULTIGRID)
+      multigridIterate(&levels, X, &old_source, tol*1e1);
+    else
+      linearSolve(A, M, X, &old_source, tol*1e1, SOR_factor);
 
     /* Compute the new source */
     matrixMultiplication(M, X, &new_source);
@@ -84,6 +127,9 @@ FP_PRECISION eigenvalueSolve(Matrix* A, Matrix* M, Vector* X, FP_PRECISION tol,
 
   log_printf(INFO, "Matrix-Vector eigenvalue solve iterations: %d", iter);
 
+  if (solver_type == MULTIGRID)
+    deleteMultigridLevels(&levels);
+
   return _k_eff;
 }
 
@@ -214,6 +260,373 @@ void linearSolve(Matrix* A, Matrix* M, Vector* X, Vector* B, FP_PRECISION tol,
 }
 
 
+/**
+ * @brief Solves a linear system using geometric multigrid.
+ * @details This function takes in a loss + streaming Matrix (A), a flux
+ *          Vector (X), a source Vector (B) and a tolerance on the relative
+ *          2-norm of the residual (tol) and solves the linear system with
+ *          multigrid W-cycles. The coarse grids are formed by agglomerating
+ *          2 x 2 blocks of cells on the structured mesh with Galerkin coarse
+ *          grid operators, such that the number of cycles needed is
+ *          largely independent of the number of mesh cells. The input X
+ *          Vector is modified in place to be the solution vector.
+ * @param A the loss + streaming Matrix object
+ * @param X the flux Vector object
+ * @param B the source Vector object
+ * @param tol the relative residual convergence threshold
+ */
+void multigridSolve(Matrix* A, Vector* X, Vector* B, FP_PRECISION tol) {
+
+  multigridLevels levels;
+  initializeMultigridLevels(A, &levels);
+  multigridIterate(&levels, X, B, tol);
+  deleteMultigridLevels(&levels);
+}
+
+
+/**
+ * @brief Performs red-black Gauss-Seidel sweeps over a structured mesh.
+ * @details Unlike linearSolve(...), every cell is visited for meshes with an
+ *          odd number of cells in either dimension, as is the case for
+ *          many of the coarse multigrid levels.
+ * @param A the Matrix object
+ * @param X the solution Vector object
+ * @param B the right hand side Vector object
+ * @param num_sweeps the number of red-black sweeps
+ */
+static void redBlackGaussSeidel(Matrix* A, Vector* X, Vector* B,
+                                int num_sweeps) {
+
+  int num_x = X->getNumX();
+  int num_y = X->getNumY();
+  int num_groups = X->getNumGroups();
+  int* IA = A->getIA();
+  int* JA = A->getJA();
+  FP_PRECISION* DIAG = A->getDiag();
+  FP_PRECISION* a = A->getA();
+  FP_PRECISION* x = X->getArray();
+  FP_PRECISION* b = B->getArray();
+
+  for (int sweep = 0; sweep < num_sweeps; sweep++) {
+    for (int color = 0; color < 2; color++) {
+
+#pragma omp parallel for
+      for (int cy = 0; cy < num_y; cy++) {
+        for (int cx = (cy + color) % 2; cx < num_x; cx += 2) {
+          for (int g = 0; g < num_groups; g++) {
+
+            int row = (cy*num_x + cx)*num_groups + g;
+            FP_PRECISION val = b[row];
+
+            for (int i = IA[row]; i < IA[row+1]; i++) {
+              if (JA[i] != row)
+                val -= a[i] * x[JA[i]];
+            }
+
+            x[row] = val / DIAG[row];
+          }
+        }
+      }
+    }
+  }
+}
+
+
+/**
+ * @brief Computes the residual R = B - A * X of a linear system.
+ * @param A the Matrix object
+ * @param X the solution Vector object
+ * @param B the right hand side Vector object
+ * @param R the residual Vector object
+ * @return the 2-norm of the residual
+ */
+static double computeResidual(Matrix* A, Vector* X, Vector* B, Vector* R) {
+
+  int* IA = A->getIA();
+  int* JA = A->getJA();
+  FP_PRECISION* a = A->getA();
+  FP_PRECISION* x = X->getArray();
+  FP_PRECISION* b = B->getArray();
+  FP_PRECISION* r = R->getArray();
+  int num_rows = X->getNumRows();
+  double norm = 0.;
+
+#pragma omp parallel for reduction(+:norm)
+  for (int row = 0; row < num_rows; row++) {
+    double val = b[row];
+    for (int i = IA[row]; i < IA[row+1]; i++)
+      val -= double(a[i]) * x[JA[i]];
+    r[row] = val;
+    norm += val * val;
+  }
+
+  return sqrt(norm);
+}
+
+
+/**
+ * @brief Constructs the coarse multigrid levels for a Matrix.
+ * @details Each coarse cell agglomerates a 2 x 2 block of cells on the next
+ *          finer level, with the last coarse row or column holding a single
+ *          row or column of fine cells for odd mesh dimensions. The coarse
+ *          Matrix is the Galerkin product R * A * P with piecewise constant
+ *          prolongation (P) and summation restriction (R = P^T), which
+ *          preserves the 5-point spatial stencil and the coupling between
+ *          energy groups within a cell. Levels are added until the coarsest
+ *          level has no more than MAX_MULTIGRID_COARSEST_CELLS cells.
+ * @param A the fine grid Matrix object
+ * @param levels the multigrid levels to initialize
+ */
+static void initializeMultigridLevels(Matrix* A, multigridLevels* levels) {
+
+  int num_x = A->getNumX();
+  int num_y = A->getNumY();
+  int num_groups = A->getNumGroups();
+  omp_lock_t* cell_locks = A->getCellLocks();
+
+  levels->A.push_back(A);
+  levels->X.push_back(NULL);
+  levels->B.push_back(NULL);
+  levels->R.push_back(new Vector(cell_locks, num_x, num_y, num_groups));
+  levels->E.push_back(new Vector(cell_locks, num_x, num_y, num_groups));
+  levels->AE.push_back(new Vector(cell_locks, num_x, num_y, num_groups));
+
+  while (num_x * num_y > MAX_MULTIGRID_COARSEST_CELLS &&
+         (num_x > 1 || num_y > 1)) {
+
+    Matrix* fine = levels->A.back();
+    int fine_x = num_x;
+    num_x = (num_x + 1) / 2;
+    num_y = (num_y + 1) / 2;
+
+    /* Allocate the OpenMP locks for the coarse cells */
+    cell_locks = new omp_lock_t[num_x * num_y];
+    for (int c = 0; c < num_x * num_y; c++)
+      omp_init_lock(&cell_locks[c]);
+
+    /* Form the Galerkin coarse grid Matrix */
+    Matrix* coarse = new Matrix(cell_locks, num_x, num_y, num_groups);
+    int* IA = fine->getIA();
+    int* JA = fine->getJA();
+    FP_PRECISION* a = fine->getA();
+
+    for (int row = 0; row < fine->getNumRows(); row++) {
+
+      int cell_to = row / num_groups;
+      int coarse_to = (cell_to / fine_x / 2) * num_x + (cell_to % fine_x) / 2;
+
+      for (int i = IA[row]; i < IA[row+1]; i++) {
+        int cell_from = JA[i] / num_groups;
+        int coarse_from = (cell_from / fine_x / 2) * num_x
+            + (cell_from % fine_x) / 2;
+        coarse->incrementValue(coarse_from, JA[i] % num_groups, coarse_to,
+                               row % num_groups, a[i]);
+      }
+    }
+
+    levels->A.push_back(coarse);
+    levels->X.push_back(new Vector(cell_locks, num_x, num_y, num_groups));
+    levels->B.push_back(new Vector(cell_locks, num_x, num_y, num_groups));
+    levels->R.push_back(new Vector(cell_locks, num_x, num_y, num_groups));
+    levels->E.push_back(new Vector(cell_locks, num_x, num_y, num_groups));
+    levels->AE.push_back(new Vector(cell_locks, num_x, num_y, num_groups));
+    levels->cell_locks.push_back(cell_locks);
+  }
+
+  log_printf(DEBUG, "Initialized %d multigrid levels", int(levels->A.size()));
+}
+
+
+/**
+ * @brief Deletes the coarse multigrid levels and work Vectors.
+ * @param levels the multigrid levels to delete
+ */
+static void deleteMultigridLevels(multigridLevels* levels) {
+
+  for (size_t l = 0; l < levels->A.size(); l++) {
+    if (l > 0) {
+      delete levels->A[l];
+      delete levels->X[l];
+      delete levels->B[l];
+    }
+    delete levels->R[l];
+    delete levels->E[l];
+    delete levels->AE[l];
+  }
+
+  for (size_t l = 0; l < levels->cell_locks.size(); l++)
+    delete [] levels->cell_locks[l];
+
+  levels->A.clear();
+  levels->X.clear();
+  levels->B.clear();
+  levels->R.clear();
+  levels->E.clear();
+  levels->AE.clear();
+  levels->cell_locks.clear();
+}
+
+
+/**
+ * @brief Performs a multigrid W-cycle starting at a given level.
+ * @param levels the multigrid levels
+ * @param l the index of the level
+ */
+static void multigridCycle(multigridLevels* levels, int l) {
+
+  Matrix* A = levels->A[l];
+  Vector* X = levels->X[l];
+  Vector* B = levels->B[l];
+
+  /* Solve the coarsest level with Gauss-Seidel */
+  if (l == int(levels->A.size()) - 1) {
+    redBlackGaussSeidel(A, X, B, NUM_MULTIGRID_COARSEST_SMOOTHINGS);
+    return;
+  }
+
+  Vector* R = levels->R[l];
+  Vector* E = levels->E[l];
+  Vector* AE = levels->AE[l];
+  Vector* X_coarse = levels->X[l+1];
+  Vector* B_coarse = levels->B[l+1];
+  int num_x = X->getNumX();
+  int num_y = X->getNumY();
+  int num_groups = X->getNumGroups();
+  int coarse_x = X_coarse->getNumX();
+  int num_rows = X->getNumRows();
+  FP_PRECISION* x = X->getArray();
+  FP_PRECISION* r = R->getArray();
+  FP_PRECISION* e = E->getArray();
+  FP_PRECISION* ae = AE->getArray();
+  FP_PRECISION* x_coarse = X_coarse->getArray();
+  FP_PRECISION* b_coarse = B_coarse->getArray();
+
+  /* Pre-smoothing */
+  redBlackGaussSeidel(A, X, B, NUM_MULTIGRID_SMOOTHINGS);
+
+  /* Restrict the residual to the coarse level */
+  computeResidual(A, X, B, R);
+  B_coarse->clear();
+  X_coarse->clear();
+
+#pragma omp parallel for
+  for (int cy = 0; cy < (num_y + 1) / 2; cy++) {
+    for (int fy = 2*cy; fy < std::min(2*cy + 2, num_y); fy++) {
+      for (int fx = 0; fx < num_x; fx++) {
+        int coarse_row = (cy * coarse_x + fx / 2) * num_groups;
+        int fine_row = (fy * num_x + fx) * num_groups;
+        for (int g = 0; g < num_groups; g++)
+          b_coarse[coarse_row + g] += r[fine_row + g];
+      }
+    }
+  }
+
+  /* Solve for the coarse grid correction with two cycles */
+  multigridCycle(levels, l+1);
+  multigridCycle(levels, l+1);
+
+  /* Prolongate the correction to the fine level */
+#pragma omp parallel for
+  for (int fy = 0; fy < num_y; fy++) {
+    for (int fx = 0; fx < num_x; fx++) {
+      int coarse_row = ((fy / 2) * coarse_x + fx / 2) * num_groups;
+      int fine_row = (fy * num_x + fx) * num_groups;
+      for (int g = 0; g < num_groups; g++)
+        e[fine_row + g] = x_coarse[coarse_row + g];
+    }
+  }
+
+  /* Scale the correction to minimize the energy norm of the error, which
+   * compensates for the underestimated correction of piecewise constant
+   * prolongation */
+  matrixMultiplication(A, E, AE);
+
+  double e_dot_r = 0.;
+  double e_dot_ae = 0.;
+
+#pragma omp parallel for reduction(+:e_dot_r,e_dot_ae)
+  for (int row = 0; row < num_rows; row++) {
+    e_dot_r += double(e[row]) * r[row];
+    e_dot_ae += double(e[row]) * ae[row];
+  }
+
+  FP_PRECISION alpha = 1.;
+  if (e_dot_ae > 0.)
+    alpha = e_dot_r / e_dot_ae;
+
+#pragma omp parallel for
+  for (int row = 0; row < num_rows; row++)
+    x[row] += alpha * e[row];
+
+  /* Post-smoothing */
+  redBlackGaussSeidel(A, X, B, NUM_MULTIGRID_SMOOTHINGS);
+}
+
+
+/**
+ * @brief Solves a linear system using a constructed multigrid hierarchy.
+ * @param levels the multigrid levels for the linear system's Matrix
+ * @param X the flux Vector object
+ * @param B the source Vector object
+ * @param tol the relative residual convergence threshold
+ */
+static void multigridIterate(multigridLevels* levels, Vector* X, Vector* B,
+                             FP_PRECISION tol) {
+
+  Matrix* A = levels->A[0];
+  Vector* R = levels->R[0];
+  int iter = 0;
+
+  /* Check for consistency of matrix and vector dimensions */
+  if (A->getNumX() != B->getNumX() || A->getNumX() != X->getNumX() ||
+      A->getNumY() != B->getNumY() || A->getNumY() != X->getNumY() ||
+      A->getNumGroups() != B->getNumGroups() ||
+      A->getNumGroups() != X->getNumGroups())
+    log_printf(ERROR, "Cannot perform multigrid solve with different "
+               "dimensions for the A matrix, B vector, and X vector: "
+               "(%d, %d, %d), (%d, %d, %d), (%d, %d, %d)", A->getNumX(),
+               A->getNumY(), A->getNumGroups(), B->getNumX(), B->getNumY(),
+               B->getNumGroups(), X->getNumX(), X->getNumY(),
+               X->getNumGroups());
+
+  levels->X[0] = X;
+  levels->B[0] = B;
+
+  /* Compute the norm of the right hand side */
+  FP_PRECISION* b = B->getArray();
+  double b_norm = 0.;
+  for (int row = 0; row < B->getNumRows(); row++)
+    b_norm += double(b[row]) * b[row];
+  b_norm = sqrt(b_norm);
+
+  if (b_norm == 0.)
+    b_norm = 1.;
+
+  double residual = computeResidual(A, X, B, R) / b_norm;
+  double old_residual;
+
+  while (iter < MAX_LINEAR_SOLVE_ITERATIONS && residual >= tol) {
+
+    multigridCycle(levels, 0);
+    iter++;
+
+    old_residual = residual;
+    residual = computeResidual(A, X, B, R) / b_norm;
+
+    log_printf(INFO, "Multigrid iter: %d, residual: %f", iter, residual);
+
+    /* Stop if the residual has stagnated at the floating point precision */
+    if (iter > 1 && residual > 0.9 * old_residual)
+      break;
+  }
+
+  levels->X[0] = NULL;
+  levels->B[0] = NULL;
+
+  log_printf(INFO, "multigrid solve iterations: %d", iter);
+}
+
+
 /**
  * @brief Performs a matrix vector multiplication.
  * @details This function takes in a Matrix (A), a variable Vector (X),
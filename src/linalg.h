@@ -21,13 +21,32 @@
 #include "constants.h"
 #include <math.h>
 #include <vector>
+#include <algorithm>
 #include <omp.h>
 #endif
 
+
+/**
+ * @enum linearSolverType
+ * @brief The methods used to solve the linear systems in each power
+ *        iteration of the Matrix-Vector eigenvalue solver.
+ */
+enum linearSolverType {
+
+  /** Red-black Gauss-Seidel with successive over-relaxation */
+  RED_BLACK_SOR,
+
+  /** Geometric multigrid cycles with red-black Gauss-Seidel smoothing */
+  MULTIGRID
+};
+
+
 FP_PRECISION eigenvalueSolve(Matrix* A, Matrix* M, Vector* X, FP_PRECISION tol,
-                             FP_PRECISION SOR_factor=1.5);
+                             FP_PRECISION SOR_factor=1.5,
+                             linearSolverType solver_type=RED_BLACK_SOR);
 void linearSolve(Matrix* A, Matrix* M, Vector* X, Vector* B, FP_PRECISION tol,
                  FP_PRECISION SOR_factor=1.5);
+void multigridSolve(Matrix* A, Vector* X, Vector* B, FP_PRECISION tol);
 void matrixMultiplication(Matrix* A, Vector* X, Vector* B);
 FP_PRECISION computeRMSE(Vector* x, Vector* y, bool integrated);
 
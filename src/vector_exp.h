@@ -0,0 +1,127 @@
+/**
+ * @file vector_exp.h
+ * @brief Portable SIMD evaluation of the exponentials in the transport
+ *        equation for compilers without Intel's MKL.
+ * @date October 19, 2026
+ */
+
+#ifndef VECTOR_EXP_H_
+#define VECTOR_EXP_H_
+
+#ifdef __cplusplus
+#include <stdint.h>
+#include <string.h>
+#endif
+
+
+/** The largest optical length for which exp(-tau) is computed in single
+ *  precision, beyond which 1 - exp(-tau) is one to single precision and
+ *  exp(-tau) would underflow */
+#define VEXP_MAX_TAU_FLOAT 80.f
+
+/** The largest optical length for which exp(-tau) is computed in double
+ *  precision */
+#define VEXP_MAX_TAU_DOUBLE 700.
+
+
+/**
+ * @brief Computes \f$ 1 - exp(-\tau) \f$ for an array of non-negative
+ *        optical lengths in single precision.
+ * @details The exponential is reduced to \f$ exp(-\tau) = 2^{-k} exp(-r) \f$
+ *          with \f$ k = round(\tau / ln(2)) \f$ and
+ *          \f$ |r| \leq ln(2) / 2 \f$, where \f$ exp(-r) - 1 \f$ is
+ *          evaluated with a degree 6 minimax polynomial (relative error of
+ *          1.1E-8). The result is computed as
+ *          \f$ (1 - 2^{-k}) - 2^{-k} (exp(-r) - 1) \f$, or directly from
+ *          the polynomial if k = 0, such that it is accurate to a few units
+ *          in the last place for small optical lengths where one minus the
+ *          exponential would otherwise cancel. The loop has no library
+ *          calls such that it is vectorized by any compiler supporting
+ *          OpenMP SIMD directives (with -ffast-math or -fno-trapping-math
+ *          for the selects to be if-converted).
+ * @param taus an array of non-negative optical lengths
+ * @param exponentials the array to store \f$ 1 - exp(-\tau) \f$ (may be
+ *        the same array as taus)
+ * @param length the length of the arrays
+ */
+inline void one_minus_exp(float* taus, float* exponentials, int length) {
+
+#pragma omp simd
+  for (int i=0; i < length; i++) {
+
+    float tau = taus[i];
+    tau = (tau < VEXP_MAX_TAU_FLOAT) ? tau : VEXP_MAX_TAU_FLOAT;
+
+    /* Reduce the optical length by a multiple of ln(2) */
+    int k = (int)(tau * 1.44269504f + 0.5f);
+    float r = tau - k * 0.693147181f;
+
+    /* Minimax polynomial for (exp(-r) - 1) / r on [-ln(2)/2, ln(2)/2] */
+    float poly = 1.39485837e-3f;
+    poly = poly * r - 8.36915067e-3f;
+    poly = poly * r + 4.16662407e-2f;
+    poly = poly * r - 1.66665052e-1f;
+    poly = poly * r + 5.00000008e-1f;
+    poly = poly * r - 1.00000001f;
+    poly *= r;
+
+    /* Build 2^(-k) from its exponent bits */
+    int32_t bits = (127 - k) << 23;
+    float scale;
+    memcpy(&scale, &bits, sizeof(float));
+
+    /* Use the polynomial alone if k = 0 since fast-math optimizations may
+     * otherwise re-associate the expression and cancel the leading digits */
+    exponentials[i] = (k == 0) ? -poly : (1.f - scale) - scale * poly;
+  }
+}
+
+
+/**
+ * @brief Computes \f$ 1 - exp(-\tau) \f$ for an array of non-negative
+ *        optical lengths in double precision.
+ * @details This uses the same range reduction as the single precision
+ *          version with a degree 11 minimax polynomial (relative error of
+ *          1.8E-17).
+ * @param taus an array of non-negative optical lengths
+ * @param exponentials the array to store \f$ 1 - exp(-\tau) \f$ (may be
+ *        the same array as taus)
+ * @param length the length of the arrays
+ */
+inline void one_minus_exp(double* taus, double* exponentials, int length) {
+
+#pragma omp simd
+  for (int i=0; i < length; i++) {
+
+    double tau = taus[i];
+    tau = (tau < VEXP_MAX_TAU_DOUBLE) ? tau : VEXP_MAX_TAU_DOUBLE;
+
+    /* Reduce the optical length by a multiple of ln(2) */
+    int k = (int)(tau * 1.4426950408889634 + 0.5);
+    double r = tau - k * 0.69314718055994531;
+
+    /* Minimax polynomial for (exp(-r) - 1) / r on [-ln(2)/2, ln(2)/2] */
+    double poly = -2.5114870824586322e-8;
+    poly = poly * r + 2.7626358147967994e-7;
+    poly = poly * r - 2.7557226405392908e-6;
+    poly = poly * r + 2.4801504344541418e-5;
+    poly = poly * r - 1.9841269905300144e-4;
+    poly = poly * r + 1.3888888932490819e-3;
+    poly = poly * r - 8.3333333333130575e-3;
+    poly = poly * r + 4.1666666666573135e-2;
+    poly = poly * r - 1.6666666666666691e-1;
+    poly = poly * r + 5.0000000000000056e-1;
+    poly = poly * r - 1.0;
+    poly *= r;
+
+    /* Build 2^(-k) from its exponent bits */
+    int64_t bits = (int64_t)(1023 - k) << 52;
+    double scale;
+    memcpy(&scale, &bits, sizeof(double));
+
+    exponentials[i] = (k == 0) ? -poly : (1. - scale) - scale * poly;
+  }
+}
+
+
+#endif /* VECTOR_EXP_H_ */
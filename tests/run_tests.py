@@ -56,6 +56,9 @@ class Test(object):
         setup_cmd = [sys.executable, 'setup.py', 'install']
         setup_cmd += ['--install-purelib=tests/openmoc']
         setup_cmd += ['--cc={0}'.format(self.cc), '--fp={0}'.format(self.fp)]
+
+        # Build the mixed precision module used by test_mixed_precision
+        setup_cmd += ['--with-precisions=mixed']
         if self.debug:
             setup_cmd += ['--debug-mode']
 
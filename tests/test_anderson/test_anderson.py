@@ -0,0 +1,39 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import MultiSimTestHarness
+from input_set import PwrAssemblyInput
+
+
+class AndersonTestHarness(MultiSimTestHarness):
+    """Eigenvalue calculations for a 17x17 lattice with 7-group C5G7 cross
+    section data without and with Anderson acceleration of the source
+    iteration. The accelerated eigenvalue must agree with the unaccelerated
+    eigenvalue to within 1E-4 in fewer iterations."""
+
+    def __init__(self):
+        super(AndersonTestHarness, self).__init__()
+        self.input_set = PwrAssemblyInput()
+        self.num_simulations = 1
+        self.keff_tolerance = 1E-4
+
+    def _run_openmoc(self):
+        """Run an eigenvalue calculation with each Anderson depth."""
+
+        for depth in [0, 3]:
+            self.solver.setAndersonDepth(depth)
+            super(AndersonTestHarness, self)._run_openmoc()
+
+        # Compare the accelerated to the unaccelerated calculation
+        assert abs(self.keffs[1] - self.keffs[0]) < self.keff_tolerance, \
+            'Anderson acceleration changed the eigenvalue.'
+        assert self.num_iters[1] < self.num_iters[0], \
+            'Anderson acceleration did not reduce the number of iterations.'
+
+
+if __name__ == '__main__':
+    harness = AndersonTestHarness()
+    harness.main()
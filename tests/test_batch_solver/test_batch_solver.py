@@ -0,0 +1,50 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import PinCellInput
+import openmoc
+
+
+class BatchSolverTestHarness(TestHarness):
+    """An eigenvalue calculation for a pin cell with 7-group C5G7 cross
+    section data and a second material state which replaces the UO2 fuel
+    with MOX. This tests the BatchSolver."""
+
+    def __init__(self):
+        super(BatchSolverTestHarness, self).__init__()
+        self.input_set = PinCellInput()
+        self.res_type = openmoc.SCALAR_FLUX
+
+    def _create_solver(self):
+        """Instantiate a BatchSolver with a nominal and a MOX state."""
+        self.solver = openmoc.BatchSolver(self.track_generator)
+        self.solver.setNumThreads(self.num_threads)
+        self.solver.setConvergenceThreshold(self.tolerance)
+        self.solver.setNumStates(2)
+        self.solver.setStateMaterial(1, self.input_set.materials['UO2'],
+                                     self.input_set.materials['MOX-8.7%'])
+
+    def _get_results(self, num_iters=True, keff=True, fluxes=True,
+                     num_fsrs=False, num_tracks=False, num_segments=False,
+                     hash_output=False):
+        """Digest info in the solver for each state and return as a string."""
+
+        outstr = ''
+        for state in range(self.solver.getNumStates()):
+            self.solver.setActiveState(state)
+            outstr += 'State: {0}\n'.format(state)
+            outstr += super(BatchSolverTestHarness, self)._get_results(
+                num_iters=(num_iters and state == 0), keff=keff,
+                fluxes=fluxes, num_fsrs=num_fsrs, num_tracks=num_tracks,
+                num_segments=num_segments, hash_output=hash_output)
+
+        return outstr
+
+
+if __name__ == '__main__':
+    harness = BatchSolverTestHarness()
+    harness.main()
@@ -0,0 +1,54 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import MultiSimTestHarness
+from input_set import PwrAssemblyInput
+import openmoc
+
+
+class CmfdMultigridTestHarness(MultiSimTestHarness):
+    """Eigenvalue calculations with CMFD for a 17x17 lattice with 7-group
+    C5G7 cross section data, solving the CMFD linear systems with red-black
+    SOR and with multigrid. The multigrid eigenvalue must agree with the
+    SOR eigenvalue to within 1E-6."""
+
+    def __init__(self):
+        super(CmfdMultigridTestHarness, self).__init__()
+        self.input_set = PwrAssemblyInput()
+        self.num_simulations = 1
+        self.keff_tolerance = 1E-6
+        self.cmfd = None
+
+    def _create_geometry(self):
+        """Initialize CMFD and add it to the Geometry."""
+
+        super(CmfdMultigridTestHarness, self)._create_geometry()
+
+        # Initialize CMFD
+        self.cmfd = openmoc.Cmfd()
+        self.cmfd.setSORRelaxationFactor(1.5)
+        self.cmfd.setLatticeStructure(17,17)
+        self.cmfd.setGroupStructure([1,4,8])
+        self.cmfd.setKNearest(3)
+
+        # Add CMFD to the Geometry
+        self.input_set.geometry.setCmfd(self.cmfd)
+
+    def _run_openmoc(self):
+        """Run an eigenvalue calculation with each CMFD linear solver."""
+
+        for solver_type in [openmoc.RED_BLACK_SOR, openmoc.MULTIGRID]:
+            self.cmfd.setLinearSolverType(solver_type)
+            super(CmfdMultigridTestHarness, self)._run_openmoc()
+
+        # Compare the multigrid eigenvalue to the SOR eigenvalue
+        assert abs(self.keffs[1] - self.keffs[0]) < self.keff_tolerance, \
+            'The multigrid CMFD eigenvalue differs from the SOR eigenvalue.'
+
+
+if __name__ == '__main__':
+    harness = CmfdMultigridTestHarness()
+    harness.main()
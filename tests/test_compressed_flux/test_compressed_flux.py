@@ -0,0 +1,40 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import MultiSimTestHarness
+from input_set import SimpleLatticeInput
+import openmoc
+
+
+class CompressedFluxTestHarness(MultiSimTestHarness):
+    """Eigenvalue calculations for a 4x4 lattice with the boundary angular
+    fluxes stored in full precision, in half precision and as scaled 16-bit
+    integers. The eigenvalues with compressed boundary angular fluxes must
+    agree with the full precision eigenvalue to within 1E-4."""
+
+    def __init__(self):
+        super(CompressedFluxTestHarness, self).__init__()
+        self.input_set = SimpleLatticeInput()
+        self.num_simulations = 1
+        self.keff_tolerance = 1E-4
+
+    def _run_openmoc(self):
+        """Run an eigenvalue calculation with each boundary flux storage."""
+
+        for storage in [openmoc.BOUNDARY_FLUX_FULL, openmoc.BOUNDARY_FLUX_HALF,
+                        openmoc.BOUNDARY_FLUX_SCALED]:
+            self.solver.setBoundaryFluxStorage(storage)
+            super(CompressedFluxTestHarness, self)._run_openmoc()
+
+        # Compare the compressed eigenvalues to the full precision eigenvalue
+        for keff in self.keffs[1:]:
+            assert abs(keff - self.keffs[0]) < self.keff_tolerance, \
+                'Compressed boundary fluxes changed the eigenvalue.'
+
+
+if __name__ == '__main__':
+    harness = CompressedFluxTestHarness()
+    harness.main()
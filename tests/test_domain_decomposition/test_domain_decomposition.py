@@ -0,0 +1,89 @@
+#!/usr/bin/env python
+
+import os
+import sys
+import threading
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import PwrAssemblyInput
+import openmoc
+
+
+class DomainDecompositionTestHarness(TestHarness):
+    """An eigenvalue calculation for a 17x17 lattice with 7-group C5G7
+    cross section data decomposed into 2x2 spatial domains. Each domain is
+    solved in its own Python thread and exchanges its interface fluxes
+    through a ThreadCommunicatorGroup."""
+
+    def __init__(self):
+        super(DomainDecompositionTestHarness, self).__init__()
+        self.num_domains_x = 2
+        self.num_domains_y = 2
+        self.input_sets = []
+        self.track_generators = []
+        self.solvers = []
+        self.communicators = None
+
+    def _setup(self):
+        """Build the materials, geometry, tracks and solver of each domain."""
+
+        num_domains = self.num_domains_x * self.num_domains_y
+        self.communicators = openmoc.ThreadCommunicatorGroup(num_domains)
+
+        for rank in range(num_domains):
+            self.input_set = PwrAssemblyInput()
+            self._create_geometry()
+            self.input_set.geometry.setDomain(
+                self.num_domains_x, self.num_domains_y,
+                rank % self.num_domains_x, rank // self.num_domains_x)
+            self._create_trackgenerator()
+            self._generate_tracks()
+            self._create_solver()
+            self.solver.setCommunicator(
+                self.communicators.getCommunicator(rank))
+
+            self.input_sets.append(self.input_set)
+            self.track_generators.append(self.track_generator)
+            self.solvers.append(self.solver)
+
+    def _run_openmoc(self):
+        """Run the eigenvalue calculations of all domains concurrently."""
+
+        errors = []
+
+        def solve(solver):
+            try:
+                solver.computeEigenvalue(self.max_iters,
+                                         res_type=self.res_type)
+            except Exception as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=solve, args=(solver,))
+                   for solver in self.solvers]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        if errors:
+            raise errors[0]
+
+    def _get_results(self, num_iters=True, keff=True, fluxes=False,
+                     num_fsrs=True, num_tracks=False, num_segments=False,
+                     hash_output=False):
+        """Return the eigenvalue and FSRs of each domain as a string."""
+
+        outstr = ''
+        for rank, solver in enumerate(self.solvers):
+            outstr += 'Domain: {0}\tIters: {1}\tkeff: {2:12.5E}\t' \
+                      'FSRs: {3}\n'.format(
+                          rank, solver.getNumIterations(), solver.getKeff(),
+                          self.input_sets[rank].geometry.getNumFSRs())
+
+        return outstr
+
+
+if __name__ == '__main__':
+    harness = DomainDecompositionTestHarness()
+    harness.main()
@@ -0,0 +1,34 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import PinCellInput
+import openmoc
+
+
+class GroupBlocksTestHarness(TestHarness):
+    """An eigenvalue calculation for a pin cell with 7-group C5G7 cross
+    section data where the energy groups are swept in 4 concurrent blocks.
+    This tests CPUSolver::setNumGroupBlocks(...)."""
+
+    def __init__(self):
+        super(GroupBlocksTestHarness, self).__init__()
+        self.input_set = PinCellInput()
+        self.res_type = openmoc.SCALAR_FLUX
+
+        # The number of blocks is limited by the number of threads
+        self.num_threads = 4
+        self.num_group_blocks = 4
+
+    def _create_solver(self):
+        """Instantiate a CPUSolver which sweeps blocks of energy groups."""
+        super(GroupBlocksTestHarness, self)._create_solver()
+        self.solver.setNumGroupBlocks(self.num_group_blocks)
+
+
+if __name__ == '__main__':
+    harness = GroupBlocksTestHarness()
+    harness.main()
@@ -0,0 +1,55 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import PwrAssemblyInput
+import openmoc
+
+
+class KrylovEigenmodesTestHarness(TestHarness):
+    """A forward eigenmode calculation for a 17x17 lattice with 7-group C5G7
+    cross section data and vacuum boundaries. This tests the
+    KrylovSolver::computeEigenmodes(...) method."""
+
+    def __init__(self):
+        super(KrylovEigenmodesTestHarness, self).__init__()
+        self.input_set = PwrAssemblyInput()
+        self.num_modes = 3
+        self.krylov_solver = None
+
+    def _create_geometry(self):
+        """Put VACUUM boundary conditions on all bounding surfaces."""
+
+        super(KrylovEigenmodesTestHarness, self)._create_geometry()
+
+        # Apply VACUUM BCs on all bounding surfaces
+        surfaces = self.input_set.geometry.getAllSurfaces()
+        for surface_id in surfaces:
+            surface = surfaces[surface_id]
+            if surface.getSurfaceType() != openmoc.ZCYLINDER:
+                surface.setBoundaryType(openmoc.VACUUM)
+
+    def _run_openmoc(self):
+        """Run a KrylovSolver forward eigenmode calculation."""
+        self.krylov_solver = openmoc.KrylovSolver(self.solver)
+        self.krylov_solver.computeEigenmodes(openmoc.FORWARD, self.num_modes)
+
+    def _get_results(self, num_iters=False, keff=False, fluxes=False,
+                     num_fsrs=False, num_tracks=False, num_segments=False,
+                     hash_output=False):
+        """Return the eigenvalue of each eigenmode as a string."""
+
+        outstr = ''
+        for mode in range(self.krylov_solver.getNumModes()):
+            outstr += 'Mode: {0}\tkeff: {1:12.5E}\n'.format(
+                mode, self.krylov_solver.getEigenvalue(mode))
+
+        return outstr
+
+
+if __name__ == '__main__':
+    harness = KrylovEigenmodesTestHarness()
+    harness.main()
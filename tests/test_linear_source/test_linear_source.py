@@ -0,0 +1,49 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import HomInfMedInput
+import openmoc
+
+
+class LinearSourceTestHarness(TestHarness):
+    """An eigenvalue calculation in a cube with vacuum BCs in x and
+    reflective BCs in y with 2-group cross section data. The flux gradient
+    across each FSR is resolved with the linear source CPULSSolver."""
+
+    def __init__(self):
+        super(LinearSourceTestHarness, self).__init__()
+        self.input_set = HomInfMedInput()
+
+    def _create_geometry(self):
+        """Put VACUUM boundary conditions on left and right boundaries."""
+
+        super(LinearSourceTestHarness, self)._create_geometry()
+
+        # Get the root Cell
+        cells = self.input_set.geometry.getAllCells()
+        for cell_id in cells:
+            cell = cells[cell_id]
+            if cell.getName() == 'root cell':
+                root_cell = cell
+
+        # Apply VACUUM BCs on the min/max XPlane surfaces
+        surfaces = root_cell.getSurfaces()
+        for surface_id in surfaces:
+            surface = surfaces[surface_id]._surface
+            if surface.getName() in ['xmin', 'xmax']:
+                surface.setBoundaryType(openmoc.VACUUM)
+
+    def _create_solver(self):
+        """Instantiate a CPULSSolver."""
+        self.solver = openmoc.CPULSSolver(self.track_generator)
+        self.solver.setNumThreads(self.num_threads)
+        self.solver.setConvergenceThreshold(self.tolerance)
+
+
+if __name__ == '__main__':
+    harness = LinearSourceTestHarness()
+    harness.main()
@@ -0,0 +1,61 @@
+#!/usr/bin/env python
+
+import os
+import sys
+
+# Use the mixed precision module built side by side with the main module
+os.environ['OPENMOC_PRECISION'] = 'mixed'
+
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import PinCellInput
+import openmoc
+
+
+class MixedPrecisionTestHarness(TestHarness):
+    """An eigenvalue calculation for a pin cell with 7-group C5G7 cross
+    section data in mixed precision. The eigenvalue and fluxes are compared
+    to those of the double precision module to within a relative tolerance,
+    since the single precision angular fluxes change the last digits."""
+
+    def __init__(self):
+        super(MixedPrecisionTestHarness, self).__init__()
+        self.input_set = PinCellInput()
+        self.res_type = openmoc.SCALAR_FLUX
+        self.rel_tolerance = 1E-5
+
+    def _get_results(self, num_iters=False, keff=True, fluxes=True,
+                     num_fsrs=False, num_tracks=False, num_segments=False,
+                     hash_output=False):
+        """Digest info in the solver and return as a string."""
+        return super(MixedPrecisionTestHarness, self)._get_results(
+                num_iters=num_iters, keff=keff, fluxes=fluxes,
+                num_fsrs=num_fsrs, num_tracks=num_tracks,
+                num_segments=num_segments, hash_output=hash_output)
+
+    def _compare_results(self):
+        """Make sure the current results agree with the double precision
+        results to within the relative tolerance."""
+
+        with open('results_test.dat', 'r') as fh:
+            test_values = fh.read().split()
+        with open('results_true.dat', 'r') as fh:
+            true_values = fh.read().split()
+
+        compare = len(test_values) == len(true_values)
+        for test, true in zip(test_values, true_values):
+            try:
+                compare &= abs(float(test) - float(true)) <= \
+                    self.rel_tolerance * abs(float(true))
+            except ValueError:
+                compare &= test == true
+
+        if not compare:
+            os.rename('results_test.dat', 'results_error.dat')
+        assert compare, 'Results do not agree.'
+
+
+if __name__ == '__main__':
+    harness = MixedPrecisionTestHarness()
+    harness.main()
@@ -0,0 +1,53 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import PwrAssemblyInput
+import openmoc
+
+
+class OTFCmfdPwrAssemblyTestHarness(TestHarness):
+    """An eigenvalue calculation with CMFD for a 17x17 lattice with 7-group
+    C5G7 cross section data, where the Track segments are traced on-the-fly
+    in each transport sweep rather than stored."""
+
+    def __init__(self):
+        super(OTFCmfdPwrAssemblyTestHarness, self).__init__()
+        self.input_set = PwrAssemblyInput()
+
+    def _create_geometry(self):
+        """Initialize CMFD and add it to the Geometry."""
+
+        super(OTFCmfdPwrAssemblyTestHarness, self)._create_geometry()
+
+        # Initialize CMFD
+        cmfd = openmoc.Cmfd()
+        cmfd.setSORRelaxationFactor(1.5)
+        cmfd.setLatticeStructure(17,17)
+        cmfd.setGroupStructure([1,4,8])
+        cmfd.setKNearest(3)
+
+        # Add CMFD to the Geometry
+        self.input_set.geometry.setCmfd(cmfd)
+
+    def _create_trackgenerator(self):
+        """Instantiate a TrackGenerator which traces segments on-the-fly."""
+        super(OTFCmfdPwrAssemblyTestHarness, self)._create_trackgenerator()
+        self.track_generator.setSegmentFormation(openmoc.OTF_SEGMENTS)
+
+    def _get_results(self, num_iters=True, keff=True, fluxes=True,
+                     num_fsrs=False, num_tracks=False, num_segments=False,
+                     hash_output=True):
+        """Digest info in the solver and return hash as a string."""
+        return super(OTFCmfdPwrAssemblyTestHarness, self)._get_results(
+                num_iters=num_iters, keff=keff, fluxes=fluxes,
+                num_fsrs=num_fsrs, num_tracks=num_tracks,
+                num_segments=num_segments, hash_output=hash_output)
+
+
+if __name__ == '__main__':
+    harness = OTFCmfdPwrAssemblyTestHarness()
+    harness.main()
@@ -0,0 +1,43 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import PwrAssemblyInput
+import openmoc
+
+
+class OTFModularPwrAssemblyTestHarness(TestHarness):
+    """An eigenvalue calculation for a 17x17 lattice with 7-group C5G7
+    cross section data, where the Track segments are traced on-the-fly with
+    segment templates by more threads than the Geometry was created with."""
+
+    def __init__(self):
+        super(OTFModularPwrAssemblyTestHarness, self).__init__()
+        self.input_set = PwrAssemblyInput()
+
+        # Trace the Tracks again with more threads than OpenMP started with
+        self.num_threads += 1
+
+    def _create_trackgenerator(self):
+        """Instantiate a TrackGenerator which traces segments on-the-fly
+        with segment templates."""
+        super(OTFModularPwrAssemblyTestHarness, self)._create_trackgenerator()
+        self.track_generator.setSegmentFormation(openmoc.OTF_SEGMENTS)
+        self.track_generator.setModularRayTracing(True)
+
+    def _get_results(self, num_iters=True, keff=True, fluxes=True,
+                     num_fsrs=False, num_tracks=False, num_segments=False,
+                     hash_output=True):
+        """Digest info in the solver and return hash as a string."""
+        return super(OTFModularPwrAssemblyTestHarness, self)._get_results(
+                num_iters=num_iters, keff=keff, fluxes=fluxes,
+                num_fsrs=num_fsrs, num_tracks=num_tracks,
+                num_segments=num_segments, hash_output=hash_output)
+
+
+if __name__ == '__main__':
+    harness = OTFModularPwrAssemblyTestHarness()
+    harness.main()
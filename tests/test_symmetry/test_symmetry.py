@@ -0,0 +1,36 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import PwrAssemblyInput
+
+
+class SymmetryTestHarness(TestHarness):
+    """An eigenvalue calculation for one quarter of a 17x17 lattice with
+    7-group C5G7 cross section data. This tests Geometry::useSymmetry(...)."""
+
+    def __init__(self):
+        super(SymmetryTestHarness, self).__init__()
+        self.input_set = PwrAssemblyInput()
+
+    def _create_geometry(self):
+        """Solve only one quarter of the mirror symmetric Geometry."""
+        super(SymmetryTestHarness, self)._create_geometry()
+        self.input_set.geometry.useSymmetry(True, True)
+
+    def _get_results(self, num_iters=True, keff=True, fluxes=False,
+                     num_fsrs=True, num_tracks=True, num_segments=True,
+                     hash_output=False):
+        """Digest info in the solver and return as a string."""
+        return super(SymmetryTestHarness, self)._get_results(
+                num_iters=num_iters, keff=keff, fluxes=fluxes,
+                num_fsrs=num_fsrs, num_tracks=num_tracks,
+                num_segments=num_segments, hash_output=hash_output)
+
+
+if __name__ == '__main__':
+    harness = SymmetryTestHarness()
+    harness.main()
@@ -0,0 +1,29 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import MultiSimTestHarness
+from input_set import PwrAssemblyInput
+
+
+class WarmStartTestHarness(MultiSimTestHarness):
+    """Two eigenvalue calculations for a 17x17 lattice with 7-group C5G7
+    cross section data where the second calculation starts from the fluxes
+    and eigenvalue of the first. This tests Solver::setWarmStart(...)."""
+
+    def __init__(self):
+        super(WarmStartTestHarness, self).__init__()
+        self.input_set = PwrAssemblyInput()
+        self.num_simulations = 2
+
+    def _create_solver(self):
+        """Instantiate a CPUSolver which is warm started."""
+        super(WarmStartTestHarness, self)._create_solver()
+        self.solver.setWarmStart(True)
+
+
+if __name__ == '__main__':
+    harness = WarmStartTestHarness()
+    harness.main()
@@ -243,12 +243,13 @@ class TrackingTestHarness(TestHarness):
         for i in range(num_segments):
             info += str(i) + ': '
             segment = track.getSegment(i)
+            material = geometry.findFSRMaterial(segment._region_id)
             info += str(round(segment._length, 8)) + ', '
             info += str(segment._region_id) + ', '
-            info += str(segment._cmfd_surface_fwd) + ', '
-            info += str(segment._cmfd_surface_bwd) + ', '
-            info += str(segment._material.getName()) + ', '
-            info += str(segment._material.getId()) + '\n'
+            info += str(track.getCmfdSurfaceFwd(i)) + ', '
+            info += str(track.getCmfdSurfaceBwd(i)) + ', '
+            info += str(material.getName()) + ', '
+            info += str(material.getId()) + '\n'
         track.clearSegments()
         return info
 